@@ -183,9 +183,8 @@ static int dmic_mcux_stop(struct mcux_dmic_drv_data *drv_data)
 	k_msgq_purge(drv_data->rx_queue);
 
 	/* Free all memory slabs */
-	for (uint32_t i = 0; i < CONFIG_DMIC_MCUX_DMA_BUFFERS; i++) {
-		k_mem_slab_free(drv_data->mem_slab, drv_data->dma_bufs[i]);
-	}
+	k_mem_slab_free_bulk(drv_data->mem_slab, drv_data->dma_bufs,
+			     CONFIG_DMIC_MCUX_DMA_BUFFERS);
 
 	drv_data->dmic_state = DMIC_STATE_CONFIGURED;
 
@@ -545,14 +544,11 @@ static int dmic_mcux_start(const struct device *dev)
 	 * a minimum of two buffers
 	 */
 
-	for (uint32_t i = 0; i < CONFIG_DMIC_MCUX_DMA_BUFFERS; i++) {
-		/* Allocate buffers for DMA */
-		ret = k_mem_slab_alloc(drv_data->mem_slab,
-				       &drv_data->dma_bufs[i], K_NO_WAIT);
-		if (ret < 0) {
-			LOG_ERR("failed to allocate buffer");
-			return -ENOBUFS;
-		}
+	ret = k_mem_slab_alloc_bulk(drv_data->mem_slab, drv_data->dma_bufs,
+				    CONFIG_DMIC_MCUX_DMA_BUFFERS);
+	if (ret < 0) {
+		LOG_ERR("failed to allocate buffer");
+		return -ENOBUFS;
 	}
 
 	ret = dmic_mcux_setup_dma(dev);
@@ -659,13 +659,10 @@ static int i2s_mcux_rx_stream_start(const struct device *dev)
 		return -EINVAL;
 	}
 
-	for (int i = 0; i < NUM_RX_DMA_BLOCKS; i++) {
-		ret = k_mem_slab_alloc(stream->cfg.mem_slab, &buffer[i],
-							K_NO_WAIT);
-		if (ret != 0) {
-			LOG_ERR("buffer alloc from mem_slab failed (%d)", ret);
-			return ret;
-		}
+	ret = k_mem_slab_alloc_bulk(stream->cfg.mem_slab, buffer, NUM_RX_DMA_BLOCKS);
+	if (ret != 0) {
+		LOG_ERR("buffer alloc from mem_slab failed (%d)", ret);
+		return ret;
 	}
 
 	i2s_mcux_config_dma_blocks(dev, I2S_DIR_RX, (uint32_t *)buffer,
@@ -0,0 +1,188 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @defgroup cpp_memory_resource C++ memory resources
+ * @ingroup os_services
+ *
+ * @brief std::pmr memory resources over Zephyr heaps
+ *
+ * These adapt Zephyr memory allocators to the C++17
+ * std::pmr::memory_resource interface, so that polymorphic allocator
+ * aware containers such as std::pmr::vector, std::pmr::map and
+ * std::pmr::string can be placed on a dedicated heap or in a bounded
+ * buffer instead of the C library heap used by operator new.
+ *
+ * Allocation failures throw std::bad_alloc when exceptions are enabled,
+ * as required by the interface, and cause a kernel panic otherwise.
+ *
+ * Requires a C++17 standard library providing <memory_resource>.
+ *
+ * @{
+ */
+
+#ifndef ZEPHYR_INCLUDE_CPP_MEMORY_RESOURCE_HPP_
+#define ZEPHYR_INCLUDE_CPP_MEMORY_RESOURCE_HPP_
+
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/sys_heap.h>
+
+namespace zephyr::pmr
+{
+
+/** @cond INTERNAL_HIDDEN */
+namespace detail
+{
+[[noreturn]] inline void alloc_failed()
+{
+#if defined(__cpp_exceptions)
+	throw std::bad_alloc();
+#else
+	k_panic();
+	CODE_UNREACHABLE;
+#endif
+}
+} /* namespace detail */
+/** @endcond */
+
+/**
+ * @brief Memory resource allocating from a sys_heap
+ *
+ * A sys_heap is not synchronized: the resource must only be used from
+ * one context at a time, or access must be serialized by the caller.
+ */
+class sys_heap_resource : public std::pmr::memory_resource {
+public:
+	/**
+	 * @param heap Initialized heap to allocate from.
+	 */
+	explicit sys_heap_resource(struct sys_heap *heap) noexcept : heap_(heap)
+	{
+	}
+
+private:
+	void *do_allocate(std::size_t bytes, std::size_t alignment) override
+	{
+		void *ptr = sys_heap_aligned_alloc(heap_, alignment, bytes);
+
+		if (ptr == nullptr) {
+			detail::alloc_failed();
+		}
+
+		return ptr;
+	}
+
+	void do_deallocate(void *ptr, std::size_t, std::size_t) override
+	{
+		sys_heap_free(heap_, ptr);
+	}
+
+	bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+	{
+		return this == &other;
+	}
+
+	struct sys_heap *heap_;
+};
+
+/**
+ * @brief Memory resource allocating from a k_heap
+ *
+ * Allocations do not block: they fail immediately if the heap has no
+ * room. The resource may be shared between threads.
+ */
+class k_heap_resource : public std::pmr::memory_resource {
+public:
+	/**
+	 * @param heap Initialized heap to allocate from, e.g. one defined with
+	 *             K_HEAP_DEFINE().
+	 */
+	explicit k_heap_resource(struct k_heap *heap) noexcept : heap_(heap)
+	{
+	}
+
+private:
+	void *do_allocate(std::size_t bytes, std::size_t alignment) override
+	{
+		void *ptr = k_heap_aligned_alloc(heap_, alignment, bytes, K_NO_WAIT);
+
+		if (ptr == nullptr) {
+			detail::alloc_failed();
+		}
+
+		return ptr;
+	}
+
+	void do_deallocate(void *ptr, std::size_t, std::size_t) override
+	{
+		k_heap_free(heap_, ptr);
+	}
+
+	bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+	{
+		return this == &other;
+	}
+
+	struct k_heap *heap_;
+};
+
+/** @cond INTERNAL_HIDDEN */
+namespace detail
+{
+/* Base class owning the buffer, so it is constructed before the
+ * monotonic_buffer_resource that is handed a pointer to it.
+ */
+template <std::size_t N> struct arena_storage {
+	alignas(std::max_align_t) std::byte buffer[N];
+};
+} /* namespace detail */
+/** @endcond */
+
+/**
+ * @brief Monotonic arena of a fixed size
+ *
+ * Allocation bumps a pointer through an internal buffer of @p N bytes and
+ * deallocation does nothing; all memory is reclaimed at once by release()
+ * or when the arena is destroyed. This suits request or frame scoped
+ * work, where many short lived objects are created and dropped together.
+ *
+ * Unlike a plain std::pmr::monotonic_buffer_resource, the arena never
+ * falls back to the C library heap: running out of buffer space is an
+ * allocation failure unless another @p upstream resource is given.
+ *
+ * The arena is not synchronized.
+ *
+ * @tparam N Size of the arena in bytes.
+ */
+template <std::size_t N>
+class arena_resource : private detail::arena_storage<N>,
+		       public std::pmr::monotonic_buffer_resource {
+public:
+	/**
+	 * @param upstream Resource providing more memory once the buffer is
+	 *                 used up, none by default.
+	 */
+	explicit arena_resource(
+		std::pmr::memory_resource *upstream = std::pmr::null_memory_resource()) noexcept
+		: std::pmr::monotonic_buffer_resource(detail::arena_storage<N>::buffer, N,
+						      upstream)
+	{
+	}
+
+	arena_resource(const arena_resource &) = delete;
+	arena_resource &operator=(const arena_resource &) = delete;
+};
+
+} /* namespace zephyr::pmr */
+
+/** @} */
+
+#endif /* ZEPHYR_INCLUDE_CPP_MEMORY_RESOURCE_HPP_ */
@@ -98,6 +98,12 @@ struct disk_info {
 	const struct device *dev;
 	/** Internally used disk reference count */
 	uint16_t refcnt;
+#if defined(CONFIG_DISK_CACHE) || defined(__DOXYGEN__)
+	/** Internally used, sector count of a disk using the block cache */
+	uint32_t cache_sectors;
+	/** Internally used, serializes block cache accesses to this disk */
+	struct k_mutex cache_lock;
+#endif
 };
 
 /**
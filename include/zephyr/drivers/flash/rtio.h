@@ -0,0 +1,53 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_DRIVERS_FLASH_RTIO_H_
+#define ZEPHYR_INCLUDE_DRIVERS_FLASH_RTIO_H_
+
+#include <zephyr/device.h>
+#include <zephyr/rtio/rtio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Flash RTIO iodev API
+ *
+ * Submissions are executed in order on the RTIO work queue with the
+ * synchronous flash API, which lets callers queue erase and program
+ * operations and keep working while they complete. Supported operations
+ * are RTIO_OP_STORAGE_READ, RTIO_OP_STORAGE_WRITE and
+ * RTIO_OP_STORAGE_ERASE, with offsets and lengths in bytes.
+ */
+extern const struct rtio_iodev_api flash_iodev_api;
+
+/**
+ * @brief Define an iodev for a flash device
+ *
+ * @param name Symbolic name to use for defining the iodev
+ * @param node_id Devicetree node identifier of the flash device
+ */
+#define FLASH_DT_IODEV_DEFINE(name, node_id)					\
+	RTIO_IODEV_DEFINE(name, &flash_iodev_api, (void *)DEVICE_DT_GET(node_id))
+
+/**
+ * @brief Get the flash device of an iodev
+ *
+ * @param iodev Iodev defined with FLASH_DT_IODEV_DEFINE
+ *
+ * @return Flash device
+ */
+static inline const struct device *flash_iodev_device(const struct rtio_iodev *iodev)
+{
+	return (const struct device *)iodev->data;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_DRIVERS_FLASH_RTIO_H_ */
@@ -0,0 +1,199 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef ZEPHYR_INCLUDE_FS_FCB_TS_H_
+#define ZEPHYR_INCLUDE_FS_FCB_TS_H_
+
+/*
+ * Append-only time-series record store on top of the flash circular buffer.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <zephyr/fs/fcb.h>
+#include <zephyr/kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup fcb_ts FCB Time Series
+ * @ingroup fcb
+ * @{
+ */
+
+/**
+ * @brief Header of a batch of records, as stored at the start of every FCB entry.
+ *
+ * The header is followed by @p count records, each made of a 32-bit
+ * timestamp delta from @p base_ts and @p rec_len bytes of payload.
+ */
+struct fcb_ts_batch_hdr {
+	uint64_t base_ts;    /**< Timestamp of the first record in the batch */
+	uint32_t last_delta; /**< Delta of the last, most recent, record in the batch */
+	uint16_t count;      /**< Number of records in the batch */
+	uint16_t rec_len;    /**< Payload length of every record */
+};
+
+/**
+ * @brief Timestamp range of the records held by one FCB sector.
+ *
+ * A sector without records has @p min_ts greater than @p max_ts.
+ */
+struct fcb_ts_sector_range {
+	uint64_t min_ts; /**< Oldest timestamp in the sector */
+	uint64_t max_ts; /**< Newest timestamp in the sector */
+};
+
+/**
+ * @brief Record passed to @ref fcb_ts_append.
+ */
+struct fcb_ts_record {
+	uint64_t timestamp; /**< Record timestamp */
+	const void *data;   /**< Record payload, fcb_ts::rec_len bytes */
+};
+
+/**
+ * @brief FCB time-series instance structure
+ *
+ * The first part should be filled in by the user before calling
+ * @ref fcb_ts_init. The second part is used for internal bookkeeping.
+ */
+struct fcb_ts {
+	/* Caller of fcb_ts_init fills this in */
+	struct fcb *fcb;
+	/**< Initialized FCB instance holding the records. It must not be used
+	 * for other entries while the time-series store is in use.
+	 */
+
+	uint16_t rec_len; /**< Payload length of every record */
+
+	uint8_t *buf;
+	/**< Staging buffer that collects records until they are written as
+	 * one FCB entry. Its size bounds the batch size, as does the size of
+	 * the smallest FCB sector.
+	 */
+
+	size_t buf_size; /**< Size of buf */
+
+	struct fcb_ts_sector_range *ranges;
+	/**< Sparse index, one element per FCB sector (fcb::f_sector_cnt) */
+
+	/* Internal state */
+	struct k_mutex mtx;     /**< Serializes access to the staging buffer */
+	uint64_t last_ts;       /**< Newest timestamp written or staged */
+	uint64_t batch_base;    /**< Timestamp of the first staged record */
+	size_t batch_len;       /**< Bytes of buf in use */
+	size_t batch_max;       /**< Largest batch fitting buf and an empty sector */
+	uint16_t batch_cnt;     /**< Number of records staged in buf */
+	bool has_last;          /**< Whether last_ts is valid */
+};
+
+/**
+ * @brief Range read iterator, see @ref fcb_ts_iter_init.
+ *
+ * All fields are internal.
+ */
+struct fcb_ts_iter {
+	struct fcb_ts *ts;            /**< Time-series store */
+	uint64_t from;                /**< Oldest timestamp to report */
+	uint64_t to;                  /**< Newest timestamp to report */
+	struct fcb_entry loc;         /**< Current batch */
+	struct fcb_ts_batch_hdr hdr;  /**< Header of the current batch */
+	uint16_t rec_idx;             /**< Next record in the current batch */
+	bool done;                    /**< Iteration has finished */
+};
+
+/**
+ * Initialize a time-series store.
+ *
+ * Walks the batch headers stored in the FCB to build the per-sector
+ * timestamp index and to find the newest timestamp.
+ *
+ * @param[in,out] ts Time-series instance structure.
+ *
+ * @return 0 on success, -EINVAL if a batch of one record does not fit in
+ *         the staging buffer or in the smallest FCB sector, other negative
+ *         errno code on failure.
+ */
+int fcb_ts_init(struct fcb_ts *ts);
+
+/**
+ * Stage one record.
+ *
+ * The record is kept in the staging buffer and written together with the
+ * following ones, as a single FCB entry, when the buffer fills up or on
+ * @ref fcb_ts_flush. Timestamps must not decrease. When the FCB runs out of
+ * space its oldest sector is rotated out.
+ *
+ * @param[in] ts        Time-series instance structure.
+ * @param[in] timestamp Record timestamp.
+ * @param[in] data      Record payload, fcb_ts::rec_len bytes.
+ *
+ * @return 0 on success, -EINVAL if @p timestamp is older than the newest
+ *         record, other negative errno code on failure.
+ */
+int fcb_ts_add(struct fcb_ts *ts, uint64_t timestamp, const void *data);
+
+/**
+ * Append multiple records and flush them.
+ *
+ * @param[in] ts   Time-series instance structure.
+ * @param[in] recs Records, ordered by timestamp.
+ * @param[in] cnt  Number of records.
+ *
+ * @return 0 on success, negative errno code on failure.
+ */
+int fcb_ts_append(struct fcb_ts *ts, const struct fcb_ts_record *recs, size_t cnt);
+
+/**
+ * Write the staged records to flash.
+ *
+ * @param[in] ts Time-series instance structure.
+ *
+ * @return 0 on success, negative errno code on failure.
+ */
+int fcb_ts_flush(struct fcb_ts *ts);
+
+/**
+ * Start reading records with timestamps in [from, to].
+ *
+ * Sectors whose timestamp range lies before @p from are skipped without
+ * being read, and the first record is located by bisecting its batch.
+ * Records that have not been flushed are not reported. The iterator must
+ * not be used after the FCB has been rotated.
+ *
+ * @param[in]  ts   Time-series instance structure.
+ * @param[out] it   Iterator to initialize.
+ * @param[in]  from Oldest timestamp to report.
+ * @param[in]  to   Newest timestamp to report.
+ *
+ * @return 0 on success, negative errno code on failure.
+ */
+int fcb_ts_iter_init(struct fcb_ts *ts, struct fcb_ts_iter *it, uint64_t from, uint64_t to);
+
+/**
+ * Read the next record of a range.
+ *
+ * @param[in,out] it        Iterator.
+ * @param[out]    timestamp Record timestamp.
+ * @param[out]    data      Buffer of fcb_ts::rec_len bytes for the payload,
+ *                          may be NULL.
+ *
+ * @return 0 on success, -ENOENT when there are no more records, other
+ *         negative errno code on failure.
+ */
+int fcb_ts_iter_next(struct fcb_ts_iter *it, uint64_t *timestamp, void *data);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_FS_FCB_TS_H_ */
@@ -145,6 +145,18 @@ struct fs_statvfs {
 	unsigned long f_bfree;
 };
 
+/**
+ * @brief Structure describing one buffer of a vectored I/O request
+ *
+ * Used by fs_readv() and fs_writev().
+ */
+struct fs_iovec {
+	/** Pointer to the data buffer */
+	void *iov_base;
+	/** Length of the data buffer */
+	size_t iov_len;
+};
+
 
 /**
  * @name fs_open open and creation mode flags
@@ -409,6 +421,93 @@ ssize_t fs_read(struct fs_file_t *zfp, void *ptr, size_t size);
  */
 ssize_t fs_write(struct fs_file_t *zfp, const void *ptr, size_t size);
 
+#if defined(CONFIG_FILE_SYSTEM_VECTORED_IO) || defined(__DOXYGEN__)
+/**
+ * @brief Read file into multiple buffers
+ *
+ * Fills the @p iovcnt buffers described by @p iov in order, starting at the
+ * current file position, as if by consecutive calls to fs_read(). Reading
+ * stops at the end of the file.
+ *
+ * Available only if @kconfig{CONFIG_FILE_SYSTEM_VECTORED_IO} is enabled.
+ *
+ * @param zfp Pointer to the file object
+ * @param iov Array of buffers to fill
+ * @param iovcnt Number of elements in @p iov
+ *
+ * @retval >=0 a number of bytes read, on success;
+ * @retval -EBADF when invoked on zfp that represents unopened/closed file;
+ * @retval -ENOTSUP when not implemented by underlying file system driver;
+ * @retval <0 a negative errno code on error.
+ */
+ssize_t fs_readv(struct fs_file_t *zfp, const struct fs_iovec *iov, size_t iovcnt);
+
+/**
+ * @brief Write file from multiple buffers
+ *
+ * Writes the @p iovcnt buffers described by @p iov in order, starting at the
+ * current file position, as if by consecutive calls to fs_write().
+ *
+ * Available only if @kconfig{CONFIG_FILE_SYSTEM_VECTORED_IO} is enabled.
+ *
+ * @param zfp Pointer to the file object
+ * @param iov Array of buffers to write
+ * @param iovcnt Number of elements in @p iov
+ *
+ * @retval >=0 a number of bytes written, on success;
+ * @retval -EBADF when invoked on zfp that represents unopened/closed file;
+ * @retval -ENOTSUP when not implemented by underlying file system driver;
+ * @retval <0 an other negative errno code on error.
+ */
+ssize_t fs_writev(struct fs_file_t *zfp, const struct fs_iovec *iov, size_t iovcnt);
+
+/**
+ * @brief Read file at a given offset
+ *
+ * Reads up to @p size bytes starting at @p offset without changing the file
+ * position. File systems without a native implementation fall back to
+ * seeking, reading and seeking back, which is not atomic with respect to
+ * other users of the same file object.
+ *
+ * Available only if @kconfig{CONFIG_FILE_SYSTEM_VECTORED_IO} is enabled.
+ *
+ * @param zfp Pointer to the file object
+ * @param ptr Pointer to the data buffer
+ * @param size Number of bytes to be read
+ * @param offset Offset in the file to read from
+ *
+ * @retval >=0 a number of bytes read, on success;
+ * @retval -EBADF when invoked on zfp that represents unopened/closed file;
+ * @retval -EINVAL when @p offset is negative;
+ * @retval -ENOTSUP when not implemented by underlying file system driver;
+ * @retval <0 a negative errno code on error.
+ */
+ssize_t fs_pread(struct fs_file_t *zfp, void *ptr, size_t size, off_t offset);
+
+/**
+ * @brief Write file at a given offset
+ *
+ * Writes @p size bytes starting at @p offset without changing the file
+ * position. File systems without a native implementation fall back to
+ * seeking, writing and seeking back, which is not atomic with respect to
+ * other users of the same file object.
+ *
+ * Available only if @kconfig{CONFIG_FILE_SYSTEM_VECTORED_IO} is enabled.
+ *
+ * @param zfp Pointer to the file object
+ * @param ptr Pointer to the data buffer
+ * @param size Number of bytes to be written
+ * @param offset Offset in the file to write at
+ *
+ * @retval >=0 a number of bytes written, on success;
+ * @retval -EBADF when invoked on zfp that represents unopened/closed file;
+ * @retval -EINVAL when @p offset is negative;
+ * @retval -ENOTSUP when not implemented by underlying file system driver;
+ * @retval <0 an other negative errno code on error.
+ */
+ssize_t fs_pwrite(struct fs_file_t *zfp, const void *ptr, size_t size, off_t offset);
+#endif /* CONFIG_FILE_SYSTEM_VECTORED_IO */
+
 /**
  * @brief Seek file
  *
@@ -467,6 +566,29 @@ off_t fs_tell(struct fs_file_t *zfp);
  */
 int fs_truncate(struct fs_file_t *zfp, off_t length);
 
+/**
+ * @brief Preallocate the storage of an open file
+ *
+ * Expands the file to @p length bytes and reserves its storage at once, so
+ * that later writes within that size do not need to allocate. The file
+ * system may place the storage contiguously, which speeds up sequential
+ * access; FAT does so when the file is empty. Unlike with fs_truncate(), the
+ * content of the added region is unspecified. The file position is not
+ * changed.
+ *
+ * Available only if @kconfig{CONFIG_FILE_SYSTEM_EXPAND} is enabled.
+ *
+ * @param zfp Pointer to the file object
+ * @param length New size of the file in bytes
+ *
+ * @retval 0 on success;
+ * @retval -EBADF when invoked on zfp that represents unopened/closed file;
+ * @retval -EINVAL when @p length is smaller than the size of the file;
+ * @retval -ENOTSUP when not implemented by underlying file system driver;
+ * @retval <0 an other negative errno code on error.
+ */
+int fs_expand(struct fs_file_t *zfp, off_t length);
+
 /**
  * @brief Flush cached write data buffers of an open file
  *
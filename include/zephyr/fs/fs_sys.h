@@ -91,6 +91,41 @@ struct fs_file_system_t {
 	 * @return 0 on success, negative errno code on fail.
 	 */
 	int (*close)(struct fs_file_t *filp);
+#if defined(CONFIG_FILE_SYSTEM_VECTORED_IO) || defined(__DOXYGEN__)
+	/**
+	 * Reads nbytes number of bytes at an offset, keeping the file position.
+	 * Optional, fs_pread() falls back to lseek, tell and read calls.
+	 *
+	 * @param filp File to read from.
+	 * @param dest Destination buffer.
+	 * @param nbytes Number of bytes to read.
+	 * @param off Offset in the file.
+	 * @return Number of bytes read on success, negative errno code on fail.
+	 */
+	ssize_t (*pread)(struct fs_file_t *filp, void *dest, size_t nbytes, off_t off);
+	/**
+	 * Writes nbytes number of bytes at an offset, keeping the file position.
+	 * Optional, fs_pwrite() falls back to lseek, tell and write calls.
+	 *
+	 * @param filp File to write to.
+	 * @param src Source buffer.
+	 * @param nbytes Number of bytes to write.
+	 * @param off Offset in the file.
+	 * @return Number of bytes written on success, negative errno code on fail.
+	 */
+	ssize_t (*pwrite)(struct fs_file_t *filp, const void *src, size_t nbytes, off_t off);
+#endif
+#if defined(CONFIG_FILE_SYSTEM_EXPAND) || defined(__DOXYGEN__)
+	/**
+	 * Preallocates the storage of the file up to the new length.
+	 * Optional, fs_expand() returns -ENOTSUP without it.
+	 *
+	 * @param filp File to expand.
+	 * @param length New length of the file.
+	 * @return 0 on success, negative errno code on fail.
+	 */
+	int (*expand)(struct fs_file_t *filp, off_t length);
+#endif
 	/** @} */
 
 	/**
@@ -61,6 +61,20 @@ struct nvs_fs {
 	const struct flash_parameters *flash_parameters;
 #if CONFIG_NVS_LOOKUP_CACHE
 	uint32_t lookup_cache[CONFIG_NVS_LOOKUP_CACHE_SIZE];
+#if CONFIG_NVS_LOOKUP_INDEX
+	/** IDs owning the lookup cache entries */
+	uint16_t lookup_ids[CONFIG_NVS_LOOKUP_CACHE_SIZE];
+	/** Set when some IDs did not fit in the lookup cache */
+	bool lookup_overflow;
+#endif
+#endif
+#if defined(CONFIG_NVS_GC_BACKGROUND) || defined(__DOXYGEN__)
+	/** Background garbage collection work item */
+	struct k_work gc_work;
+	/** Next ate to move by background garbage collection, or its state */
+	uint32_t gc_bg_addr;
+	/** Free space of the write sector when it was started, or sector size after mount */
+	uint32_t gc_bg_base;
 #endif
 };
 
@@ -31,6 +31,17 @@ extern "C" {
  * @{
  */
 
+/**
+ * @brief ID type used in the ZMS API.
+ *
+ * @note The width of this type depends on @kconfig{CONFIG_ZMS_ID_64BIT}.
+ */
+#if CONFIG_ZMS_ID_64BIT
+typedef uint64_t zms_id_t;
+#else
+typedef uint32_t zms_id_t;
+#endif
+
 /** Zephyr Memory Storage file system structure */
 struct zms_fs {
 	/** File system offset in flash */
@@ -64,6 +75,28 @@ struct zms_fs {
 #if CONFIG_ZMS_LOOKUP_CACHE
 	/** Lookup table used to cache ATE addresses of written IDs */
 	uint64_t lookup_cache[CONFIG_ZMS_LOOKUP_CACHE_SIZE];
+#if CONFIG_ZMS_LOOKUP_INDEX
+	/** IDs owning the lookup cache entries */
+	zms_id_t lookup_ids[CONFIG_ZMS_LOOKUP_CACHE_SIZE];
+	/** Set when some IDs did not fit in the lookup cache */
+	bool lookup_overflow;
+#endif
+#endif
+#if defined(CONFIG_ZMS_GC_BACKGROUND) || defined(__DOXYGEN__)
+	/** Background garbage collection work item */
+	struct k_work gc_work;
+	/** Next ATE to move by background garbage collection, or its state */
+	uint64_t gc_bg_addr;
+	/** Free space of the write sector when it was started, or sector size after mount */
+	uint64_t gc_bg_base;
+	/** Sector left for background garbage collection to erase, or its state */
+	uint64_t gc_bg_erase_addr;
+	/** Held by background garbage collection while erasing without the ZMS lock */
+	struct k_mutex gc_bg_erase_lock;
+	/** Set when background garbage collection erased gc_bg_erase_addr */
+	bool gc_bg_erased;
+	/** Cycle counter of the sector being garbage collected in the background */
+	uint8_t gc_bg_cycle;
 #endif
 };
 
@@ -77,17 +110,6 @@ struct zms_fs {
  * @{
  */
 
-/**
- * @brief ID type used in the ZMS API.
- *
- * @note The width of this type depends on @kconfig{CONFIG_ZMS_ID_64BIT}.
- */
-#if CONFIG_ZMS_ID_64BIT
-typedef uint64_t zms_id_t;
-#else
-typedef uint32_t zms_id_t;
-#endif
-
 /**
  * @brief Mount a ZMS file system onto the device specified in `fs`.
  *
@@ -5814,6 +5814,42 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem,
  */
 void k_mem_slab_free(struct k_mem_slab *slab, void *mem);
 
+/**
+ * @brief Allocate multiple memory blocks from a memory slab.
+ *
+ * This routine allocates @a count memory blocks while taking the slab
+ * lock only once, which is cheaper than calling k_mem_slab_alloc() in a
+ * loop, e.g. when refilling a ring of DMA buffers. It never waits:
+ * either all @a count blocks are allocated or none is.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param slab Address of the memory slab.
+ * @param mem Array of at least @a count elements receiving the
+ *            addresses of the allocated blocks.
+ * @param count Number of blocks to allocate.
+ *
+ * @retval 0 Memory allocated.
+ * @retval -ENOMEM Less than @a count blocks are free, nothing was allocated.
+ */
+int k_mem_slab_alloc_bulk(struct k_mem_slab *slab, void **mem, size_t count);
+
+/**
+ * @brief Free multiple memory blocks to a memory slab.
+ *
+ * This routine releases @a count memory blocks back to their memory slab
+ * while taking the slab lock only once. Threads waiting in
+ * k_mem_slab_alloc() receive the released blocks first.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param slab Address of the memory slab.
+ * @param mem Array of @a count pointers to the memory blocks (as returned
+ *            by k_mem_slab_alloc() or k_mem_slab_alloc_bulk()).
+ * @param count Number of blocks to free.
+ */
+void k_mem_slab_free_bulk(struct k_mem_slab *slab, void **mem, size_t count);
+
 /**
  * @brief Get the number of used blocks in a memory slab.
  *
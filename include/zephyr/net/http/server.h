@@ -27,6 +27,7 @@
 #include <zephyr/net/http/hpack.h>
 #include <zephyr/net/http/status.h>
 #include <zephyr/net/socket.h>
+#include <zephyr/sys/arena.h>
 #include <zephyr/sys/iterable_sections.h>
 
 #ifdef __cplusplus
@@ -387,8 +388,11 @@ struct http_header_capture_ctx {
 	/** Number of headers captured */
 	size_t count;
 
-	/** Current position in buffer */
-	size_t cursor;
+	/** Allocator for the captured strings, over buffer */
+	struct sys_arena arena;
+
+	/** Arena position before the name of the header being captured */
+	struct sys_arena_mark name_mark;
 
 	/** The HTTP2 stream associated with the current headers */
 	struct http2_stream_ctx *current_stream;
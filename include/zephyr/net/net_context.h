@@ -1315,6 +1315,31 @@ int net_context_sendmsg(struct net_context *context,
 			k_timeout_t timeout,
 			void *user_data);
 
+/**
+ * @brief Send a network buffer chain to a connected UDP peer without copying.
+ *
+ * @details The fragments of @p buf are appended to the packet after the
+ * IP and UDP headers instead of being copied into packet buffers. On
+ * success the caller's reference to @p buf is handed over to the network
+ * stack, which releases it once the packet has been transmitted or
+ * dropped, so the pool destroy callback of the buffers can be used as the
+ * completion notification. The data must not be modified until then. On
+ * failure the caller keeps its reference.
+ *
+ * @param context The network context to use.
+ * @param buf The payload to send
+ * @param cb Caller-supplied callback function.
+ * @param timeout Timeout for the send attempt.
+ * @param user_data Caller-supplied user data.
+ *
+ * @return numbers of bytes sent on success, a negative errno otherwise
+ */
+int net_context_send_buf(struct net_context *context,
+			 struct net_buf *buf,
+			 net_context_send_cb_t cb,
+			 k_timeout_t timeout,
+			 void *user_data);
+
 /**
  * @brief Receive network data from a peer specified by context.
  *
@@ -237,6 +237,9 @@ struct net_pkt {
 	uint8_t chksum_done : 1; /* Checksum has already been computed for
 				  * the packet.
 				  */
+	uint8_t chksum_payload : 1; /* Transport header checksum field holds
+				     * the precomputed payload checksum.
+				     */
 	uint8_t loopback : 1; /* Packet is a loop back packet. */
 #if defined(CONFIG_NET_IP_FRAGMENT)
 	uint8_t ip_reassembled : 1; /* Packet is a reassembled IP packet. */
@@ -576,6 +579,17 @@ static inline void net_pkt_set_chksum_done(struct net_pkt *pkt,
 	pkt->chksum_done = is_chksum_done;
 }
 
+static inline bool net_pkt_is_chksum_payload(struct net_pkt *pkt)
+{
+	return !!(pkt->chksum_payload);
+}
+
+static inline void net_pkt_set_chksum_payload(struct net_pkt *pkt,
+					      bool is_chksum_payload)
+{
+	pkt->chksum_payload = is_chksum_payload;
+}
+
 static inline uint8_t net_pkt_ip_hdr_len(struct net_pkt *pkt)
 {
 #if defined(CONFIG_NET_IP)
@@ -2447,6 +2461,45 @@ int net_pkt_read_be32(struct net_pkt *pkt, uint32_t *data);
  */
 int net_pkt_write(struct net_pkt *pkt, const void *data, size_t length);
 
+/**
+ * @brief Write data into a net_pkt and compute its Internet checksum
+ *
+ * @details Same as net_pkt_write(), but the ones' complement sum of the
+ *          written bytes is computed while copying, so the payload does not
+ *          need to be walked a second time when the transport checksum is
+ *          calculated. The sum treats the first written byte as the high
+ *          order byte of a 16-bit word and is added to the value pointed to
+ *          by @p chksum, which must be initialized by the caller.
+ *
+ * @param pkt    The network packet where to write
+ * @param data   Data to be written
+ * @param length Length of the data to be written
+ * @param chksum Pointer to the running checksum, in host byte order
+ *
+ * @return 0 on success, negative errno code otherwise.
+ */
+int net_pkt_write_chksum(struct net_pkt *pkt, const void *data, size_t length,
+			 uint16_t *chksum);
+
+/**
+ * @brief Write data from a scatter/gather array into a net_pkt
+ *
+ * @details The buffers are copied in order, each one fragment chunk at a
+ *          time, until @p length bytes are written or the array ends. If
+ *          @p chksum is not NULL, the ones' complement sum of the gathered
+ *          bytes is added to it as in net_pkt_write_chksum().
+ *
+ * @param pkt    The network packet where to write
+ * @param iov    Array of buffers to be written
+ * @param iovcnt Number of entries in @p iov
+ * @param length Maximum number of bytes to write
+ * @param chksum Pointer to the running checksum, in host byte order, or NULL
+ *
+ * @return 0 on success, negative errno code otherwise.
+ */
+int net_pkt_write_iov(struct net_pkt *pkt, const struct net_iovec *iov,
+		      size_t iovcnt, size_t length, uint16_t *chksum);
+
 /**
  * @brief Write a byte (uint8_t) data to a net_pkt
  *
@@ -554,6 +554,59 @@ static inline ssize_t zsock_recv(int sock, void *buf, size_t max_len,
 	return zsock_recvfrom(sock, buf, max_len, flags, NULL, NULL);
 }
 
+struct net_pkt;
+
+/**
+ * @brief Receive a datagram without copying its payload
+ *
+ * @details
+ * Dequeues the next received datagram of a UDP or raw socket and hands the
+ * underlying network packet over to the caller instead of copying its data
+ * into a user buffer. The packet cursor is positioned at the start of the
+ * payload, so it can be consumed with net_pkt_read() or by walking the
+ * packet's net_buf fragments directly. The caller owns the packet and must
+ * release it with net_pkt_unref() once done, which returns the buffers to
+ * the network stack.
+ *
+ * Blocking behaviour follows zsock_recv(): @c ZSOCK_MSG_DONTWAIT, the socket
+ * non-blocking mode and @c SO_RCVTIMEO are honoured. This function is only
+ * available to kernel threads.
+ *
+ * @param sock Socket descriptor of a native (non-offloaded) datagram socket
+ * @param pkt Where to store the received packet
+ * @param flags Receive flags, only @c ZSOCK_MSG_DONTWAIT is supported
+ *
+ * @return Number of payload bytes in the packet, or -1 with errno set.
+ */
+ssize_t zsock_recv_pkt(int sock, struct net_pkt **pkt, int flags);
+
+struct net_buf;
+
+/**
+ * @brief Send a datagram without copying its payload
+ *
+ * @details
+ * Sends the data of a network buffer chain as one datagram to the peer of a
+ * connected UDP socket. The buffers are linked into the outgoing packet
+ * behind the protocol headers instead of being copied. On success the
+ * caller's reference to @p buf is passed to the network stack, which
+ * releases it once the packet has been transmitted or dropped. The destroy
+ * callback of the buffer pool is the completion notification: the data must
+ * not be modified before the buffers are released. On failure the caller
+ * still owns @p buf.
+ *
+ * Blocking behaviour follows zsock_send(): @c ZSOCK_MSG_DONTWAIT, the socket
+ * non-blocking mode and @c SO_SNDTIMEO are honoured. This function is only
+ * available to kernel threads.
+ *
+ * @param sock Socket descriptor of a native (non-offloaded) UDP socket
+ * @param buf Payload of the datagram
+ * @param flags Send flags, only @c ZSOCK_MSG_DONTWAIT is supported
+ *
+ * @return Number of bytes sent, or -1 with errno set.
+ */
+ssize_t zsock_send_buf(int sock, struct net_buf *buf, int flags);
+
 /**
  * @brief Control blocking/non-blocking mode of a socket
  *
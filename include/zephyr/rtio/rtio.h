@@ -372,6 +372,18 @@ struct rtio_sqe {
 			rtio_signaled_t callback;
 			void *userdata;
 		} await;
+
+		/** OP_STORAGE_READ, OP_STORAGE_WRITE and OP_STORAGE_ERASE */
+		struct {
+			/** Byte offset for flash, first sector for disks */
+			uint32_t offset;
+			/** Length in bytes for flash, sector count for disks */
+			uint32_t len;
+			union {
+				uint8_t *rx_buf; /**< Buffer to read into */
+				const uint8_t *tx_buf; /**< Buffer to write from */
+			};
+		} storage;
 	};
 };
 
@@ -584,6 +596,15 @@ struct rtio_iodev {
 /** An operation to await a signal while blocking the iodev (if one is provided) */
 #define RTIO_OP_AWAIT (RTIO_OP_I3C_CCC+1)
 
+/** An operation that reads from a storage device at a given offset */
+#define RTIO_OP_STORAGE_READ (RTIO_OP_AWAIT+1)
+
+/** An operation that writes to a storage device at a given offset */
+#define RTIO_OP_STORAGE_WRITE (RTIO_OP_STORAGE_READ+1)
+
+/** An operation that erases a range of a storage device */
+#define RTIO_OP_STORAGE_ERASE (RTIO_OP_STORAGE_WRITE+1)
+
 /**
  * @brief Prepare a nop (no op) submission
  */
@@ -817,6 +838,74 @@ static inline void rtio_sqe_prep_delay(struct rtio_sqe *sqe,
 	sqe->userdata = userdata;
 }
 
+/**
+ * @brief Prepare a storage read op submission
+ *
+ * For flash devices @p offset and @p len are in bytes, for disks they are
+ * the start sector and the number of sectors.
+ */
+static inline void rtio_sqe_prep_storage_read(struct rtio_sqe *sqe,
+					      const struct rtio_iodev *iodev,
+					      int8_t prio,
+					      uint32_t offset,
+					      uint8_t *buf,
+					      uint32_t len,
+					      void *userdata)
+{
+	memset(sqe, 0, sizeof(struct rtio_sqe));
+	sqe->op = RTIO_OP_STORAGE_READ;
+	sqe->prio = prio;
+	sqe->iodev = iodev;
+	sqe->storage.offset = offset;
+	sqe->storage.len = len;
+	sqe->storage.rx_buf = buf;
+	sqe->userdata = userdata;
+}
+
+/**
+ * @brief Prepare a storage write op submission
+ *
+ * @see rtio_sqe_prep_storage_read()
+ */
+static inline void rtio_sqe_prep_storage_write(struct rtio_sqe *sqe,
+					       const struct rtio_iodev *iodev,
+					       int8_t prio,
+					       uint32_t offset,
+					       const uint8_t *buf,
+					       uint32_t len,
+					       void *userdata)
+{
+	memset(sqe, 0, sizeof(struct rtio_sqe));
+	sqe->op = RTIO_OP_STORAGE_WRITE;
+	sqe->prio = prio;
+	sqe->iodev = iodev;
+	sqe->storage.offset = offset;
+	sqe->storage.len = len;
+	sqe->storage.tx_buf = buf;
+	sqe->userdata = userdata;
+}
+
+/**
+ * @brief Prepare a storage erase op submission
+ *
+ * @see rtio_sqe_prep_storage_read()
+ */
+static inline void rtio_sqe_prep_storage_erase(struct rtio_sqe *sqe,
+					       const struct rtio_iodev *iodev,
+					       int8_t prio,
+					       uint32_t offset,
+					       uint32_t len,
+					       void *userdata)
+{
+	memset(sqe, 0, sizeof(struct rtio_sqe));
+	sqe->op = RTIO_OP_STORAGE_ERASE;
+	sqe->prio = prio;
+	sqe->iodev = iodev;
+	sqe->storage.offset = offset;
+	sqe->storage.len = len;
+	sqe->userdata = userdata;
+}
+
 static inline struct rtio_iodev_sqe *rtio_sqe_pool_alloc(struct rtio_sqe_pool *pool)
 {
 	struct mpsc_node *node = mpsc_pop(&pool->free_q);
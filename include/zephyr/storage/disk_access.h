@@ -30,6 +30,9 @@
  */
 
 #include <zephyr/drivers/disk.h>
+#if defined(CONFIG_DISK_ACCESS_RTIO)
+#include <zephyr/rtio/rtio.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -113,6 +116,62 @@ int disk_access_write(const char *pdrv, const uint8_t *data_buf,
  */
 int disk_access_ioctl(const char *pdrv, uint8_t cmd, void *buff);
 
+/**
+ * @brief Disk block cache statistics
+ */
+struct disk_cache_stats {
+	/** Sectors served from the cache */
+	uint32_t hits;
+	/** Sectors that had to be read from the disk */
+	uint32_t misses;
+	/** Sectors read ahead of a sequential access */
+	uint32_t read_ahead;
+	/** Dirty sectors written back to the disk */
+	uint32_t writebacks;
+	/** Requests passed directly to the disk driver */
+	uint32_t bypassed;
+};
+
+/**
+ * @brief Get the disk block cache statistics
+ *
+ * Available when @kconfig{CONFIG_DISK_CACHE} is enabled.
+ *
+ * @param[out] stats        Statistics accumulated since boot or last reset
+ */
+void disk_cache_stats_get(struct disk_cache_stats *stats);
+
+/**
+ * @brief Reset the disk block cache statistics
+ */
+void disk_cache_stats_reset(void);
+
+#if defined(CONFIG_DISK_ACCESS_RTIO) || defined(__DOXYGEN__)
+
+/**
+ * @brief Disk access RTIO iodev API
+ *
+ * Submissions are executed in order on the RTIO work queue with
+ * @ref disk_access_read and @ref disk_access_write. Supported operations
+ * are RTIO_OP_STORAGE_READ and RTIO_OP_STORAGE_WRITE, with the offset
+ * being the start sector and the length a number of sectors.
+ */
+extern const struct rtio_iodev_api disk_access_iodev_api;
+
+/**
+ * @brief Define an iodev for a disk
+ *
+ * The disk must be initialized with @ref disk_access_ioctl before
+ * submitting to the iodev.
+ *
+ * @param name Symbolic name to use for defining the iodev
+ * @param pdrv Disk name
+ */
+#define DISK_ACCESS_IODEV_DEFINE(name, pdrv)					\
+	RTIO_IODEV_DEFINE(name, &disk_access_iodev_api, (void *)(pdrv))
+
+#endif /* CONFIG_DISK_ACCESS_RTIO */
+
 #ifdef __cplusplus
 }
 #endif
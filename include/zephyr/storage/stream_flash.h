@@ -25,6 +25,9 @@
 
 #include <stdbool.h>
 #include <zephyr/drivers/flash.h>
+#ifdef CONFIG_STREAM_FLASH_PIPELINE
+#include <zephyr/rtio/rtio.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -75,6 +78,22 @@ struct stream_flash_ctx {
 #endif
 	size_t write_block_size;	/* Offset/size device write alignment */
 	uint8_t erase_value;
+#ifdef CONFIG_STREAM_FLASH_PIPELINE
+	struct rtio *rtio;		/* Context for background writes,
+					 * NULL when writing synchronously
+					 */
+	struct rtio_iodev iodev;	/* Iodev of the flash device */
+	uint8_t *pending_buf;		/* Buffer being written, spare buffer
+					 * when pending_bytes is 0
+					 */
+	size_t pending_bytes;		/* Payload bytes being written */
+	uint8_t pending_ops;		/* Completions not yet consumed */
+#ifdef CONFIG_STREAM_FLASH_ERASE
+	size_t erase_ahead_from;	/* erased_up_to before the pending
+					 * erase ahead was queued
+					 */
+#endif
+#endif
 	/** @endcond */
 };
 
@@ -97,6 +116,49 @@ struct stream_flash_ctx {
 int stream_flash_init(struct stream_flash_ctx *ctx, const struct device *fdev,
 		      uint8_t *buf, size_t buf_len, size_t offset, size_t size,
 		      stream_flash_callback_t cb);
+/**
+ * @brief Define an RTIO context suitable for pipelined stream writes.
+ *
+ * @param name Symbolic name of the RTIO context
+ */
+#define STREAM_FLASH_RTIO_DEFINE(name) RTIO_DEFINE(name, 2, 2)
+
+/**
+ * @brief Initialize context for pipelined stream writes to flash.
+ *
+ * Works like @ref stream_flash_init, but splits @p buf in two halves. Once
+ * one half is full it is written to flash in the background, on the RTIO
+ * work queue, while data is collected in the other half. Pages are also
+ * erased one buffer ahead, so that the erase overlaps with receiving data.
+ * A write call only blocks when both halves are in use.
+ *
+ * Progress reported by @ref stream_flash_bytes_written only includes data
+ * confirmed written; errors of a background write are returned by the
+ * following write call. The post write callback, if any, is invoked from
+ * the write call that consumes the completion, with either half of @p buf.
+ * Always finish a stream with a flushing write, which waits for all
+ * background operations.
+ *
+ * Available with @kconfig{CONFIG_STREAM_FLASH_PIPELINE}.
+ *
+ * @param ctx context to be initialized
+ * @param fdev Flash device to operate on
+ * @param buf Write buffer, split in two halves
+ * @param buf_len Length of write buffer. Each half can not be larger than
+ *                the page size and must be multiple of the flash device
+ *                write-block-size.
+ * @param offset Offset within flash device to start writing to
+ * @param size Number of bytes available for performing buffered write.
+ * @param cb Callback to be invoked on completed flash write operations.
+ * @param r RTIO context used only by this stream, see
+ *          @ref STREAM_FLASH_RTIO_DEFINE.
+ *
+ * @return non-negative on success, negative errno code on fail
+ */
+int stream_flash_init_pipelined(struct stream_flash_ctx *ctx, const struct device *fdev,
+				uint8_t *buf, size_t buf_len, size_t offset, size_t size,
+				stream_flash_callback_t cb, struct rtio *r);
+
 /**
  * @brief Read number of bytes written to the flash.
  *
@@ -113,7 +175,8 @@ size_t stream_flash_bytes_written(const struct stream_flash_ctx *ctx);
  *
  * @param ctx context
  *
- * @return Number of payload bytes buffered for the next flash write.
+ * @return Number of payload bytes buffered for the next flash write,
+ *         including data a pipelined context is writing in the background.
  */
 size_t stream_flash_bytes_buffered(const struct stream_flash_ctx *ctx);
 
@@ -0,0 +1,198 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_ARENA_H_
+#define ZEPHYR_INCLUDE_SYS_ARENA_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/sys/__assert.h>
+#include <zephyr/sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct k_heap;
+struct sys_arena_chunk;
+
+/**
+ * @defgroup sys_arena_apis Arena Allocator
+ * @ingroup heaps
+ * @{
+ */
+
+/**
+ * @brief Arena allocator
+ *
+ * An arena hands out memory by advancing a pointer through a buffer and
+ * has no per-allocation free: everything allocated is released at once
+ * by sys_arena_reset(), or back to a checkpoint by sys_arena_rollback().
+ * This makes allocation a handful of instructions and removes any need
+ * to track individual objects, which suits memory whose lifetime is a
+ * request, a frame or a parsing pass.
+ *
+ * The arena starts in an optional buffer given at initialization. Once
+ * that is used up, and if a parent heap was given, further chunks are
+ * allocated from the parent and chained together; they are returned to
+ * the parent on reset or rollback. Without a parent heap, the arena has
+ * a fixed size and allocation fails when the buffer is full.
+ *
+ * An arena is not synchronized: it must only be used from one context
+ * at a time.
+ */
+struct sys_arena {
+	/** @cond INTERNAL_HIDDEN */
+	/* Next free byte and end of the current buffer or chunk */
+	uint8_t *pos;
+	uint8_t *end;
+	/* Most recent chunk allocated from the parent heap */
+	struct sys_arena_chunk *chunk;
+	uint8_t *buf;
+	size_t buf_size;
+	struct k_heap *parent;
+	size_t chunk_size;
+	/** @endcond */
+};
+
+/**
+ * @brief Arena position, see sys_arena_checkpoint()
+ */
+struct sys_arena_mark {
+	/** @cond INTERNAL_HIDDEN */
+	struct sys_arena_chunk *chunk;
+	uint8_t *pos;
+	/** @endcond */
+};
+
+/**
+ * @brief Statically define a fixed size arena
+ *
+ * @param name Name of the arena.
+ * @param size Size of the arena buffer in bytes.
+ */
+#define SYS_ARENA_DEFINE(name, size)                                                               \
+	static uint8_t __aligned(sizeof(void *)) _sys_arena_buf_##name[size];                      \
+	struct sys_arena name = {                                                                  \
+		.pos = _sys_arena_buf_##name,                                                      \
+		.end = _sys_arena_buf_##name + (size),                                             \
+		.buf = _sys_arena_buf_##name,                                                      \
+		.buf_size = (size),                                                                \
+	}
+
+/**
+ * @brief Initialize an arena
+ *
+ * @param arena Arena to initialize.
+ * @param buf Initial buffer, or NULL to allocate everything from @p parent.
+ * @param size Size of @p buf in bytes.
+ * @param parent Heap to take more chunks from once @p buf is used up, or
+ *               NULL for an arena of a fixed size.
+ * @param chunk_size Minimum size of the chunks taken from @p parent. Larger
+ *                   allocations get a chunk of their own size.
+ */
+static inline void sys_arena_init(struct sys_arena *arena, void *buf, size_t size,
+				  struct k_heap *parent, size_t chunk_size)
+{
+	*arena = (struct sys_arena){
+		.pos = buf,
+		.end = (uint8_t *)buf + size,
+		.buf = buf,
+		.buf_size = size,
+		.parent = parent,
+		.chunk_size = chunk_size,
+	};
+}
+
+/** @cond INTERNAL_HIDDEN */
+void *z_sys_arena_alloc_chunk(struct sys_arena *arena, size_t size, size_t align);
+/** @endcond */
+
+/**
+ * @brief Allocate memory from an arena
+ *
+ * @param arena Arena to allocate from.
+ * @param size Number of bytes to allocate.
+ * @param align Required alignment, a power of two.
+ *
+ * @return Pointer to the memory, or NULL if the arena is full and no chunk
+ *         could be taken from its parent heap.
+ */
+static inline void *sys_arena_aligned_alloc(struct sys_arena *arena, size_t size, size_t align)
+{
+	uintptr_t p = ROUND_UP((uintptr_t)arena->pos, align);
+
+	__ASSERT(IS_POWER_OF_TWO(align), "alignment %zu not a power of two", align);
+
+	if (p <= (uintptr_t)arena->end && size <= (uintptr_t)arena->end - p) {
+		arena->pos = (uint8_t *)p + size;
+		return (void *)p;
+	}
+
+	return z_sys_arena_alloc_chunk(arena, size, align);
+}
+
+/**
+ * @brief Allocate pointer aligned memory from an arena
+ *
+ * @see sys_arena_aligned_alloc()
+ */
+static inline void *sys_arena_alloc(struct sys_arena *arena, size_t size)
+{
+	return sys_arena_aligned_alloc(arena, size, sizeof(void *));
+}
+
+/**
+ * @brief Record the current position of an arena
+ *
+ * Rolling back to the returned mark frees everything allocated after this
+ * call. A mark is invalidated by resetting the arena or by rolling it back
+ * to an earlier mark.
+ */
+static inline struct sys_arena_mark sys_arena_checkpoint(const struct sys_arena *arena)
+{
+	return (struct sys_arena_mark){
+		.chunk = arena->chunk,
+		.pos = arena->pos,
+	};
+}
+
+/**
+ * @brief Free everything allocated since a checkpoint
+ *
+ * Chunks taken from the parent heap since then are returned to it.
+ *
+ * @param arena Arena to roll back.
+ * @param mark Position returned by sys_arena_checkpoint().
+ */
+void sys_arena_rollback(struct sys_arena *arena, const struct sys_arena_mark *mark);
+
+/**
+ * @brief Free everything allocated from an arena
+ *
+ * All chunks are returned to the parent heap and the arena starts over at
+ * the beginning of its initial buffer.
+ */
+static inline void sys_arena_reset(struct sys_arena *arena)
+{
+	struct sys_arena_mark start = {
+		.chunk = NULL,
+		.pos = arena->buf,
+	};
+
+	sys_arena_rollback(arena, &start);
+}
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_ARENA_H_ */
@@ -168,6 +168,30 @@ int sys_bitarray_test_and_clear_bit(sys_bitarray_t *bitarray, size_t bit, int *p
 int sys_bitarray_alloc(sys_bitarray_t *bitarray, size_t num_bits,
 		       size_t *offset);
 
+/**
+ * Allocate multiple single bits in a bit array
+ *
+ * This finds @p count previously unallocated bits, which do not need
+ * to be next to each other, marks them as allocated and returns their
+ * offsets via @p offsets. The bit array is scanned a whole bundle at a
+ * time and locked only once, which is much faster than calling
+ * sys_bitarray_alloc() @p count times with a single bit.
+ *
+ * Either all @p count bits are allocated or none is.
+ *
+ * @param[in]  bitarray Bitarray struct
+ * @param[in]  count    Number of bits to allocate
+ * @param[out] offsets  Array of at least @p count elements receiving
+ *                      the offsets of the allocated bits, in increasing
+ *                      order, if successful
+ *
+ * @retval 0       Allocation successful
+ * @retval -EINVAL Invalid argument (e.g. allocating more bits than
+ *                 the bitarray has, trying to allocate 0 bits, etc.)
+ * @retval -ENOSPC Less than @p count bits are unallocated
+ */
+int sys_bitarray_alloc_bits(sys_bitarray_t *bitarray, size_t count, size_t *offsets);
+
 /**
  * Calculates the bit-wise XOR of two bitarrays in a region.
  * The result is stored in the first bitarray passed in (@p dst).
@@ -241,6 +265,27 @@ int sys_bitarray_popcount_region(sys_bitarray_t *bitarray, size_t num_bits, size
 int sys_bitarray_free(sys_bitarray_t *bitarray, size_t num_bits,
 		      size_t offset);
 
+/**
+ * Free multiple single bits in a bit array
+ *
+ * This marks the bits at the @p count offsets listed in @p offsets as
+ * no longer allocated, taking the lock only once. It is the counterpart
+ * of sys_bitarray_alloc_bits().
+ *
+ * Either all @p count bits are freed or none is.
+ *
+ * @param bitarray Bitarray struct
+ * @param count    Number of bits to free
+ * @param offsets  Array of @p count bit positions to free
+ *
+ * @retval 0       Free is successful
+ * @retval -EINVAL Invalid argument (e.g. offset out of bounds, trying
+ *                 to free 0 bits, etc.)
+ * @retval -EFAULT Not all of the indicated bits are allocated, or a bit
+ *                 is listed more than once.
+ */
+int sys_bitarray_free_bits(sys_bitarray_t *bitarray, size_t count, const size_t *offsets);
+
 /**
  * Test if bits in a region is all set.
  *
@@ -0,0 +1,253 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @defgroup btree_apis B-Tree
+ * @ingroup datastructure_apis
+ *
+ * @brief Cache-aware B-tree ordered by integer keys
+ *
+ * This implements a balanced B-tree that guarantees O(log(N)) runtime
+ * for all operations, as an alternative to the @ref rbtree_apis when
+ * lookups and minimum extraction dominate. Every tree node holds up to
+ * 2 * @kconfig{CONFIG_BTREE_MIN_DEGREE} - 1 entries whose sort keys are
+ * stored next to each other inside the node, so a search only touches
+ * one or two cache lines per level instead of one element per level,
+ * and the tree is much shallower than a binary tree.
+ *
+ * Like the red/black tree, the data structure is intrusive: a @ref
+ * btnode handle is placed in the user struct. Because the nodes of the
+ * tree itself hold multiple entries they are not embedded in the user
+ * structs; they are taken from a pool provided when the tree is
+ * defined, so no heap is required. Ordering is done on a signed 32-bit
+ * key rather than a comparison callback, so the keys can be scanned
+ * without dereferencing the user structs. Entries with equal keys are
+ * kept in insertion order.
+ *
+ * @note Enable with @kconfig{CONFIG_BTREE}
+ *
+ * @{
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_BTREE_H_
+#define ZEPHYR_INCLUDE_SYS_BTREE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief B-tree entry handle, embedded in the user struct
+ */
+struct btnode {
+	/** @cond INTERNAL_HIDDEN */
+	/* User key in the upper half, insertion sequence in the lower half */
+	uint64_t sort_key;
+	/** @endcond */
+};
+
+/** @cond INTERNAL_HIDDEN */
+
+#define Z_BTREE_MAX_ENTRIES (2 * CONFIG_BTREE_MIN_DEGREE - 1)
+
+struct btree_node {
+	uint64_t keys[Z_BTREE_MAX_ENTRIES];
+	struct btnode *entries[Z_BTREE_MAX_ENTRIES];
+	/* Unused in leaves; links free nodes through children[0] */
+	struct btree_node *children[Z_BTREE_MAX_ENTRIES + 1];
+	uint8_t n;
+	bool leaf;
+};
+
+/** @endcond */
+
+/**
+ * @brief Number of tree nodes needed to hold a given number of entries
+ *
+ * @param n Maximum number of entries in the tree.
+ */
+#define BTREE_NODES(n) (DIV_ROUND_UP(n, CONFIG_BTREE_MIN_DEGREE - 1) + 1)
+
+/**
+ * @brief B-tree structure
+ */
+struct btree {
+	/** @cond INTERNAL_HIDDEN */
+	struct btree_node *root;
+	/* Nodes released by the tree */
+	struct btree_node *free;
+	/* Nodes of the pool never used yet */
+	struct btree_node *pool;
+	size_t pool_left;
+	size_t size;
+	uint32_t seq;
+	/** @endcond */
+};
+
+/**
+ * @brief Statically define and initialize a B-tree
+ *
+ * The tree can be accessed outside the module where it is defined
+ * using:
+ *
+ * @code extern struct btree <name>; @endcode
+ *
+ * @param name Name of the tree.
+ * @param max_entries Maximum number of entries in the tree.
+ */
+#define BTREE_DEFINE(name, max_entries)                                                            \
+	static struct btree_node _btree_nodes_##name[BTREE_NODES(max_entries)];                    \
+	struct btree name = {                                                                      \
+		.pool = _btree_nodes_##name,                                                       \
+		.pool_left = BTREE_NODES(max_entries),                                             \
+	}
+
+/**
+ * @brief Initialize a B-tree
+ *
+ * @param tree Tree to initialize.
+ * @param nodes Pool of tree nodes, see @ref BTREE_NODES.
+ * @param n_nodes Number of nodes in @p nodes.
+ */
+static inline void btree_init(struct btree *tree, struct btree_node *nodes, size_t n_nodes)
+{
+	*tree = (struct btree){
+		.pool = nodes,
+		.pool_left = n_nodes,
+	};
+}
+
+/**
+ * @brief Insert an entry into the tree
+ *
+ * The entry is placed after all entries with the same key.
+ *
+ * @param tree Tree to insert into.
+ * @param node Entry handle, must not be in any tree.
+ * @param key Sort key of the entry.
+ *
+ * @retval 0 on success.
+ * @retval -ENOMEM if the node pool of the tree is exhausted.
+ */
+int btree_insert(struct btree *tree, struct btnode *node, int32_t key);
+
+/**
+ * @brief Remove an entry from the tree
+ *
+ * @param tree Tree to remove from.
+ * @param node Entry handle, must be in @p tree.
+ */
+void btree_remove(struct btree *tree, struct btnode *node);
+
+/** @cond INTERNAL_HIDDEN */
+struct btnode *z_btree_get_minmax(struct btree *tree, bool max);
+struct btnode *z_btree_next(struct btree *tree, struct btnode *prev);
+/** @endcond */
+
+/**
+ * @brief Returns the lowest-sorted entry of the tree
+ */
+static inline struct btnode *btree_get_min(struct btree *tree)
+{
+	return z_btree_get_minmax(tree, false);
+}
+
+/**
+ * @brief Returns the highest-sorted entry of the tree
+ */
+static inline struct btnode *btree_get_max(struct btree *tree)
+{
+	return z_btree_get_minmax(tree, true);
+}
+
+/**
+ * @brief Remove and return the lowest-sorted entry of the tree
+ *
+ * @return The removed entry, or NULL if the tree is empty.
+ */
+struct btnode *btree_remove_min(struct btree *tree);
+
+/**
+ * @brief Returns true if the given entry is part of the tree
+ */
+bool btree_contains(struct btree *tree, struct btnode *node);
+
+/**
+ * @brief Returns the number of entries in the tree
+ */
+static inline size_t btree_size(const struct btree *tree)
+{
+	return tree->size;
+}
+
+/**
+ * @brief Returns true if the tree has no entries
+ */
+static inline bool btree_is_empty(const struct btree *tree)
+{
+	return tree->size == 0;
+}
+
+/**
+ * @brief Returns the key an entry was inserted with
+ */
+static inline int32_t btnode_key(const struct btnode *node)
+{
+	return (int32_t)((uint32_t)(node->sort_key >> 32) ^ BIT(31));
+}
+
+/**
+ * @brief Walk a tree in-order
+ *
+ * Each step looks up the successor of the previous entry by key, so the
+ * current entry may be removed from the tree inside the loop. Entries
+ * inserted during the loop may or may not be visited.
+ *
+ * @param tree A pointer to a struct btree to walk
+ * @param node The symbol name of a local struct btnode* variable to
+ *             use as the iterator
+ */
+#define BTREE_FOR_EACH(tree, node)                                                                 \
+	for ((node) = z_btree_next((tree), NULL); (node) != NULL;                                  \
+	     (node) = z_btree_next((tree), (node)))
+
+/**
+ * @brief Loop over a B-tree with implicit container field logic
+ *
+ * As for BTREE_FOR_EACH(), but "node" can have an arbitrary type
+ * containing a struct btnode.
+ *
+ * @param tree A pointer to a struct btree to walk
+ * @param node The symbol name of a local iterator
+ * @param field The field name of a struct btnode inside node
+ */
+#define BTREE_FOR_EACH_CONTAINER(tree, node, field)                                                \
+	for ((node) = Z_BTREE_CONTAINER(z_btree_next((tree), NULL), node, field);                  \
+	     (node) != NULL;                                                                       \
+	     (node) = Z_BTREE_CONTAINER(z_btree_next((tree), &(node)->field), node, field))
+
+/** @cond INTERNAL_HIDDEN */
+#define Z_BTREE_CONTAINER(ptr, node, field)                                                        \
+	({                                                                                         \
+		struct btnode *_bn = (ptr);                                                        \
+		_bn ? CONTAINER_OF(_bn, __typeof__(*(node)), field) : NULL;                        \
+	})
+/** @endcond */
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
+
+#endif /* ZEPHYR_INCLUDE_SYS_BTREE_H_ */
@@ -310,6 +310,35 @@ uint32_t crc32_ieee_update(uint32_t crc, const uint8_t *data, size_t len);
 uint32_t crc32_c(uint32_t crc, const uint8_t *data,
 		 size_t len, bool first_pkt, bool last_pkt);
 
+/**
+ * @brief Combine the IEEE CRC32 checksums of two consecutive blocks.
+ *
+ * Computes the checksum of the concatenation of two blocks from the
+ * checksums of each block, so that the blocks can be processed separately,
+ * for instance in parallel.
+ *
+ * @param crc1 CRC32 checksum of the first block, as returned by crc32_ieee().
+ * @param crc2 CRC32 checksum of the second block, as returned by crc32_ieee().
+ * @param len2 Length of the second block.
+ *
+ * @return CRC32 value of the two blocks.
+ */
+uint32_t crc32_ieee_combine(uint32_t crc1, uint32_t crc2, size_t len2);
+
+/**
+ * @brief Combine the CRC32C (Castagnoli) checksums of two consecutive blocks.
+ *
+ * @param crc1 CRC32C checksum of the first block, computed with @p first_pkt
+ *             and @p last_pkt set.
+ * @param crc2 CRC32C checksum of the second block, computed the same way.
+ * @param len2 Length of the second block.
+ *
+ * @return CRC32C value of the two blocks.
+ *
+ * @see crc32_ieee_combine()
+ */
+uint32_t crc32_c_combine(uint32_t crc1, uint32_t crc2, size_t len2);
+
 /**
  * @brief Update a CRC-32K/4.2 (*op) (Koopman) checksum. This is a good HD=4
  * checksum up to 2,147,483,615 bits and HD=5/6 up to 6,167 bits.
@@ -0,0 +1,150 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @ingroup hashmap_implementations
+ * @brief Concurrent (Sharded) Hashmap Implementation
+ *
+ * The Hashmap is split into shards, each protected by its own spinlock, so
+ * that operations on keys living in different shards proceed in parallel.
+ * Each shard is a separate-chaining table which is resized incrementally: a
+ * few buckets of the previous table are migrated on every insertion or
+ * removal, so no single operation pays for a full rehash.
+ *
+ * Insertion, removal and lookup may be called concurrently from any context
+ * that may take a spinlock. Iteration and @ref sys_hashmap_clear still require
+ * that no other thread modifies the Hashmap at the same time.
+ *
+ * @note Enable with @kconfig{CONFIG_SYS_HASH_MAP_CONCURRENT}
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_HASH_MAP_CONCURRENT_H_
+#define ZEPHYR_INCLUDE_SYS_HASH_MAP_CONCURRENT_H_
+
+#include <stddef.h>
+
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/hash_function.h>
+#include <zephyr/sys/hash_map_api.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(CONFIG_SYS_HASH_MAP_CONCURRENT) || defined(__DOXYGEN__)
+
+/** @brief One lock-protected shard of a concurrent Hashmap */
+struct sys_hashmap_concurrent_shard {
+	/** Lock protecting all other members of the shard */
+	struct k_spinlock lock;
+	/** Bucket array that new entries are inserted into */
+	void *buckets;
+	/** Number of buckets in @a buckets */
+	size_t n_buckets;
+	/** Bucket array being migrated into @a buckets, or `NULL` */
+	void *old_buckets;
+	/** Number of buckets in @a old_buckets */
+	size_t n_old_buckets;
+	/** Index of the next bucket of @a old_buckets to migrate */
+	size_t rehash_pos;
+	/** Number of entries in the shard */
+	size_t size;
+};
+
+/**
+ * @brief Concurrent Hashmap data
+ *
+ * The leading members mirror @ref sys_hashmap_data and hold the totals over
+ * all shards; @a buckets is always `NULL`.
+ */
+struct sys_hashmap_concurrent_data {
+	void *buckets;
+	size_t n_buckets;
+	size_t size;
+	struct sys_hashmap_concurrent_shard shards[CONFIG_SYS_HASH_MAP_CONCURRENT_SHARDS];
+};
+
+#endif /* CONFIG_SYS_HASH_MAP_CONCURRENT */
+
+/**
+ * @brief Declare a Concurrent Hashmap (advanced)
+ *
+ * Declare a Concurrent Hashmap with control over advanced parameters.
+ *
+ * @note The allocator @p _alloc_func is used for allocating internal Hashmap
+ * entries and does not interact with any user-provided keys or values. It is
+ * never called with a shard lock held.
+ *
+ * @param _name Name of the Hashmap.
+ * @param _hash_func Hash function pointer of type @ref sys_hash_func32_t.
+ * @param _alloc_func Allocator function pointer of type @ref sys_hashmap_allocator_t.
+ * @param ... Details for @ref sys_hashmap_config.
+ */
+#define SYS_HASHMAP_CONCURRENT_DEFINE_ADVANCED(_name, _hash_func, _alloc_func, ...)                \
+	SYS_HASHMAP_DEFINE_ADVANCED(_name, &sys_hashmap_concurrent_api, sys_hashmap_config,        \
+				    sys_hashmap_concurrent_data, _hash_func, _alloc_func,          \
+				    __VA_ARGS__)
+
+/**
+ * @brief Declare a Concurrent Hashmap statically (advanced)
+ *
+ * Declare a Concurrent Hashmap statically with control over advanced parameters.
+ *
+ * @note The allocator @p _alloc_func is used for allocating internal Hashmap
+ * entries and does not interact with any user-provided keys or values. It is
+ * never called with a shard lock held.
+ *
+ * @param _name Name of the Hashmap.
+ * @param _hash_func Hash function pointer of type @ref sys_hash_func32_t.
+ * @param _alloc_func Allocator function pointer of type @ref sys_hashmap_allocator_t.
+ * @param ... Details for @ref sys_hashmap_config.
+ */
+#define SYS_HASHMAP_CONCURRENT_DEFINE_STATIC_ADVANCED(_name, _hash_func, _alloc_func, ...)         \
+	SYS_HASHMAP_DEFINE_STATIC_ADVANCED(_name, &sys_hashmap_concurrent_api, sys_hashmap_config, \
+					   sys_hashmap_concurrent_data, _hash_func, _alloc_func,   \
+					   __VA_ARGS__)
+
+/**
+ * @brief Declare a Concurrent Hashmap statically
+ *
+ * Declare a Concurrent Hashmap statically with default parameters.
+ *
+ * @param _name Name of the Hashmap.
+ */
+#define SYS_HASHMAP_CONCURRENT_DEFINE_STATIC(_name)                                                \
+	SYS_HASHMAP_CONCURRENT_DEFINE_STATIC_ADVANCED(                                             \
+		_name, sys_hash32, SYS_HASHMAP_DEFAULT_ALLOCATOR,                                  \
+		SYS_HASHMAP_CONFIG(SIZE_MAX, SYS_HASHMAP_DEFAULT_LOAD_FACTOR))
+
+/**
+ * @brief Declare a Concurrent Hashmap
+ *
+ * Declare a Concurrent Hashmap with default parameters.
+ *
+ * @param _name Name of the Hashmap.
+ */
+#define SYS_HASHMAP_CONCURRENT_DEFINE(_name)                                                       \
+	SYS_HASHMAP_CONCURRENT_DEFINE_ADVANCED(                                                    \
+		_name, sys_hash32, SYS_HASHMAP_DEFAULT_ALLOCATOR,                                  \
+		SYS_HASHMAP_CONFIG(SIZE_MAX, SYS_HASHMAP_DEFAULT_LOAD_FACTOR))
+
+#ifdef CONFIG_SYS_HASH_MAP_CHOICE_CONCURRENT
+#define SYS_HASHMAP_DEFAULT_DEFINE(_name)	 SYS_HASHMAP_CONCURRENT_DEFINE(_name)
+#define SYS_HASHMAP_DEFAULT_DEFINE_STATIC(_name) SYS_HASHMAP_CONCURRENT_DEFINE_STATIC(_name)
+#define SYS_HASHMAP_DEFAULT_DEFINE_ADVANCED(_name, _hash_func, _alloc_func, ...)                   \
+	SYS_HASHMAP_CONCURRENT_DEFINE_ADVANCED(_name, _hash_func, _alloc_func, __VA_ARGS__)
+#define SYS_HASHMAP_DEFAULT_DEFINE_STATIC_ADVANCED(_name, _hash_func, _alloc_func, ...)            \
+	SYS_HASHMAP_CONCURRENT_DEFINE_STATIC_ADVANCED(_name, _hash_func, _alloc_func, __VA_ARGS__)
+#endif
+
+extern const struct sys_hashmap_api sys_hashmap_concurrent_api;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_HASH_MAP_CONCURRENT_H_ */
@@ -49,6 +49,26 @@ typedef int (*min_heap_cmp_t)(const void *a,
 typedef bool (*min_heap_eq_t)(const void *node,
 			       const void *other);
 
+/**
+ * @brief Index reported for an element that left the heap.
+ */
+#define MIN_HEAP_INDEX_NONE SIZE_MAX
+
+/**
+ * @brief Element position tracking function.
+ *
+ * Called whenever an element is stored at a new index of the heap, and
+ * with @ref MIN_HEAP_INDEX_NONE on the copy returned by min_heap_pop() or
+ * min_heap_remove(). Keeping track of the index, e.g. in the object an
+ * element points to, allows removing or updating that element later in
+ * O(log n) time with min_heap_remove() and min_heap_update(), without
+ * searching for it.
+ *
+ * @param elem Pointer to the element.
+ * @param index New index of the element in the heap.
+ */
+typedef void (*min_heap_index_t)(void *elem, size_t index);
+
 /**
  * @brief min-heap data structure with user-provided comparator.
  */
@@ -63,6 +83,8 @@ struct min_heap {
 	size_t size;
 	/** Comparator function */
 	min_heap_cmp_t cmp;
+	/** Optional position tracking function */
+	min_heap_index_t index_cb;
 };
 
 /**
@@ -120,6 +142,21 @@ struct min_heap {
 void min_heap_init(struct min_heap *heap, void *storage, size_t cap,
 		   size_t elem_size, min_heap_cmp_t cmp);
 
+/**
+ * @brief Track the position of the elements of a min-heap.
+ *
+ * Must be called before any element is pushed.
+ *
+ * @param heap Pointer to the min-heap.
+ * @param index_cb Function called each time an element moves, or NULL.
+ */
+static inline void min_heap_set_index_cb(struct min_heap *heap, min_heap_index_t index_cb)
+{
+	__ASSERT_NO_MSG(heap != NULL);
+
+	heap->index_cb = index_cb;
+}
+
 /**
  * @brief Push an element into the min-heap.
  *
@@ -162,6 +199,20 @@ void *min_heap_peek(const struct min_heap *heap);
  */
 bool min_heap_remove(struct min_heap *heap, size_t id, void *out_buf);
 
+/**
+ * @brief Restore the heap order after an element was modified.
+ *
+ * Moves the element at the given index up or down after its ordering key
+ * was changed in place through min_heap_get_element(), in O(log n) time.
+ * This is the decrease-key, and increase-key, operation of the heap.
+ *
+ * @param heap Pointer to the min-heap.
+ * @param id Index of the modified element.
+ *
+ * @return true in success, false if @p id is out of range.
+ */
+bool min_heap_update(struct min_heap *heap, size_t id);
+
 /**
  * @brief Check if the min heap is empty.
  *
@@ -0,0 +1,185 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_RADIX_HEAP_H_
+#define ZEPHYR_INCLUDE_SYS_RADIX_HEAP_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/sys/dlist.h>
+#include <zephyr/sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief radix_heap
+ * @defgroup radix_heap_apis Radix Heap service
+ * @ingroup datastructure_apis
+ *
+ * A monotone priority queue for unsigned 64-bit keys. Keys are never
+ * pushed below the key of the last popped node, which holds for
+ * deadlines in a timeout queue. Nodes are sorted into buckets by the
+ * highest bit in which their key differs from that last popped key, so
+ * push, remove and update are O(1), and pop is amortized O(log C), C
+ * being the largest key difference in the heap.
+ *
+ * @{
+ */
+
+/** @cond INTERNAL_HIDDEN */
+#define Z_RADIX_HEAP_BUCKETS 65
+/** @endcond */
+
+/**
+ * @brief Radix heap node, to be embedded in user structures.
+ */
+struct radix_heap_node {
+	/** @cond INTERNAL_HIDDEN */
+	sys_dnode_t node;
+	uint64_t key;
+	/** @endcond */
+};
+
+/**
+ * @brief Radix heap.
+ */
+struct radix_heap {
+	/** @cond INTERNAL_HIDDEN */
+	/* Bucket n holds the keys whose highest bit differing from last is n - 1 */
+	sys_dlist_t buckets[Z_RADIX_HEAP_BUCKETS];
+	/* Bit n - 1 is set when bucket n is not empty, for n >= 1 */
+	uint64_t mask;
+	uint64_t last;
+	size_t size;
+	/** @endcond */
+};
+
+/**
+ * @brief Initialize a radix heap.
+ *
+ * @param heap Pointer to the radix heap.
+ * @param start Lower bound of the keys that will be pushed.
+ */
+void radix_heap_init(struct radix_heap *heap, uint64_t start);
+
+/**
+ * @brief Push a node into the radix heap.
+ *
+ * @param heap Pointer to the radix heap.
+ * @param node Node to insert, must not be in any heap.
+ * @param key Key of the node, must not be lower than radix_heap_last().
+ */
+void radix_heap_push(struct radix_heap *heap, struct radix_heap_node *node, uint64_t key);
+
+/**
+ * @brief Remove a node from the radix heap.
+ *
+ * @param heap Pointer to the radix heap.
+ * @param node Node to remove, must be in @p heap.
+ */
+void radix_heap_remove(struct radix_heap *heap, struct radix_heap_node *node);
+
+/**
+ * @brief Peek at the node with the lowest key.
+ *
+ * When several nodes have the lowest key, any of them may be returned.
+ * The heap is not modified, so keys down to radix_heap_last() can still
+ * be pushed afterwards. Unless the lowest key equals radix_heap_last(),
+ * this scans the bucket holding it.
+ *
+ * @param heap Pointer to the radix heap.
+ *
+ * @return Node with the lowest key, or NULL if the heap is empty.
+ */
+struct radix_heap_node *radix_heap_peek(struct radix_heap *heap);
+
+/**
+ * @brief Remove and return the node with the lowest key.
+ *
+ * Raises radix_heap_last() to the key of the returned node.
+ *
+ * @param heap Pointer to the radix heap.
+ *
+ * @return Node with the lowest key, or NULL if the heap is empty.
+ */
+struct radix_heap_node *radix_heap_pop(struct radix_heap *heap);
+
+/**
+ * @brief Change the key of a node in the radix heap.
+ *
+ * @param heap Pointer to the radix heap.
+ * @param node Node to update, must be in @p heap.
+ * @param key New key of the node, must not be lower than radix_heap_last().
+ */
+static inline void radix_heap_update(struct radix_heap *heap, struct radix_heap_node *node,
+				     uint64_t key)
+{
+	radix_heap_remove(heap, node);
+	radix_heap_push(heap, node, key);
+}
+
+/**
+ * @brief Get the key of a node.
+ *
+ * @param node Pointer to the node.
+ *
+ * @return Key the node was last pushed with.
+ */
+static inline uint64_t radix_heap_node_key(const struct radix_heap_node *node)
+{
+	return node->key;
+}
+
+/**
+ * @brief Get the lowest key that may be pushed into the heap.
+ *
+ * @param heap Pointer to the radix heap.
+ *
+ * @return Key of the last node returned by radix_heap_pop(), or the
+ *         start value before that.
+ */
+static inline uint64_t radix_heap_last(const struct radix_heap *heap)
+{
+	return heap->last;
+}
+
+/**
+ * @brief Get the number of nodes in the radix heap.
+ *
+ * @param heap Pointer to the radix heap.
+ *
+ * @return Number of nodes.
+ */
+static inline size_t radix_heap_size(const struct radix_heap *heap)
+{
+	return heap->size;
+}
+
+/**
+ * @brief Check if the radix heap is empty.
+ *
+ * @param heap Pointer to the radix heap.
+ *
+ * @return true if heap is empty, false otherwise.
+ */
+static inline bool radix_heap_is_empty(const struct radix_heap *heap)
+{
+	return heap->size == 0;
+}
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_RADIX_HEAP_H_ */
@@ -8,6 +8,8 @@
 #define ZEPHYR_INCLUDE_SYS_RING_BUFFER_H_
 
 #include <zephyr/sys/util.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/barrier.h>
 #include <errno.h>
 
 #ifdef __cplusplus
@@ -21,6 +23,10 @@ extern "C" {
  *
  * @brief Simple ring buffer implementation.
  *
+ * One producer and one consumer may use a ring buffer concurrently, from any
+ * context and on any CPU, without locking: each side only writes its own
+ * indexes and publishes them with the memory barriers required on SMP.
+ *
  * @{
  */
 
@@ -74,6 +80,24 @@ static inline void ring_buf_internal_reset(struct ring_buf *buf, ring_buf_idx_t
 	buf->get.head = buf->get.tail = buf->get.base = value;
 }
 
+/* Reads an index published by the other side of the ring buffer. */
+static inline ring_buf_idx_t ring_buf_internal_load(const ring_buf_idx_t *idx)
+{
+	return *(const volatile ring_buf_idx_t *)idx;
+}
+
+/*
+ * Orders accesses to the claimed area against loads and stores of the index
+ * published by the other side. A single CPU only needs the compiler barrier.
+ */
+static ALWAYS_INLINE void ring_buf_internal_fence(void)
+{
+	if (IS_ENABLED(CONFIG_SMP)) {
+		barrier_dmem_fence_full();
+	}
+	compiler_barrier();
+}
+
 /** @endcond */
 
 #define RING_BUF_INIT(buf, size8)	\
@@ -212,7 +236,7 @@ static inline void ring_buf_item_init(struct ring_buf *buf,
  */
 static inline bool ring_buf_is_empty(const struct ring_buf *buf)
 {
-	return buf->get.head == buf->put.tail;
+	return buf->get.head == ring_buf_internal_load(&buf->put.tail);
 }
 
 /**
@@ -234,7 +258,7 @@ static inline void ring_buf_reset(struct ring_buf *buf)
  */
 static inline uint32_t ring_buf_space_get(const struct ring_buf *buf)
 {
-	ring_buf_idx_t allocated = buf->put.head - buf->get.tail;
+	ring_buf_idx_t allocated = buf->put.head - ring_buf_internal_load(&buf->get.tail);
 
 	return buf->size - allocated;
 }
@@ -272,7 +296,7 @@ static inline uint32_t ring_buf_capacity_get(const struct ring_buf *buf)
  */
 static inline uint32_t ring_buf_size_get(const struct ring_buf *buf)
 {
-	ring_buf_idx_t available = buf->put.tail - buf->get.head;
+	ring_buf_idx_t available = ring_buf_internal_load(&buf->put.tail) - buf->get.head;
 
 	return available;
 }
@@ -287,7 +311,8 @@ static inline uint32_t ring_buf_size_get(const struct ring_buf *buf)
  * @warning
  * Use cases involving multiple writers to the ring buffer must prevent
  * concurrent write operations, either by preventing all writers from
- * being preempted or by using a mutex to govern writes to the ring buffer.
+ * being preempted or by using a mutex to govern writes to the ring buffer,
+ * or use @ref ring_buf_mp instead.
  *
  * @warning
  * Ring buffer instance should not mix byte access and item access
@@ -320,7 +345,8 @@ static inline uint32_t ring_buf_put_claim(struct ring_buf *buf,
  * @warning
  * Use cases involving multiple writers to the ring buffer must prevent
  * concurrent write operations, either by preventing all writers from
- * being preempted or by using a mutex to govern writes to the ring buffer.
+ * being preempted or by using a mutex to govern writes to the ring buffer,
+ * or use @ref ring_buf_mp instead.
  *
  * @warning
  * Ring buffer instance should not mix byte access and item access
@@ -345,7 +371,8 @@ static inline int ring_buf_put_finish(struct ring_buf *buf, uint32_t size)
  * @warning
  * Use cases involving multiple writers to the ring buffer must prevent
  * concurrent write operations, either by preventing all writers from
- * being preempted or by using a mutex to govern writes to the ring buffer.
+ * being preempted or by using a mutex to govern writes to the ring buffer,
+ * or use @ref ring_buf_mp instead.
  *
  * @warning
  * Ring buffer instance should not mix byte access and item access
@@ -479,7 +506,8 @@ uint32_t ring_buf_peek(struct ring_buf *buf, uint8_t *data, uint32_t size);
  * @warning
  * Use cases involving multiple writers to the ring buffer must prevent
  * concurrent write operations, either by preventing all writers from
- * being preempted or by using a mutex to govern writes to the ring buffer.
+ * being preempted or by using a mutex to govern writes to the ring buffer,
+ * or use @ref ring_buf_mp instead.
  *
  * @param buf Address of ring buffer.
  * @param type Data item's type identifier (application specific).
@@ -520,6 +548,298 @@ int ring_buf_item_put(struct ring_buf *buf, uint16_t type, uint8_t value,
 int ring_buf_item_get(struct ring_buf *buf, uint16_t *type, uint8_t *value,
 		      uint32_t *data, uint8_t *size32);
 
+#if defined(CONFIG_RING_BUFFER_MP) || defined(__DOXYGEN__)
+
+/**
+ * @brief A structure to represent a multi-producer ring buffer
+ *
+ * Any number of producers, in threads, ISRs or on other CPUs, may write to
+ * the ring buffer concurrently without locking, while a single consumer
+ * reads from it. Producers reserve space with a compare-and-swap on a state
+ * word holding the write index and the number of open claims; written data
+ * becomes visible to the consumer once no claim is open anymore.
+ *
+ * The size of the ring buffer must be a power of two.
+ *
+ * @note Enable with @kconfig{CONFIG_RING_BUFFER_MP}
+ */
+struct ring_buf_mp {
+	/** @cond INTERNAL_HIDDEN */
+	struct ring_buf rb;
+	/* Write index in the low half, number of open claims in the high half */
+	atomic_t put_state;
+	/** @endcond */
+};
+
+/** @cond INTERNAL_HIDDEN */
+
+/* Width of the write index kept in ring_buf_mp::put_state */
+#define RING_BUF_MP_IDX_BITS MIN(4 * sizeof(atomic_val_t), 8 * sizeof(ring_buf_idx_t))
+#define RING_BUF_MP_IDX_MASK ((1UL << RING_BUF_MP_IDX_BITS) - 1UL)
+
+/* The size must also fit the index distances held in the state word */
+#define RING_BUF_MP_MAX_SIZE MIN(RING_BUFFER_MAX_SIZE, 1UL << (RING_BUF_MP_IDX_BITS - 1))
+
+/* Distance from @p idx up to the write index held in @p state */
+static inline uint32_t ring_buf_mp_internal_dist(atomic_val_t state, ring_buf_idx_t idx)
+{
+	return ((unsigned long)state - (unsigned long)idx) & RING_BUF_MP_IDX_MASK;
+}
+
+void ring_buf_mp_internal_sync(struct ring_buf_mp *buf);
+
+/**
+ * @brief Function to force ring_buf_mp internal states to given value
+ *
+ * Any value other than 0 makes sense only in validation testing context.
+ */
+static inline void ring_buf_mp_internal_reset(struct ring_buf_mp *buf, ring_buf_idx_t value)
+{
+	ring_buf_internal_reset(&buf->rb, value);
+	/* producers locate data with the index modulo the power of two size */
+	buf->rb.put.base = buf->rb.get.base = value & ~(ring_buf_idx_t)(buf->rb.size - 1U);
+	atomic_set(&buf->put_state, (atomic_val_t)(value & RING_BUF_MP_IDX_MASK));
+}
+
+/** @endcond */
+
+/**
+ * @brief Define and initialize a multi-producer ring buffer for byte data.
+ *
+ * The ring buffer can be accessed outside the module where it is defined
+ * using:
+ *
+ * @code extern struct ring_buf_mp <name>; @endcode
+ *
+ * @param name  Name of the ring buffer.
+ * @param size8 Size of ring buffer (in bytes), a power of two.
+ */
+#define RING_BUF_MP_DECLARE(name, size8) \
+	BUILD_ASSERT(size8 <= RING_BUF_MP_MAX_SIZE,\
+		RING_BUFFER_SIZE_ASSERT_MSG); \
+	BUILD_ASSERT(IS_POWER_OF_TWO(size8), "Size must be a power of two"); \
+	static uint8_t __noinit _ring_buffer_data_##name[size8]; \
+	struct ring_buf_mp name = { \
+		.rb = RING_BUF_INIT(_ring_buffer_data_##name, size8), \
+	}
+
+/**
+ * @brief Initialize a multi-producer ring buffer.
+ *
+ * This routine initializes a ring buffer, prior to its first use. It is only
+ * used for ring buffers not defined using RING_BUF_MP_DECLARE.
+ *
+ * @param buf Address of ring buffer.
+ * @param size Ring buffer size (in bytes), a power of two.
+ * @param data Ring buffer data area (uint8_t data[size]).
+ */
+static inline void ring_buf_mp_init(struct ring_buf_mp *buf, uint32_t size, uint8_t *data)
+{
+	__ASSERT(size <= RING_BUF_MP_MAX_SIZE, RING_BUFFER_SIZE_ASSERT_MSG);
+	__ASSERT(IS_POWER_OF_TWO(size), "Size must be a power of two");
+
+	ring_buf_init(&buf->rb, size, data);
+	atomic_clear(&buf->put_state);
+}
+
+/**
+ * @brief Reset multi-producer ring buffer state.
+ *
+ * No producer or consumer may use the ring buffer at the same time.
+ *
+ * @param buf Address of ring buffer.
+ */
+static inline void ring_buf_mp_reset(struct ring_buf_mp *buf)
+{
+	ring_buf_mp_internal_reset(buf, 0);
+}
+
+/**
+ * @brief Return multi-producer ring buffer capacity.
+ *
+ * @param buf Address of ring buffer.
+ *
+ * @return Ring buffer capacity (in bytes).
+ */
+static inline uint32_t ring_buf_mp_capacity_get(const struct ring_buf_mp *buf)
+{
+	return buf->rb.size;
+}
+
+/**
+ * @brief Determine free space in a multi-producer ring buffer.
+ *
+ * May be called from any context.
+ *
+ * @param buf Address of ring buffer.
+ *
+ * @return Ring buffer free space (in bytes).
+ */
+static inline uint32_t ring_buf_mp_space_get(const struct ring_buf_mp *buf)
+{
+	atomic_val_t state = atomic_get(&buf->put_state);
+
+	return buf->rb.size -
+	       ring_buf_mp_internal_dist(state, ring_buf_internal_load(&buf->rb.get.tail));
+}
+
+/**
+ * @brief Determine if a multi-producer ring buffer is empty.
+ *
+ * May be called from any context. Claimed but not yet finished areas count
+ * as data.
+ *
+ * @param buf Address of ring buffer.
+ *
+ * @return true if the ring buffer is empty, or false if not.
+ */
+static inline bool ring_buf_mp_is_empty(const struct ring_buf_mp *buf)
+{
+	atomic_val_t state = atomic_get(&buf->put_state);
+
+	/* no open claim and no committed data past the read index */
+	return (unsigned long)state ==
+	       (ring_buf_internal_load(&buf->rb.get.head) & RING_BUF_MP_IDX_MASK);
+}
+
+/**
+ * @brief Determine size of available data in a multi-producer ring buffer.
+ *
+ * Only the consumer may call this routine.
+ *
+ * @param buf Address of ring buffer.
+ *
+ * @return Ring buffer data size (in bytes).
+ */
+static inline uint32_t ring_buf_mp_size_get(struct ring_buf_mp *buf)
+{
+	ring_buf_mp_internal_sync(buf);
+
+	return ring_buf_size_get(&buf->rb);
+}
+
+/**
+ * @brief Allocate buffer for writing data to a multi-producer ring buffer.
+ *
+ * The allocated area is contiguous, so it may directly be handed to a DMA
+ * transfer, and is reserved for the caller only. Each successful claim must
+ * be followed by exactly one @ref ring_buf_mp_put_finish, which commits the
+ * whole area. Data becomes visible to the consumer only while no claim is
+ * open, so claims should be held briefly.
+ *
+ * @param[in]  buf  Address of ring buffer.
+ * @param[out] data Pointer to the address. It is set to a location within
+ *		    ring buffer.
+ * @param[in]  size Requested allocation size (in bytes).
+ *
+ * @return Size of allocated buffer which can be smaller than requested if
+ *	   there is not enough free space or buffer wraps. Nothing is
+ *	   allocated when 0 is returned.
+ */
+uint32_t ring_buf_mp_put_claim(struct ring_buf_mp *buf, uint8_t **data, uint32_t size);
+
+/**
+ * @brief Commit an area allocated with @ref ring_buf_mp_put_claim.
+ *
+ * @param buf  Address of ring buffer.
+ */
+void ring_buf_mp_put_finish(struct ring_buf_mp *buf);
+
+/**
+ * @brief Reserve a block for writing in place to a multi-producer ring buffer.
+ *
+ * Unlike @ref ring_buf_mp_put_claim, the block is reserved entirely or not
+ * at all, and may wrap around the end of the buffer: its first bytes,
+ * as many as returned, start at @p data and the remaining ones at @p wrap.
+ * Each successful reservation must be followed by exactly one
+ * @ref ring_buf_mp_put_finish, which commits the whole block.
+ *
+ * @param[in]  buf  Address of ring buffer.
+ * @param[out] data Start of the block.
+ * @param[out] wrap Start of the part of the block past the end of the buffer.
+ * @param[in]  size Block size (in bytes).
+ *
+ * @return Number of bytes of the block starting at @p data, or 0 if there
+ *	   is not enough free space and nothing was reserved.
+ */
+uint32_t ring_buf_mp_put_reserve(struct ring_buf_mp *buf, uint8_t **data, uint8_t **wrap,
+				 uint32_t size);
+
+/**
+ * @brief Write (copy) data to a multi-producer ring buffer.
+ *
+ * Data from concurrent writers is never interleaved: either all @p size
+ * bytes are written as one block or, if there is not enough free space,
+ * nothing is.
+ *
+ * @param buf Address of ring buffer.
+ * @param data Address of data.
+ * @param size Data size (in bytes).
+ *
+ * @return Number of bytes written, either @p size or 0.
+ */
+uint32_t ring_buf_mp_put(struct ring_buf_mp *buf, const uint8_t *data, uint32_t size);
+
+/**
+ * @brief Get address of a valid data in a multi-producer ring buffer.
+ *
+ * Only the consumer may call this routine. It otherwise behaves like
+ * @ref ring_buf_get_claim.
+ *
+ * @param[in]  buf  Address of ring buffer.
+ * @param[out] data Pointer to the address. It is set to a location within
+ *		    ring buffer.
+ * @param[in]  size Requested size (in bytes).
+ *
+ * @return Number of valid bytes in the provided buffer which can be smaller
+ *	   than requested if there is not enough free space or buffer wraps.
+ */
+static inline uint32_t ring_buf_mp_get_claim(struct ring_buf_mp *buf, uint8_t **data,
+					     uint32_t size)
+{
+	ring_buf_mp_internal_sync(buf);
+
+	return ring_buf_get_claim(&buf->rb, data, size);
+}
+
+/**
+ * @brief Indicate number of bytes read from claimed buffer.
+ *
+ * Only the consumer may call this routine. It otherwise behaves like
+ * @ref ring_buf_get_finish.
+ *
+ * @param  buf  Address of ring buffer.
+ * @param  size Number of bytes that can be freed.
+ *
+ * @retval 0 Successful operation.
+ * @retval -EINVAL Provided @a size exceeds valid bytes in the ring buffer.
+ */
+static inline int ring_buf_mp_get_finish(struct ring_buf_mp *buf, uint32_t size)
+{
+	return ring_buf_get_finish(&buf->rb, size);
+}
+
+/**
+ * @brief Read data from a multi-producer ring buffer.
+ *
+ * Only the consumer may call this routine. It otherwise behaves like
+ * @ref ring_buf_get.
+ *
+ * @param buf  Address of ring buffer.
+ * @param data Address of the output buffer. Can be NULL to discard data.
+ * @param size Data size (in bytes).
+ *
+ * @return Number of bytes written to the output buffer.
+ */
+static inline uint32_t ring_buf_mp_get(struct ring_buf_mp *buf, uint8_t *data, uint32_t size)
+{
+	ring_buf_mp_internal_sync(buf);
+
+	return ring_buf_get(&buf->rb, data, size);
+}
+
+#endif /* CONFIG_RING_BUFFER_MP */
+
 /**
  * @}
  */
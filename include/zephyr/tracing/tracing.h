@@ -1875,6 +1875,35 @@
  */
 #define sys_port_trace_k_mem_slab_free_exit(slab)
 
+/**
+ * @brief Trace Memory Slab bulk alloc attempt entry
+ * @param slab Memory Slab object
+ * @param count Number of blocks
+ */
+#define sys_port_trace_k_mem_slab_alloc_bulk_enter(slab, count)
+
+/**
+ * @brief Trace Memory Slab bulk alloc attempt outcome
+ * @param slab Memory Slab object
+ * @param count Number of blocks
+ * @param ret Return value
+ */
+#define sys_port_trace_k_mem_slab_alloc_bulk_exit(slab, count, ret)
+
+/**
+ * @brief Trace Memory Slab bulk free entry
+ * @param slab Memory Slab object
+ * @param count Number of blocks
+ */
+#define sys_port_trace_k_mem_slab_free_bulk_enter(slab, count)
+
+/**
+ * @brief Trace Memory Slab bulk free exit
+ * @param slab Memory Slab object
+ * @param count Number of blocks
+ */
+#define sys_port_trace_k_mem_slab_free_bulk_exit(slab, count)
+
 /** @} */ /* end of subsys_tracing_apis_mslab */
 
 /**
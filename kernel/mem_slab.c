@@ -300,6 +300,83 @@ void k_mem_slab_free(struct k_mem_slab *slab, void *mem)
 	k_spin_unlock(&slab->lock, key);
 }
 
+int k_mem_slab_alloc_bulk(struct k_mem_slab *slab, void **mem, size_t count)
+{
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, alloc_bulk, slab, count);
+
+	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+
+	if ((slab->info.num_blocks - slab->info.num_used) < count) {
+		k_spin_unlock(&slab->lock, key);
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc_bulk, slab, count, -ENOMEM);
+
+		return -ENOMEM;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		mem[i] = slab->free_list;
+		slab->free_list = *(char **)(slab->free_list);
+	}
+	slab->info.num_used += count;
+	__ASSERT((slab->free_list == NULL &&
+		  slab->info.num_used == slab->info.num_blocks) ||
+		 slab_ptr_is_good(slab, slab->free_list),
+		 "slab corruption detected");
+
+#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+	slab->info.max_used = max(slab->info.num_used,
+				  slab->info.max_used);
+#endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
+
+	k_spin_unlock(&slab->lock, key);
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc_bulk, slab, count, 0);
+
+	return 0;
+}
+
+void k_mem_slab_free_bulk(struct k_mem_slab *slab, void **mem, size_t count)
+{
+	bool need_sched = false;
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free_bulk, slab, count);
+
+	for (size_t i = 0; i < count; i++) {
+		if (!slab_ptr_is_good(slab, mem[i])) {
+			__ASSERT(false, "Invalid memory pointer provided");
+			k_panic();
+			return;
+		}
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+
+	for (size_t i = 0; i < count; i++) {
+		if (unlikely(slab->free_list == NULL) && IS_ENABLED(CONFIG_MULTITHREADING)) {
+			struct k_thread *pending_thread = z_unpend_first_thread(&slab->wait_q);
+
+			if (unlikely(pending_thread != NULL)) {
+				z_thread_return_value_set_with_data(pending_thread, 0, mem[i]);
+				z_ready_thread(pending_thread);
+				need_sched = true;
+				continue;
+			}
+		}
+		*(char **) mem[i] = slab->free_list;
+		slab->free_list = (char *) mem[i];
+		slab->info.num_used--;
+	}
+
+	if (need_sched) {
+		z_reschedule(&slab->lock, key);
+	} else {
+		k_spin_unlock(&slab->lock, key);
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free_bulk, slab, count);
+}
+
 int k_mem_slab_runtime_stats_get(struct k_mem_slab *slab, struct sys_memory_stats *stats)
 {
 	if ((slab == NULL) || (stats == NULL)) {
@@ -0,0 +1,107 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <zephyr/kernel.h>
+#include <zephyr/types.h>
+#include <zephyr/sys/util.h>
+
+#define MAX_BLOCK_SIZE CONFIG_CPP_NEW_POOL_MAX_BLOCK_SIZE
+
+/* Blocks get the same alignment as malloc(), which is what operator new
+ * promises for objects without extended alignment.
+ */
+#define BLOCK_ALIGN __alignof__(z_max_align_t)
+
+BUILD_ASSERT(IS_POWER_OF_TWO(MAX_BLOCK_SIZE),
+	     "CONFIG_CPP_NEW_POOL_MAX_BLOCK_SIZE must be a power of two");
+BUILD_ASSERT(BLOCK_ALIGN <= 16, "smallest size class is not aligned enough");
+
+/* Not static so that tests can check which allocations are pooled */
+#define CPP_NEW_SLAB_DEFINE(size)                                                                  \
+	K_MEM_SLAB_DEFINE(z_cpp_new_slab_##size, size, CONFIG_CPP_NEW_POOL_BLOCKS, BLOCK_ALIGN)
+
+CPP_NEW_SLAB_DEFINE(16);
+#if MAX_BLOCK_SIZE >= 32
+CPP_NEW_SLAB_DEFINE(32);
+#endif
+#if MAX_BLOCK_SIZE >= 64
+CPP_NEW_SLAB_DEFINE(64);
+#endif
+#if MAX_BLOCK_SIZE >= 128
+CPP_NEW_SLAB_DEFINE(128);
+#endif
+#if MAX_BLOCK_SIZE >= 256
+CPP_NEW_SLAB_DEFINE(256);
+#endif
+#if MAX_BLOCK_SIZE >= 512
+CPP_NEW_SLAB_DEFINE(512);
+#endif
+#if MAX_BLOCK_SIZE >= 1024
+CPP_NEW_SLAB_DEFINE(1024);
+#endif
+
+/* Indexed by size class, smallest first */
+static struct k_mem_slab *const cpp_new_slabs[] = {
+	&z_cpp_new_slab_16,
+#if MAX_BLOCK_SIZE >= 32
+	&z_cpp_new_slab_32,
+#endif
+#if MAX_BLOCK_SIZE >= 64
+	&z_cpp_new_slab_64,
+#endif
+#if MAX_BLOCK_SIZE >= 128
+	&z_cpp_new_slab_128,
+#endif
+#if MAX_BLOCK_SIZE >= 256
+	&z_cpp_new_slab_256,
+#endif
+#if MAX_BLOCK_SIZE >= 512
+	&z_cpp_new_slab_512,
+#endif
+#if MAX_BLOCK_SIZE >= 1024
+	&z_cpp_new_slab_1024,
+#endif
+};
+
+static bool in_slab(const struct k_mem_slab *slab, const void *ptr)
+{
+	const char *p = ptr;
+
+	return p >= slab->buffer &&
+	       p < slab->buffer + (size_t)slab->info.num_blocks * slab->info.block_size;
+}
+
+void *z_cpp_new_pool_alloc(size_t size)
+{
+	if (size <= MAX_BLOCK_SIZE) {
+		/* size class i holds blocks of 16 << i bytes */
+		size_t i = size <= 16 ? 0 : LOG2CEIL(size) - 4;
+		void *ptr;
+
+		if (k_mem_slab_alloc(cpp_new_slabs[i], &ptr, K_NO_WAIT) == 0) {
+			return ptr;
+		}
+	}
+
+	return malloc(size);
+}
+
+void z_cpp_new_pool_free(void *ptr)
+{
+	if (ptr == NULL) {
+		return;
+	}
+
+	ARRAY_FOR_EACH(cpp_new_slabs, i) {
+		if (in_slab(cpp_new_slabs[i], ptr)) {
+			k_mem_slab_free(cpp_new_slabs[i], ptr);
+			return;
+		}
+	}
+
+	free(ptr);
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Replacements for the allocating operator new and matching operator delete
+ * that serve small objects from the CONFIG_CPP_NEW_POOLS memory slabs. The
+ * over-aligned variants are left to the C++ library.
+ */
+
+#include <cstddef>
+#include <new>
+
+extern "C" {
+void *z_cpp_new_pool_alloc(size_t size);
+void z_cpp_new_pool_free(void *ptr);
+}
+
+#if __cplusplus < 201103L
+#define NOEXCEPT
+#else /* >= C++11 */
+#define NOEXCEPT noexcept
+#endif /* __cplusplus */
+
+#if __cplusplus < 202002L
+#define NODISCARD
+#else
+#define NODISCARD [[nodiscard]]
+#endif /* __cplusplus */
+
+static void *pool_new(std::size_t size)
+{
+	void *ptr = z_cpp_new_pool_alloc(size);
+
+#if defined(__cpp_exceptions) && !defined(CONFIG_MINIMAL_LIBCPP)
+	if (ptr == nullptr) {
+		throw std::bad_alloc();
+	}
+#endif
+
+	return ptr;
+}
+
+NODISCARD void *operator new(std::size_t size)
+{
+	return pool_new(size);
+}
+
+NODISCARD void *operator new[](std::size_t size)
+{
+	return pool_new(size);
+}
+
+NODISCARD void *operator new(std::size_t size, const std::nothrow_t &) NOEXCEPT
+{
+	return z_cpp_new_pool_alloc(size);
+}
+
+NODISCARD void *operator new[](std::size_t size, const std::nothrow_t &) NOEXCEPT
+{
+	return z_cpp_new_pool_alloc(size);
+}
+
+void operator delete(void *ptr) NOEXCEPT
+{
+	z_cpp_new_pool_free(ptr);
+}
+
+void operator delete[](void *ptr) NOEXCEPT
+{
+	z_cpp_new_pool_free(ptr);
+}
+
+void operator delete(void *ptr, const std::nothrow_t &) NOEXCEPT
+{
+	z_cpp_new_pool_free(ptr);
+}
+
+void operator delete[](void *ptr, const std::nothrow_t &) NOEXCEPT
+{
+	z_cpp_new_pool_free(ptr);
+}
+
+#if (__cplusplus > 201103L)
+void operator delete(void *ptr, std::size_t) NOEXCEPT
+{
+	z_cpp_new_pool_free(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t) NOEXCEPT
+{
+	z_cpp_new_pool_free(ptr);
+}
+#endif /* __cplusplus > 201103L */
@@ -19,6 +19,8 @@
 #define NODISCARD [[nodiscard]]
 #endif /* __cplusplus */
 
+/* CONFIG_CPP_NEW_POOLS provides the operators that are not over-aligned */
+#if !defined(CONFIG_CPP_NEW_POOLS)
 NODISCARD void* operator new(size_t size)
 {
 	return malloc(size);
@@ -38,6 +40,7 @@ NODISCARD void* operator new[](std::size_t size, const std::nothrow_t& tag) NOEX
 {
 	return malloc(size);
 }
+#endif /* !CONFIG_CPP_NEW_POOLS */
 
 #if __cplusplus >= 201703L
 NODISCARD void* operator new(size_t size, std::align_val_t al)
@@ -63,6 +66,7 @@ NODISCARD void* operator new[](std::size_t size, std::align_val_t al,
 }
 #endif /* __cplusplus >= 201703L */
 
+#if !defined(CONFIG_CPP_NEW_POOLS)
 void operator delete(void* ptr) NOEXCEPT
 {
 	free(ptr);
@@ -84,3 +88,4 @@ void operator delete[](void* ptr, size_t) NOEXCEPT
 	free(ptr);
 }
 #endif // __cplusplus > 201103L
+#endif /* !CONFIG_CPP_NEW_POOLS */
@@ -0,0 +1,580 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/dlist.h>
+#include <zephyr/sys/hash_map.h>
+#include <zephyr/sys/hash_map_concurrent.h>
+#include <zephyr/sys/util.h>
+
+#define N_SHARDS    CONFIG_SYS_HASH_MAP_CONCURRENT_SHARDS
+#define REHASH_STEP CONFIG_SYS_HASH_MAP_CONCURRENT_REHASH_STEP
+
+struct sys_hashmap_concurrent_entry {
+	sys_dnode_t node;
+	uint64_t key;
+	uint64_t value;
+	uint32_t hash;
+};
+
+BUILD_ASSERT(offsetof(struct sys_hashmap_concurrent_data, buckets) ==
+	     offsetof(struct sys_hashmap_data, buckets));
+BUILD_ASSERT(offsetof(struct sys_hashmap_concurrent_data, n_buckets) ==
+	     offsetof(struct sys_hashmap_data, n_buckets));
+BUILD_ASSERT(offsetof(struct sys_hashmap_concurrent_data, size) ==
+	     offsetof(struct sys_hashmap_data, size));
+/* the totals over all shards are updated with atomic operations */
+BUILD_ASSERT(sizeof(size_t) == sizeof(atomic_t));
+
+static inline struct sys_hashmap_concurrent_data *cmap_data(const struct sys_hashmap *map)
+{
+	return (struct sys_hashmap_concurrent_data *)map->data;
+}
+
+static inline void cmap_total_add(size_t *total, size_t delta)
+{
+	(void)atomic_add((atomic_t *)total, (atomic_val_t)delta);
+}
+
+static inline void cmap_total_sub(size_t *total, size_t delta)
+{
+	(void)atomic_sub((atomic_t *)total, (atomic_val_t)delta);
+}
+
+/*
+ * The top bits of the hash select the shard and the bottom bits select the
+ * bucket within the shard, so that both stay uniformly distributed.
+ */
+static inline struct sys_hashmap_concurrent_shard *cmap_shard(const struct sys_hashmap *map,
+							      uint32_t hash)
+{
+	return &cmap_data(map)->shards[((uint64_t)hash * N_SHARDS) >> 32];
+}
+
+static sys_dlist_t *cmap_alloc_buckets(const struct sys_hashmap *map, size_t n_buckets)
+{
+	sys_dlist_t *buckets;
+
+	buckets = map->alloc_func(NULL, n_buckets * sizeof(*buckets));
+	if (buckets == NULL) {
+		return NULL;
+	}
+
+	for (size_t i = 0; i < n_buckets; ++i) {
+		sys_dlist_init(&buckets[i]);
+	}
+
+	return buckets;
+}
+
+static void cmap_free(const struct sys_hashmap *map, void *ptr)
+{
+	if (ptr != NULL) {
+		map->alloc_func(ptr, 0);
+	}
+}
+
+static struct sys_hashmap_concurrent_entry *cmap_find_in(sys_dlist_t *buckets, size_t n_buckets,
+							 uint32_t hash, uint64_t key)
+{
+	struct sys_hashmap_concurrent_entry *entry;
+
+	if (n_buckets == 0) {
+		return NULL;
+	}
+
+	SYS_DLIST_FOR_EACH_CONTAINER(&buckets[hash & (n_buckets - 1)], entry, node) {
+		if (entry->hash == hash && entry->key == key) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+/* must be called with the shard lock held */
+static struct sys_hashmap_concurrent_entry *
+cmap_find(const struct sys_hashmap_concurrent_shard *shard, uint32_t hash, uint64_t key)
+{
+	struct sys_hashmap_concurrent_entry *entry;
+
+	entry = cmap_find_in(shard->buckets, shard->n_buckets, hash, key);
+	if (entry == NULL && shard->old_buckets != NULL) {
+		entry = cmap_find_in(shard->old_buckets, shard->n_old_buckets, hash, key);
+	}
+
+	return entry;
+}
+
+/*
+ * Migrate up to @p n_steps buckets of the previous bucket array of @p shard.
+ *
+ * Must be called with the shard lock held. Returns the previous bucket array
+ * once it has been drained, which the caller frees after unlocking.
+ */
+static void *cmap_rehash_step(struct sys_hashmap_concurrent_shard *shard, size_t n_steps)
+{
+	sys_dnode_t *node;
+	sys_dlist_t *old_buckets = shard->old_buckets;
+	sys_dlist_t *buckets = shard->buckets;
+	struct sys_hashmap_concurrent_entry *entry;
+
+	if (old_buckets == NULL) {
+		return NULL;
+	}
+
+	for (; n_steps > 0 && shard->rehash_pos < shard->n_old_buckets;
+	     --n_steps, ++shard->rehash_pos) {
+		while ((node = sys_dlist_get(&old_buckets[shard->rehash_pos])) != NULL) {
+			entry = CONTAINER_OF(node, struct sys_hashmap_concurrent_entry, node);
+			sys_dlist_append(&buckets[entry->hash & (shard->n_buckets - 1)], node);
+		}
+	}
+
+	if (shard->rehash_pos < shard->n_old_buckets) {
+		return NULL;
+	}
+
+	shard->old_buckets = NULL;
+	shard->n_old_buckets = 0;
+	shard->rehash_pos = 0;
+
+	return old_buckets;
+}
+
+/*
+ * Make @p buckets the bucket array new entries go to, turning the current one
+ * into the array being migrated. Must be called with the shard lock held and
+ * no migration in progress.
+ */
+static void cmap_install(const struct sys_hashmap *map, struct sys_hashmap_concurrent_shard *shard,
+			 sys_dlist_t *buckets, size_t n_buckets)
+{
+	__ASSERT_NO_MSG(shard->old_buckets == NULL);
+
+	cmap_total_add(&cmap_data(map)->n_buckets, n_buckets);
+	cmap_total_sub(&cmap_data(map)->n_buckets, shard->n_buckets);
+
+	shard->old_buckets = shard->buckets;
+	shard->n_old_buckets = shard->n_buckets;
+	shard->rehash_pos = 0;
+	shard->buckets = buckets;
+	shard->n_buckets = n_buckets;
+}
+
+/*
+ * Number of buckets @p shard should have given its current size, growing and
+ * shrinking by a factor of 2. Shrinking waits until the load drops to a
+ * quarter of the load factor so that a shard does not resize back and forth.
+ * Must be called with the shard lock held.
+ */
+static size_t cmap_resize_target(const struct sys_hashmap *map,
+				 const struct sys_hashmap_concurrent_shard *shard)
+{
+	const size_t n_buckets = shard->n_buckets;
+	const size_t load_factor = map->config->load_factor;
+
+	if (n_buckets == 0) {
+		return 0;
+	}
+
+	if (shard->size * 100 > load_factor * n_buckets) {
+		return n_buckets * 2;
+	}
+
+	if (n_buckets > map->config->initial_n_buckets &&
+	    shard->size * 400 < load_factor * n_buckets) {
+		return n_buckets / 2;
+	}
+
+	return n_buckets;
+}
+
+static int cmap_resize(const struct sys_hashmap *map, struct sys_hashmap_concurrent_shard *shard,
+		       size_t n_buckets)
+{
+	void *old_buckets = NULL;
+	k_spinlock_key_t lock_key;
+	sys_dlist_t *buckets;
+
+	/* allocate outside of the lock; the shard is re-checked below */
+	buckets = cmap_alloc_buckets(map, n_buckets);
+	if (buckets == NULL) {
+		return -ENOMEM;
+	}
+
+	lock_key = k_spin_lock(&shard->lock);
+
+	if (shard->n_buckets != n_buckets && cmap_resize_target(map, shard) == n_buckets) {
+		/*
+		 * A migration still in progress is finished first. It normally
+		 * completes long before the next resize is due.
+		 */
+		old_buckets = cmap_rehash_step(shard, SIZE_MAX);
+		cmap_install(map, shard, buckets, n_buckets);
+		buckets = NULL;
+	}
+
+	k_spin_unlock(&shard->lock, lock_key);
+
+	cmap_free(map, old_buckets);
+	cmap_free(map, buckets);
+
+	return 0;
+}
+
+static void sys_hashmap_concurrent_iter_table(const struct sys_hashmap_concurrent_data *data,
+					      size_t t, sys_dlist_t **buckets, size_t *n_buckets)
+{
+	const struct sys_hashmap_concurrent_shard *shard = &data->shards[t / 2];
+
+	/* each shard contributes its previous bucket array, then its current one */
+	if (t % 2 == 0) {
+		*buckets = shard->old_buckets;
+		*n_buckets = shard->n_old_buckets;
+	} else {
+		*buckets = shard->buckets;
+		*n_buckets = shard->n_buckets;
+	}
+}
+
+static void sys_hashmap_concurrent_iter_next(struct sys_hashmap_iterator *it)
+{
+	size_t t = 0;
+	size_t n_buckets;
+	sys_dlist_t *buckets;
+	sys_dlist_t *bucket = NULL;
+	bool found_previous_key = true;
+	struct sys_hashmap_concurrent_entry *entry;
+	const struct sys_hashmap *map = it->map;
+	const struct sys_hashmap_concurrent_data *data = cmap_data(map);
+
+	__ASSERT(it->size == map->data->size, "Concurrent modification!");
+	__ASSERT(sys_hashmap_iterator_has_next(it), "Attempt to access beyond current bound!");
+
+	if (it->pos != 0) {
+		/* resume from the bucket that holds the previous key */
+		uint32_t hash = map->hash_func(&it->key, sizeof(it->key));
+		const struct sys_hashmap_concurrent_shard *shard = cmap_shard(map, hash);
+		sys_dlist_t *old_buckets = shard->old_buckets;
+
+		bucket = it->state;
+		t = 2 * (shard - data->shards) + 1;
+		if (old_buckets != NULL && bucket >= old_buckets &&
+		    bucket < &old_buckets[shard->n_old_buckets]) {
+			--t;
+		}
+		found_previous_key = false;
+	}
+
+	for (; t < 2 * N_SHARDS; ++t, bucket = NULL) {
+		sys_hashmap_concurrent_iter_table(data, t, &buckets, &n_buckets);
+		if (buckets == NULL) {
+			continue;
+		}
+
+		for (bucket = (bucket == NULL) ? buckets : bucket; bucket < &buckets[n_buckets];
+		     ++bucket) {
+			SYS_DLIST_FOR_EACH_CONTAINER(bucket, entry, node) {
+				if (!found_previous_key) {
+					if (entry->key == it->key) {
+						found_previous_key = true;
+					}
+
+					continue;
+				}
+
+				it->state = bucket;
+				it->key = entry->key;
+				it->value = entry->value;
+				++it->pos;
+
+				return;
+			}
+
+			/* only the bucket of the previous key needs to be scanned for it */
+			found_previous_key = true;
+		}
+	}
+
+	__ASSERT(false, "Entire Hashmap traversed and no entry was found");
+}
+
+/*
+ * Concurrent Hashmap API
+ */
+
+static void sys_hashmap_concurrent_iter(const struct sys_hashmap *map,
+					struct sys_hashmap_iterator *it)
+{
+	it->map = map;
+	it->next = sys_hashmap_concurrent_iter_next;
+	it->state = NULL;
+	it->key = 0;
+	it->value = 0;
+	it->pos = 0;
+	*((size_t *)&it->size) = map->data->size;
+}
+
+static void sys_hashmap_concurrent_free_buckets(struct sys_hashmap *map, sys_dlist_t *buckets,
+						size_t n_buckets, sys_hashmap_callback_t cb,
+						void *cookie)
+{
+	sys_dnode_t *node;
+	struct sys_hashmap_concurrent_entry *entry;
+
+	if (buckets == NULL) {
+		return;
+	}
+
+	for (size_t i = 0; i < n_buckets; ++i) {
+		while ((node = sys_dlist_get(&buckets[i])) != NULL) {
+			entry = CONTAINER_OF(node, struct sys_hashmap_concurrent_entry, node);
+
+			if (cb != NULL) {
+				cb(entry->key, entry->value, cookie);
+			}
+
+			map->alloc_func(entry, 0);
+		}
+	}
+
+	map->alloc_func(buckets, 0);
+}
+
+static void sys_hashmap_concurrent_clear(struct sys_hashmap *map, sys_hashmap_callback_t cb,
+					 void *cookie)
+{
+	size_t n_buckets;
+	size_t n_old_buckets;
+	sys_dlist_t *buckets;
+	sys_dlist_t *old_buckets;
+	k_spinlock_key_t lock_key;
+	struct sys_hashmap_concurrent_shard *shard;
+	struct sys_hashmap_concurrent_data *data = cmap_data(map);
+
+	for (size_t i = 0; i < N_SHARDS; ++i) {
+		shard = &data->shards[i];
+
+		/* detach the shard's entries, then free them outside of the lock */
+		lock_key = k_spin_lock(&shard->lock);
+
+		buckets = shard->buckets;
+		n_buckets = shard->n_buckets;
+		old_buckets = shard->old_buckets;
+		n_old_buckets = shard->n_old_buckets;
+		cmap_total_sub(&data->size, shard->size);
+		cmap_total_sub(&data->n_buckets, shard->n_buckets);
+		shard->buckets = NULL;
+		shard->n_buckets = 0;
+		shard->old_buckets = NULL;
+		shard->n_old_buckets = 0;
+		shard->rehash_pos = 0;
+		shard->size = 0;
+
+		k_spin_unlock(&shard->lock, lock_key);
+
+		sys_hashmap_concurrent_free_buckets(map, old_buckets, n_old_buckets, cb, cookie);
+		sys_hashmap_concurrent_free_buckets(map, buckets, n_buckets, cb, cookie);
+	}
+}
+
+static int sys_hashmap_concurrent_insert(struct sys_hashmap *map, uint64_t key, uint64_t value,
+					 uint64_t *old_value)
+{
+	int ret;
+	bool need_buckets;
+	size_t target = 0;
+	void *old_buckets = NULL;
+	k_spinlock_key_t lock_key;
+	sys_dlist_t *buckets = NULL;
+	struct sys_hashmap_concurrent_entry *entry = NULL;
+	struct sys_hashmap_concurrent_entry *found;
+	struct sys_hashmap_concurrent_data *data = cmap_data(map);
+	const uint32_t hash = map->hash_func(&key, sizeof(key));
+	struct sys_hashmap_concurrent_shard *shard = cmap_shard(map, hash);
+
+	while (true) {
+		lock_key = k_spin_lock(&shard->lock);
+
+		if (old_buckets == NULL) {
+			old_buckets = cmap_rehash_step(shard, REHASH_STEP);
+		}
+
+		found = cmap_find(shard, hash, key);
+		if (found != NULL) {
+			if (old_value != NULL) {
+				*old_value = found->value;
+			}
+
+			found->value = value;
+			ret = 0;
+			break;
+		}
+
+		if (shard->buckets == NULL && buckets != NULL) {
+			cmap_install(map, shard, buckets, map->config->initial_n_buckets);
+			buckets = NULL;
+		}
+
+		if (entry != NULL && shard->buckets != NULL) {
+			if ((size_t)atomic_inc((atomic_t *)&data->size) >= map->config->max_size) {
+				(void)atomic_dec((atomic_t *)&data->size);
+				ret = -ENOSPC;
+				break;
+			}
+
+			entry->key = key;
+			entry->value = value;
+			entry->hash = hash;
+			sys_dlist_append(&((sys_dlist_t *)shard->buckets)[hash & (shard->n_buckets - 1)],
+					 &entry->node);
+			entry = NULL;
+			++shard->size;
+
+			target = cmap_resize_target(map, shard);
+			if (target == shard->n_buckets) {
+				target = 0;
+			}
+
+			ret = 1;
+			break;
+		}
+
+		need_buckets = shard->buckets == NULL;
+
+		k_spin_unlock(&shard->lock, lock_key);
+
+		/* allocations are made outside of the lock before trying again */
+		if (entry == NULL) {
+			entry = map->alloc_func(NULL, sizeof(*entry));
+			if (entry == NULL) {
+				ret = -ENOMEM;
+				goto out;
+			}
+			sys_dnode_init(&entry->node);
+		}
+
+		if (need_buckets && buckets == NULL) {
+			buckets = cmap_alloc_buckets(map, map->config->initial_n_buckets);
+			if (buckets == NULL) {
+				ret = -ENOMEM;
+				goto out;
+			}
+		}
+	}
+
+	k_spin_unlock(&shard->lock, lock_key);
+
+out:
+	cmap_free(map, old_buckets);
+	cmap_free(map, buckets);
+	cmap_free(map, entry);
+
+	if (target != 0) {
+		/* the entry is in place; a failed resize only leaves longer chains */
+		(void)cmap_resize(map, shard, target);
+	}
+
+	return ret;
+}
+
+static bool sys_hashmap_concurrent_remove(struct sys_hashmap *map, uint64_t key, uint64_t *value)
+{
+	size_t target = 0;
+	void *garbage[3] = {NULL};
+	k_spinlock_key_t lock_key;
+	struct sys_hashmap_concurrent_entry *entry;
+	struct sys_hashmap_concurrent_data *data = cmap_data(map);
+	const uint32_t hash = map->hash_func(&key, sizeof(key));
+	struct sys_hashmap_concurrent_shard *shard = cmap_shard(map, hash);
+
+	lock_key = k_spin_lock(&shard->lock);
+
+	garbage[0] = cmap_rehash_step(shard, REHASH_STEP);
+
+	entry = cmap_find(shard, hash, key);
+	if (entry != NULL) {
+		if (value != NULL) {
+			*value = entry->value;
+		}
+
+		sys_dlist_remove(&entry->node);
+		--shard->size;
+		(void)atomic_dec((atomic_t *)&data->size);
+
+		if (shard->size == 0) {
+			/* an empty shard releases its bucket arrays right away */
+			garbage[1] = shard->buckets;
+			garbage[2] = shard->old_buckets;
+			cmap_total_sub(&data->n_buckets, shard->n_buckets);
+			shard->buckets = NULL;
+			shard->n_buckets = 0;
+			shard->old_buckets = NULL;
+			shard->n_old_buckets = 0;
+			shard->rehash_pos = 0;
+		} else {
+			target = cmap_resize_target(map, shard);
+			if (target == shard->n_buckets) {
+				target = 0;
+			}
+		}
+	}
+
+	k_spin_unlock(&shard->lock, lock_key);
+
+	for (size_t i = 0; i < ARRAY_SIZE(garbage); ++i) {
+		cmap_free(map, garbage[i]);
+	}
+
+	if (entry == NULL) {
+		return false;
+	}
+
+	cmap_free(map, entry);
+
+	if (target != 0) {
+		/* ignore a possible -ENOMEM since the table will remain intact */
+		(void)cmap_resize(map, shard, target);
+	}
+
+	return true;
+}
+
+static bool sys_hashmap_concurrent_get(const struct sys_hashmap *map, uint64_t key,
+				       uint64_t *value)
+{
+	k_spinlock_key_t lock_key;
+	struct sys_hashmap_concurrent_entry *entry;
+	const uint32_t hash = map->hash_func(&key, sizeof(key));
+	struct sys_hashmap_concurrent_shard *shard = cmap_shard(map, hash);
+
+	lock_key = k_spin_lock(&shard->lock);
+
+	entry = cmap_find(shard, hash, key);
+	if (entry != NULL && value != NULL) {
+		*value = entry->value;
+	}
+
+	k_spin_unlock(&shard->lock, lock_key);
+
+	return entry != NULL;
+}
+
+const struct sys_hashmap_api sys_hashmap_concurrent_api = {
+	.iter = sys_hashmap_concurrent_iter,
+	.clear = sys_hashmap_concurrent_clear,
+	.insert = sys_hashmap_concurrent_insert,
+	.remove = sys_hashmap_concurrent_remove,
+	.get = sys_hashmap_concurrent_get,
+};
@@ -0,0 +1,509 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/hash_map.h>
+#include <zephyr/sys/hash_map_swiss.h>
+#include <zephyr/sys/math_extras.h>
+#include <zephyr/sys/util.h>
+
+/*
+ * Control bytes: a full slot stores the low 7 bits of its hash (h2), so the
+ * high bit is only set for empty and deleted slots.
+ */
+#define CTRL_EMPTY   ((uint8_t)0x80)
+#define CTRL_DELETED ((uint8_t)0xfe)
+
+/* Highest load, in hundredths, at which probe sequences stay short */
+#define SWISS_MAX_LOAD_FACTOR 87
+
+/*
+ * Group probing. A group is GROUP_WIDTH consecutive control bytes, starting
+ * at any slot. Matches are returned as a bitmask with one bit per control
+ * byte at position (i << MASK_SHIFT).
+ */
+#if defined(CONFIG_SYS_HASH_MAP_SWISS_SIMD) && defined(__SSE2__)
+#include <emmintrin.h>
+
+#define GROUP_WIDTH 16
+#define MASK_SHIFT  0
+
+typedef uint32_t group_mask_t;
+
+static inline __m128i group_load(const uint8_t *ctrl)
+{
+	return _mm_loadu_si128((const __m128i *)ctrl);
+}
+
+static inline group_mask_t group_match(const uint8_t *ctrl, uint8_t h2)
+{
+	return _mm_movemask_epi8(_mm_cmpeq_epi8(group_load(ctrl), _mm_set1_epi8((char)h2)));
+}
+
+static inline group_mask_t group_match_empty(const uint8_t *ctrl)
+{
+	return group_match(ctrl, CTRL_EMPTY);
+}
+
+static inline group_mask_t group_match_empty_or_deleted(const uint8_t *ctrl)
+{
+	return _mm_movemask_epi8(group_load(ctrl));
+}
+
+static inline unsigned int mask_leading_zeros(group_mask_t mask)
+{
+	return u32_count_leading_zeros(mask) - (32 - GROUP_WIDTH);
+}
+
+static inline unsigned int mask_trailing_zeros(group_mask_t mask)
+{
+	return u32_count_trailing_zeros(mask);
+}
+
+#else
+
+#define GROUP_WIDTH 8
+#define MASK_SHIFT  3
+#define GROUP_LSBS  0x0101010101010101ULL
+#define GROUP_MSBS  0x8080808080808080ULL
+
+typedef uint64_t group_mask_t;
+
+#if defined(CONFIG_SYS_HASH_MAP_SWISS_SIMD) && defined(__ARM_NEON)
+#include <arm_neon.h>
+
+static inline group_mask_t group_match(const uint8_t *ctrl, uint8_t h2)
+{
+	uint8x8_t eq = vceq_u8(vld1_u8(ctrl), vdup_n_u8(h2));
+
+	return vget_lane_u64(vreinterpret_u64_u8(eq), 0) & GROUP_MSBS;
+}
+
+static inline group_mask_t group_match_empty(const uint8_t *ctrl)
+{
+	return group_match(ctrl, CTRL_EMPTY);
+}
+
+static inline group_mask_t group_match_empty_or_deleted(const uint8_t *ctrl)
+{
+	return vget_lane_u64(vreinterpret_u64_u8(vld1_u8(ctrl)), 0) & GROUP_MSBS;
+}
+
+#else /* SWAR */
+
+/*
+ * May report a false positive for a byte just above a true match; callers
+ * check the control byte and key of every candidate anyway.
+ */
+static inline group_mask_t group_match(const uint8_t *ctrl, uint8_t h2)
+{
+	uint64_t x = sys_get_le64(ctrl) ^ (GROUP_LSBS * h2);
+
+	return (x - GROUP_LSBS) & ~x & GROUP_MSBS;
+}
+
+/* EMPTY is the only control byte with the high bit set and bit 1 clear */
+static inline group_mask_t group_match_empty(const uint8_t *ctrl)
+{
+	uint64_t g = sys_get_le64(ctrl);
+
+	return g & ~(g << 6) & GROUP_MSBS;
+}
+
+static inline group_mask_t group_match_empty_or_deleted(const uint8_t *ctrl)
+{
+	return sys_get_le64(ctrl) & GROUP_MSBS;
+}
+
+#endif /* __ARM_NEON */
+
+static inline unsigned int mask_leading_zeros(group_mask_t mask)
+{
+	return u64_count_leading_zeros(mask) >> MASK_SHIFT;
+}
+
+static inline unsigned int mask_trailing_zeros(group_mask_t mask)
+{
+	return u64_count_trailing_zeros(mask) >> MASK_SHIFT;
+}
+
+#endif /* __SSE2__ */
+
+struct swiss_slot {
+	uint64_t key;
+	uint64_t value;
+};
+
+BUILD_ASSERT(offsetof(struct sys_hashmap_swiss_data, buckets) ==
+	     offsetof(struct sys_hashmap_data, buckets));
+BUILD_ASSERT(offsetof(struct sys_hashmap_swiss_data, n_buckets) ==
+	     offsetof(struct sys_hashmap_data, n_buckets));
+BUILD_ASSERT(offsetof(struct sys_hashmap_swiss_data, size) ==
+	     offsetof(struct sys_hashmap_data, size));
+
+static inline bool ctrl_is_full(uint8_t ctrl)
+{
+	return (ctrl & 0x80) == 0;
+}
+
+static inline uint8_t hash_h2(uint32_t hash)
+{
+	return hash & 0x7f;
+}
+
+static inline size_t hash_h1(uint32_t hash)
+{
+	return hash >> 7;
+}
+
+/* The control bytes follow the slots, with the first group mirrored at the end */
+static inline uint8_t *swiss_ctrl(void *buckets, size_t n_buckets)
+{
+	return (uint8_t *)&((struct swiss_slot *)buckets)[n_buckets];
+}
+
+static inline size_t swiss_alloc_size(size_t n_buckets)
+{
+	return n_buckets * sizeof(struct swiss_slot) + n_buckets + GROUP_WIDTH;
+}
+
+static inline void swiss_set_ctrl(uint8_t *ctrl, size_t n_buckets, size_t i, uint8_t c)
+{
+	ctrl[i] = c;
+	if (i < GROUP_WIDTH) {
+		ctrl[n_buckets + i] = c;
+	}
+}
+
+/*
+ * Maximum number of full and deleted slots of a table with @p n_buckets slots.
+ * It is always less than @p n_buckets, so every probe sequence reaches an
+ * empty slot.
+ */
+static inline size_t swiss_capacity(const struct sys_hashmap *map, size_t n_buckets)
+{
+	return n_buckets * MIN(map->config->load_factor, SWISS_MAX_LOAD_FACTOR) / 100;
+}
+
+/*
+ * Groups are probed quadratically: the offsets of successive groups grow by
+ * GROUP_WIDTH each time, which visits every group of a power-of-two table.
+ */
+static size_t sys_hashmap_swiss_find(const struct sys_hashmap *map, uint64_t key, uint32_t hash)
+{
+	group_mask_t match;
+	const size_t n_buckets = map->data->n_buckets;
+	const size_t mask = n_buckets - 1;
+	const uint8_t h2 = hash_h2(hash);
+	struct swiss_slot *const slots = map->data->buckets;
+	const uint8_t *ctrl;
+
+	if (n_buckets == 0) {
+		return SIZE_MAX;
+	}
+
+	ctrl = swiss_ctrl(slots, n_buckets);
+
+	for (size_t pos = hash_h1(hash) & mask, stride = 0; stride < n_buckets;
+	     stride += GROUP_WIDTH, pos = (pos + stride) & mask) {
+		for (match = group_match(&ctrl[pos], h2); match != 0; match &= match - 1) {
+			size_t i = (pos + mask_trailing_zeros(match)) & mask;
+
+			if (ctrl[i] == h2 && slots[i].key == key) {
+				return i;
+			}
+		}
+
+		if (group_match_empty(&ctrl[pos]) != 0) {
+			break;
+		}
+	}
+
+	return SIZE_MAX;
+}
+
+static size_t sys_hashmap_swiss_find_free(const uint8_t *ctrl, size_t n_buckets, uint32_t hash)
+{
+	group_mask_t match;
+	const size_t mask = n_buckets - 1;
+
+	for (size_t pos = hash_h1(hash) & mask, stride = 0;;
+	     stride += GROUP_WIDTH, pos = (pos + stride) & mask) {
+		__ASSERT(stride < n_buckets, "No free slot. Memory has been corrupted");
+
+		match = group_match_empty_or_deleted(&ctrl[pos]);
+		if (match != 0) {
+			return (pos + mask_trailing_zeros(match)) & mask;
+		}
+	}
+}
+
+static int sys_hashmap_swiss_rehash(struct sys_hashmap *map, size_t new_n_buckets)
+{
+	size_t i;
+	uint8_t *ctrl;
+	uint8_t *new_ctrl;
+	struct swiss_slot *new_slots;
+	struct sys_hashmap_swiss_data *data = (struct sys_hashmap_swiss_data *)map->data;
+	struct swiss_slot *const slots = data->buckets;
+
+	if (new_n_buckets == 0) {
+		new_slots = NULL;
+	} else {
+		new_slots = map->alloc_func(NULL, swiss_alloc_size(new_n_buckets));
+		if (new_slots == NULL) {
+			return -ENOMEM;
+		}
+
+		new_ctrl = swiss_ctrl(new_slots, new_n_buckets);
+		memset(new_ctrl, CTRL_EMPTY, new_n_buckets + GROUP_WIDTH);
+
+		/* re-insert all entries; keys are unique, so only a free slot is needed */
+		ctrl = (slots != NULL) ? swiss_ctrl(slots, data->n_buckets) : NULL;
+		for (size_t j = 0, n = 0; j < data->n_buckets && n < data->size; ++j) {
+			if (!ctrl_is_full(ctrl[j])) {
+				continue;
+			}
+
+			uint32_t hash = map->hash_func(&slots[j].key, sizeof(slots[j].key));
+
+			i = sys_hashmap_swiss_find_free(new_ctrl, new_n_buckets, hash);
+			swiss_set_ctrl(new_ctrl, new_n_buckets, i, hash_h2(hash));
+			new_slots[i] = slots[j];
+			++n;
+		}
+	}
+
+	if (slots != NULL) {
+		map->alloc_func(slots, 0);
+	}
+
+	data->buckets = new_slots;
+	data->n_buckets = new_n_buckets;
+	data->n_tombstones = 0;
+
+	return 0;
+}
+
+/* Make room for one more entry, growing or purging deleted slots as needed */
+static int sys_hashmap_swiss_reserve(struct sys_hashmap *map)
+{
+	size_t new_n_buckets;
+	struct sys_hashmap_swiss_data *data = (struct sys_hashmap_swiss_data *)map->data;
+	const size_t size = data->size + 1;
+
+	if (data->size != SIZE_MAX && data->size == map->config->max_size) {
+		return -ENOSPC;
+	}
+
+	if (data->n_buckets != 0 && size + data->n_tombstones <= swiss_capacity(map, data->n_buckets)) {
+		return 0;
+	}
+
+	if (data->n_buckets == 0) {
+		new_n_buckets = MAX(map->config->initial_n_buckets, GROUP_WIDTH);
+	} else if (size * 2 > swiss_capacity(map, data->n_buckets)) {
+		new_n_buckets = data->n_buckets * 2;
+	} else {
+		/* mostly deleted slots: rehash in place to reclaim them */
+		new_n_buckets = data->n_buckets;
+	}
+
+	while (size > swiss_capacity(map, new_n_buckets)) {
+		new_n_buckets *= 2;
+	}
+
+	return sys_hashmap_swiss_rehash(map, new_n_buckets);
+}
+
+static void sys_hashmap_swiss_iter_next(struct sys_hashmap_iterator *it)
+{
+	size_t i;
+	const struct sys_hashmap *map = (const struct sys_hashmap *)it->map;
+	struct swiss_slot *slots = map->data->buckets;
+	const uint8_t *ctrl = swiss_ctrl(slots, map->data->n_buckets);
+
+	__ASSERT(it->size == map->data->size, "Concurrent modification!");
+	__ASSERT(sys_hashmap_iterator_has_next(it), "Attempt to access beyond current bound!");
+
+	if (it->pos == 0) {
+		it->state = slots;
+	}
+
+	i = (struct swiss_slot *)it->state - slots;
+	__ASSERT(i < map->data->n_buckets, "Invalid iterator state %p", it->state);
+
+	for (; i < map->data->n_buckets; ++i) {
+		if (ctrl_is_full(ctrl[i])) {
+			it->state = &slots[i + 1];
+			it->key = slots[i].key;
+			it->value = slots[i].value;
+			++it->pos;
+			return;
+		}
+	}
+
+	__ASSERT(false, "Entire Hashmap traversed and no entry was found");
+}
+
+/*
+ * Swiss Table Hashmap API
+ */
+
+static void sys_hashmap_swiss_iter(const struct sys_hashmap *map, struct sys_hashmap_iterator *it)
+{
+	it->map = map;
+	it->next = sys_hashmap_swiss_iter_next;
+	it->pos = 0;
+	*((size_t *)&it->size) = map->data->size;
+}
+
+static void sys_hashmap_swiss_clear(struct sys_hashmap *map, sys_hashmap_callback_t cb,
+				    void *cookie)
+{
+	struct sys_hashmap_swiss_data *data = (struct sys_hashmap_swiss_data *)map->data;
+	struct swiss_slot *slots = data->buckets;
+	const uint8_t *ctrl = (slots != NULL) ? swiss_ctrl(slots, data->n_buckets) : NULL;
+
+	for (size_t i = 0, j = 0; cb != NULL && i < data->n_buckets && j < data->size; ++i) {
+		if (ctrl_is_full(ctrl[i])) {
+			cb(slots[i].key, slots[i].value, cookie);
+			++j;
+		}
+	}
+
+	if (data->buckets != NULL) {
+		map->alloc_func(data->buckets, 0);
+		data->buckets = NULL;
+	}
+
+	data->n_buckets = 0;
+	data->size = 0;
+	data->n_tombstones = 0;
+}
+
+static int sys_hashmap_swiss_insert(struct sys_hashmap *map, uint64_t key, uint64_t value,
+				    uint64_t *old_value)
+{
+	int ret;
+	size_t i;
+	uint8_t *ctrl;
+	struct swiss_slot *slots;
+	struct sys_hashmap_swiss_data *data = (struct sys_hashmap_swiss_data *)map->data;
+	const uint32_t hash = map->hash_func(&key, sizeof(key));
+
+	i = sys_hashmap_swiss_find(map, key, hash);
+	if (i != SIZE_MAX) {
+		slots = data->buckets;
+		if (old_value != NULL) {
+			*old_value = slots[i].value;
+		}
+
+		slots[i].value = value;
+
+		return 0;
+	}
+
+	ret = sys_hashmap_swiss_reserve(map);
+	if (ret < 0) {
+		return ret;
+	}
+
+	slots = data->buckets;
+	ctrl = swiss_ctrl(slots, data->n_buckets);
+	i = sys_hashmap_swiss_find_free(ctrl, data->n_buckets, hash);
+	if (ctrl[i] == CTRL_DELETED) {
+		--data->n_tombstones;
+	}
+
+	swiss_set_ctrl(ctrl, data->n_buckets, i, hash_h2(hash));
+	slots[i].key = key;
+	slots[i].value = value;
+	++data->size;
+
+	return 1;
+}
+
+static bool sys_hashmap_swiss_remove(struct sys_hashmap *map, uint64_t key, uint64_t *value)
+{
+	size_t i;
+	uint8_t *ctrl;
+	group_mask_t empty_before;
+	group_mask_t empty_after;
+	struct swiss_slot *slots;
+	struct sys_hashmap_swiss_data *data = (struct sys_hashmap_swiss_data *)map->data;
+	const size_t n_buckets = data->n_buckets;
+
+	i = sys_hashmap_swiss_find(map, key, map->hash_func(&key, sizeof(key)));
+	if (i == SIZE_MAX) {
+		return false;
+	}
+
+	slots = data->buckets;
+	ctrl = swiss_ctrl(slots, n_buckets);
+
+	if (value != NULL) {
+		*value = slots[i].value;
+	}
+
+	/*
+	 * If no group that contains slot i was ever full, no probe sequence
+	 * went past it and the slot can be marked empty instead of deleted.
+	 */
+	empty_before = group_match_empty(&ctrl[(i - GROUP_WIDTH) & (n_buckets - 1)]);
+	empty_after = group_match_empty(&ctrl[i]);
+	if (empty_before != 0 && empty_after != 0 &&
+	    mask_trailing_zeros(empty_after) + mask_leading_zeros(empty_before) < GROUP_WIDTH) {
+		swiss_set_ctrl(ctrl, n_buckets, i, CTRL_EMPTY);
+	} else {
+		swiss_set_ctrl(ctrl, n_buckets, i, CTRL_DELETED);
+		++data->n_tombstones;
+	}
+
+	--data->size;
+
+	/* ignore a possible -ENOMEM since the table will remain intact */
+	if (data->size == 0) {
+		(void)sys_hashmap_swiss_rehash(map, 0);
+	} else if (n_buckets > GROUP_WIDTH &&
+		   data->size <= swiss_capacity(map, n_buckets / 2) / 2) {
+		(void)sys_hashmap_swiss_rehash(map, n_buckets / 2);
+	}
+
+	return true;
+}
+
+static bool sys_hashmap_swiss_get(const struct sys_hashmap *map, uint64_t key, uint64_t *value)
+{
+	size_t i;
+	struct swiss_slot *slots = map->data->buckets;
+
+	i = sys_hashmap_swiss_find(map, key, map->hash_func(&key, sizeof(key)));
+	if (i == SIZE_MAX) {
+		return false;
+	}
+
+	if (value != NULL) {
+		*value = slots[i].value;
+	}
+
+	return true;
+}
+
+const struct sys_hashmap_api sys_hashmap_swiss_api = {
+	.iter = sys_hashmap_swiss_iter,
+	.clear = sys_hashmap_swiss_clear,
+	.insert = sys_hashmap_swiss_insert,
+	.remove = sys_hashmap_swiss_remove,
+	.get = sys_hashmap_swiss_get,
+};
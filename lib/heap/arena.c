@@ -0,0 +1,71 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/arena.h>
+#include <zephyr/sys/math_extras.h>
+
+/* Header of the chunks taken from the parent heap, followed by the data */
+struct sys_arena_chunk {
+	struct sys_arena_chunk *prev;
+	size_t size;
+};
+
+void *z_sys_arena_alloc_chunk(struct sys_arena *arena, size_t size, size_t align)
+{
+	struct sys_arena_chunk *chunk;
+	uint8_t *data;
+	size_t bytes;
+	uintptr_t p;
+
+	if (arena->parent == NULL) {
+		return NULL;
+	}
+
+	/* the space left in the current chunk is abandoned */
+	if (size_add_overflow(size, align - 1, &bytes)) {
+		return NULL;
+	}
+	bytes = MAX(bytes, arena->chunk_size);
+
+	chunk = k_heap_alloc(arena->parent, sizeof(*chunk) + bytes, K_NO_WAIT);
+	if (chunk == NULL) {
+		return NULL;
+	}
+
+	chunk->prev = arena->chunk;
+	chunk->size = bytes;
+	arena->chunk = chunk;
+
+	data = (uint8_t *)(chunk + 1);
+	p = ROUND_UP((uintptr_t)data, align);
+	arena->pos = (uint8_t *)p + size;
+	arena->end = data + bytes;
+
+	return (void *)p;
+}
+
+void sys_arena_rollback(struct sys_arena *arena, const struct sys_arena_mark *mark)
+{
+	struct sys_arena_chunk *chunk = arena->chunk;
+
+	while (chunk != mark->chunk) {
+		struct sys_arena_chunk *prev;
+
+		__ASSERT(chunk != NULL, "mark not in arena");
+		prev = chunk->prev;
+		k_heap_free(arena->parent, chunk);
+		chunk = prev;
+	}
+
+	arena->chunk = chunk;
+	arena->pos = mark->pos;
+	if (chunk != NULL) {
+		arena->end = (uint8_t *)(chunk + 1) + chunk->size;
+	} else {
+		arena->end = arena->buf + arena->buf_size;
+	}
+}
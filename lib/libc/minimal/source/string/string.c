@@ -24,6 +24,47 @@ typedef uintptr_t mem_word_t;
 
 #endif
 
+#if !defined(CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SIZE)
+
+#define MEM_WORD_MASK  ((uintptr_t)sizeof(mem_word_t) - 1)
+#define MEM_WORD_ONES  ((mem_word_t)-1 / 0xFF)
+#define MEM_WORD_HIGHS (MEM_WORD_ONES << 7)
+
+/*
+ * Returns non-zero if any byte of <w> is zero.
+ *
+ * strlen() reads whole aligned words past the terminator, and memcpy() with
+ * a misaligned source reads the aligned words that contain its first and
+ * last bytes, including bytes before and after the source buffer. Aligned
+ * words never cross into another page or memory protection region, so these
+ * reads are harmless, but the address sanitizer would report them. The word
+ * at a time functions are therefore not instrumented.
+ */
+static inline mem_word_t mem_word_has_zero(mem_word_t w)
+{
+#if defined(CONFIG_MINIMAL_LIBC_STRING_ZBB)
+	mem_word_t r;
+
+	/* orc.b sets every non-zero byte to 0xff */
+	__asm__ ("orc.b %0, %1" : "=r"(r) : "r"(w));
+
+	return ~r;
+#else
+	return (w - MEM_WORD_ONES) & ~w & MEM_WORD_HIGHS;
+#endif
+}
+
+#if defined(CONFIG_MINIMAL_LIBC_STRING_REP_MOVSB) && (defined(__x86_64__) || defined(__i386__))
+/*
+ * Processors with Enhanced REP MOVSB/STOSB move whole cache lines at a time,
+ * but the microcoded instructions have a startup cost that only pays off for
+ * larger blocks.
+ */
+#define REP_MOVSB_THRESHOLD 256
+#endif
+
+#endif /* !CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SIZE */
+
 /**
  *
  * @brief Copy a string
@@ -118,16 +159,36 @@ char *strrchr(const char *s, int c)
  * @return number of bytes in string <s>
  */
 
-size_t strlen(const char *s)
+__noasan size_t strlen(const char *s)
 {
-	size_t n = 0;
+	const char *p = s;
 
-	while (*s != '\0') {
-		s++;
-		n++;
+#if !defined(CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SIZE)
+	/* check bytes until word-aligned */
+
+	while (((uintptr_t)p) & MEM_WORD_MASK) {
+		if (*p == '\0') {
+			return p - s;
+		}
+		p++;
+	}
+
+	/* skip whole words without a terminator */
+
+	const mem_word_t *w = (const mem_word_t *)p;
+
+	while (mem_word_has_zero(*w) == 0) {
+		w++;
+	}
+
+	p = (const char *)w;
+#endif
+
+	while (*p != '\0') {
+		p++;
 	}
 
-	return n;
+	return p - s;
 }
 
 /**
@@ -240,6 +301,34 @@ int memcmp(const void *m1, const void *m2, size_t n)
 		return 0;
 	}
 
+#if !defined(CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SIZE)
+	/* skip equal words if buffers have identical alignment */
+
+	if ((((uintptr_t)c1 ^ (uintptr_t)c2) & MEM_WORD_MASK) == 0) {
+		while (((uintptr_t)c1) & MEM_WORD_MASK) {
+			if ((n == 1) || (*c1 != *c2)) {
+				return *c1 - *c2;
+			}
+			c1++;
+			c2++;
+			n--;
+		}
+
+		const mem_word_t *w1 = (const mem_word_t *)c1;
+		const mem_word_t *w2 = (const mem_word_t *)c2;
+
+		/* keep at least one byte for the final comparison */
+		while ((n > sizeof(mem_word_t)) && (*w1 == *w2)) {
+			w1++;
+			w2++;
+			n -= sizeof(mem_word_t);
+		}
+
+		c1 = (const char *)w1;
+		c2 = (const char *)w2;
+	}
+#endif
+
 	while ((--n > 0) && (*c1 == *c2)) {
 		c1++;
 		c2++;
@@ -290,40 +379,87 @@ void *memmove(void *d, const void *s, size_t n)
  * @return pointer to start of destination buffer
  */
 
-void *memcpy(void *ZRESTRICT d, const void *ZRESTRICT s, size_t n)
+__noasan void *memcpy(void *ZRESTRICT d, const void *ZRESTRICT s, size_t n)
 {
-	/* attempt word-sized copying only if buffers have identical alignment */
-
 	unsigned char *d_byte = (unsigned char *)d;
 	const unsigned char *s_byte = (const unsigned char *)s;
 
 #if !defined(CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SIZE)
-	const uintptr_t mask = sizeof(mem_word_t) - 1;
+#if defined(REP_MOVSB_THRESHOLD)
+	if (n >= REP_MOVSB_THRESHOLD) {
+		__asm__ volatile("rep movsb"
+				 : "+D"(d_byte), "+S"(s_byte), "+c"(n)
+				 :
+				 : "memory");
+		return d;
+	}
+#endif
 
-	if ((((uintptr_t)d ^ (uintptr_t)s_byte) & mask) == 0) {
+	/* small copies are not worth aligning */
 
-		/* do byte-sized copying until word-aligned or finished */
+	if (n >= 2 * sizeof(mem_word_t)) {
 
-		while (((uintptr_t)d_byte) & mask) {
-			if (n == 0) {
-				return d;
-			}
+		/* do byte-sized copying until destination is word-aligned */
+
+		while (((uintptr_t)d_byte) & MEM_WORD_MASK) {
 			*(d_byte++) = *(s_byte++);
 			n--;
 		}
 
-		/* do word-sized copying as long as possible */
-
 		mem_word_t *d_word = (mem_word_t *)d_byte;
-		const mem_word_t *s_word = (const mem_word_t *)s_byte;
+		mem_word_t *d_start = d_word;
+
+		if ((((uintptr_t)s_byte) & MEM_WORD_MASK) == 0) {
+			const mem_word_t *s_word = (const mem_word_t *)s_byte;
+
+			/* unrolled so that load/store multiple instructions can be used */
+
+			while (n >= 4 * sizeof(mem_word_t)) {
+				mem_word_t w0 = s_word[0];
+				mem_word_t w1 = s_word[1];
+				mem_word_t w2 = s_word[2];
+				mem_word_t w3 = s_word[3];
+
+				d_word[0] = w0;
+				d_word[1] = w1;
+				d_word[2] = w2;
+				d_word[3] = w3;
+				d_word += 4;
+				s_word += 4;
+				n -= 4 * sizeof(mem_word_t);
+			}
 
-		while (n >= sizeof(mem_word_t)) {
-			*(d_word++) = *(s_word++);
-			n -= sizeof(mem_word_t);
+			while (n >= sizeof(mem_word_t)) {
+				*(d_word++) = *(s_word++);
+				n -= sizeof(mem_word_t);
+			}
+		} else {
+			/*
+			 * Source is not word-aligned: read aligned source words
+			 * and shift two of them into every destination word,
+			 * which avoids unaligned accesses.
+			 */
+			const unsigned int lo = (((uintptr_t)s_byte) & MEM_WORD_MASK) * 8U;
+			const unsigned int hi = Z_MEM_WORD_T_WIDTH - lo;
+			const mem_word_t *s_word =
+				(const mem_word_t *)((uintptr_t)s_byte & ~MEM_WORD_MASK);
+			mem_word_t prev = *(s_word++);
+
+			while (n >= sizeof(mem_word_t)) {
+				mem_word_t next = *(s_word++);
+
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+				*(d_word++) = (prev >> lo) | (next << hi);
+#else
+				*(d_word++) = (prev << lo) | (next >> hi);
+#endif
+				prev = next;
+				n -= sizeof(mem_word_t);
+			}
 		}
 
+		s_byte += (d_word - d_start) * sizeof(mem_word_t);
 		d_byte = (unsigned char *)d_word;
-		s_byte = (unsigned char *)s_word;
 	}
 #endif
 
@@ -352,7 +488,17 @@ void *memset(void *buf, int c, size_t n)
 	unsigned char c_byte = (unsigned char)c;
 
 #if !defined(CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SIZE)
-	while (((uintptr_t)d_byte) & (sizeof(mem_word_t) - 1)) {
+#if defined(REP_MOVSB_THRESHOLD)
+	if (n >= REP_MOVSB_THRESHOLD) {
+		__asm__ volatile("rep stosb"
+				 : "+D"(d_byte), "+c"(n)
+				 : "a"(c_byte)
+				 : "memory");
+		return buf;
+	}
+#endif
+
+	while (((uintptr_t)d_byte) & MEM_WORD_MASK) {
 		if (n == 0) {
 			return buf;
 		}
@@ -371,6 +517,15 @@ void *memset(void *buf, int c, size_t n)
 	c_word |= c_word << 32;
 #endif
 
+	while (n >= 4 * sizeof(mem_word_t)) {
+		d_word[0] = c_word;
+		d_word[1] = c_word;
+		d_word[2] = c_word;
+		d_word[3] = c_word;
+		d_word += 4;
+		n -= 4 * sizeof(mem_word_t);
+	}
+
 	while (n >= sizeof(mem_word_t)) {
 		*(d_word++) = c_word;
 		n -= sizeof(mem_word_t);
@@ -396,11 +551,35 @@ void *memset(void *buf, int c, size_t n)
  * @return pointer to start of found byte
  */
 
-void *memchr(const void *s, int c, size_t n)
+__noasan void *memchr(const void *s, int c, size_t n)
 {
-	if (n != 0) {
-		const unsigned char *p = s;
+	const unsigned char *p = s;
+
+#if !defined(CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SIZE)
+	/* check bytes until word-aligned */
+
+	while ((n > 0) && (((uintptr_t)p) & MEM_WORD_MASK)) {
+		if (*p == (unsigned char)c) {
+			return (void *)p;
+		}
+		p++;
+		n--;
+	}
+
+	/* skip whole words without a match */
+
+	const mem_word_t *w = (const mem_word_t *)p;
+	const mem_word_t pattern = MEM_WORD_ONES * (unsigned char)c;
 
+	while ((n >= sizeof(mem_word_t)) && (mem_word_has_zero(*w ^ pattern) == 0)) {
+		w++;
+		n -= sizeof(mem_word_t);
+	}
+
+	p = (const unsigned char *)w;
+#endif
+
+	if (n != 0) {
 		do {
 			if (*p++ == (unsigned char)c) {
 				return ((void *)(p - 1));
@@ -13,6 +13,11 @@
 #include <zephyr/init.h>
 #include <string.h>
 
+/* Number of blocks handled under a single lock by sys_mem_blocks_alloc()
+ * and sys_mem_blocks_free(), bounded to limit stack usage.
+ */
+#define SYS_MEM_BLOCKS_BATCH 16
+
 static void *alloc_blocks(sys_mem_blocks_t *mem_block, size_t num_blocks)
 {
 	size_t offset;
@@ -126,8 +131,11 @@ out:
 int sys_mem_blocks_alloc(sys_mem_blocks_t *mem_block, size_t count,
 			 void **out_blocks)
 {
+	size_t offsets[SYS_MEM_BLOCKS_BATCH];
+	size_t done = 0;
+	size_t batch;
 	int ret = 0;
-	int i;
+	int r;
 
 	__ASSERT_NO_MSG(mem_block != NULL);
 	__ASSERT_NO_MSG(out_blocks != NULL);
@@ -145,25 +153,51 @@ int sys_mem_blocks_alloc(sys_mem_blocks_t *mem_block, size_t count,
 		goto out;
 	}
 
-	for (i = 0; i < count; i++) {
-		void *ptr = alloc_blocks(mem_block, 1);
+	while (done < count) {
+		batch = MIN(count - done, ARRAY_SIZE(offsets));
+
+#ifdef CONFIG_SYS_MEM_BLOCKS_RUNTIME_STATS
+		k_spinlock_key_t  key = k_spin_lock(&mem_block->lock);
+#endif
+
+		r = sys_bitarray_alloc_bits(mem_block->bitmap, batch, offsets);
+
+#ifdef CONFIG_SYS_MEM_BLOCKS_RUNTIME_STATS
+		if (r == 0) {
+			mem_block->info.used_blocks += (uint32_t)batch;
+
+			if (mem_block->info.max_used_blocks < mem_block->info.used_blocks) {
+				mem_block->info.max_used_blocks = mem_block->info.used_blocks;
+			}
+		}
+
+		k_spin_unlock(&mem_block->lock, key);
+#endif
 
-		if (ptr == NULL) {
+		if (r != 0) {
 			break;
 		}
 
-		out_blocks[i] = ptr;
+		for (size_t i = 0; i < batch; i++) {
+			void *ptr = mem_block->buffer + (offsets[i] << mem_block->info.blk_sz_shift);
+
+			out_blocks[done + i] = ptr;
 
 #ifdef CONFIG_SYS_MEM_BLOCKS_LISTENER
-		heap_listener_notify_alloc(HEAP_ID_FROM_POINTER(mem_block),
-					   ptr,
-					   BIT(mem_block->info.blk_sz_shift));
+			heap_listener_notify_alloc(HEAP_ID_FROM_POINTER(mem_block),
+						   ptr,
+						   BIT(mem_block->info.blk_sz_shift));
 #endif
+		}
+
+		done += batch;
 	}
 
 	/* If error, free already allocated blocks. */
-	if (i < count) {
-		(void)sys_mem_blocks_free(mem_block, i, out_blocks);
+	if (done < count) {
+		if (done > 0) {
+			(void)sys_mem_blocks_free(mem_block, done, out_blocks);
+		}
 		ret = -ENOMEM;
 	}
 
@@ -249,11 +283,98 @@ out:
 }
 
 
+static int free_blocks_one_by_one(sys_mem_blocks_t *mem_block, size_t count,
+				  void **in_blocks)
+{
+	int ret = 0;
+
+	for (size_t i = 0; i < count; i++) {
+		void *ptr = in_blocks[i];
+
+		int r = free_blocks(mem_block, ptr, 1);
+
+		if (r != 0) {
+			ret = r;
+		}
+#ifdef CONFIG_SYS_MEM_BLOCKS_LISTENER
+		else {
+			/*
+			 * Since we do not keep track of failed free ops,
+			 * we need to notify free one-by-one, instead of
+			 * notifying at the end of function.
+			 */
+			heap_listener_notify_free(HEAP_ID_FROM_POINTER(mem_block),
+						  ptr, BIT(mem_block->info.blk_sz_shift));
+		}
+#endif
+	}
+
+	return ret;
+}
+
+static int free_blocks_batch(sys_mem_blocks_t *mem_block, size_t count,
+			     void **in_blocks)
+{
+	size_t offsets[SYS_MEM_BLOCKS_BATCH];
+	uint8_t *blk;
+	int ret;
+
+	__ASSERT_NO_MSG(count <= ARRAY_SIZE(offsets));
+
+	for (size_t i = 0; i < count; i++) {
+		blk = in_blocks[i];
+
+		/* Make sure incoming block is within the mem_block buffer */
+		if (blk < mem_block->buffer) {
+			goto one_by_one;
+		}
+
+		offsets[i] = (blk - mem_block->buffer) >> mem_block->info.blk_sz_shift;
+		if (offsets[i] >= mem_block->info.num_blocks) {
+			goto one_by_one;
+		}
+	}
+
+#ifdef CONFIG_SYS_MEM_BLOCKS_RUNTIME_STATS
+	k_spinlock_key_t  key = k_spin_lock(&mem_block->lock);
+#endif
+
+	ret = sys_bitarray_free_bits(mem_block->bitmap, count, offsets);
+
+#ifdef CONFIG_SYS_MEM_BLOCKS_RUNTIME_STATS
+	if (ret == 0) {
+		mem_block->info.used_blocks -= (uint32_t)count;
+	}
+
+	k_spin_unlock(&mem_block->lock, key);
+#endif
+
+	if (ret != 0) {
+		goto one_by_one;
+	}
+
+#ifdef CONFIG_SYS_MEM_BLOCKS_LISTENER
+	for (size_t i = 0; i < count; i++) {
+		heap_listener_notify_free(HEAP_ID_FROM_POINTER(mem_block),
+					  in_blocks[i], BIT(mem_block->info.blk_sz_shift));
+	}
+#endif
+
+	return 0;
+
+one_by_one:
+	/* The batch frees nothing on error, so fall back to freeing the
+	 * valid pointers individually and report the error.
+	 */
+	return free_blocks_one_by_one(mem_block, count, in_blocks);
+}
+
 int sys_mem_blocks_free(sys_mem_blocks_t *mem_block, size_t count,
 			void **in_blocks)
 {
+	size_t batch;
 	int ret = 0;
-	int i;
+	int r;
 
 	__ASSERT_NO_MSG(mem_block != NULL);
 	__ASSERT_NO_MSG(in_blocks != NULL);
@@ -270,25 +391,13 @@ int sys_mem_blocks_free(sys_mem_blocks_t *mem_block, size_t count,
 		goto out;
 	}
 
-	for (i = 0; i < count; i++) {
-		void *ptr = in_blocks[i];
-
-		int r = free_blocks(mem_block, ptr, 1);
+	for (size_t i = 0; i < count; i += batch) {
+		batch = MIN(count - i, SYS_MEM_BLOCKS_BATCH);
 
+		r = free_blocks_batch(mem_block, batch, &in_blocks[i]);
 		if (r != 0) {
 			ret = r;
 		}
-#ifdef CONFIG_SYS_MEM_BLOCKS_LISTENER
-		else {
-			/*
-			 * Since we do not keep track of failed free ops,
-			 * we need to notify free one-by-one, instead of
-			 * notifying at the end of function.
-			 */
-			heap_listener_notify_free(HEAP_ID_FROM_POINTER(mem_block),
-						  ptr, BIT(mem_block->info.blk_sz_shift));
-		}
-#endif
 	}
 
 out:
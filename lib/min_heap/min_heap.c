@@ -10,6 +10,21 @@
 
 LOG_MODULE_REGISTER(min_heap);
 
+#define ARITY CONFIG_MIN_HEAP_ARITY
+
+/**
+ * @brief Report the index of the element stored at the given index.
+ *
+ * @param heap Pointer to the min-heap.
+ * @param index Index of the element that moved.
+ */
+static inline void report_index(struct min_heap *heap, size_t index)
+{
+	if (heap->index_cb != NULL) {
+		heap->index_cb(min_heap_get_element(heap, index), index);
+	}
+}
+
 /**
  * @brief Restore heap order by moving a node up the tree.
  *
@@ -18,11 +33,13 @@ LOG_MODULE_REGISTER(min_heap);
  *
  * @param heap Pointer to the min-heap.
  * @param index Index of the node to heapify upwards.
+ *
+ * @return Final index of the node.
  */
-static void heapify_up(struct min_heap *heap, size_t index)
+static size_t heapify_up(struct min_heap *heap, size_t index)
 {
 	while (index > 0) {
-		size_t parent = (index - 1) / 2;
+		size_t parent = (index - 1) / ARITY;
 		void *curr = min_heap_get_element(heap, index);
 		void *par = min_heap_get_element(heap, parent);
 
@@ -30,42 +47,42 @@ static void heapify_up(struct min_heap *heap, size_t index)
 			break;
 		}
 		byteswp(curr, par, heap->elem_size);
+		report_index(heap, index);
 		index = parent;
 	}
+
+	return index;
 }
 
 /**
  * @brief Restore heap order by moving a node down the tree.
  *
  * Moves the node at the specified index downward in the heap until the
- * min-heap property is restored.
+ * min-heap property is restored. With more than two children per node,
+ * the children of a node are adjacent in memory, so finding the smallest
+ * one costs fewer cache misses than the extra tree levels would.
  *
  * @param heap Pointer to the min-heap.
  * @param index Index of the node to heapify downward.
+ *
+ * @return Final index of the node.
  */
-
-static void heapify_down(struct min_heap *heap, size_t index)
+static size_t heapify_down(struct min_heap *heap, size_t index)
 {
-	/* Terminate the loop naturally when the left child is out of bounds */
-	for (size_t left = 2 * index + 1; left < heap->size; left = 2 * index + 1) {
+	/* Terminate the loop naturally when the first child is out of bounds */
+	for (size_t first = ARITY * index + 1; first < heap->size; first = ARITY * index + 1) {
 
-		size_t right = left + 1;
+		size_t last = MIN(first + ARITY, heap->size);
 		size_t smallest = index;
 		void *elem_index = min_heap_get_element(heap, index);
-		void *elem_left = min_heap_get_element(heap, left);
 		void *elem_smallest = elem_index;
 
-		if (heap->cmp(elem_left, elem_index) < 0) {
-			smallest = left;
-			elem_smallest = elem_left;
-		}
+		for (size_t child = first; child < last; child++) {
+			void *elem_child = min_heap_get_element(heap, child);
 
-		if (right < heap->size) {
-			void *elem_right = min_heap_get_element(heap, right);
-
-			if (heap->cmp(elem_right, elem_smallest) < 0) {
-				smallest = right;
-				elem_smallest = elem_right;
+			if (heap->cmp(elem_child, elem_smallest) < 0) {
+				smallest = child;
+				elem_smallest = elem_child;
 			}
 		}
 
@@ -74,10 +91,29 @@ static void heapify_down(struct min_heap *heap, size_t index)
 		}
 
 		byteswp(elem_index, elem_smallest, heap->elem_size);
+		report_index(heap, index);
 		index = smallest;
 	}
+
+	return index;
 }
 
+/**
+ * @brief Move a node to its place and report where it ended up.
+ *
+ * @param heap Pointer to the min-heap.
+ * @param index Index of the node whose ordering may be wrong.
+ */
+static void heapify(struct min_heap *heap, size_t index)
+{
+	size_t moved = heapify_up(heap, index);
+
+	if (moved == index) {
+		moved = heapify_down(heap, index);
+	}
+
+	report_index(heap, moved);
+}
 
 void min_heap_init(struct min_heap *heap, void *storage, size_t cap,
 		   size_t elem_size, min_heap_cmp_t cmp)
@@ -86,6 +122,7 @@ void min_heap_init(struct min_heap *heap, void *storage, size_t cap,
 	heap->capacity = cap;
 	heap->elem_size = elem_size;
 	heap->cmp = cmp;
+	heap->index_cb = NULL;
 	heap->size = 0;
 }
 
@@ -107,8 +144,8 @@ int min_heap_push(struct min_heap *heap, const void *item)
 	void *dest = min_heap_get_element(heap, heap->size);
 
 	memcpy(dest, item, heap->elem_size);
-	heapify_up(heap, heap->size);
 	heap->size++;
+	report_index(heap, heapify_up(heap, heap->size - 1));
 
 	return 0;
 }
@@ -127,13 +164,27 @@ bool min_heap_remove(struct min_heap *heap, size_t id, void *out_buf)
 		void *last = min_heap_get_element(heap, heap->size);
 
 		memcpy(removed, last, heap->elem_size);
-		heapify_down(heap, id);
-		heapify_up(heap, id);
+		heapify(heap, id);
+	}
+
+	if (heap->index_cb != NULL) {
+		heap->index_cb(out_buf, MIN_HEAP_INDEX_NONE);
 	}
 
 	return true;
 }
 
+bool min_heap_update(struct min_heap *heap, size_t id)
+{
+	if (id >= heap->size) {
+		return false;
+	}
+
+	heapify(heap, id);
+
+	return true;
+}
+
 bool min_heap_pop(struct min_heap *heap, void *out_buf)
 {
 	return min_heap_remove(heap, 0, out_buf);
@@ -0,0 +1,122 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/sys/__assert.h>
+#include <zephyr/sys/math_extras.h>
+#include <zephyr/sys/radix_heap.h>
+
+/**
+ * @brief Get the bucket a key belongs to.
+ *
+ * @param heap Pointer to the radix heap.
+ * @param key Key, not lower than the last popped key.
+ *
+ * @return 0 if @p key equals the last popped key, otherwise one plus the
+ *         index of the highest bit in which they differ.
+ */
+static inline unsigned int bucket_of(const struct radix_heap *heap, uint64_t key)
+{
+	return 64U - u64_count_leading_zeros(key ^ heap->last);
+}
+
+static void bucket_add(struct radix_heap *heap, struct radix_heap_node *node)
+{
+	unsigned int b = bucket_of(heap, node->key);
+
+	sys_dlist_append(&heap->buckets[b], &node->node);
+	if (b > 0U) {
+		heap->mask |= BIT64(b - 1U);
+	}
+}
+
+void radix_heap_init(struct radix_heap *heap, uint64_t start)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(heap->buckets); i++) {
+		sys_dlist_init(&heap->buckets[i]);
+	}
+	heap->mask = 0U;
+	heap->last = start;
+	heap->size = 0;
+}
+
+void radix_heap_push(struct radix_heap *heap, struct radix_heap_node *node, uint64_t key)
+{
+	__ASSERT(key >= heap->last, "key %llu below last popped key %llu",
+		 (unsigned long long)key, (unsigned long long)heap->last);
+
+	node->key = key;
+	bucket_add(heap, node);
+	heap->size++;
+}
+
+void radix_heap_remove(struct radix_heap *heap, struct radix_heap_node *node)
+{
+	unsigned int b = bucket_of(heap, node->key);
+
+	sys_dlist_remove(&node->node);
+	if (b > 0U && sys_dlist_is_empty(&heap->buckets[b])) {
+		heap->mask &= ~BIT64(b - 1U);
+	}
+	heap->size--;
+}
+
+/* Lowest non-empty bucket above bucket 0, which must be empty */
+static inline sys_dlist_t *lowest_bucket(struct radix_heap *heap)
+{
+	return &heap->buckets[u64_count_trailing_zeros(heap->mask) + 1U];
+}
+
+struct radix_heap_node *radix_heap_peek(struct radix_heap *heap)
+{
+	struct radix_heap_node *n, *min = NULL;
+
+	if (!sys_dlist_is_empty(&heap->buckets[0]) || heap->mask == 0U) {
+		return SYS_DLIST_PEEK_HEAD_CONTAINER(&heap->buckets[0], n, node);
+	}
+
+	SYS_DLIST_FOR_EACH_CONTAINER(lowest_bucket(heap), n, node) {
+		if (min == NULL || n->key < min->key) {
+			min = n;
+		}
+	}
+
+	return min;
+}
+
+struct radix_heap_node *radix_heap_pop(struct radix_heap *heap)
+{
+	struct radix_heap_node *n, *tmp;
+	sys_dlist_t *bucket;
+	uint64_t min = UINT64_MAX;
+
+	if (sys_dlist_is_empty(&heap->buckets[0]) && heap->mask != 0U) {
+		/* The lowest key of the first non-empty bucket becomes the new
+		 * last key. Every other key of that bucket then differs from it
+		 * in a lower bit, and keys of higher buckets keep their bucket.
+		 */
+		bucket = lowest_bucket(heap);
+
+		SYS_DLIST_FOR_EACH_CONTAINER(bucket, n, node) {
+			min = MIN(min, n->key);
+		}
+
+		heap->mask &= ~BIT64(u64_count_trailing_zeros(heap->mask));
+		heap->last = min;
+
+		SYS_DLIST_FOR_EACH_CONTAINER_SAFE(bucket, n, tmp, node) {
+			sys_dlist_remove(&n->node);
+			bucket_add(heap, n);
+		}
+	}
+
+	n = SYS_DLIST_PEEK_HEAD_CONTAINER(&heap->buckets[0], n, node);
+	if (n != NULL) {
+		sys_dlist_remove(&n->node);
+		heap->size--;
+	}
+
+	return n;
+}
@@ -471,12 +471,18 @@ int cbvprintf_package(void *packaged, size_t len, uint32_t flags,
 			}
 
 			if (!parsing) {
-				if (*fmt == '%') {
-					parsing = true;
-					arg_idx++;
-					align = VA_STACK_ALIGN(int);
-					size = sizeof(int);
+				/* Literal text carries no arguments, jump
+				 * straight to the next conversion specifier.
+				 */
+				fmt = strchr(fmt, '%');
+				if (fmt == NULL) {
+					break;
 				}
+
+				parsing = true;
+				arg_idx++;
+				align = VA_STACK_ALIGN(int);
+				size = sizeof(int);
 				continue;
 			}
 			switch (*fmt) {
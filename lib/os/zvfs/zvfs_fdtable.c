@@ -349,6 +349,22 @@ static ssize_t zvfs_rw(int fd, void *buf, size_t sz, bool is_write, const size_t
 
 	prw = supports_pread_pwrite(fdtable[fd].mode);
 	if (from_offset != NULL && !prw) {
+		/*
+		 * Files keep their own position, so give the backend a chance to
+		 * transfer at an offset without moving it.
+		 */
+		if (fdtable[fd].vtable->ioctl != NULL) {
+			int prev_errno = errno;
+
+			res = zvfs_fdtable_call_ioctl(fdtable[fd].vtable, fdtable[fd].obj,
+						      is_write ? ZFD_IOCTL_PWRITE : ZFD_IOCTL_PREAD,
+						      buf, sz, (off_t)*from_offset);
+			if (res >= 0 || errno != EOPNOTSUPP) {
+				goto unlock;
+			}
+			errno = prev_errno;
+		}
+
 		/*
 		 * Seekable file types should support pread() / pwrite() and per-fd offset passing.
 		 * Otherwise, it's a bug.
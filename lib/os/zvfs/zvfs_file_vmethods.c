@@ -71,6 +71,24 @@ int zvfs_ioctl_vmeth(void *obj, unsigned int request, va_list args)
 		}
 		break;
 	}
+#if defined(CONFIG_FILE_SYSTEM_VECTORED_IO)
+	case ZFD_IOCTL_PREAD: {
+		void *buf = va_arg(args, void *);
+		size_t count = va_arg(args, size_t);
+		off_t offset = va_arg(args, off_t);
+
+		rc = fs_pread(ptr, buf, count, offset);
+		break;
+	}
+	case ZFD_IOCTL_PWRITE: {
+		const void *buf = va_arg(args, const void *);
+		size_t count = va_arg(args, size_t);
+		off_t offset = va_arg(args, off_t);
+
+		rc = fs_pwrite(ptr, buf, count, offset);
+		break;
+	}
+#endif
 	default:
 		errno = EOPNOTSUPP;
 		return -1;
@@ -574,6 +574,63 @@ out:
 	return ret;
 }
 
+int sys_bitarray_alloc_bits(sys_bitarray_t *bitarray, size_t count, size_t *offsets)
+{
+	k_spinlock_key_t key;
+	uint32_t free_bits;
+	size_t bit, n = 0;
+	int ret;
+
+	__ASSERT_NO_MSG(bitarray != NULL);
+	__ASSERT_NO_MSG(bitarray->num_bits > 0);
+
+	key = k_spin_lock(&bitarray->lock);
+
+	CHECKIF(offsets == NULL) {
+		ret = -EINVAL;
+		goto out;
+	}
+
+	if ((count == 0) || (count > bitarray->num_bits)) {
+		ret = -EINVAL;
+		goto out;
+	}
+
+	/* Collect free bits a whole bundle at a time, skipping bundles
+	 * which are fully allocated.
+	 */
+	for (size_t idx = 0; (idx < bitarray->num_bundles) && (n < count); idx++) {
+		free_bits = ~bitarray->bundles[idx];
+
+		while ((free_bits != 0U) && (n < count)) {
+			bit = idx * bundle_bitness(bitarray) + find_lsb_set(free_bits) - 1;
+			if (bit >= bitarray->num_bits) {
+				/* Padding bits of the last bundle */
+				break;
+			}
+
+			offsets[n++] = bit;
+			free_bits &= free_bits - 1U;
+		}
+	}
+
+	if (n < count) {
+		ret = -ENOSPC;
+		goto out;
+	}
+
+	for (n = 0; n < count; n++) {
+		bitarray->bundles[offsets[n] / bundle_bitness(bitarray)] |=
+			BIT(offsets[n] % bundle_bitness(bitarray));
+	}
+
+	ret = 0;
+
+out:
+	k_spin_unlock(&bitarray->lock, key);
+	return ret;
+}
+
 int sys_bitarray_find_nth_set(sys_bitarray_t *bitarray, size_t n, size_t num_bits, size_t offset,
 			      size_t *found_at)
 {
@@ -695,6 +752,60 @@ out:
 	return ret;
 }
 
+int sys_bitarray_free_bits(sys_bitarray_t *bitarray, size_t count, const size_t *offsets)
+{
+	k_spinlock_key_t key;
+	size_t idx, n;
+	uint32_t mask;
+	int ret;
+
+	__ASSERT_NO_MSG(bitarray != NULL);
+	__ASSERT_NO_MSG(bitarray->num_bits > 0);
+
+	key = k_spin_lock(&bitarray->lock);
+
+	CHECKIF(offsets == NULL) {
+		ret = -EINVAL;
+		goto out;
+	}
+
+	if ((count == 0) || (count > bitarray->num_bits)) {
+		ret = -EINVAL;
+		goto out;
+	}
+
+	ret = 0;
+	for (n = 0; n < count; n++) {
+		if (offsets[n] >= bitarray->num_bits) {
+			ret = -EINVAL;
+			break;
+		}
+
+		idx = offsets[n] / bundle_bitness(bitarray);
+		mask = BIT(offsets[n] % bundle_bitness(bitarray));
+
+		/* Clearing as we go also catches the same bit listed twice */
+		if ((bitarray->bundles[idx] & mask) == 0U) {
+			ret = -EFAULT;
+			break;
+		}
+
+		bitarray->bundles[idx] &= ~mask;
+	}
+
+	if (ret != 0) {
+		/* Leave the bit array untouched on error */
+		while (n-- > 0) {
+			bitarray->bundles[offsets[n] / bundle_bitness(bitarray)] |=
+				BIT(offsets[n] % bundle_bitness(bitarray));
+		}
+	}
+
+out:
+	k_spin_unlock(&bitarray->lock, key);
+	return ret;
+}
+
 static bool is_region_set_clear(sys_bitarray_t *bitarray, size_t num_bits,
 				size_t offset, bool to_set)
 {
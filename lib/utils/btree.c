@@ -0,0 +1,376 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Single-pass B-tree insertion and deletion as described in Cormen et al.,
+ * "Introduction to Algorithms", chapter 18: nodes are split on the way down
+ * before they could overflow, and refilled from a sibling before they could
+ * underflow, so neither operation ever walks back up the tree.
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/sys/__assert.h>
+#include <zephyr/sys/btree.h>
+
+#define T           CONFIG_BTREE_MIN_DEGREE
+#define MAX_ENTRIES Z_BTREE_MAX_ENTRIES
+
+BUILD_ASSERT(T >= 2, "B-tree minimum degree must be at least 2");
+BUILD_ASSERT(MAX_ENTRIES <= UINT8_MAX, "B-tree minimum degree too large");
+
+static inline uint64_t make_sort_key(int32_t key, uint32_t seq)
+{
+	/* flipping the sign bit makes signed keys sort as unsigned */
+	return ((uint64_t)((uint32_t)key ^ BIT(31)) << 32) | seq;
+}
+
+static struct btree_node *node_alloc(struct btree *tree, bool leaf)
+{
+	struct btree_node *x = tree->free;
+
+	if (x != NULL) {
+		tree->free = x->children[0];
+	} else if (tree->pool_left > 0) {
+		x = tree->pool++;
+		tree->pool_left--;
+	} else {
+		return NULL;
+	}
+
+	x->n = 0;
+	x->leaf = leaf;
+
+	return x;
+}
+
+static void node_free(struct btree *tree, struct btree_node *x)
+{
+	x->children[0] = tree->free;
+	tree->free = x;
+}
+
+/* Index of the first key greater than k */
+static unsigned int upper_bound(const struct btree_node *x, uint64_t k)
+{
+	unsigned int i = 0;
+
+	while (i < x->n && x->keys[i] <= k) {
+		i++;
+	}
+
+	return i;
+}
+
+/* Index of the first key greater than or equal to k */
+static unsigned int lower_bound(const struct btree_node *x, uint64_t k)
+{
+	unsigned int i = 0;
+
+	while (i < x->n && x->keys[i] < k) {
+		i++;
+	}
+
+	return i;
+}
+
+/* Moves entries [from, n) of x by delta positions, and the children
+ * after them when x is an internal node.
+ */
+static void shift(struct btree_node *x, unsigned int from, int delta)
+{
+	unsigned int count = x->n - from;
+
+	memmove(&x->keys[from + delta], &x->keys[from], count * sizeof(x->keys[0]));
+	memmove(&x->entries[from + delta], &x->entries[from], count * sizeof(x->entries[0]));
+	if (!x->leaf) {
+		memmove(&x->children[from + 1 + delta], &x->children[from + 1],
+			count * sizeof(x->children[0]));
+	}
+}
+
+static void copy_entry(struct btree_node *dst, unsigned int i, const struct btree_node *src,
+		       unsigned int j)
+{
+	dst->keys[i] = src->keys[j];
+	dst->entries[i] = src->entries[j];
+}
+
+/* Splits the full child i of x around its median, which moves up into x */
+static int split_child(struct btree *tree, struct btree_node *x, unsigned int i)
+{
+	struct btree_node *y = x->children[i];
+	struct btree_node *z = node_alloc(tree, y->leaf);
+
+	if (z == NULL) {
+		return -ENOMEM;
+	}
+
+	z->n = T - 1;
+	memcpy(z->keys, &y->keys[T], (T - 1) * sizeof(y->keys[0]));
+	memcpy(z->entries, &y->entries[T], (T - 1) * sizeof(y->entries[0]));
+	if (!y->leaf) {
+		memcpy(z->children, &y->children[T], T * sizeof(y->children[0]));
+	}
+	y->n = T - 1;
+
+	shift(x, i, 1);
+	copy_entry(x, i, y, T - 1);
+	x->children[i + 1] = z;
+	x->n++;
+
+	return 0;
+}
+
+/* Merges child i + 1 of x and the separating entry into child i */
+static void merge_children(struct btree *tree, struct btree_node *x, unsigned int i)
+{
+	struct btree_node *y = x->children[i];
+	struct btree_node *z = x->children[i + 1];
+
+	copy_entry(y, y->n, x, i);
+	memcpy(&y->keys[y->n + 1], z->keys, z->n * sizeof(z->keys[0]));
+	memcpy(&y->entries[y->n + 1], z->entries, z->n * sizeof(z->entries[0]));
+	if (!y->leaf) {
+		memcpy(&y->children[y->n + 1], z->children, (z->n + 1) * sizeof(z->children[0]));
+	}
+	y->n += z->n + 1;
+
+	shift(x, i + 1, -1);
+	x->n--;
+	node_free(tree, z);
+}
+
+/* Makes sure child i of x has more than the minimum number of entries,
+ * borrowing from a sibling or merging with one, and returns the child
+ * that now covers the keys of child i.
+ */
+static struct btree_node *fill_child(struct btree *tree, struct btree_node *x, unsigned int i)
+{
+	struct btree_node *c = x->children[i];
+	struct btree_node *sib;
+
+	if (c->n >= T) {
+		return c;
+	}
+
+	if (i > 0 && x->children[i - 1]->n >= T) {
+		sib = x->children[i - 1];
+		if (!c->leaf) {
+			memmove(&c->children[1], &c->children[0], (c->n + 1) * sizeof(c->children[0]));
+			c->children[0] = sib->children[sib->n];
+		}
+		memmove(&c->keys[1], &c->keys[0], c->n * sizeof(c->keys[0]));
+		memmove(&c->entries[1], &c->entries[0], c->n * sizeof(c->entries[0]));
+		copy_entry(c, 0, x, i - 1);
+		copy_entry(x, i - 1, sib, sib->n - 1);
+		sib->n--;
+		c->n++;
+		return c;
+	}
+
+	if (i < x->n && x->children[i + 1]->n >= T) {
+		sib = x->children[i + 1];
+		copy_entry(c, c->n, x, i);
+		copy_entry(x, i, sib, 0);
+		if (!c->leaf) {
+			c->children[c->n + 1] = sib->children[0];
+			memmove(&sib->children[0], &sib->children[1],
+				sib->n * sizeof(sib->children[0]));
+		}
+		memmove(&sib->keys[0], &sib->keys[1], (sib->n - 1) * sizeof(sib->keys[0]));
+		memmove(&sib->entries[0], &sib->entries[1], (sib->n - 1) * sizeof(sib->entries[0]));
+		sib->n--;
+		c->n++;
+		return c;
+	}
+
+	if (i < x->n) {
+		merge_children(tree, x, i);
+		return c;
+	}
+
+	merge_children(tree, x, i - 1);
+	return x->children[i - 1];
+}
+
+int btree_insert(struct btree *tree, struct btnode *node, int32_t key)
+{
+	uint64_t k = make_sort_key(key, tree->seq);
+	struct btree_node *x = tree->root;
+	unsigned int i;
+
+	if (x == NULL) {
+		x = node_alloc(tree, true);
+		if (x == NULL) {
+			return -ENOMEM;
+		}
+		tree->root = x;
+	} else if (x->n == MAX_ENTRIES) {
+		struct btree_node *s = node_alloc(tree, false);
+
+		if (s == NULL) {
+			return -ENOMEM;
+		}
+		s->children[0] = x;
+		if (split_child(tree, s, 0) != 0) {
+			node_free(tree, s);
+			return -ENOMEM;
+		}
+		tree->root = s;
+		x = s;
+	}
+
+	while (!x->leaf) {
+		i = upper_bound(x, k);
+		if (x->children[i]->n == MAX_ENTRIES) {
+			/* a failed split leaves a valid tree behind */
+			if (split_child(tree, x, i) != 0) {
+				return -ENOMEM;
+			}
+			if (k > x->keys[i]) {
+				i++;
+			}
+		}
+		x = x->children[i];
+	}
+
+	i = upper_bound(x, k);
+	shift(x, i, 1);
+	x->keys[i] = k;
+	x->entries[i] = node;
+	x->n++;
+
+	node->sort_key = k;
+	tree->seq++;
+	tree->size++;
+
+	return 0;
+}
+
+void btree_remove(struct btree *tree, struct btnode *node)
+{
+	uint64_t k = node->sort_key;
+	struct btree_node *x = tree->root;
+	struct btree_node *p;
+	unsigned int i;
+
+	__ASSERT(x != NULL, "node not in tree");
+
+	for (;;) {
+		i = lower_bound(x, k);
+
+		if (i < x->n && x->keys[i] == k) {
+			if (x->leaf) {
+				shift(x, i + 1, -1);
+				x->n--;
+				break;
+			}
+
+			if (x->children[i]->n >= T) {
+				/* replace with the predecessor, then delete that one */
+				p = x->children[i];
+				while (!p->leaf) {
+					p = p->children[p->n];
+				}
+				copy_entry(x, i, p, p->n - 1);
+				k = x->keys[i];
+				x = x->children[i];
+			} else if (x->children[i + 1]->n >= T) {
+				/* replace with the successor, then delete that one */
+				p = x->children[i + 1];
+				while (!p->leaf) {
+					p = p->children[0];
+				}
+				copy_entry(x, i, p, 0);
+				k = x->keys[i];
+				x = x->children[i + 1];
+			} else {
+				merge_children(tree, x, i);
+				x = x->children[i];
+			}
+			continue;
+		}
+
+		__ASSERT(!x->leaf, "node not in tree");
+		x = fill_child(tree, x, i);
+	}
+
+	/* merging the last two children of the root empties it */
+	x = tree->root;
+	if (x->n == 0) {
+		tree->root = x->leaf ? NULL : x->children[0];
+		node_free(tree, x);
+	}
+
+	tree->size--;
+}
+
+struct btnode *btree_remove_min(struct btree *tree)
+{
+	struct btnode *node = btree_get_min(tree);
+
+	if (node != NULL) {
+		btree_remove(tree, node);
+	}
+
+	return node;
+}
+
+bool btree_contains(struct btree *tree, struct btnode *node)
+{
+	uint64_t k = node->sort_key;
+	struct btree_node *x = tree->root;
+	unsigned int i;
+
+	while (x != NULL) {
+		i = lower_bound(x, k);
+		if (i < x->n && x->keys[i] == k) {
+			return x->entries[i] == node;
+		}
+		x = x->leaf ? NULL : x->children[i];
+	}
+
+	return false;
+}
+
+struct btnode *z_btree_get_minmax(struct btree *tree, bool max)
+{
+	struct btree_node *x = tree->root;
+
+	if (x == NULL) {
+		return NULL;
+	}
+
+	while (!x->leaf) {
+		x = x->children[max ? x->n : 0];
+	}
+
+	return x->entries[max ? x->n - 1 : 0];
+}
+
+struct btnode *z_btree_next(struct btree *tree, struct btnode *prev)
+{
+	struct btree_node *x = tree->root;
+	struct btnode *next = NULL;
+	unsigned int i;
+
+	if (prev == NULL) {
+		return btree_get_min(tree);
+	}
+
+	/* the successor is the last entry passed on the way down that sorts
+	 * after prev
+	 */
+	while (x != NULL) {
+		i = upper_bound(x, prev->sort_key);
+		if (i < x->n) {
+			next = x->entries[i];
+		}
+		x = x->leaf ? NULL : x->children[i];
+	}
+
+	return next;
+}
@@ -9,6 +9,7 @@
 #include <errno.h>
 #include <limits.h>
 #include <math.h>
+#include <zephyr/sys/math_extras.h>
 #include <zephyr/sys/printk.h>
 #include <zephyr/sys/util.h>
 #include <stdbool.h>
@@ -90,12 +91,28 @@ static int peek(struct json_lexer *lex)
 	return chr;
 }
 
+static void skip_string_run(struct json_lexer *lex)
+{
+	char *pos = lex->pos;
+
+	while (pos < lex->end && *pos != '"' && *pos != '\\' && *pos != '\0') {
+		pos++;
+	}
+
+	lex->pos = pos;
+}
+
 static void *lexer_string(struct json_lexer *lex)
 {
 	ignore(lex);
 
 	while (true) {
-		int chr = next(lex);
+		int chr;
+
+		/* Plain characters need no state handling, skip them in bulk */
+		skip_string_run(lex);
+
+		chr = next(lex);
 
 		if (chr == '\0') {
 			emit(lex, JSON_TOK_ERROR);
@@ -1150,55 +1167,80 @@ static int arr_data_parse(struct json_obj *obj, struct json_obj_token *val)
 	return -EINVAL;
 }
 
+/* Find the descriptor matching a key among the ones not decoded yet, by
+ * walking the bits of the pending mask. Encoders usually emit fields in
+ * descriptor order, or in reverse order, so the descriptors after the
+ * previously matched one are tried upwards first, then the ones before it
+ * downwards. Either way each key then matches on the first comparison, and
+ * decoded descriptors are never visited.
+ * return the descriptor index, or -1 if no descriptor matches.
+ */
+static int obj_find_descr(const struct json_obj_descr *descr, uint64_t pending,
+			  size_t hint, const struct json_obj_key_value *kv)
+{
+	uint64_t above = pending & ~BIT64_MASK(hint);
+	uint64_t below = pending & BIT64_MASK(hint);
+	int i;
+
+	while (above != 0U) {
+		i = u64_count_trailing_zeros(above);
+		above &= above - 1U;
+
+		if (kv->key_len == descr[i].field_name_len &&
+		    !memcmp(kv->key, descr[i].field_name, kv->key_len)) {
+			return i;
+		}
+	}
+
+	while (below != 0U) {
+		i = 63 - u64_count_leading_zeros(below);
+		below &= ~BIT64(i);
+
+		if (kv->key_len == descr[i].field_name_len &&
+		    !memcmp(kv->key, descr[i].field_name, kv->key_len)) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
 static int64_t obj_parse(struct json_obj *obj, const struct json_obj_descr *descr,
 			 size_t descr_len, void *val)
 {
 	struct json_obj_key_value kv;
 	int64_t decoded_fields = 0;
-	size_t i;
+	size_t hint = 0;
 	int ret;
+	int i;
 
 	while (!obj_next(obj, &kv)) {
 		if (kv.value.type == JSON_TOK_OBJECT_END) {
 			return decoded_fields;
 		}
 
-		for (i = 0; i < descr_len; i++) {
-			void *decode_field = (char *)val + descr[i].offset;
-
-			/* Field has been decoded already, skip */
-			if (decoded_fields & ((int64_t)1 << i)) {
-				continue;
-			}
+		i = obj_find_descr(descr, BIT64_MASK(descr_len) & ~(uint64_t)decoded_fields,
+				   hint, &kv);
 
-			/* Check if it's the i-th field */
-			if (kv.key_len != descr[i].field_name_len) {
-				continue;
-			}
-
-			if (memcmp(kv.key, descr[i].field_name,
-				   descr[i].field_name_len)) {
-				continue;
-			}
-
-			/* Store the decoded value */
-			ret = decode_value(obj, &descr[i], &kv.value,
-					   decode_field, val);
+		/* Skip field, if no descriptor was found */
+		if (i < 0) {
+			ret = skip_field(obj, &kv);
 			if (ret < 0) {
 				return ret;
 			}
 
-			decoded_fields |= (int64_t)1<<i;
-			break;
+			continue;
 		}
 
-		/* Skip field, if no descriptor was found */
-		if (i >= descr_len) {
-			ret = skip_field(obj, &kv);
-			if (ret < 0) {
-				return ret;
-			}
+		/* Store the decoded value */
+		ret = decode_value(obj, &descr[i], &kv.value,
+				   (char *)val + descr[i].offset, val);
+		if (ret < 0) {
+			return ret;
 		}
+
+		decoded_fields |= (int64_t)1<<i;
+		hint = i + 1;
 	}
 
 	return -EINVAL;
@@ -1294,6 +1336,7 @@ static int json_escape_internal(const char *str,
 				json_append_bytes_t append_bytes,
 				void *data)
 {
+	const char *run;
 	const char *cur;
 	int ret = 0;
 
@@ -1301,18 +1344,31 @@ static int json_escape_internal(const char *str,
 		return ret;
 	}
 
-	for (cur = str; ret == 0 && *cur; cur++) {
+	/* Hand runs of characters that need no escaping to the callback
+	 * in one call rather than one byte at a time.
+	 */
+	for (run = cur = str; ret == 0 && *cur; cur++) {
 		char escaped = escape_as(*cur);
 
 		if (escaped) {
 			char bytes[2] = { '\\', escaped };
 
+			if (cur > run) {
+				ret = append_bytes(run, cur - run, data);
+				if (ret) {
+					return ret;
+				}
+			}
+
 			ret = append_bytes(bytes, 2, data);
-		} else {
-			ret = append_bytes(cur, 1, data);
+			run = cur + 1;
 		}
 	}
 
+	if (ret == 0 && cur > run) {
+		ret = append_bytes(run, cur - run, data);
+	}
+
 	return ret;
 }
 
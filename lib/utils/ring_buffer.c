@@ -14,6 +14,9 @@ uint32_t ring_buf_area_claim(struct ring_buf *buf, struct ring_buf_index *ring,
 {
 	ring_buf_idx_t head_offset, wrap_size;
 
+	/* the caller sized the claim from the other side's published tail */
+	ring_buf_internal_fence();
+
 	head_offset = ring->head - ring->base;
 	if (unlikely(head_offset >= buf->size)) {
 		/* ring->base is not yet adjusted */
@@ -31,22 +34,26 @@ uint32_t ring_buf_area_claim(struct ring_buf *buf, struct ring_buf_index *ring,
 int ring_buf_area_finish(struct ring_buf *buf, struct ring_buf_index *ring,
 			 uint32_t size)
 {
-	ring_buf_idx_t claimed_size, tail_offset;
+	ring_buf_idx_t claimed_size, tail, tail_offset;
 
 	claimed_size = ring->head - ring->tail;
 	if (unlikely(size > claimed_size)) {
 		return -EINVAL;
 	}
 
-	ring->tail += size;
-	ring->head = ring->tail;
+	tail = ring->tail + size;
+	ring->head = tail;
 
-	tail_offset = ring->tail - ring->base;
+	tail_offset = tail - ring->base;
 	if (unlikely(tail_offset >= buf->size)) {
 		/* we wrapped: adjust ring->base */
 		ring->base += buf->size;
 	}
 
+	/* complete all accesses to the area before the other side may see it */
+	ring_buf_internal_fence();
+	*(volatile ring_buf_idx_t *)&ring->tail = tail;
+
 	return 0;
 }
 
@@ -232,3 +239,119 @@ int ring_buf_item_get(struct ring_buf *buf, uint16_t *type, uint8_t *value,
 
 	return 0;
 }
+
+#ifdef CONFIG_RING_BUFFER_MP
+
+#define MP_PENDING_ONE (RING_BUF_MP_IDX_MASK + 1UL)
+
+static inline unsigned long mp_pending(atomic_val_t state)
+{
+	return (unsigned long)state >> RING_BUF_MP_IDX_BITS;
+}
+
+/*
+ * Reserves up to size bytes for the caller and returns the offset of the
+ * area. The area is cut at the end of the buffer unless the whole size is
+ * required, in which case nothing is reserved if it does not fit.
+ */
+static uint32_t mp_reserve(struct ring_buf_mp *buf, uint32_t size, bool all,
+			   uint32_t *offset)
+{
+	atomic_val_t state, new_state;
+	unsigned long head;
+	uint32_t space;
+
+	do {
+		state = atomic_get(&buf->put_state);
+		head = (unsigned long)state & RING_BUF_MP_IDX_MASK;
+		space = buf->rb.size -
+			ring_buf_mp_internal_dist(state,
+						  ring_buf_internal_load(&buf->rb.get.tail));
+		*offset = head & (buf->rb.size - 1U);
+
+		if (all) {
+			if (size > space) {
+				return 0;
+			}
+		} else {
+			size = MIN(size, MIN(space, buf->rb.size - *offset));
+		}
+
+		if (size == 0U) {
+			return 0;
+		}
+
+		new_state = (atomic_val_t)((((unsigned long)state & ~RING_BUF_MP_IDX_MASK) +
+					    MP_PENDING_ONE) |
+					   ((head + size) & RING_BUF_MP_IDX_MASK));
+	} while (!atomic_cas(&buf->put_state, state, new_state));
+
+	return size;
+}
+
+uint32_t ring_buf_mp_put_claim(struct ring_buf_mp *buf, uint8_t **data, uint32_t size)
+{
+	uint32_t offset;
+
+	size = mp_reserve(buf, size, false, &offset);
+	if (size != 0U) {
+		*data = &buf->rb.buffer[offset];
+	}
+
+	return size;
+}
+
+void ring_buf_mp_put_finish(struct ring_buf_mp *buf)
+{
+	__ASSERT_NO_MSG(mp_pending(atomic_get(&buf->put_state)) != 0U);
+
+	(void)atomic_sub(&buf->put_state, (atomic_val_t)MP_PENDING_ONE);
+}
+
+uint32_t ring_buf_mp_put_reserve(struct ring_buf_mp *buf, uint8_t **data, uint8_t **wrap,
+				 uint32_t size)
+{
+	uint32_t offset;
+
+	if (mp_reserve(buf, size, true, &offset) == 0U) {
+		return 0;
+	}
+
+	*data = &buf->rb.buffer[offset];
+	*wrap = buf->rb.buffer;
+
+	return MIN(size, buf->rb.size - offset);
+}
+
+uint32_t ring_buf_mp_put(struct ring_buf_mp *buf, const uint8_t *data, uint32_t size)
+{
+	uint32_t partial_size;
+	uint8_t *dst, *wrap;
+
+	partial_size = ring_buf_mp_put_reserve(buf, &dst, &wrap, size);
+	if (partial_size == 0U) {
+		return 0;
+	}
+
+	memcpy(dst, data, partial_size);
+	memcpy(wrap, data + partial_size, size - partial_size);
+
+	ring_buf_mp_put_finish(buf);
+
+	return size;
+}
+
+void ring_buf_mp_internal_sync(struct ring_buf_mp *buf)
+{
+	atomic_val_t state = atomic_get(&buf->put_state);
+
+	/*
+	 * With no claim open, everything up to the write index is committed.
+	 * Only the consumer writes put.tail of a multi-producer ring buffer.
+	 */
+	if (mp_pending(state) == 0U) {
+		buf->rb.put.tail += ring_buf_mp_internal_dist(state, buf->rb.put.tail);
+	}
+}
+
+#endif /* CONFIG_RING_BUFFER_MP */
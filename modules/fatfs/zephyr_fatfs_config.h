@@ -83,6 +83,16 @@
 #define FF_MULTI_PARTITION	CONFIG_FS_FATFS_MULTI_PARTITION
 #endif /* defined(CONFIG_FS_FATFS_MULTI_PARTITION) */
 
+#if defined(CONFIG_FS_FATFS_FASTSEEK)
+#undef FF_USE_FASTSEEK
+#define FF_USE_FASTSEEK		CONFIG_FS_FATFS_FASTSEEK
+#endif /* defined(CONFIG_FS_FATFS_FASTSEEK) */
+
+#if defined(CONFIG_FILE_SYSTEM_EXPAND) || defined(CONFIG_FS_FATFS_EXTRA_NATIVE_API)
+#undef FF_USE_EXPAND
+#define FF_USE_EXPAND		1
+#endif /* defined(CONFIG_FILE_SYSTEM_EXPAND) || defined(CONFIG_FS_FATFS_EXTRA_NATIVE_API) */
+
 /*
  * These options are override from default values, but have no Kconfig
  * options.
@@ -121,10 +131,8 @@
 
 #if defined(CONFIG_FS_FATFS_EXTRA_NATIVE_API)
 #undef FF_USE_LABEL
-#undef FF_USE_EXPAND
 #undef FF_USE_FIND
 #define FF_USE_LABEL 1
-#define FF_USE_EXPAND 1
 #define FF_USE_FIND 1
 #endif /* defined(CONFIG_FS_FATFS_EXTRA_NATIVE_API) */
 
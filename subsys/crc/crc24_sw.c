@@ -9,29 +9,6 @@
 
 #include <zephyr/sys/crc.h>
 
-uint32_t __weak crc24_pgp(const uint8_t *data, size_t len)
-{
-	return crc24_pgp_update(CRC24_PGP_INITIAL_VALUE, data, len) & CRC24_FINAL_VALUE_MASK;
-}
-
-/* CRC-24 implementation from the section 6.1 of the RFC 4880 */
-uint32_t __weak crc24_pgp_update(uint32_t crc, const uint8_t *data, size_t len)
-{
-	int i;
-
-	while (len--) {
-		crc ^= (*data++) << 16;
-		for (i = 0; i < 8; i++) {
-			crc <<= 1;
-			if (crc & 0x01000000) {
-				crc ^= CRC24_PGP_POLY;
-			}
-		}
-	}
-
-	return crc;
-}
-
 /** This code is originally extracted from github.com/go-gnss/rtcm,
  * licensed as Apache-2.0.
  */
@@ -71,6 +48,36 @@ static const uint32_t crc24q[] = {
 	0x42fa2f, 0xc4b6d4, 0xc82f22, 0x4e63d9, 0xd11cce, 0x575035, 0x5bc9c3, 0xdd8538
 };
 
+uint32_t __weak crc24_pgp(const uint8_t *data, size_t len)
+{
+	return crc24_pgp_update(CRC24_PGP_INITIAL_VALUE, data, len) & CRC24_FINAL_VALUE_MASK;
+}
+
+/* CRC-24 implementation from the section 6.1 of the RFC 4880 */
+uint32_t __weak crc24_pgp_update(uint32_t crc, const uint8_t *data, size_t len)
+{
+#if defined(CONFIG_CRC_SW_SLICING_BY_4) || defined(CONFIG_CRC_SW_SLICING_BY_8)
+	/* CRC-24Q uses the same polynomial, so its table can be shared */
+	for (; len > 0; len--) {
+		crc = ((crc << 8) & CRC24_FINAL_VALUE_MASK) ^ crc24q[*data++ ^ ((crc >> 16) & 0xff)];
+	}
+#else
+	int i;
+
+	while (len--) {
+		crc ^= (*data++) << 16;
+		for (i = 0; i < 8; i++) {
+			crc <<= 1;
+			if (crc & 0x01000000) {
+				crc ^= CRC24_PGP_POLY;
+			}
+		}
+	}
+#endif
+
+	return crc;
+}
+
 /**
  * @brief Calculate RTCM3 frame checksum
  *
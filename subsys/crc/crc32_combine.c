@@ -0,0 +1,64 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/sys/crc.h>
+#include <zephyr/sys/util.h>
+
+/* Reflected polynomials, bit 31 holds the coefficient of x^0 */
+#define CRC32_IEEE_POLY_REFLECTED 0xEDB88320U
+#define CRC32C_POLY_REFLECTED     0x82F63B78U
+
+/* Multiplies a and b modulo the polynomial, in the reflected representation */
+static uint32_t crc32_multmodp(uint32_t a, uint32_t b, uint32_t poly)
+{
+	uint32_t m = BIT(31);
+	uint32_t p = 0;
+
+	while (m != 0 && a != 0) {
+		if (a & m) {
+			p ^= b;
+			a &= ~m;
+		}
+
+		m >>= 1;
+		b = (b & 1) ? (b >> 1) ^ poly : b >> 1;
+	}
+
+	return p;
+}
+
+/*
+ * Computes the CRC of two consecutive blocks from the CRCs of each block:
+ * shifting crc1 over the len2 bytes of the second block is a multiplication
+ * by x^(8 * len2), done in O(log(len2)) steps by squaring. The initial value
+ * and final XOR of the CRCs cancel out.
+ */
+static uint32_t crc32_combine(uint32_t crc1, uint32_t crc2, size_t len2, uint32_t poly)
+{
+	/* x^8, the shift over one byte */
+	uint32_t sq = BIT(31 - 8);
+	uint32_t xn = BIT(31);
+
+	for (; len2 != 0; len2 >>= 1) {
+		if (len2 & 1) {
+			xn = crc32_multmodp(sq, xn, poly);
+		}
+
+		sq = crc32_multmodp(sq, sq, poly);
+	}
+
+	return crc32_multmodp(xn, crc1, poly) ^ crc2;
+}
+
+uint32_t crc32_ieee_combine(uint32_t crc1, uint32_t crc2, size_t len2)
+{
+	return crc32_combine(crc1, crc2, len2, CRC32_IEEE_POLY_REFLECTED);
+}
+
+uint32_t crc32_c_combine(uint32_t crc1, uint32_t crc2, size_t len2)
+{
+	return crc32_combine(crc1, crc2, len2, CRC32C_POLY_REFLECTED);
+}
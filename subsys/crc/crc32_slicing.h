@@ -0,0 +1,54 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_SUBSYS_CRC_CRC32_SLICING_H_
+#define ZEPHYR_SUBSYS_CRC_CRC32_SLICING_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/sys/byteorder.h>
+
+#if defined(CONFIG_CRC_SW_SLICING_BY_8)
+#define CRC32_SLICES 8
+#elif defined(CONFIG_CRC_SW_SLICING_BY_4)
+#define CRC32_SLICES 4
+#endif
+
+#if defined(CRC32_SLICES)
+/*
+ * Updates a reflected CRC-32, without pre or post inversion, using slicing
+ * tables: table[0] is the classic byte table and table[k][i] holds the CRC of
+ * byte i followed by k zero bytes, so CRC32_SLICES bytes are folded in with
+ * one lookup each.
+ */
+static inline uint32_t crc32_slicing_update(const uint32_t (*table)[256], uint32_t crc,
+					    const uint8_t *data, size_t len)
+{
+	for (; len >= CRC32_SLICES; len -= CRC32_SLICES, data += CRC32_SLICES) {
+		uint32_t lo = crc ^ sys_get_le32(data);
+
+#if CRC32_SLICES == 8
+		uint32_t hi = sys_get_le32(data + 4);
+
+		crc = table[7][lo & 0xff] ^ table[6][(lo >> 8) & 0xff] ^
+		      table[5][(lo >> 16) & 0xff] ^ table[4][lo >> 24] ^
+		      table[3][hi & 0xff] ^ table[2][(hi >> 8) & 0xff] ^
+		      table[1][(hi >> 16) & 0xff] ^ table[0][hi >> 24];
+#else
+		crc = table[3][lo & 0xff] ^ table[2][(lo >> 8) & 0xff] ^
+		      table[1][(lo >> 16) & 0xff] ^ table[0][lo >> 24];
+#endif
+	}
+
+	for (; len > 0; len--) {
+		crc = (crc >> 8) ^ table[0][(crc ^ *data++) & 0xff];
+	}
+
+	return crc;
+}
+#endif /* CRC32_SLICES */
+
+#endif /* ZEPHYR_SUBSYS_CRC_CRC32_SLICING_H_ */
@@ -5,13 +5,412 @@
  */
 
 #include <zephyr/sys/crc.h>
+#include "crc32_slicing.h"
 
+#if defined(CONFIG_CRC_ARCH_INSTRUCTIONS) && defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#define CRC32C_ARM_CRC32
+#elif defined(CONFIG_CRC_ARCH_INSTRUCTIONS) && defined(__SSE4_2__)
+#include <nmmintrin.h>
+#define CRC32C_SSE42
+#endif
+
+#if defined(CRC32C_ARM_CRC32) || defined(CRC32C_SSE42)
+/* Castagnoli CRC of 8 bytes, without pre or post inversion */
+static inline uint32_t crc32c_u64(uint32_t crc, uint64_t val)
+{
+#if defined(CRC32C_ARM_CRC32)
+	return __crc32cd(crc, val);
+#elif defined(__x86_64__)
+	return (uint32_t)_mm_crc32_u64(crc, val);
+#else
+	crc = _mm_crc32_u32(crc, (uint32_t)val);
+	return _mm_crc32_u32(crc, (uint32_t)(val >> 32));
+#endif
+}
+
+static inline uint32_t crc32c_u8(uint32_t crc, uint8_t val)
+{
+#if defined(CRC32C_ARM_CRC32)
+	return __crc32cb(crc, val);
+#else
+	return _mm_crc32_u8(crc, val);
+#endif
+}
+#elif defined(CRC32_SLICES)
+/* Slicing tables generated from polynomial 0x82F63B78 (reflected) */
+static const uint32_t crc32c_slices[CRC32_SLICES][256] = {
+	{
+		0x00000000UL, 0xF26B8303UL, 0xE13B70F7UL, 0x1350F3F4UL, 0xC79A971FUL, 0x35F1141CUL,
+		0x26A1E7E8UL, 0xD4CA64EBUL, 0x8AD958CFUL, 0x78B2DBCCUL, 0x6BE22838UL, 0x9989AB3BUL,
+		0x4D43CFD0UL, 0xBF284CD3UL, 0xAC78BF27UL, 0x5E133C24UL, 0x105EC76FUL, 0xE235446CUL,
+		0xF165B798UL, 0x030E349BUL, 0xD7C45070UL, 0x25AFD373UL, 0x36FF2087UL, 0xC494A384UL,
+		0x9A879FA0UL, 0x68EC1CA3UL, 0x7BBCEF57UL, 0x89D76C54UL, 0x5D1D08BFUL, 0xAF768BBCUL,
+		0xBC267848UL, 0x4E4DFB4BUL, 0x20BD8EDEUL, 0xD2D60DDDUL, 0xC186FE29UL, 0x33ED7D2AUL,
+		0xE72719C1UL, 0x154C9AC2UL, 0x061C6936UL, 0xF477EA35UL, 0xAA64D611UL, 0x580F5512UL,
+		0x4B5FA6E6UL, 0xB93425E5UL, 0x6DFE410EUL, 0x9F95C20DUL, 0x8CC531F9UL, 0x7EAEB2FAUL,
+		0x30E349B1UL, 0xC288CAB2UL, 0xD1D83946UL, 0x23B3BA45UL, 0xF779DEAEUL, 0x05125DADUL,
+		0x1642AE59UL, 0xE4292D5AUL, 0xBA3A117EUL, 0x4851927DUL, 0x5B016189UL, 0xA96AE28AUL,
+		0x7DA08661UL, 0x8FCB0562UL, 0x9C9BF696UL, 0x6EF07595UL, 0x417B1DBCUL, 0xB3109EBFUL,
+		0xA0406D4BUL, 0x522BEE48UL, 0x86E18AA3UL, 0x748A09A0UL, 0x67DAFA54UL, 0x95B17957UL,
+		0xCBA24573UL, 0x39C9C670UL, 0x2A993584UL, 0xD8F2B687UL, 0x0C38D26CUL, 0xFE53516FUL,
+		0xED03A29BUL, 0x1F682198UL, 0x5125DAD3UL, 0xA34E59D0UL, 0xB01EAA24UL, 0x42752927UL,
+		0x96BF4DCCUL, 0x64D4CECFUL, 0x77843D3BUL, 0x85EFBE38UL, 0xDBFC821CUL, 0x2997011FUL,
+		0x3AC7F2EBUL, 0xC8AC71E8UL, 0x1C661503UL, 0xEE0D9600UL, 0xFD5D65F4UL, 0x0F36E6F7UL,
+		0x61C69362UL, 0x93AD1061UL, 0x80FDE395UL, 0x72966096UL, 0xA65C047DUL, 0x5437877EUL,
+		0x4767748AUL, 0xB50CF789UL, 0xEB1FCBADUL, 0x197448AEUL, 0x0A24BB5AUL, 0xF84F3859UL,
+		0x2C855CB2UL, 0xDEEEDFB1UL, 0xCDBE2C45UL, 0x3FD5AF46UL, 0x7198540DUL, 0x83F3D70EUL,
+		0x90A324FAUL, 0x62C8A7F9UL, 0xB602C312UL, 0x44694011UL, 0x5739B3E5UL, 0xA55230E6UL,
+		0xFB410CC2UL, 0x092A8FC1UL, 0x1A7A7C35UL, 0xE811FF36UL, 0x3CDB9BDDUL, 0xCEB018DEUL,
+		0xDDE0EB2AUL, 0x2F8B6829UL, 0x82F63B78UL, 0x709DB87BUL, 0x63CD4B8FUL, 0x91A6C88CUL,
+		0x456CAC67UL, 0xB7072F64UL, 0xA457DC90UL, 0x563C5F93UL, 0x082F63B7UL, 0xFA44E0B4UL,
+		0xE9141340UL, 0x1B7F9043UL, 0xCFB5F4A8UL, 0x3DDE77ABUL, 0x2E8E845FUL, 0xDCE5075CUL,
+		0x92A8FC17UL, 0x60C37F14UL, 0x73938CE0UL, 0x81F80FE3UL, 0x55326B08UL, 0xA759E80BUL,
+		0xB4091BFFUL, 0x466298FCUL, 0x1871A4D8UL, 0xEA1A27DBUL, 0xF94AD42FUL, 0x0B21572CUL,
+		0xDFEB33C7UL, 0x2D80B0C4UL, 0x3ED04330UL, 0xCCBBC033UL, 0xA24BB5A6UL, 0x502036A5UL,
+		0x4370C551UL, 0xB11B4652UL, 0x65D122B9UL, 0x97BAA1BAUL, 0x84EA524EUL, 0x7681D14DUL,
+		0x2892ED69UL, 0xDAF96E6AUL, 0xC9A99D9EUL, 0x3BC21E9DUL, 0xEF087A76UL, 0x1D63F975UL,
+		0x0E330A81UL, 0xFC588982UL, 0xB21572C9UL, 0x407EF1CAUL, 0x532E023EUL, 0xA145813DUL,
+		0x758FE5D6UL, 0x87E466D5UL, 0x94B49521UL, 0x66DF1622UL, 0x38CC2A06UL, 0xCAA7A905UL,
+		0xD9F75AF1UL, 0x2B9CD9F2UL, 0xFF56BD19UL, 0x0D3D3E1AUL, 0x1E6DCDEEUL, 0xEC064EEDUL,
+		0xC38D26C4UL, 0x31E6A5C7UL, 0x22B65633UL, 0xD0DDD530UL, 0x0417B1DBUL, 0xF67C32D8UL,
+		0xE52CC12CUL, 0x1747422FUL, 0x49547E0BUL, 0xBB3FFD08UL, 0xA86F0EFCUL, 0x5A048DFFUL,
+		0x8ECEE914UL, 0x7CA56A17UL, 0x6FF599E3UL, 0x9D9E1AE0UL, 0xD3D3E1ABUL, 0x21B862A8UL,
+		0x32E8915CUL, 0xC083125FUL, 0x144976B4UL, 0xE622F5B7UL, 0xF5720643UL, 0x07198540UL,
+		0x590AB964UL, 0xAB613A67UL, 0xB831C993UL, 0x4A5A4A90UL, 0x9E902E7BUL, 0x6CFBAD78UL,
+		0x7FAB5E8CUL, 0x8DC0DD8FUL, 0xE330A81AUL, 0x115B2B19UL, 0x020BD8EDUL, 0xF0605BEEUL,
+		0x24AA3F05UL, 0xD6C1BC06UL, 0xC5914FF2UL, 0x37FACCF1UL, 0x69E9F0D5UL, 0x9B8273D6UL,
+		0x88D28022UL, 0x7AB90321UL, 0xAE7367CAUL, 0x5C18E4C9UL, 0x4F48173DUL, 0xBD23943EUL,
+		0xF36E6F75UL, 0x0105EC76UL, 0x12551F82UL, 0xE03E9C81UL, 0x34F4F86AUL, 0xC69F7B69UL,
+		0xD5CF889DUL, 0x27A40B9EUL, 0x79B737BAUL, 0x8BDCB4B9UL, 0x988C474DUL, 0x6AE7C44EUL,
+		0xBE2DA0A5UL, 0x4C4623A6UL, 0x5F16D052UL, 0xAD7D5351UL,
+	},
+	{
+		0x00000000UL, 0x13A29877UL, 0x274530EEUL, 0x34E7A899UL, 0x4E8A61DCUL, 0x5D28F9ABUL,
+		0x69CF5132UL, 0x7A6DC945UL, 0x9D14C3B8UL, 0x8EB65BCFUL, 0xBA51F356UL, 0xA9F36B21UL,
+		0xD39EA264UL, 0xC03C3A13UL, 0xF4DB928AUL, 0xE7790AFDUL, 0x3FC5F181UL, 0x2C6769F6UL,
+		0x1880C16FUL, 0x0B225918UL, 0x714F905DUL, 0x62ED082AUL, 0x560AA0B3UL, 0x45A838C4UL,
+		0xA2D13239UL, 0xB173AA4EUL, 0x859402D7UL, 0x96369AA0UL, 0xEC5B53E5UL, 0xFFF9CB92UL,
+		0xCB1E630BUL, 0xD8BCFB7CUL, 0x7F8BE302UL, 0x6C297B75UL, 0x58CED3ECUL, 0x4B6C4B9BUL,
+		0x310182DEUL, 0x22A31AA9UL, 0x1644B230UL, 0x05E62A47UL, 0xE29F20BAUL, 0xF13DB8CDUL,
+		0xC5DA1054UL, 0xD6788823UL, 0xAC154166UL, 0xBFB7D911UL, 0x8B507188UL, 0x98F2E9FFUL,
+		0x404E1283UL, 0x53EC8AF4UL, 0x670B226DUL, 0x74A9BA1AUL, 0x0EC4735FUL, 0x1D66EB28UL,
+		0x298143B1UL, 0x3A23DBC6UL, 0xDD5AD13BUL, 0xCEF8494CUL, 0xFA1FE1D5UL, 0xE9BD79A2UL,
+		0x93D0B0E7UL, 0x80722890UL, 0xB4958009UL, 0xA737187EUL, 0xFF17C604UL, 0xECB55E73UL,
+		0xD852F6EAUL, 0xCBF06E9DUL, 0xB19DA7D8UL, 0xA23F3FAFUL, 0x96D89736UL, 0x857A0F41UL,
+		0x620305BCUL, 0x71A19DCBUL, 0x45463552UL, 0x56E4AD25UL, 0x2C896460UL, 0x3F2BFC17UL,
+		0x0BCC548EUL, 0x186ECCF9UL, 0xC0D23785UL, 0xD370AFF2UL, 0xE797076BUL, 0xF4359F1CUL,
+		0x8E585659UL, 0x9DFACE2EUL, 0xA91D66B7UL, 0xBABFFEC0UL, 0x5DC6F43DUL, 0x4E646C4AUL,
+		0x7A83C4D3UL, 0x69215CA4UL, 0x134C95E1UL, 0x00EE0D96UL, 0x3409A50FUL, 0x27AB3D78UL,
+		0x809C2506UL, 0x933EBD71UL, 0xA7D915E8UL, 0xB47B8D9FUL, 0xCE1644DAUL, 0xDDB4DCADUL,
+		0xE9537434UL, 0xFAF1EC43UL, 0x1D88E6BEUL, 0x0E2A7EC9UL, 0x3ACDD650UL, 0x296F4E27UL,
+		0x53028762UL, 0x40A01F15UL, 0x7447B78CUL, 0x67E52FFBUL, 0xBF59D487UL, 0xACFB4CF0UL,
+		0x981CE469UL, 0x8BBE7C1EUL, 0xF1D3B55BUL, 0xE2712D2CUL, 0xD69685B5UL, 0xC5341DC2UL,
+		0x224D173FUL, 0x31EF8F48UL, 0x050827D1UL, 0x16AABFA6UL, 0x6CC776E3UL, 0x7F65EE94UL,
+		0x4B82460DUL, 0x5820DE7AUL, 0xFBC3FAF9UL, 0xE861628EUL, 0xDC86CA17UL, 0xCF245260UL,
+		0xB5499B25UL, 0xA6EB0352UL, 0x920CABCBUL, 0x81AE33BCUL, 0x66D73941UL, 0x7575A136UL,
+		0x419209AFUL, 0x523091D8UL, 0x285D589DUL, 0x3BFFC0EAUL, 0x0F186873UL, 0x1CBAF004UL,
+		0xC4060B78UL, 0xD7A4930FUL, 0xE3433B96UL, 0xF0E1A3E1UL, 0x8A8C6AA4UL, 0x992EF2D3UL,
+		0xADC95A4AUL, 0xBE6BC23DUL, 0x5912C8C0UL, 0x4AB050B7UL, 0x7E57F82EUL, 0x6DF56059UL,
+		0x1798A91CUL, 0x043A316BUL, 0x30DD99F2UL, 0x237F0185UL, 0x844819FBUL, 0x97EA818CUL,
+		0xA30D2915UL, 0xB0AFB162UL, 0xCAC27827UL, 0xD960E050UL, 0xED8748C9UL, 0xFE25D0BEUL,
+		0x195CDA43UL, 0x0AFE4234UL, 0x3E19EAADUL, 0x2DBB72DAUL, 0x57D6BB9FUL, 0x447423E8UL,
+		0x70938B71UL, 0x63311306UL, 0xBB8DE87AUL, 0xA82F700DUL, 0x9CC8D894UL, 0x8F6A40E3UL,
+		0xF50789A6UL, 0xE6A511D1UL, 0xD242B948UL, 0xC1E0213FUL, 0x26992BC2UL, 0x353BB3B5UL,
+		0x01DC1B2CUL, 0x127E835BUL, 0x68134A1EUL, 0x7BB1D269UL, 0x4F567AF0UL, 0x5CF4E287UL,
+		0x04D43CFDUL, 0x1776A48AUL, 0x23910C13UL, 0x30339464UL, 0x4A5E5D21UL, 0x59FCC556UL,
+		0x6D1B6DCFUL, 0x7EB9F5B8UL, 0x99C0FF45UL, 0x8A626732UL, 0xBE85CFABUL, 0xAD2757DCUL,
+		0xD74A9E99UL, 0xC4E806EEUL, 0xF00FAE77UL, 0xE3AD3600UL, 0x3B11CD7CUL, 0x28B3550BUL,
+		0x1C54FD92UL, 0x0FF665E5UL, 0x759BACA0UL, 0x663934D7UL, 0x52DE9C4EUL, 0x417C0439UL,
+		0xA6050EC4UL, 0xB5A796B3UL, 0x81403E2AUL, 0x92E2A65DUL, 0xE88F6F18UL, 0xFB2DF76FUL,
+		0xCFCA5FF6UL, 0xDC68C781UL, 0x7B5FDFFFUL, 0x68FD4788UL, 0x5C1AEF11UL, 0x4FB87766UL,
+		0x35D5BE23UL, 0x26772654UL, 0x12908ECDUL, 0x013216BAUL, 0xE64B1C47UL, 0xF5E98430UL,
+		0xC10E2CA9UL, 0xD2ACB4DEUL, 0xA8C17D9BUL, 0xBB63E5ECUL, 0x8F844D75UL, 0x9C26D502UL,
+		0x449A2E7EUL, 0x5738B609UL, 0x63DF1E90UL, 0x707D86E7UL, 0x0A104FA2UL, 0x19B2D7D5UL,
+		0x2D557F4CUL, 0x3EF7E73BUL, 0xD98EEDC6UL, 0xCA2C75B1UL, 0xFECBDD28UL, 0xED69455FUL,
+		0x97048C1AUL, 0x84A6146DUL, 0xB041BCF4UL, 0xA3E32483UL,
+	},
+	{
+		0x00000000UL, 0xA541927EUL, 0x4F6F520DUL, 0xEA2EC073UL, 0x9EDEA41AUL, 0x3B9F3664UL,
+		0xD1B1F617UL, 0x74F06469UL, 0x38513EC5UL, 0x9D10ACBBUL, 0x773E6CC8UL, 0xD27FFEB6UL,
+		0xA68F9ADFUL, 0x03CE08A1UL, 0xE9E0C8D2UL, 0x4CA15AACUL, 0x70A27D8AUL, 0xD5E3EFF4UL,
+		0x3FCD2F87UL, 0x9A8CBDF9UL, 0xEE7CD990UL, 0x4B3D4BEEUL, 0xA1138B9DUL, 0x045219E3UL,
+		0x48F3434FUL, 0xEDB2D131UL, 0x079C1142UL, 0xA2DD833CUL, 0xD62DE755UL, 0x736C752BUL,
+		0x9942B558UL, 0x3C032726UL, 0xE144FB14UL, 0x4405696AUL, 0xAE2BA919UL, 0x0B6A3B67UL,
+		0x7F9A5F0EUL, 0xDADBCD70UL, 0x30F50D03UL, 0x95B49F7DUL, 0xD915C5D1UL, 0x7C5457AFUL,
+		0x967A97DCUL, 0x333B05A2UL, 0x47CB61CBUL, 0xE28AF3B5UL, 0x08A433C6UL, 0xADE5A1B8UL,
+		0x91E6869EUL, 0x34A714E0UL, 0xDE89D493UL, 0x7BC846EDUL, 0x0F382284UL, 0xAA79B0FAUL,
+		0x40577089UL, 0xE516E2F7UL, 0xA9B7B85BUL, 0x0CF62A25UL, 0xE6D8EA56UL, 0x43997828UL,
+		0x37691C41UL, 0x92288E3FUL, 0x78064E4CUL, 0xDD47DC32UL, 0xC76580D9UL, 0x622412A7UL,
+		0x880AD2D4UL, 0x2D4B40AAUL, 0x59BB24C3UL, 0xFCFAB6BDUL, 0x16D476CEUL, 0xB395E4B0UL,
+		0xFF34BE1CUL, 0x5A752C62UL, 0xB05BEC11UL, 0x151A7E6FUL, 0x61EA1A06UL, 0xC4AB8878UL,
+		0x2E85480BUL, 0x8BC4DA75UL, 0xB7C7FD53UL, 0x12866F2DUL, 0xF8A8AF5EUL, 0x5DE93D20UL,
+		0x29195949UL, 0x8C58CB37UL, 0x66760B44UL, 0xC337993AUL, 0x8F96C396UL, 0x2AD751E8UL,
+		0xC0F9919BUL, 0x65B803E5UL, 0x1148678CUL, 0xB409F5F2UL, 0x5E273581UL, 0xFB66A7FFUL,
+		0x26217BCDUL, 0x8360E9B3UL, 0x694E29C0UL, 0xCC0FBBBEUL, 0xB8FFDFD7UL, 0x1DBE4DA9UL,
+		0xF7908DDAUL, 0x52D11FA4UL, 0x1E704508UL, 0xBB31D776UL, 0x511F1705UL, 0xF45E857BUL,
+		0x80AEE112UL, 0x25EF736CUL, 0xCFC1B31FUL, 0x6A802161UL, 0x56830647UL, 0xF3C29439UL,
+		0x19EC544AUL, 0xBCADC634UL, 0xC85DA25DUL, 0x6D1C3023UL, 0x8732F050UL, 0x2273622EUL,
+		0x6ED23882UL, 0xCB93AAFCUL, 0x21BD6A8FUL, 0x84FCF8F1UL, 0xF00C9C98UL, 0x554D0EE6UL,
+		0xBF63CE95UL, 0x1A225CEBUL, 0x8B277743UL, 0x2E66E53DUL, 0xC448254EUL, 0x6109B730UL,
+		0x15F9D359UL, 0xB0B84127UL, 0x5A968154UL, 0xFFD7132AUL, 0xB3764986UL, 0x1637DBF8UL,
+		0xFC191B8BUL, 0x595889F5UL, 0x2DA8ED9CUL, 0x88E97FE2UL, 0x62C7BF91UL, 0xC7862DEFUL,
+		0xFB850AC9UL, 0x5EC498B7UL, 0xB4EA58C4UL, 0x11ABCABAUL, 0x655BAED3UL, 0xC01A3CADUL,
+		0x2A34FCDEUL, 0x8F756EA0UL, 0xC3D4340CUL, 0x6695A672UL, 0x8CBB6601UL, 0x29FAF47FUL,
+		0x5D0A9016UL, 0xF84B0268UL, 0x1265C21BUL, 0xB7245065UL, 0x6A638C57UL, 0xCF221E29UL,
+		0x250CDE5AUL, 0x804D4C24UL, 0xF4BD284DUL, 0x51FCBA33UL, 0xBBD27A40UL, 0x1E93E83EUL,
+		0x5232B292UL, 0xF77320ECUL, 0x1D5DE09FUL, 0xB81C72E1UL, 0xCCEC1688UL, 0x69AD84F6UL,
+		0x83834485UL, 0x26C2D6FBUL, 0x1AC1F1DDUL, 0xBF8063A3UL, 0x55AEA3D0UL, 0xF0EF31AEUL,
+		0x841F55C7UL, 0x215EC7B9UL, 0xCB7007CAUL, 0x6E3195B4UL, 0x2290CF18UL, 0x87D15D66UL,
+		0x6DFF9D15UL, 0xC8BE0F6BUL, 0xBC4E6B02UL, 0x190FF97CUL, 0xF321390FUL, 0x5660AB71UL,
+		0x4C42F79AUL, 0xE90365E4UL, 0x032DA597UL, 0xA66C37E9UL, 0xD29C5380UL, 0x77DDC1FEUL,
+		0x9DF3018DUL, 0x38B293F3UL, 0x7413C95FUL, 0xD1525B21UL, 0x3B7C9B52UL, 0x9E3D092CUL,
+		0xEACD6D45UL, 0x4F8CFF3BUL, 0xA5A23F48UL, 0x00E3AD36UL, 0x3CE08A10UL, 0x99A1186EUL,
+		0x738FD81DUL, 0xD6CE4A63UL, 0xA23E2E0AUL, 0x077FBC74UL, 0xED517C07UL, 0x4810EE79UL,
+		0x04B1B4D5UL, 0xA1F026ABUL, 0x4BDEE6D8UL, 0xEE9F74A6UL, 0x9A6F10CFUL, 0x3F2E82B1UL,
+		0xD50042C2UL, 0x7041D0BCUL, 0xAD060C8EUL, 0x08479EF0UL, 0xE2695E83UL, 0x4728CCFDUL,
+		0x33D8A894UL, 0x96993AEAUL, 0x7CB7FA99UL, 0xD9F668E7UL, 0x9557324BUL, 0x3016A035UL,
+		0xDA386046UL, 0x7F79F238UL, 0x0B899651UL, 0xAEC8042FUL, 0x44E6C45CUL, 0xE1A75622UL,
+		0xDDA47104UL, 0x78E5E37AUL, 0x92CB2309UL, 0x378AB177UL, 0x437AD51EUL, 0xE63B4760UL,
+		0x0C158713UL, 0xA954156DUL, 0xE5F54FC1UL, 0x40B4DDBFUL, 0xAA9A1DCCUL, 0x0FDB8FB2UL,
+		0x7B2BEBDBUL, 0xDE6A79A5UL, 0x3444B9D6UL, 0x91052BA8UL,
+	},
+	{
+		0x00000000UL, 0xDD45AAB8UL, 0xBF672381UL, 0x62228939UL, 0x7B2231F3UL, 0xA6679B4BUL,
+		0xC4451272UL, 0x1900B8CAUL, 0xF64463E6UL, 0x2B01C95EUL, 0x49234067UL, 0x9466EADFUL,
+		0x8D665215UL, 0x5023F8ADUL, 0x32017194UL, 0xEF44DB2CUL, 0xE964B13DUL, 0x34211B85UL,
+		0x560392BCUL, 0x8B463804UL, 0x924680CEUL, 0x4F032A76UL, 0x2D21A34FUL, 0xF06409F7UL,
+		0x1F20D2DBUL, 0xC2657863UL, 0xA047F15AUL, 0x7D025BE2UL, 0x6402E328UL, 0xB9474990UL,
+		0xDB65C0A9UL, 0x06206A11UL, 0xD725148BUL, 0x0A60BE33UL, 0x6842370AUL, 0xB5079DB2UL,
+		0xAC072578UL, 0x71428FC0UL, 0x136006F9UL, 0xCE25AC41UL, 0x2161776DUL, 0xFC24DDD5UL,
+		0x9E0654ECUL, 0x4343FE54UL, 0x5A43469EUL, 0x8706EC26UL, 0xE524651FUL, 0x3861CFA7UL,
+		0x3E41A5B6UL, 0xE3040F0EUL, 0x81268637UL, 0x5C632C8FUL, 0x45639445UL, 0x98263EFDUL,
+		0xFA04B7C4UL, 0x27411D7CUL, 0xC805C650UL, 0x15406CE8UL, 0x7762E5D1UL, 0xAA274F69UL,
+		0xB327F7A3UL, 0x6E625D1BUL, 0x0C40D422UL, 0xD1057E9AUL, 0xABA65FE7UL, 0x76E3F55FUL,
+		0x14C17C66UL, 0xC984D6DEUL, 0xD0846E14UL, 0x0DC1C4ACUL, 0x6FE34D95UL, 0xB2A6E72DUL,
+		0x5DE23C01UL, 0x80A796B9UL, 0xE2851F80UL, 0x3FC0B538UL, 0x26C00DF2UL, 0xFB85A74AUL,
+		0x99A72E73UL, 0x44E284CBUL, 0x42C2EEDAUL, 0x9F874462UL, 0xFDA5CD5BUL, 0x20E067E3UL,
+		0x39E0DF29UL, 0xE4A57591UL, 0x8687FCA8UL, 0x5BC25610UL, 0xB4868D3CUL, 0x69C32784UL,
+		0x0BE1AEBDUL, 0xD6A40405UL, 0xCFA4BCCFUL, 0x12E11677UL, 0x70C39F4EUL, 0xAD8635F6UL,
+		0x7C834B6CUL, 0xA1C6E1D4UL, 0xC3E468EDUL, 0x1EA1C255UL, 0x07A17A9FUL, 0xDAE4D027UL,
+		0xB8C6591EUL, 0x6583F3A6UL, 0x8AC7288AUL, 0x57828232UL, 0x35A00B0BUL, 0xE8E5A1B3UL,
+		0xF1E51979UL, 0x2CA0B3C1UL, 0x4E823AF8UL, 0x93C79040UL, 0x95E7FA51UL, 0x48A250E9UL,
+		0x2A80D9D0UL, 0xF7C57368UL, 0xEEC5CBA2UL, 0x3380611AUL, 0x51A2E823UL, 0x8CE7429BUL,
+		0x63A399B7UL, 0xBEE6330FUL, 0xDCC4BA36UL, 0x0181108EUL, 0x1881A844UL, 0xC5C402FCUL,
+		0xA7E68BC5UL, 0x7AA3217DUL, 0x52A0C93FUL, 0x8FE56387UL, 0xEDC7EABEUL, 0x30824006UL,
+		0x2982F8CCUL, 0xF4C75274UL, 0x96E5DB4DUL, 0x4BA071F5UL, 0xA4E4AAD9UL, 0x79A10061UL,
+		0x1B838958UL, 0xC6C623E0UL, 0xDFC69B2AUL, 0x02833192UL, 0x60A1B8ABUL, 0xBDE41213UL,
+		0xBBC47802UL, 0x6681D2BAUL, 0x04A35B83UL, 0xD9E6F13BUL, 0xC0E649F1UL, 0x1DA3E349UL,
+		0x7F816A70UL, 0xA2C4C0C8UL, 0x4D801BE4UL, 0x90C5B15CUL, 0xF2E73865UL, 0x2FA292DDUL,
+		0x36A22A17UL, 0xEBE780AFUL, 0x89C50996UL, 0x5480A32EUL, 0x8585DDB4UL, 0x58C0770CUL,
+		0x3AE2FE35UL, 0xE7A7548DUL, 0xFEA7EC47UL, 0x23E246FFUL, 0x41C0CFC6UL, 0x9C85657EUL,
+		0x73C1BE52UL, 0xAE8414EAUL, 0xCCA69DD3UL, 0x11E3376BUL, 0x08E38FA1UL, 0xD5A62519UL,
+		0xB784AC20UL, 0x6AC10698UL, 0x6CE16C89UL, 0xB1A4C631UL, 0xD3864F08UL, 0x0EC3E5B0UL,
+		0x17C35D7AUL, 0xCA86F7C2UL, 0xA8A47EFBUL, 0x75E1D443UL, 0x9AA50F6FUL, 0x47E0A5D7UL,
+		0x25C22CEEUL, 0xF8878656UL, 0xE1873E9CUL, 0x3CC29424UL, 0x5EE01D1DUL, 0x83A5B7A5UL,
+		0xF90696D8UL, 0x24433C60UL, 0x4661B559UL, 0x9B241FE1UL, 0x8224A72BUL, 0x5F610D93UL,
+		0x3D4384AAUL, 0xE0062E12UL, 0x0F42F53EUL, 0xD2075F86UL, 0xB025D6BFUL, 0x6D607C07UL,
+		0x7460C4CDUL, 0xA9256E75UL, 0xCB07E74CUL, 0x16424DF4UL, 0x106227E5UL, 0xCD278D5DUL,
+		0xAF050464UL, 0x7240AEDCUL, 0x6B401616UL, 0xB605BCAEUL, 0xD4273597UL, 0x09629F2FUL,
+		0xE6264403UL, 0x3B63EEBBUL, 0x59416782UL, 0x8404CD3AUL, 0x9D0475F0UL, 0x4041DF48UL,
+		0x22635671UL, 0xFF26FCC9UL, 0x2E238253UL, 0xF36628EBUL, 0x9144A1D2UL, 0x4C010B6AUL,
+		0x5501B3A0UL, 0x88441918UL, 0xEA669021UL, 0x37233A99UL, 0xD867E1B5UL, 0x05224B0DUL,
+		0x6700C234UL, 0xBA45688CUL, 0xA345D046UL, 0x7E007AFEUL, 0x1C22F3C7UL, 0xC167597FUL,
+		0xC747336EUL, 0x1A0299D6UL, 0x782010EFUL, 0xA565BA57UL, 0xBC65029DUL, 0x6120A825UL,
+		0x0302211CUL, 0xDE478BA4UL, 0x31035088UL, 0xEC46FA30UL, 0x8E647309UL, 0x5321D9B1UL,
+		0x4A21617BUL, 0x9764CBC3UL, 0xF54642FAUL, 0x2803E842UL,
+	},
+#if CRC32_SLICES == 8
+	{
+		0x00000000UL, 0x38116FACUL, 0x7022DF58UL, 0x4833B0F4UL, 0xE045BEB0UL, 0xD854D11CUL,
+		0x906761E8UL, 0xA8760E44UL, 0xC5670B91UL, 0xFD76643DUL, 0xB545D4C9UL, 0x8D54BB65UL,
+		0x2522B521UL, 0x1D33DA8DUL, 0x55006A79UL, 0x6D1105D5UL, 0x8F2261D3UL, 0xB7330E7FUL,
+		0xFF00BE8BUL, 0xC711D127UL, 0x6F67DF63UL, 0x5776B0CFUL, 0x1F45003BUL, 0x27546F97UL,
+		0x4A456A42UL, 0x725405EEUL, 0x3A67B51AUL, 0x0276DAB6UL, 0xAA00D4F2UL, 0x9211BB5EUL,
+		0xDA220BAAUL, 0xE2336406UL, 0x1BA8B557UL, 0x23B9DAFBUL, 0x6B8A6A0FUL, 0x539B05A3UL,
+		0xFBED0BE7UL, 0xC3FC644BUL, 0x8BCFD4BFUL, 0xB3DEBB13UL, 0xDECFBEC6UL, 0xE6DED16AUL,
+		0xAEED619EUL, 0x96FC0E32UL, 0x3E8A0076UL, 0x069B6FDAUL, 0x4EA8DF2EUL, 0x76B9B082UL,
+		0x948AD484UL, 0xAC9BBB28UL, 0xE4A80BDCUL, 0xDCB96470UL, 0x74CF6A34UL, 0x4CDE0598UL,
+		0x04EDB56CUL, 0x3CFCDAC0UL, 0x51EDDF15UL, 0x69FCB0B9UL, 0x21CF004DUL, 0x19DE6FE1UL,
+		0xB1A861A5UL, 0x89B90E09UL, 0xC18ABEFDUL, 0xF99BD151UL, 0x37516AAEUL, 0x0F400502UL,
+		0x4773B5F6UL, 0x7F62DA5AUL, 0xD714D41EUL, 0xEF05BBB2UL, 0xA7360B46UL, 0x9F2764EAUL,
+		0xF236613FUL, 0xCA270E93UL, 0x8214BE67UL, 0xBA05D1CBUL, 0x1273DF8FUL, 0x2A62B023UL,
+		0x625100D7UL, 0x5A406F7BUL, 0xB8730B7DUL, 0x806264D1UL, 0xC851D425UL, 0xF040BB89UL,
+		0x5836B5CDUL, 0x6027DA61UL, 0x28146A95UL, 0x10050539UL, 0x7D1400ECUL, 0x45056F40UL,
+		0x0D36DFB4UL, 0x3527B018UL, 0x9D51BE5CUL, 0xA540D1F0UL, 0xED736104UL, 0xD5620EA8UL,
+		0x2CF9DFF9UL, 0x14E8B055UL, 0x5CDB00A1UL, 0x64CA6F0DUL, 0xCCBC6149UL, 0xF4AD0EE5UL,
+		0xBC9EBE11UL, 0x848FD1BDUL, 0xE99ED468UL, 0xD18FBBC4UL, 0x99BC0B30UL, 0xA1AD649CUL,
+		0x09DB6AD8UL, 0x31CA0574UL, 0x79F9B580UL, 0x41E8DA2CUL, 0xA3DBBE2AUL, 0x9BCAD186UL,
+		0xD3F96172UL, 0xEBE80EDEUL, 0x439E009AUL, 0x7B8F6F36UL, 0x33BCDFC2UL, 0x0BADB06EUL,
+		0x66BCB5BBUL, 0x5EADDA17UL, 0x169E6AE3UL, 0x2E8F054FUL, 0x86F90B0BUL, 0xBEE864A7UL,
+		0xF6DBD453UL, 0xCECABBFFUL, 0x6EA2D55CUL, 0x56B3BAF0UL, 0x1E800A04UL, 0x269165A8UL,
+		0x8EE76BECUL, 0xB6F60440UL, 0xFEC5B4B4UL, 0xC6D4DB18UL, 0xABC5DECDUL, 0x93D4B161UL,
+		0xDBE70195UL, 0xE3F66E39UL, 0x4B80607DUL, 0x73910FD1UL, 0x3BA2BF25UL, 0x03B3D089UL,
+		0xE180B48FUL, 0xD991DB23UL, 0x91A26BD7UL, 0xA9B3047BUL, 0x01C50A3FUL, 0x39D46593UL,
+		0x71E7D567UL, 0x49F6BACBUL, 0x24E7BF1EUL, 0x1CF6D0B2UL, 0x54C56046UL, 0x6CD40FEAUL,
+		0xC4A201AEUL, 0xFCB36E02UL, 0xB480DEF6UL, 0x8C91B15AUL, 0x750A600BUL, 0x4D1B0FA7UL,
+		0x0528BF53UL, 0x3D39D0FFUL, 0x954FDEBBUL, 0xAD5EB117UL, 0xE56D01E3UL, 0xDD7C6E4FUL,
+		0xB06D6B9AUL, 0x887C0436UL, 0xC04FB4C2UL, 0xF85EDB6EUL, 0x5028D52AUL, 0x6839BA86UL,
+		0x200A0A72UL, 0x181B65DEUL, 0xFA2801D8UL, 0xC2396E74UL, 0x8A0ADE80UL, 0xB21BB12CUL,
+		0x1A6DBF68UL, 0x227CD0C4UL, 0x6A4F6030UL, 0x525E0F9CUL, 0x3F4F0A49UL, 0x075E65E5UL,
+		0x4F6DD511UL, 0x777CBABDUL, 0xDF0AB4F9UL, 0xE71BDB55UL, 0xAF286BA1UL, 0x9739040DUL,
+		0x59F3BFF2UL, 0x61E2D05EUL, 0x29D160AAUL, 0x11C00F06UL, 0xB9B60142UL, 0x81A76EEEUL,
+		0xC994DE1AUL, 0xF185B1B6UL, 0x9C94B463UL, 0xA485DBCFUL, 0xECB66B3BUL, 0xD4A70497UL,
+		0x7CD10AD3UL, 0x44C0657FUL, 0x0CF3D58BUL, 0x34E2BA27UL, 0xD6D1DE21UL, 0xEEC0B18DUL,
+		0xA6F30179UL, 0x9EE26ED5UL, 0x36946091UL, 0x0E850F3DUL, 0x46B6BFC9UL, 0x7EA7D065UL,
+		0x13B6D5B0UL, 0x2BA7BA1CUL, 0x63940AE8UL, 0x5B856544UL, 0xF3F36B00UL, 0xCBE204ACUL,
+		0x83D1B458UL, 0xBBC0DBF4UL, 0x425B0AA5UL, 0x7A4A6509UL, 0x3279D5FDUL, 0x0A68BA51UL,
+		0xA21EB415UL, 0x9A0FDBB9UL, 0xD23C6B4DUL, 0xEA2D04E1UL, 0x873C0134UL, 0xBF2D6E98UL,
+		0xF71EDE6CUL, 0xCF0FB1C0UL, 0x6779BF84UL, 0x5F68D028UL, 0x175B60DCUL, 0x2F4A0F70UL,
+		0xCD796B76UL, 0xF56804DAUL, 0xBD5BB42EUL, 0x854ADB82UL, 0x2D3CD5C6UL, 0x152DBA6AUL,
+		0x5D1E0A9EUL, 0x650F6532UL, 0x081E60E7UL, 0x300F0F4BUL, 0x783CBFBFUL, 0x402DD013UL,
+		0xE85BDE57UL, 0xD04AB1FBUL, 0x9879010FUL, 0xA0686EA3UL,
+	},
+	{
+		0x00000000UL, 0xEF306B19UL, 0xDB8CA0C3UL, 0x34BCCBDAUL, 0xB2F53777UL, 0x5DC55C6EUL,
+		0x697997B4UL, 0x8649FCADUL, 0x6006181FUL, 0x8F367306UL, 0xBB8AB8DCUL, 0x54BAD3C5UL,
+		0xD2F32F68UL, 0x3DC34471UL, 0x097F8FABUL, 0xE64FE4B2UL, 0xC00C303EUL, 0x2F3C5B27UL,
+		0x1B8090FDUL, 0xF4B0FBE4UL, 0x72F90749UL, 0x9DC96C50UL, 0xA975A78AUL, 0x4645CC93UL,
+		0xA00A2821UL, 0x4F3A4338UL, 0x7B8688E2UL, 0x94B6E3FBUL, 0x12FF1F56UL, 0xFDCF744FUL,
+		0xC973BF95UL, 0x2643D48CUL, 0x85F4168DUL, 0x6AC47D94UL, 0x5E78B64EUL, 0xB148DD57UL,
+		0x370121FAUL, 0xD8314AE3UL, 0xEC8D8139UL, 0x03BDEA20UL, 0xE5F20E92UL, 0x0AC2658BUL,
+		0x3E7EAE51UL, 0xD14EC548UL, 0x570739E5UL, 0xB83752FCUL, 0x8C8B9926UL, 0x63BBF23FUL,
+		0x45F826B3UL, 0xAAC84DAAUL, 0x9E748670UL, 0x7144ED69UL, 0xF70D11C4UL, 0x183D7ADDUL,
+		0x2C81B107UL, 0xC3B1DA1EUL, 0x25FE3EACUL, 0xCACE55B5UL, 0xFE729E6FUL, 0x1142F576UL,
+		0x970B09DBUL, 0x783B62C2UL, 0x4C87A918UL, 0xA3B7C201UL, 0x0E045BEBUL, 0xE13430F2UL,
+		0xD588FB28UL, 0x3AB89031UL, 0xBCF16C9CUL, 0x53C10785UL, 0x677DCC5FUL, 0x884DA746UL,
+		0x6E0243F4UL, 0x813228EDUL, 0xB58EE337UL, 0x5ABE882EUL, 0xDCF77483UL, 0x33C71F9AUL,
+		0x077BD440UL, 0xE84BBF59UL, 0xCE086BD5UL, 0x213800CCUL, 0x1584CB16UL, 0xFAB4A00FUL,
+		0x7CFD5CA2UL, 0x93CD37BBUL, 0xA771FC61UL, 0x48419778UL, 0xAE0E73CAUL, 0x413E18D3UL,
+		0x7582D309UL, 0x9AB2B810UL, 0x1CFB44BDUL, 0xF3CB2FA4UL, 0xC777E47EUL, 0x28478F67UL,
+		0x8BF04D66UL, 0x64C0267FUL, 0x507CEDA5UL, 0xBF4C86BCUL, 0x39057A11UL, 0xD6351108UL,
+		0xE289DAD2UL, 0x0DB9B1CBUL, 0xEBF65579UL, 0x04C63E60UL, 0x307AF5BAUL, 0xDF4A9EA3UL,
+		0x5903620EUL, 0xB6330917UL, 0x828FC2CDUL, 0x6DBFA9D4UL, 0x4BFC7D58UL, 0xA4CC1641UL,
+		0x9070DD9BUL, 0x7F40B682UL, 0xF9094A2FUL, 0x16392136UL, 0x2285EAECUL, 0xCDB581F5UL,
+		0x2BFA6547UL, 0xC4CA0E5EUL, 0xF076C584UL, 0x1F46AE9DUL, 0x990F5230UL, 0x763F3929UL,
+		0x4283F2F3UL, 0xADB399EAUL, 0x1C08B7D6UL, 0xF338DCCFUL, 0xC7841715UL, 0x28B47C0CUL,
+		0xAEFD80A1UL, 0x41CDEBB8UL, 0x75712062UL, 0x9A414B7BUL, 0x7C0EAFC9UL, 0x933EC4D0UL,
+		0xA7820F0AUL, 0x48B26413UL, 0xCEFB98BEUL, 0x21CBF3A7UL, 0x1577387DUL, 0xFA475364UL,
+		0xDC0487E8UL, 0x3334ECF1UL, 0x0788272BUL, 0xE8B84C32UL, 0x6EF1B09FUL, 0x81C1DB86UL,
+		0xB57D105CUL, 0x5A4D7B45UL, 0xBC029FF7UL, 0x5332F4EEUL, 0x678E3F34UL, 0x88BE542DUL,
+		0x0EF7A880UL, 0xE1C7C399UL, 0xD57B0843UL, 0x3A4B635AUL, 0x99FCA15BUL, 0x76CCCA42UL,
+		0x42700198UL, 0xAD406A81UL, 0x2B09962CUL, 0xC439FD35UL, 0xF08536EFUL, 0x1FB55DF6UL,
+		0xF9FAB944UL, 0x16CAD25DUL, 0x22761987UL, 0xCD46729EUL, 0x4B0F8E33UL, 0xA43FE52AUL,
+		0x90832EF0UL, 0x7FB345E9UL, 0x59F09165UL, 0xB6C0FA7CUL, 0x827C31A6UL, 0x6D4C5ABFUL,
+		0xEB05A612UL, 0x0435CD0BUL, 0x308906D1UL, 0xDFB96DC8UL, 0x39F6897AUL, 0xD6C6E263UL,
+		0xE27A29B9UL, 0x0D4A42A0UL, 0x8B03BE0DUL, 0x6433D514UL, 0x508F1ECEUL, 0xBFBF75D7UL,
+		0x120CEC3DUL, 0xFD3C8724UL, 0xC9804CFEUL, 0x26B027E7UL, 0xA0F9DB4AUL, 0x4FC9B053UL,
+		0x7B757B89UL, 0x94451090UL, 0x720AF422UL, 0x9D3A9F3BUL, 0xA98654E1UL, 0x46B63FF8UL,
+		0xC0FFC355UL, 0x2FCFA84CUL, 0x1B736396UL, 0xF443088FUL, 0xD200DC03UL, 0x3D30B71AUL,
+		0x098C7CC0UL, 0xE6BC17D9UL, 0x60F5EB74UL, 0x8FC5806DUL, 0xBB794BB7UL, 0x544920AEUL,
+		0xB206C41CUL, 0x5D36AF05UL, 0x698A64DFUL, 0x86BA0FC6UL, 0x00F3F36BUL, 0xEFC39872UL,
+		0xDB7F53A8UL, 0x344F38B1UL, 0x97F8FAB0UL, 0x78C891A9UL, 0x4C745A73UL, 0xA344316AUL,
+		0x250DCDC7UL, 0xCA3DA6DEUL, 0xFE816D04UL, 0x11B1061DUL, 0xF7FEE2AFUL, 0x18CE89B6UL,
+		0x2C72426CUL, 0xC3422975UL, 0x450BD5D8UL, 0xAA3BBEC1UL, 0x9E87751BUL, 0x71B71E02UL,
+		0x57F4CA8EUL, 0xB8C4A197UL, 0x8C786A4DUL, 0x63480154UL, 0xE501FDF9UL, 0x0A3196E0UL,
+		0x3E8D5D3AUL, 0xD1BD3623UL, 0x37F2D291UL, 0xD8C2B988UL, 0xEC7E7252UL, 0x034E194BUL,
+		0x8507E5E6UL, 0x6A378EFFUL, 0x5E8B4525UL, 0xB1BB2E3CUL,
+	},
+	{
+		0x00000000UL, 0x68032CC8UL, 0xD0065990UL, 0xB8057558UL, 0xA5E0C5D1UL, 0xCDE3E919UL,
+		0x75E69C41UL, 0x1DE5B089UL, 0x4E2DFD53UL, 0x262ED19BUL, 0x9E2BA4C3UL, 0xF628880BUL,
+		0xEBCD3882UL, 0x83CE144AUL, 0x3BCB6112UL, 0x53C84DDAUL, 0x9C5BFAA6UL, 0xF458D66EUL,
+		0x4C5DA336UL, 0x245E8FFEUL, 0x39BB3F77UL, 0x51B813BFUL, 0xE9BD66E7UL, 0x81BE4A2FUL,
+		0xD27607F5UL, 0xBA752B3DUL, 0x02705E65UL, 0x6A7372ADUL, 0x7796C224UL, 0x1F95EEECUL,
+		0xA7909BB4UL, 0xCF93B77CUL, 0x3D5B83BDUL, 0x5558AF75UL, 0xED5DDA2DUL, 0x855EF6E5UL,
+		0x98BB466CUL, 0xF0B86AA4UL, 0x48BD1FFCUL, 0x20BE3334UL, 0x73767EEEUL, 0x1B755226UL,
+		0xA370277EUL, 0xCB730BB6UL, 0xD696BB3FUL, 0xBE9597F7UL, 0x0690E2AFUL, 0x6E93CE67UL,
+		0xA100791BUL, 0xC90355D3UL, 0x7106208BUL, 0x19050C43UL, 0x04E0BCCAUL, 0x6CE39002UL,
+		0xD4E6E55AUL, 0xBCE5C992UL, 0xEF2D8448UL, 0x872EA880UL, 0x3F2BDDD8UL, 0x5728F110UL,
+		0x4ACD4199UL, 0x22CE6D51UL, 0x9ACB1809UL, 0xF2C834C1UL, 0x7AB7077AUL, 0x12B42BB2UL,
+		0xAAB15EEAUL, 0xC2B27222UL, 0xDF57C2ABUL, 0xB754EE63UL, 0x0F519B3BUL, 0x6752B7F3UL,
+		0x349AFA29UL, 0x5C99D6E1UL, 0xE49CA3B9UL, 0x8C9F8F71UL, 0x917A3FF8UL, 0xF9791330UL,
+		0x417C6668UL, 0x297F4AA0UL, 0xE6ECFDDCUL, 0x8EEFD114UL, 0x36EAA44CUL, 0x5EE98884UL,
+		0x430C380DUL, 0x2B0F14C5UL, 0x930A619DUL, 0xFB094D55UL, 0xA8C1008FUL, 0xC0C22C47UL,
+		0x78C7591FUL, 0x10C475D7UL, 0x0D21C55EUL, 0x6522E996UL, 0xDD279CCEUL, 0xB524B006UL,
+		0x47EC84C7UL, 0x2FEFA80FUL, 0x97EADD57UL, 0xFFE9F19FUL, 0xE20C4116UL, 0x8A0F6DDEUL,
+		0x320A1886UL, 0x5A09344EUL, 0x09C17994UL, 0x61C2555CUL, 0xD9C72004UL, 0xB1C40CCCUL,
+		0xAC21BC45UL, 0xC422908DUL, 0x7C27E5D5UL, 0x1424C91DUL, 0xDBB77E61UL, 0xB3B452A9UL,
+		0x0BB127F1UL, 0x63B20B39UL, 0x7E57BBB0UL, 0x16549778UL, 0xAE51E220UL, 0xC652CEE8UL,
+		0x959A8332UL, 0xFD99AFFAUL, 0x459CDAA2UL, 0x2D9FF66AUL, 0x307A46E3UL, 0x58796A2BUL,
+		0xE07C1F73UL, 0x887F33BBUL, 0xF56E0EF4UL, 0x9D6D223CUL, 0x25685764UL, 0x4D6B7BACUL,
+		0x508ECB25UL, 0x388DE7EDUL, 0x808892B5UL, 0xE88BBE7DUL, 0xBB43F3A7UL, 0xD340DF6FUL,
+		0x6B45AA37UL, 0x034686FFUL, 0x1EA33676UL, 0x76A01ABEUL, 0xCEA56FE6UL, 0xA6A6432EUL,
+		0x6935F452UL, 0x0136D89AUL, 0xB933ADC2UL, 0xD130810AUL, 0xCCD53183UL, 0xA4D61D4BUL,
+		0x1CD36813UL, 0x74D044DBUL, 0x27180901UL, 0x4F1B25C9UL, 0xF71E5091UL, 0x9F1D7C59UL,
+		0x82F8CCD0UL, 0xEAFBE018UL, 0x52FE9540UL, 0x3AFDB988UL, 0xC8358D49UL, 0xA036A181UL,
+		0x1833D4D9UL, 0x7030F811UL, 0x6DD54898UL, 0x05D66450UL, 0xBDD31108UL, 0xD5D03DC0UL,
+		0x8618701AUL, 0xEE1B5CD2UL, 0x561E298AUL, 0x3E1D0542UL, 0x23F8B5CBUL, 0x4BFB9903UL,
+		0xF3FEEC5BUL, 0x9BFDC093UL, 0x546E77EFUL, 0x3C6D5B27UL, 0x84682E7FUL, 0xEC6B02B7UL,
+		0xF18EB23EUL, 0x998D9EF6UL, 0x2188EBAEUL, 0x498BC766UL, 0x1A438ABCUL, 0x7240A674UL,
+		0xCA45D32CUL, 0xA246FFE4UL, 0xBFA34F6DUL, 0xD7A063A5UL, 0x6FA516FDUL, 0x07A63A35UL,
+		0x8FD9098EUL, 0xE7DA2546UL, 0x5FDF501EUL, 0x37DC7CD6UL, 0x2A39CC5FUL, 0x423AE097UL,
+		0xFA3F95CFUL, 0x923CB907UL, 0xC1F4F4DDUL, 0xA9F7D815UL, 0x11F2AD4DUL, 0x79F18185UL,
+		0x6414310CUL, 0x0C171DC4UL, 0xB412689CUL, 0xDC114454UL, 0x1382F328UL, 0x7B81DFE0UL,
+		0xC384AAB8UL, 0xAB878670UL, 0xB66236F9UL, 0xDE611A31UL, 0x66646F69UL, 0x0E6743A1UL,
+		0x5DAF0E7BUL, 0x35AC22B3UL, 0x8DA957EBUL, 0xE5AA7B23UL, 0xF84FCBAAUL, 0x904CE762UL,
+		0x2849923AUL, 0x404ABEF2UL, 0xB2828A33UL, 0xDA81A6FBUL, 0x6284D3A3UL, 0x0A87FF6BUL,
+		0x17624FE2UL, 0x7F61632AUL, 0xC7641672UL, 0xAF673ABAUL, 0xFCAF7760UL, 0x94AC5BA8UL,
+		0x2CA92EF0UL, 0x44AA0238UL, 0x594FB2B1UL, 0x314C9E79UL, 0x8949EB21UL, 0xE14AC7E9UL,
+		0x2ED97095UL, 0x46DA5C5DUL, 0xFEDF2905UL, 0x96DC05CDUL, 0x8B39B544UL, 0xE33A998CUL,
+		0x5B3FECD4UL, 0x333CC01CUL, 0x60F48DC6UL, 0x08F7A10EUL, 0xB0F2D456UL, 0xD8F1F89EUL,
+		0xC5144817UL, 0xAD1764DFUL, 0x15121187UL, 0x7D113D4FUL,
+	},
+	{
+		0x00000000UL, 0x493C7D27UL, 0x9278FA4EUL, 0xDB448769UL, 0x211D826DUL, 0x6821FF4AUL,
+		0xB3657823UL, 0xFA590504UL, 0x423B04DAUL, 0x0B0779FDUL, 0xD043FE94UL, 0x997F83B3UL,
+		0x632686B7UL, 0x2A1AFB90UL, 0xF15E7CF9UL, 0xB86201DEUL, 0x847609B4UL, 0xCD4A7493UL,
+		0x160EF3FAUL, 0x5F328EDDUL, 0xA56B8BD9UL, 0xEC57F6FEUL, 0x37137197UL, 0x7E2F0CB0UL,
+		0xC64D0D6EUL, 0x8F717049UL, 0x5435F720UL, 0x1D098A07UL, 0xE7508F03UL, 0xAE6CF224UL,
+		0x7528754DUL, 0x3C14086AUL, 0x0D006599UL, 0x443C18BEUL, 0x9F789FD7UL, 0xD644E2F0UL,
+		0x2C1DE7F4UL, 0x65219AD3UL, 0xBE651DBAUL, 0xF759609DUL, 0x4F3B6143UL, 0x06071C64UL,
+		0xDD439B0DUL, 0x947FE62AUL, 0x6E26E32EUL, 0x271A9E09UL, 0xFC5E1960UL, 0xB5626447UL,
+		0x89766C2DUL, 0xC04A110AUL, 0x1B0E9663UL, 0x5232EB44UL, 0xA86BEE40UL, 0xE1579367UL,
+		0x3A13140EUL, 0x732F6929UL, 0xCB4D68F7UL, 0x827115D0UL, 0x593592B9UL, 0x1009EF9EUL,
+		0xEA50EA9AUL, 0xA36C97BDUL, 0x782810D4UL, 0x31146DF3UL, 0x1A00CB32UL, 0x533CB615UL,
+		0x8878317CUL, 0xC1444C5BUL, 0x3B1D495FUL, 0x72213478UL, 0xA965B311UL, 0xE059CE36UL,
+		0x583BCFE8UL, 0x1107B2CFUL, 0xCA4335A6UL, 0x837F4881UL, 0x79264D85UL, 0x301A30A2UL,
+		0xEB5EB7CBUL, 0xA262CAECUL, 0x9E76C286UL, 0xD74ABFA1UL, 0x0C0E38C8UL, 0x453245EFUL,
+		0xBF6B40EBUL, 0xF6573DCCUL, 0x2D13BAA5UL, 0x642FC782UL, 0xDC4DC65CUL, 0x9571BB7BUL,
+		0x4E353C12UL, 0x07094135UL, 0xFD504431UL, 0xB46C3916UL, 0x6F28BE7FUL, 0x2614C358UL,
+		0x1700AEABUL, 0x5E3CD38CUL, 0x857854E5UL, 0xCC4429C2UL, 0x361D2CC6UL, 0x7F2151E1UL,
+		0xA465D688UL, 0xED59ABAFUL, 0x553BAA71UL, 0x1C07D756UL, 0xC743503FUL, 0x8E7F2D18UL,
+		0x7426281CUL, 0x3D1A553BUL, 0xE65ED252UL, 0xAF62AF75UL, 0x9376A71FUL, 0xDA4ADA38UL,
+		0x010E5D51UL, 0x48322076UL, 0xB26B2572UL, 0xFB575855UL, 0x2013DF3CUL, 0x692FA21BUL,
+		0xD14DA3C5UL, 0x9871DEE2UL, 0x4335598BUL, 0x0A0924ACUL, 0xF05021A8UL, 0xB96C5C8FUL,
+		0x6228DBE6UL, 0x2B14A6C1UL, 0x34019664UL, 0x7D3DEB43UL, 0xA6796C2AUL, 0xEF45110DUL,
+		0x151C1409UL, 0x5C20692EUL, 0x8764EE47UL, 0xCE589360UL, 0x763A92BEUL, 0x3F06EF99UL,
+		0xE44268F0UL, 0xAD7E15D7UL, 0x572710D3UL, 0x1E1B6DF4UL, 0xC55FEA9DUL, 0x8C6397BAUL,
+		0xB0779FD0UL, 0xF94BE2F7UL, 0x220F659EUL, 0x6B3318B9UL, 0x916A1DBDUL, 0xD856609AUL,
+		0x0312E7F3UL, 0x4A2E9AD4UL, 0xF24C9B0AUL, 0xBB70E62DUL, 0x60346144UL, 0x29081C63UL,
+		0xD3511967UL, 0x9A6D6440UL, 0x4129E329UL, 0x08159E0EUL, 0x3901F3FDUL, 0x703D8EDAUL,
+		0xAB7909B3UL, 0xE2457494UL, 0x181C7190UL, 0x51200CB7UL, 0x8A648BDEUL, 0xC358F6F9UL,
+		0x7B3AF727UL, 0x32068A00UL, 0xE9420D69UL, 0xA07E704EUL, 0x5A27754AUL, 0x131B086DUL,
+		0xC85F8F04UL, 0x8163F223UL, 0xBD77FA49UL, 0xF44B876EUL, 0x2F0F0007UL, 0x66337D20UL,
+		0x9C6A7824UL, 0xD5560503UL, 0x0E12826AUL, 0x472EFF4DUL, 0xFF4CFE93UL, 0xB67083B4UL,
+		0x6D3404DDUL, 0x240879FAUL, 0xDE517CFEUL, 0x976D01D9UL, 0x4C2986B0UL, 0x0515FB97UL,
+		0x2E015D56UL, 0x673D2071UL, 0xBC79A718UL, 0xF545DA3FUL, 0x0F1CDF3BUL, 0x4620A21CUL,
+		0x9D642575UL, 0xD4585852UL, 0x6C3A598CUL, 0x250624ABUL, 0xFE42A3C2UL, 0xB77EDEE5UL,
+		0x4D27DBE1UL, 0x041BA6C6UL, 0xDF5F21AFUL, 0x96635C88UL, 0xAA7754E2UL, 0xE34B29C5UL,
+		0x380FAEACUL, 0x7133D38BUL, 0x8B6AD68FUL, 0xC256ABA8UL, 0x19122CC1UL, 0x502E51E6UL,
+		0xE84C5038UL, 0xA1702D1FUL, 0x7A34AA76UL, 0x3308D751UL, 0xC951D255UL, 0x806DAF72UL,
+		0x5B29281BUL, 0x1215553CUL, 0x230138CFUL, 0x6A3D45E8UL, 0xB179C281UL, 0xF845BFA6UL,
+		0x021CBAA2UL, 0x4B20C785UL, 0x906440ECUL, 0xD9583DCBUL, 0x613A3C15UL, 0x28064132UL,
+		0xF342C65BUL, 0xBA7EBB7CUL, 0x4027BE78UL, 0x091BC35FUL, 0xD25F4436UL, 0x9B633911UL,
+		0xA777317BUL, 0xEE4B4C5CUL, 0x350FCB35UL, 0x7C33B612UL, 0x866AB316UL, 0xCF56CE31UL,
+		0x14124958UL, 0x5D2E347FUL, 0xE54C35A1UL, 0xAC704886UL, 0x7734CFEFUL, 0x3E08B2C8UL,
+		0xC451B7CCUL, 0x8D6DCAEBUL, 0x56294D82UL, 0x1F1530A5UL,
+	},
+#endif
+};
+#else
 /* crc table generated from polynomial 0x1EDC6F41UL (Castagnoli) */
 static const uint32_t crc32c_table[16] = {
 	0x00000000UL, 0x105EC76FUL, 0x20BD8EDEUL, 0x30E349B1UL, 0x417B1DBCUL, 0x5125DAD3UL,
 	0x61C69362UL, 0x7198540DUL, 0x82F63B78UL, 0x92A8FC17UL, 0xA24BB5A6UL, 0xB21572C9UL,
 	0xC38D26C4UL, 0xD3D3E1ABUL, 0xE330A81AUL, 0xF36E6F75UL,
 };
+#endif
 
 /* This value needs to be XORed with the final crc value once crc for
  * the entire stream is calculated. This is a requirement of crc32c algo.
@@ -30,10 +429,22 @@ uint32_t __weak crc32_c(uint32_t crc, const uint8_t *data, size_t len, bool firs
 		crc = CRC32C_INIT;
 	}
 
+#if defined(CRC32C_ARM_CRC32) || defined(CRC32C_SSE42)
+	for (; len >= sizeof(uint64_t); len -= sizeof(uint64_t), data += sizeof(uint64_t)) {
+		crc = crc32c_u64(crc, sys_get_le64(data));
+	}
+
+	for (; len > 0; len--) {
+		crc = crc32c_u8(crc, *data++);
+	}
+#elif defined(CRC32_SLICES)
+	crc = crc32_slicing_update(crc32c_slices, crc, data, len);
+#else
 	for (size_t i = 0; i < len; i++) {
 		crc = crc32c_table[(crc ^ data[i]) & 0x0F] ^ (crc >> 4);
 		crc = crc32c_table[(crc ^ ((uint32_t)data[i] >> 4)) & 0x0F] ^ (crc >> 4);
 	}
+#endif
 
 	return last_pkt ? (crc ^ CRC32C_XOR_OUT) : crc;
 }
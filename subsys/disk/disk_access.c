@@ -14,6 +14,8 @@
 #include <errno.h>
 #include <zephyr/device.h>
 
+#include "disk_cache.h"
+
 #define LOG_LEVEL CONFIG_DISK_LOG_LEVEL
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(disk);
@@ -24,6 +26,21 @@ static sys_dlist_t disk_access_list = SYS_DLIST_STATIC_INIT(&disk_access_list);
 /* lock to protect storage layer registration */
 static struct k_spinlock lock;
 
+/* Last disk resolved by name, most accesses go to the same disk */
+static struct disk_info *last_disk;
+
+static bool disk_name_match(const struct disk_info *disk, const char *name,
+			    size_t name_len)
+{
+	/* Callers usually pass the registered name itself */
+	if (disk->name == name) {
+		return true;
+	}
+
+	return strlen(disk->name) == name_len &&
+	       strncmp(name, disk->name, name_len) == 0;
+}
+
 struct disk_info *disk_access_get_di(const char *name)
 {
 	struct disk_info *disk = NULL, *itr;
@@ -31,24 +48,23 @@ struct disk_info *disk_access_get_di(const char *name)
 	sys_dnode_t *node;
 	k_spinlock_key_t spinlock_key = k_spin_lock(&lock);
 
+	if ((last_disk != NULL) && disk_name_match(last_disk, name, name_len)) {
+		disk = last_disk;
+		goto out;
+	}
+
 	SYS_DLIST_FOR_EACH_NODE(&disk_access_list, node) {
 		itr = CONTAINER_OF(node, struct disk_info, node);
 
-		/*
-		 * Move to next node if mount point length is
-		 * shorter than longest_match match or if path
-		 * name is shorter than the mount point name.
-		 */
-		if (strlen(itr->name) != name_len) {
-			continue;
-		}
-
 		/* Check for disk name match */
-		if (strncmp(name, itr->name, name_len) == 0) {
+		if (disk_name_match(itr, name, name_len)) {
 			disk = itr;
+			last_disk = itr;
 			break;
 		}
 	}
+
+out:
 	k_spin_unlock(&lock, spinlock_key);
 
 	return disk;
@@ -66,6 +82,9 @@ int disk_access_init(const char *pdrv)
 			if (rc == 0) {
 				/* Increment reference count */
 				disk->refcnt++;
+				if (IS_ENABLED(CONFIG_DISK_CACHE)) {
+					disk_cache_attach(disk);
+				}
 			}
 		}
 	} else if ((disk != NULL) && (disk->refcnt < UINT16_MAX)) {
@@ -98,7 +117,13 @@ int disk_access_read(const char *pdrv, uint8_t *data_buf,
 
 	if ((disk != NULL) && (disk->ops != NULL) &&
 				(disk->ops->read != NULL)) {
-		rc = disk->ops->read(disk, data_buf, start_sector, num_sector);
+		if (IS_ENABLED(CONFIG_DISK_CACHE)) {
+			rc = disk_cache_read(disk, data_buf, start_sector,
+					     num_sector);
+		} else {
+			rc = disk->ops->read(disk, data_buf, start_sector,
+					     num_sector);
+		}
 	}
 
 	return rc;
@@ -112,7 +137,13 @@ int disk_access_write(const char *pdrv, const uint8_t *data_buf,
 
 	if ((disk != NULL) && (disk->ops != NULL) &&
 				(disk->ops->write != NULL)) {
-		rc = disk->ops->write(disk, data_buf, start_sector, num_sector);
+		if (IS_ENABLED(CONFIG_DISK_CACHE)) {
+			rc = disk_cache_write(disk, data_buf, start_sector,
+					      num_sector);
+		} else {
+			rc = disk->ops->write(disk, data_buf, start_sector,
+					      num_sector);
+		}
 	}
 
 	return rc;
@@ -131,6 +162,9 @@ int disk_access_ioctl(const char *pdrv, uint8_t cmd, void *buf)
 				rc = disk->ops->ioctl(disk, cmd, buf);
 				if (rc == 0) {
 					disk->refcnt++;
+					if (IS_ENABLED(CONFIG_DISK_CACHE)) {
+						disk_cache_attach(disk);
+					}
 				}
 			} else if (disk->refcnt < UINT16_MAX) {
 				disk->refcnt++;
@@ -142,10 +176,19 @@ int disk_access_ioctl(const char *pdrv, uint8_t cmd, void *buf)
 		case DISK_IOCTL_CTRL_DEINIT:
 			if ((buf != NULL) && (*((bool *)buf))) {
 				/* Force deinit disk */
+				if (IS_ENABLED(CONFIG_DISK_CACHE)) {
+					(void)disk_cache_detach(disk);
+				}
 				disk->refcnt = 0U;
 				disk->ops->ioctl(disk, cmd, buf);
 				rc = 0;
 			} else if (disk->refcnt == 1U) {
+				if (IS_ENABLED(CONFIG_DISK_CACHE)) {
+					rc = disk_cache_detach(disk);
+					if (rc < 0) {
+						break;
+					}
+				}
 				rc = disk->ops->ioctl(disk, cmd, buf);
 				if (rc == 0) {
 					disk->refcnt--;
@@ -157,6 +200,15 @@ int disk_access_ioctl(const char *pdrv, uint8_t cmd, void *buf)
 				LOG_WRN("Disk is already deinitialized");
 			}
 			break;
+		case DISK_IOCTL_CTRL_SYNC:
+			if (IS_ENABLED(CONFIG_DISK_CACHE)) {
+				rc = disk_cache_sync(disk);
+				if (rc < 0) {
+					break;
+				}
+			}
+			rc = disk->ops->ioctl(disk, cmd, buf);
+			break;
 		default:
 			rc = disk->ops->ioctl(disk, cmd, buf);
 		}
@@ -204,9 +256,16 @@ int disk_access_unregister(struct disk_info *disk)
 		return -EINVAL;
 	}
 
+	if (IS_ENABLED(CONFIG_DISK_CACHE)) {
+		(void)disk_cache_detach(disk);
+	}
+
 	spinlock_key = k_spin_lock(&lock);
 	/* remove disk node from the list */
 	sys_dlist_remove(&disk->node);
+	if (last_disk == disk) {
+		last_disk = NULL;
+	}
 	k_spin_unlock(&lock, spinlock_key);
 	LOG_DBG("disk interface(%s) unregistered", disk->name);
 	return 0;
@@ -0,0 +1,70 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/rtio/work.h>
+#include <zephyr/storage/disk_access.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(disk, CONFIG_DISK_LOG_LEVEL);
+
+static int disk_iodev_execute(const char *pdrv, const struct rtio_sqe *sqe)
+{
+	switch (sqe->op) {
+	case RTIO_OP_NOP:
+		return 0;
+	case RTIO_OP_STORAGE_READ:
+		return disk_access_read(pdrv, sqe->storage.rx_buf,
+					sqe->storage.offset, sqe->storage.len);
+	case RTIO_OP_STORAGE_WRITE:
+		return disk_access_write(pdrv, sqe->storage.tx_buf,
+					 sqe->storage.offset, sqe->storage.len);
+	case RTIO_OP_STORAGE_ERASE:
+		/* Disks handle erasing internally */
+		return -ENOTSUP;
+	default:
+		LOG_ERR("Invalid op code %d for submission %p", sqe->op, (void *)sqe);
+		return -EIO;
+	}
+}
+
+static void disk_iodev_submit_work_handler(struct rtio_iodev_sqe *txn_first)
+{
+	const char *pdrv = txn_first->sqe.iodev->data;
+	struct rtio_iodev_sqe *txn_curr = txn_first;
+	int rc;
+
+	LOG_DBG("Sync RTIO work item for: %p", (void *)txn_first);
+
+	/* Operations of a transaction run back to back in submission order */
+	do {
+		rc = disk_iodev_execute(pdrv, &txn_curr->sqe);
+		txn_curr = rtio_txn_next(txn_curr);
+	} while (rc == 0 && txn_curr != NULL);
+
+	if (rc != 0) {
+		rtio_iodev_sqe_err(txn_first, rc);
+	} else {
+		rtio_iodev_sqe_ok(txn_first, 0);
+	}
+}
+
+static void disk_iodev_submit(struct rtio_iodev_sqe *iodev_sqe)
+{
+	struct rtio_work_req *req = rtio_work_req_alloc();
+
+	if (req == NULL) {
+		rtio_iodev_sqe_err(iodev_sqe, -ENOMEM);
+		return;
+	}
+
+	rtio_work_req_submit(req, iodev_sqe, disk_iodev_submit_work_handler);
+}
+
+const struct rtio_iodev_api disk_access_iodev_api = {
+	.submit = disk_iodev_submit,
+};
@@ -0,0 +1,625 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <errno.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/dlist.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/drivers/disk.h>
+#include <zephyr/storage/disk_access.h>
+
+#include "disk_cache.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(disk, CONFIG_DISK_LOG_LEVEL);
+
+#define SECTOR_SIZE CONFIG_DISK_CACHE_SECTOR_SIZE
+
+/* Requests spanning more sectors than this go straight to the driver, so
+ * that large sequential transfers neither thrash the cache nor lose the
+ * benefit of multi-sector driver operations.
+ */
+#define BYPASS_THRESHOLD MAX(CONFIG_DISK_CACHE_BLOCKS / 2, 1)
+
+/*
+ * Locking: each disk has its own cache_lock, held for the whole of a cache
+ * operation on that disk, so that only one thread at a time adds, fills or
+ * overwrites blocks of a given disk. The global cache_lock protects the LRU
+ * list, the block ownership and the statistics, and is released around
+ * every driver call so that a slow disk does not hold up the others. A
+ * block being transferred to or from its disk without the global lock is
+ * marked busy; it is neither reused nor modified until the transfer is
+ * done, which is signaled through cache_idle.
+ */
+
+struct disk_cache_block {
+	/* Position in the LRU list, most recently used first */
+	sys_dnode_t node;
+	/* Owning disk, NULL if the block holds no data */
+	struct disk_info *disk;
+	uint32_t sector;
+	bool dirty;
+	/* Being read or written back without the global lock held */
+	bool busy;
+	uint8_t data[SECTOR_SIZE] __aligned(sizeof(void *));
+};
+
+static struct disk_cache_block cache_blocks[CONFIG_DISK_CACHE_BLOCKS];
+static sys_dlist_t cache_lru = SYS_DLIST_STATIC_INIT(&cache_lru);
+static bool cache_ready;
+static K_MUTEX_DEFINE(cache_lock);
+static K_CONDVAR_DEFINE(cache_idle);
+static struct disk_cache_stats cache_stats;
+
+#if CONFIG_DISK_CACHE_READ_AHEAD > 0
+/* Next sector of the last read, used to detect sequential access */
+static struct disk_info *ra_disk;
+static uint32_t ra_next;
+/* Set while a disk reads ahead into ra_buf */
+static bool ra_busy;
+static uint8_t ra_buf[(CONFIG_DISK_CACHE_READ_AHEAD + 1) * SECTOR_SIZE]
+	__aligned(sizeof(void *));
+#endif
+
+#if defined(CONFIG_DISK_CACHE_WRITE_BACK)
+static void cache_flush_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(cache_flush_work, cache_flush_handler);
+#endif
+
+static void cache_init(void)
+{
+	if (cache_ready) {
+		return;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(cache_blocks); i++) {
+		sys_dlist_append(&cache_lru, &cache_blocks[i].node);
+	}
+
+	cache_ready = true;
+}
+
+static void cache_wait_idle(void)
+{
+	(void)k_condvar_wait(&cache_idle, &cache_lock, K_FOREVER);
+}
+
+static struct disk_cache_block *cache_find(struct disk_info *disk,
+					   uint32_t sector)
+{
+	struct disk_cache_block *blk;
+
+	SYS_DLIST_FOR_EACH_CONTAINER(&cache_lru, blk, node) {
+		if (blk->disk == disk && blk->sector == sector) {
+			return blk;
+		}
+	}
+
+	return NULL;
+}
+
+/* Find a cached sector, waiting for a pending write back of it */
+static struct disk_cache_block *cache_lookup(struct disk_info *disk,
+					     uint32_t sector)
+{
+	struct disk_cache_block *blk;
+
+	while (true) {
+		blk = cache_find(disk, sector);
+		if (blk == NULL || !blk->busy) {
+			return blk;
+		}
+
+		cache_wait_idle();
+	}
+}
+
+static void cache_touch(struct disk_cache_block *blk)
+{
+	sys_dlist_remove(&blk->node);
+	sys_dlist_prepend(&cache_lru, &blk->node);
+}
+
+/* Drop the data of a block and make it the first one to be reused */
+static void cache_invalidate(struct disk_cache_block *blk)
+{
+	blk->disk = NULL;
+	blk->dirty = false;
+	sys_dlist_remove(&blk->node);
+	sys_dlist_append(&cache_lru, &blk->node);
+}
+
+/* The global lock is released while the block is written */
+static int cache_writeback(struct disk_cache_block *blk)
+{
+	struct disk_info *disk = blk->disk;
+	int rc;
+
+	if (!blk->dirty) {
+		return 0;
+	}
+
+	blk->busy = true;
+	k_mutex_unlock(&cache_lock);
+
+	rc = disk->ops->write(disk, blk->data, blk->sector, 1);
+
+	(void)k_mutex_lock(&cache_lock, K_FOREVER);
+	blk->busy = false;
+	(void)k_condvar_broadcast(&cache_idle);
+
+	if (rc < 0) {
+		LOG_ERR("Write back of sector %u failed (%d)", blk->sector, rc);
+		return rc;
+	}
+
+	blk->dirty = false;
+	cache_stats.writebacks++;
+
+	return 0;
+}
+
+/* Take over the least recently used idle block for a new sector, writing
+ * it back first if needed.
+ */
+static struct disk_cache_block *cache_evict(struct disk_info *disk,
+					    uint32_t sector, int *rc)
+{
+	struct disk_cache_block *blk;
+	sys_dnode_t *node;
+
+	while (true) {
+		node = sys_dlist_peek_tail(&cache_lru);
+		while (node != NULL &&
+		       CONTAINER_OF(node, struct disk_cache_block, node)->busy) {
+			node = sys_dlist_peek_prev(&cache_lru, node);
+		}
+
+		if (node == NULL) {
+			cache_wait_idle();
+			continue;
+		}
+
+		blk = CONTAINER_OF(node, struct disk_cache_block, node);
+		if (!blk->dirty) {
+			break;
+		}
+
+		/* Once written back the block is clean and idle, but other
+		 * blocks may have been used meanwhile, so look again.
+		 */
+		*rc = cache_writeback(blk);
+		if (*rc < 0) {
+			return NULL;
+		}
+	}
+
+	blk->disk = disk;
+	blk->sector = sector;
+	blk->dirty = false;
+	cache_touch(blk);
+
+	return blk;
+}
+
+static int cache_flush(struct disk_info *disk, bool invalidate)
+{
+	int ret = 0;
+
+	/* The LRU list may be reordered while a block is written back, so
+	 * walk the block array instead.
+	 */
+	for (size_t i = 0; i < ARRAY_SIZE(cache_blocks); i++) {
+		struct disk_cache_block *blk = &cache_blocks[i];
+		int rc;
+
+		while (blk->busy && (disk == NULL || blk->disk == disk)) {
+			cache_wait_idle();
+		}
+
+		if (blk->disk == NULL || (disk != NULL && blk->disk != disk)) {
+			continue;
+		}
+
+		rc = cache_writeback(blk);
+		if (rc < 0) {
+			ret = rc;
+		}
+
+		/* A block that could not be written back is dropped too,
+		 * it must not outlive its disk.
+		 */
+		if (invalidate) {
+			cache_invalidate(blk);
+		}
+	}
+
+	return ret;
+}
+
+#if defined(CONFIG_DISK_CACHE_WRITE_BACK)
+static void cache_flush_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	(void)k_mutex_lock(&cache_lock, K_FOREVER);
+	(void)cache_flush(NULL, false);
+	k_mutex_unlock(&cache_lock);
+}
+#endif
+
+#if CONFIG_DISK_CACHE_READ_AHEAD > 0
+/* Read a missing sector together with the following ones, returns NULL
+ * with *rc set to 0 if the disk cannot be read ahead now.
+ */
+static struct disk_cache_block *cache_read_ahead(struct disk_info *disk,
+						 uint32_t sector, int *rc)
+{
+	struct disk_cache_block *blk = NULL;
+
+	if (ra_busy || disk != ra_disk || sector != ra_next ||
+	    CONFIG_DISK_CACHE_READ_AHEAD >= disk->cache_sectors - sector) {
+		return NULL;
+	}
+
+	ra_busy = true;
+	k_mutex_unlock(&cache_lock);
+
+	*rc = disk->ops->read(disk, ra_buf, sector,
+			      CONFIG_DISK_CACHE_READ_AHEAD + 1);
+
+	(void)k_mutex_lock(&cache_lock, K_FOREVER);
+
+	if (*rc < 0) {
+		/* Retry the requested sector alone */
+		*rc = 0;
+		goto out;
+	}
+
+	/* Insert the read ahead sectors first so that the requested one
+	 * ends up most recently used. Sectors already cached may be
+	 * newer than the disk.
+	 */
+	for (int i = CONFIG_DISK_CACHE_READ_AHEAD; i > 0; i--) {
+		if (cache_find(disk, sector + i) != NULL) {
+			continue;
+		}
+
+		blk = cache_evict(disk, sector + i, rc);
+		if (blk == NULL) {
+			goto out;
+		}
+
+		memcpy(blk->data, &ra_buf[i * SECTOR_SIZE], SECTOR_SIZE);
+		cache_stats.read_ahead++;
+	}
+
+	blk = cache_evict(disk, sector, rc);
+	if (blk != NULL) {
+		memcpy(blk->data, ra_buf, SECTOR_SIZE);
+	}
+
+out:
+	ra_busy = false;
+
+	return blk;
+}
+#endif
+
+/* Read a missing sector, together with the following ones if the disk is
+ * being read sequentially.
+ */
+static struct disk_cache_block *cache_fill(struct disk_info *disk,
+					   uint32_t sector, int *rc)
+{
+	struct disk_cache_block *blk;
+
+#if CONFIG_DISK_CACHE_READ_AHEAD > 0
+	blk = cache_read_ahead(disk, sector, rc);
+	if (blk != NULL || *rc < 0) {
+		return blk;
+	}
+#endif
+
+	blk = cache_evict(disk, sector, rc);
+	if (blk == NULL) {
+		return NULL;
+	}
+
+	blk->busy = true;
+	k_mutex_unlock(&cache_lock);
+
+	*rc = disk->ops->read(disk, blk->data, sector, 1);
+
+	(void)k_mutex_lock(&cache_lock, K_FOREVER);
+	blk->busy = false;
+	(void)k_condvar_broadcast(&cache_idle);
+
+	if (*rc < 0) {
+		cache_invalidate(blk);
+		return NULL;
+	}
+
+	return blk;
+}
+
+static bool cache_in_range(const struct disk_cache_block *blk,
+			   const struct disk_info *disk,
+			   uint32_t start_sector, uint32_t num_sector)
+{
+	return blk->disk == disk && blk->sector >= start_sector &&
+	       blk->sector - start_sector < num_sector;
+}
+
+/* Copy cached sectors over data read directly from the disk. Cached
+ * sectors are never older than the disk, even once written back while the
+ * disk was being read.
+ */
+static void cache_overlay(struct disk_info *disk, uint8_t *data_buf,
+			  uint32_t start_sector, uint32_t num_sector)
+{
+	struct disk_cache_block *blk;
+
+	SYS_DLIST_FOR_EACH_CONTAINER(&cache_lru, blk, node) {
+		if (cache_in_range(blk, disk, start_sector, num_sector)) {
+			memcpy(&data_buf[(blk->sector - start_sector) * SECTOR_SIZE],
+			       blk->data, SECTOR_SIZE);
+		}
+	}
+}
+
+/* Discard pending writes of sectors about to be written directly, so that
+ * no write back can land after the new data.
+ */
+static void cache_discard_dirty(struct disk_info *disk, uint32_t start_sector,
+				uint32_t num_sector)
+{
+	struct disk_cache_block *blk;
+
+	for (size_t i = 0; i < ARRAY_SIZE(cache_blocks); i++) {
+		blk = &cache_blocks[i];
+
+		while (cache_in_range(blk, disk, start_sector, num_sector)) {
+			if (!blk->busy) {
+				blk->dirty = false;
+				break;
+			}
+
+			cache_wait_idle();
+		}
+	}
+}
+
+/* Refresh cached sectors with data written directly to the disk, or drop
+ * them if the write failed and the disk content is unknown.
+ */
+static void cache_update_clean(struct disk_info *disk, const uint8_t *data_buf,
+			       uint32_t start_sector, uint32_t num_sector)
+{
+	struct disk_cache_block *blk;
+
+	for (size_t i = 0; i < ARRAY_SIZE(cache_blocks); i++) {
+		blk = &cache_blocks[i];
+
+		if (!cache_in_range(blk, disk, start_sector, num_sector)) {
+			continue;
+		}
+
+		if (data_buf == NULL) {
+			cache_invalidate(blk);
+		} else {
+			memcpy(blk->data,
+			       &data_buf[(blk->sector - start_sector) * SECTOR_SIZE],
+			       SECTOR_SIZE);
+		}
+	}
+}
+
+/* Lock a disk for a cache operation, returns false if it is not cached */
+static bool cache_lock_disk(struct disk_info *disk)
+{
+	(void)k_mutex_lock(&disk->cache_lock, K_FOREVER);
+
+	/* The disk may have been detached while waiting */
+	if (disk->cache_sectors == 0) {
+		k_mutex_unlock(&disk->cache_lock);
+		return false;
+	}
+
+	(void)k_mutex_lock(&cache_lock, K_FOREVER);
+	cache_init();
+
+	return true;
+}
+
+static void cache_unlock_disk(struct disk_info *disk)
+{
+	k_mutex_unlock(&cache_lock);
+	k_mutex_unlock(&disk->cache_lock);
+}
+
+void disk_cache_attach(struct disk_info *disk)
+{
+	uint32_t sector_size = 0;
+	uint32_t sector_count = 0;
+
+	disk->cache_sectors = 0;
+	k_mutex_init(&disk->cache_lock);
+
+	if (disk->ops->ioctl == NULL ||
+	    disk->ops->ioctl(disk, DISK_IOCTL_GET_SECTOR_SIZE, &sector_size) != 0 ||
+	    disk->ops->ioctl(disk, DISK_IOCTL_GET_SECTOR_COUNT, &sector_count) != 0) {
+		return;
+	}
+
+	if (sector_size != SECTOR_SIZE) {
+		LOG_DBG("Not caching %s, sector size %u", disk->name, sector_size);
+		return;
+	}
+
+	disk->cache_sectors = sector_count;
+}
+
+int disk_cache_detach(struct disk_info *disk)
+{
+	int rc;
+
+	if (disk->cache_sectors == 0 || !cache_lock_disk(disk)) {
+		return 0;
+	}
+
+	rc = cache_flush(disk, true);
+#if CONFIG_DISK_CACHE_READ_AHEAD > 0
+	if (ra_disk == disk) {
+		ra_disk = NULL;
+	}
+#endif
+	disk->cache_sectors = 0;
+
+	cache_unlock_disk(disk);
+
+	return rc;
+}
+
+int disk_cache_read(struct disk_info *disk, uint8_t *data_buf,
+		    uint32_t start_sector, uint32_t num_sector)
+{
+	struct disk_cache_block *blk;
+	int rc = 0;
+
+	if (disk->cache_sectors == 0 || !cache_lock_disk(disk)) {
+		return disk->ops->read(disk, data_buf, start_sector, num_sector);
+	}
+
+	if (num_sector > BYPASS_THRESHOLD) {
+		cache_stats.bypassed++;
+		k_mutex_unlock(&cache_lock);
+
+		rc = disk->ops->read(disk, data_buf, start_sector, num_sector);
+
+		(void)k_mutex_lock(&cache_lock, K_FOREVER);
+		if (rc == 0) {
+			cache_overlay(disk, data_buf, start_sector, num_sector);
+		}
+
+		goto out;
+	}
+
+	for (uint32_t i = 0; i < num_sector; i++) {
+		blk = cache_lookup(disk, start_sector + i);
+		if (blk != NULL) {
+			cache_stats.hits++;
+			cache_touch(blk);
+		} else {
+			cache_stats.misses++;
+			blk = cache_fill(disk, start_sector + i, &rc);
+			if (blk == NULL) {
+				break;
+			}
+		}
+
+		memcpy(&data_buf[i * SECTOR_SIZE], blk->data, SECTOR_SIZE);
+	}
+
+out:
+#if CONFIG_DISK_CACHE_READ_AHEAD > 0
+	ra_disk = disk;
+	ra_next = start_sector + num_sector;
+#endif
+	cache_unlock_disk(disk);
+
+	return rc;
+}
+
+int disk_cache_write(struct disk_info *disk, const uint8_t *data_buf,
+		     uint32_t start_sector, uint32_t num_sector)
+{
+	struct disk_cache_block *blk;
+	int rc = 0;
+
+	if (disk->cache_sectors == 0 || !cache_lock_disk(disk)) {
+		return disk->ops->write(disk, data_buf, start_sector, num_sector);
+	}
+
+	if (!IS_ENABLED(CONFIG_DISK_CACHE_WRITE_BACK) ||
+	    num_sector > BYPASS_THRESHOLD) {
+		cache_stats.bypassed++;
+		cache_discard_dirty(disk, start_sector, num_sector);
+		k_mutex_unlock(&cache_lock);
+
+		rc = disk->ops->write(disk, data_buf, start_sector, num_sector);
+
+		(void)k_mutex_lock(&cache_lock, K_FOREVER);
+		cache_update_clean(disk, rc == 0 ? data_buf : NULL,
+				   start_sector, num_sector);
+
+		goto out;
+	}
+
+	/* Sectors are only written back later, so reject a request the
+	 * driver would fail now.
+	 */
+	if (start_sector >= disk->cache_sectors ||
+	    num_sector > disk->cache_sectors - start_sector) {
+		rc = -EINVAL;
+		goto out;
+	}
+
+	for (uint32_t i = 0; i < num_sector; i++) {
+		blk = cache_lookup(disk, start_sector + i);
+		if (blk != NULL) {
+			cache_touch(blk);
+		} else {
+			blk = cache_evict(disk, start_sector + i, &rc);
+			if (blk == NULL) {
+				break;
+			}
+		}
+
+		memcpy(blk->data, &data_buf[i * SECTOR_SIZE], SECTOR_SIZE);
+		blk->dirty = true;
+	}
+
+#if defined(CONFIG_DISK_CACHE_WRITE_BACK)
+	/* Push the write back out while writes keep coming */
+	(void)k_work_reschedule(&cache_flush_work,
+				K_MSEC(CONFIG_DISK_CACHE_FLUSH_DELAY_MS));
+#endif
+
+out:
+	cache_unlock_disk(disk);
+
+	return rc;
+}
+
+int disk_cache_sync(struct disk_info *disk)
+{
+	int rc;
+
+	if (disk->cache_sectors == 0 || !cache_lock_disk(disk)) {
+		return 0;
+	}
+
+	rc = cache_flush(disk, false);
+	cache_unlock_disk(disk);
+
+	return rc;
+}
+
+void disk_cache_stats_get(struct disk_cache_stats *stats)
+{
+	(void)k_mutex_lock(&cache_lock, K_FOREVER);
+	*stats = cache_stats;
+	k_mutex_unlock(&cache_lock);
+}
+
+void disk_cache_stats_reset(void)
+{
+	(void)k_mutex_lock(&cache_lock, K_FOREVER);
+	memset(&cache_stats, 0, sizeof(cache_stats));
+	k_mutex_unlock(&cache_lock);
+}
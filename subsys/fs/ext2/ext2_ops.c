@@ -172,6 +172,39 @@ static ssize_t ext2_write(struct fs_file_t *filp, const void *src, size_t nbytes
 	return r;
 }
 
+#if defined(CONFIG_FILE_SYSTEM_VECTORED_IO)
+static ssize_t ext2_pread(struct fs_file_t *filp, void *dest, size_t nbytes, off_t off)
+{
+	struct ext2_file *f = filp->filep;
+
+	if ((f->f_flags & FS_O_READ) == 0) {
+		return -EACCES;
+	}
+
+	if (off >= f->f_inode->i_size) {
+		return 0;
+	}
+
+	return ext2_inode_read(f->f_inode, dest, off, nbytes);
+}
+
+static ssize_t ext2_pwrite(struct fs_file_t *filp, const void *src, size_t nbytes, off_t off)
+{
+	struct ext2_file *f = filp->filep;
+
+	if ((f->f_flags & FS_O_WRITE) == 0) {
+		return -EACCES;
+	}
+
+	/* Same limit as ext2_lseek, writes may not leave a hole */
+	if (off > f->f_inode->i_size) {
+		return -EINVAL;
+	}
+
+	return ext2_inode_write(f->f_inode, src, off, nbytes);
+}
+#endif /* CONFIG_FILE_SYSTEM_VECTORED_IO */
+
 static int ext2_lseek(struct fs_file_t *filp, off_t off, int whence)
 {
 	struct ext2_file *f = filp->filep;
@@ -631,6 +664,10 @@ static const struct fs_file_system_t ext2_fs = {
 	.tell = ext2_tell,
 	.truncate = ext2_truncate,
 	.sync = ext2_sync,
+#if defined(CONFIG_FILE_SYSTEM_VECTORED_IO)
+	.pread = ext2_pread,
+	.pwrite = ext2_pwrite,
+#endif
 	.mkdir = ext2_mkdir,
 	.opendir = ext2_opendir,
 	.readdir = ext2_readdir,
@@ -26,8 +26,31 @@ LOG_MODULE_DECLARE(fs, CONFIG_FS_LOG_LEVEL);
 K_MEM_SLAB_DEFINE(fatfs_dirp_pool, sizeof(DIR),
 			CONFIG_FS_FATFS_NUM_DIRS, 4);
 
+#if defined(CONFIG_FS_FATFS_FASTSEEK)
+/* FatFs file object with the storage for its cluster link map */
+struct fatfs_file {
+	FIL fil;
+	/* The link map must be rebuilt, the file has grown since it was built */
+	bool map_stale;
+	DWORD clmt[CONFIG_FS_FATFS_FASTSEEK_MAP_SIZE];
+};
+
+#define FATFS_FILE_SIZE sizeof(struct fatfs_file)
+#else
+#define FATFS_FILE_SIZE sizeof(FIL)
+#endif /* CONFIG_FS_FATFS_FASTSEEK */
+
+/*
+ * Whole sectors spanning contiguous clusters are transferred directly with
+ * the disk, bypassing FatFs. This relies on the volume not being accessed
+ * concurrently, as the FatFs volume lock is not taken.
+ */
+#if defined(CONFIG_FS_FATFS_FASTSEEK) && !defined(CONFIG_FS_FATFS_REENTRANT)
+#define FATFS_DIRECT_IO 1
+#endif
+
 /* Memory pool for FatFs file objects */
-K_MEM_SLAB_DEFINE(fatfs_filep_pool, sizeof(FIL),
+K_MEM_SLAB_DEFINE(fatfs_filep_pool, FATFS_FILE_SIZE,
 			CONFIG_FS_FATFS_NUM_FILES, 4);
 
 static int translate_error(int error)
@@ -114,6 +137,286 @@ static uint8_t translate_flags(fs_mode_t flags)
 	return fat_mode;
 }
 
+#if defined(CONFIG_FS_FATFS_FASTSEEK)
+/*
+ * Builds the cluster link map of the file, which lets FatFs seek without
+ * following the FAT chain. The map stays disabled for an empty file or
+ * when the file is too fragmented for the map.
+ */
+static void fatfs_map_build(FIL *fp)
+{
+	struct fatfs_file *file = CONTAINER_OF(fp, struct fatfs_file, fil);
+
+	fp->cltbl = NULL;
+	file->map_stale = false;
+
+	if (f_size(fp) == 0) {
+		return;
+	}
+
+	file->clmt[0] = ARRAY_SIZE(file->clmt);
+	fp->cltbl = file->clmt;
+	if (f_lseek(fp, CREATE_LINKMAP) != FR_OK) {
+		fp->cltbl = NULL;
+	}
+}
+
+static void fatfs_map_refresh(FIL *fp)
+{
+	struct fatfs_file *file = CONTAINER_OF(fp, struct fatfs_file, fil);
+
+	if (file->map_stale) {
+		fatfs_map_build(fp);
+	}
+}
+
+#if !defined(CONFIG_FS_FATFS_READ_ONLY)
+static void fatfs_map_invalidate(FIL *fp)
+{
+	struct fatfs_file *file = CONTAINER_OF(fp, struct fatfs_file, fil);
+
+	fp->cltbl = NULL;
+	file->map_stale = true;
+}
+
+/*
+ * With a link map FatFs does not allocate clusters, a write past the end of
+ * the mapped chain would stop short. Writes that grow the file therefore
+ * disable the map until the next seek.
+ */
+static void fatfs_map_prepare_write(FIL *fp, UINT size)
+{
+	if (f_tell(fp) + size > f_size(fp)) {
+		fatfs_map_invalidate(fp);
+	}
+}
+#endif /* !CONFIG_FS_FATFS_READ_ONLY */
+#else
+static inline void fatfs_map_build(FIL *fp)
+{
+	ARG_UNUSED(fp);
+}
+
+static inline void fatfs_map_invalidate(FIL *fp)
+{
+	ARG_UNUSED(fp);
+}
+
+static inline void fatfs_map_refresh(FIL *fp)
+{
+	ARG_UNUSED(fp);
+}
+
+static inline void fatfs_map_prepare_write(FIL *fp, UINT size)
+{
+	ARG_UNUSED(fp);
+	ARG_UNUSED(size);
+}
+#endif /* CONFIG_FS_FATFS_FASTSEEK */
+
+#if defined(FATFS_DIRECT_IO)
+/* File data is buffered in the volume window, see FF_FS_TINY in zephyr_fatfs_config.h */
+BUILD_ASSERT(FF_FS_TINY, "direct transfers require FF_FS_TINY");
+
+static UINT fatfs_sector_size(FATFS *fs)
+{
+#if FF_MAX_SS != FF_MIN_SS
+	return fs->ssize;
+#else
+	return FF_MIN_SS;
+#endif
+}
+
+/*
+ * Finds in the link map the run of contiguous sectors holding the current
+ * position of the file. Returns the number of sectors of the run from that
+ * position on, and the first of them in sect.
+ */
+static LBA_t fatfs_map_run(FIL *fp, UINT ss, LBA_t *sect)
+{
+	FATFS *fs = fp->obj.fs;
+	DWORD *tbl = fp->cltbl + 1;
+	FSIZE_t sect_idx = fp->fptr / ss;
+	DWORD clust_idx = (DWORD)(sect_idx / fs->csize);
+	DWORD csect = (DWORD)(sect_idx % fs->csize);
+	DWORD ncl;
+
+	for (ncl = *tbl++; ncl != 0; ncl = *tbl++) {
+		DWORD clust = *tbl++;
+
+		if (clust_idx < ncl) {
+			*sect = fs->database + (LBA_t)fs->csize * (clust + clust_idx - 2) + csect;
+			return (LBA_t)fs->csize * (ncl - clust_idx) - csect;
+		}
+
+		clust_idx -= ncl;
+	}
+
+	return 0;
+}
+
+/*
+ * Looks up the next direct transfer: whole sectors from the current position
+ * on, within the file size and the size of the request. FatFs already
+ * transfers the sectors of a single cluster at once, so only runs crossing
+ * a cluster boundary are worth it.
+ */
+static UINT fatfs_direct_count(FIL *fp, UINT ss, UINT size, LBA_t *sect)
+{
+	FATFS *fs = fp->obj.fs;
+	LBA_t cnt;
+
+	if (fp->fptr % ss != 0) {
+		return 0;
+	}
+
+	cnt = fatfs_map_run(fp, ss, sect);
+	cnt = MIN(cnt, size / ss);
+	cnt = MIN(cnt, (f_size(fp) - fp->fptr) / ss);
+
+	if (cnt <= fs->csize - (DWORD)((fp->fptr / ss) % fs->csize)) {
+		return 0;
+	}
+
+	return (UINT)cnt;
+}
+
+/* Moves the file position past a direct transfer that ended at last_sect */
+static void fatfs_direct_advance(FIL *fp, LBA_t last_sect, UINT len)
+{
+	FATFS *fs = fp->obj.fs;
+
+	fp->fptr += len;
+	fp->clust = (DWORD)((last_sect - fs->database) / fs->csize) + 2;
+}
+
+/* Length of the head of a request to transfer through FatFs, up to a sector boundary */
+static UINT fatfs_direct_head(FIL *fp, UINT ss, UINT size)
+{
+	FATFS *fs = fp->obj.fs;
+	UINT head = (ss - (UINT)(fp->fptr % ss)) % ss;
+
+	return size > head + (UINT)fs->csize * ss ? head : 0;
+}
+
+static FRESULT fatfs_read_direct(FIL *fp, uint8_t *buf, UINT size, UINT *br)
+{
+	FATFS *fs = fp->obj.fs;
+	UINT ss = fatfs_sector_size(fs);
+	UINT head = fatfs_direct_head(fp, ss, size);
+	UINT cnt;
+	LBA_t sect;
+	FRESULT res;
+
+	/* Also validates the file object and the access mode */
+	res = f_read(fp, buf, head, br);
+	if (res != FR_OK || *br < head) {
+		return res;
+	}
+
+	while ((cnt = fatfs_direct_count(fp, ss, size - *br, &sect)) != 0) {
+		if (disk_read(fs->pdrv, buf + *br, sect, cnt) != RES_OK) {
+			return FR_DISK_ERR;
+		}
+
+		/* The window may hold newer data of this file */
+		if (fs->wflag && fs->winsect - sect < cnt) {
+			memcpy(buf + *br + (UINT)(fs->winsect - sect) * ss, fs->win, ss);
+		}
+
+		fatfs_direct_advance(fp, sect + cnt - 1, cnt * ss);
+		*br += cnt * ss;
+	}
+
+	return FR_OK;
+}
+
+#if !defined(CONFIG_FS_FATFS_READ_ONLY)
+static FRESULT fatfs_write_direct(FIL *fp, const uint8_t *buf, UINT size, UINT *bw)
+{
+	FATFS *fs = fp->obj.fs;
+	UINT ss = fatfs_sector_size(fs);
+	UINT head = fatfs_direct_head(fp, ss, size);
+	UINT cnt;
+	LBA_t sect;
+	FRESULT res;
+
+	/* Also validates the file object and the access mode */
+	res = f_write(fp, buf, head, bw);
+	if (res != FR_OK || *bw < head) {
+		return res;
+	}
+
+	while ((cnt = fatfs_direct_count(fp, ss, size - *bw, &sect)) != 0) {
+		if (disk_write(fs->pdrv, buf + *bw, sect, cnt) != RES_OK) {
+			return FR_DISK_ERR;
+		}
+
+		/* Keep the window, which may hold a sector of this file, up to date */
+		if (fs->winsect - sect < cnt) {
+			memcpy(fs->win, buf + *bw + (UINT)(fs->winsect - sect) * ss, ss);
+			fs->wflag = 0;
+		}
+
+		/* As f_write does, so that f_sync updates the modification time */
+		fp->flag |= FA_MODIFIED;
+		fatfs_direct_advance(fp, sect + cnt - 1, cnt * ss);
+		*bw += cnt * ss;
+	}
+
+	return FR_OK;
+}
+#endif /* !CONFIG_FS_FATFS_READ_ONLY */
+#endif /* FATFS_DIRECT_IO */
+
+/* f_read, transferring runs of contiguous clusters directly when possible */
+static FRESULT fatfs_file_read(FIL *fp, void *ptr, UINT size, UINT *br)
+{
+#if defined(FATFS_DIRECT_IO)
+	UINT done = 0;
+	FRESULT res = FR_OK;
+
+	if (fp->cltbl != NULL) {
+		res = fatfs_read_direct(fp, ptr, size, &done);
+	}
+
+	if (res == FR_OK) {
+		res = f_read(fp, (uint8_t *)ptr + done, size - done, br);
+		*br += done;
+	}
+
+	return res;
+#else
+	return f_read(fp, ptr, size, br);
+#endif
+}
+
+#if !defined(CONFIG_FS_FATFS_READ_ONLY)
+/* f_write, transferring runs of contiguous clusters directly when possible */
+static FRESULT fatfs_file_write(FIL *fp, const void *ptr, UINT size, UINT *bw)
+{
+	fatfs_map_prepare_write(fp, size);
+
+#if defined(FATFS_DIRECT_IO)
+	UINT done = 0;
+	FRESULT res = FR_OK;
+
+	if (fp->cltbl != NULL) {
+		res = fatfs_write_direct(fp, ptr, size, &done);
+	}
+
+	if (res == FR_OK) {
+		res = f_write(fp, (const uint8_t *)ptr + done, size - done, bw);
+		*bw += done;
+	}
+
+	return res;
+#else
+	return f_write(fp, ptr, size, bw);
+#endif
+}
+#endif /* !CONFIG_FS_FATFS_READ_ONLY */
+
 static int fatfs_open(struct fs_file_t *zfp, const char *file_name,
 		      fs_mode_t mode)
 {
@@ -122,7 +425,7 @@ static int fatfs_open(struct fs_file_t *zfp, const char *file_name,
 	void *ptr;
 
 	if (k_mem_slab_alloc(&fatfs_filep_pool, &ptr, K_NO_WAIT) == 0) {
-		(void)memset(ptr, 0, sizeof(FIL));
+		(void)memset(ptr, 0, FATFS_FILE_SIZE);
 		zfp->filep = ptr;
 	} else {
 		return -ENOMEM;
@@ -135,6 +438,8 @@ static int fatfs_open(struct fs_file_t *zfp, const char *file_name,
 	if (res != FR_OK) {
 		k_mem_slab_free(&fatfs_filep_pool, ptr);
 		zfp->filep = NULL;
+	} else {
+		fatfs_map_build(zfp->filep);
 	}
 
 	return translate_error(res);
@@ -195,7 +500,7 @@ static ssize_t fatfs_read(struct fs_file_t *zfp, void *ptr, size_t size)
 	FRESULT res;
 	unsigned int br;
 
-	res = f_read(zfp->filep, ptr, size, &br);
+	res = fatfs_file_read(zfp->filep, ptr, size, &br);
 	if (res != FR_OK) {
 		return translate_error(res);
 	}
@@ -222,7 +527,77 @@ static ssize_t fatfs_write(struct fs_file_t *zfp, const void *ptr, size_t size)
 	}
 
 	if (res == FR_OK) {
-		res = f_write(zfp->filep, ptr, size, &bw);
+		res = fatfs_file_write(zfp->filep, ptr, size, &bw);
+	}
+
+	if (res != FR_OK) {
+		res = translate_error(res);
+	} else {
+		res = bw;
+	}
+#endif
+
+	return res;
+}
+
+#if defined(CONFIG_FILE_SYSTEM_VECTORED_IO)
+static ssize_t fatfs_pread(struct fs_file_t *zfp, void *ptr, size_t size, off_t offset)
+{
+	FIL *fp = zfp->filep;
+	FSIZE_t pos = f_tell(fp);
+	unsigned int br = 0;
+	FRESULT res;
+
+	/* f_lseek would expand a file opened for writing, so never seek past
+	 * the end for a read.
+	 */
+	if (offset >= f_size(fp)) {
+		return 0;
+	}
+
+	fatfs_map_refresh(fp);
+
+	res = f_lseek(fp, offset);
+	if (res == FR_OK) {
+		res = fatfs_file_read(fp, ptr, size, &br);
+	}
+
+	FRESULT seek_res = f_lseek(fp, pos);
+
+	if (res == FR_OK) {
+		res = seek_res;
+	}
+
+	if (res != FR_OK) {
+		return translate_error(res);
+	}
+
+	return br;
+}
+
+static ssize_t fatfs_pwrite(struct fs_file_t *zfp, const void *ptr, size_t size, off_t offset)
+{
+	int res = -ENOTSUP;
+
+#if !defined(CONFIG_FS_FATFS_READ_ONLY)
+	FIL *fp = zfp->filep;
+	FSIZE_t pos = f_tell(fp);
+	unsigned int bw = 0;
+
+	/* Same limit as fatfs_seek: the gap would not be zero filled */
+	if (offset > f_size(fp)) {
+		return -EINVAL;
+	}
+
+	res = f_lseek(fp, offset);
+	if (res == FR_OK) {
+		res = fatfs_file_write(fp, ptr, size, &bw);
+	}
+
+	FRESULT seek_res = f_lseek(fp, pos);
+
+	if (res == FR_OK) {
+		res = seek_res;
 	}
 
 	if (res != FR_OK) {
@@ -234,6 +609,7 @@ static ssize_t fatfs_write(struct fs_file_t *zfp, const void *ptr, size_t size)
 
 	return res;
 }
+#endif /* CONFIG_FILE_SYSTEM_VECTORED_IO */
 
 static int fatfs_seek(struct fs_file_t *zfp, off_t offset, int whence)
 {
@@ -258,6 +634,8 @@ static int fatfs_seek(struct fs_file_t *zfp, off_t offset, int whence)
 		return -EINVAL;
 	}
 
+	fatfs_map_refresh(zfp->filep);
+
 	res = f_lseek(zfp->filep, pos);
 
 	return translate_error(res);
@@ -275,6 +653,9 @@ static int fatfs_truncate(struct fs_file_t *zfp, off_t length)
 #if !defined(CONFIG_FS_FATFS_READ_ONLY)
 	off_t cur_length = f_size((FIL *)zfp->filep);
 
+	/* The chain changes, and FatFs does not expand a file with a link map */
+	fatfs_map_invalidate(zfp->filep);
+
 	/* f_lseek expands file if new position is larger than file size */
 	res = f_lseek(zfp->filep, length);
 	if (res != FR_OK) {
@@ -319,6 +700,52 @@ static int fatfs_truncate(struct fs_file_t *zfp, off_t length)
 	return res;
 }
 
+#if defined(CONFIG_FILE_SYSTEM_EXPAND)
+static int fatfs_expand(struct fs_file_t *zfp, off_t length)
+{
+	int res = -ENOTSUP;
+
+#if !defined(CONFIG_FS_FATFS_READ_ONLY)
+	FIL *fp = zfp->filep;
+	FSIZE_t pos = f_tell(fp);
+	FRESULT seek_res;
+
+	if (length < f_size(fp)) {
+		return -EINVAL;
+	}
+
+	if (length == f_size(fp)) {
+		return 0;
+	}
+
+	/* FatFs can only allocate a contiguous cluster chain to an empty file */
+	if (f_size(fp) == 0) {
+		res = f_expand(fp, length, 1);
+		if (res == FR_OK) {
+			fatfs_map_build(fp);
+			return 0;
+		}
+
+		/* FR_DENIED when there is no contiguous free space either */
+		if (res != FR_DENIED) {
+			return translate_error(res);
+		}
+	}
+
+	/* Extending leaves the position at the end, unlike fs_expand */
+	res = fatfs_truncate(zfp, length);
+
+	fatfs_map_refresh(fp);
+	seek_res = f_lseek(fp, pos);
+	if (res == 0 && seek_res != FR_OK) {
+		res = translate_error(seek_res);
+	}
+#endif
+
+	return res;
+}
+#endif /* CONFIG_FILE_SYSTEM_EXPAND */
+
 static int fatfs_sync(struct fs_file_t *zfp)
 {
 	int res = -ENOTSUP;
@@ -542,6 +969,13 @@ static const struct fs_file_system_t fatfs_fs = {
 	.tell = fatfs_tell,
 	.truncate = fatfs_truncate,
 	.sync = fatfs_sync,
+#if defined(CONFIG_FILE_SYSTEM_EXPAND)
+	.expand = fatfs_expand,
+#endif
+#if defined(CONFIG_FILE_SYSTEM_VECTORED_IO)
+	.pread = fatfs_pread,
+	.pwrite = fatfs_pwrite,
+#endif
 	.opendir = fatfs_opendir,
 	.readdir = fatfs_readdir,
 	.closedir = fatfs_closedir,
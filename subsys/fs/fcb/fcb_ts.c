@@ -0,0 +1,482 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/fs/fcb.h>
+#include <zephyr/fs/fcb_ts.h>
+#include "fcb_priv.h"
+
+#define FCB_TS_DELTA_SZ sizeof(uint32_t)
+
+static inline size_t fcb_ts_rec_sz(const struct fcb_ts *ts)
+{
+	return FCB_TS_DELTA_SZ + ts->rec_len;
+}
+
+static inline size_t fcb_ts_batch_cap(const struct fcb_ts *ts)
+{
+	return ts->batch_max;
+}
+
+/* Largest FCB entry that fits in an empty sector of the given size, after
+ * the sector header, the length bytes and the CRC.
+ */
+static size_t fcb_ts_sector_cap(struct fcb *fcbp, size_t sector_size)
+{
+	size_t overhead = fcb_len_in_flash(fcbp, sizeof(struct fcb_disk_area)) +
+			  fcb_len_in_flash(fcbp, FCB_CRC_SZ);
+	size_t len1 = 0;
+	size_t len2 = 0;
+
+	/* Entries shorter than 0x80 bytes have a one byte length */
+	if (sector_size >= overhead + fcb_len_in_flash(fcbp, 1)) {
+		len1 = sector_size - overhead - fcb_len_in_flash(fcbp, 1);
+		len1 = MIN(ROUND_DOWN(len1, MAX(fcbp->f_align, 1U)), 0x7fU);
+	}
+	if (sector_size >= overhead + fcb_len_in_flash(fcbp, 2)) {
+		len2 = sector_size - overhead - fcb_len_in_flash(fcbp, 2);
+		len2 = ROUND_DOWN(len2, MAX(fcbp->f_align, 1U));
+	}
+
+	return MAX(len1, len2);
+}
+
+static inline struct fcb_ts_sector_range *fcb_ts_range(struct fcb_ts *ts,
+							const struct flash_sector *sector)
+{
+	return &ts->ranges[sector - ts->fcb->f_sectors];
+}
+
+static void fcb_ts_range_clear(struct fcb_ts *ts, const struct flash_sector *sector)
+{
+	struct fcb_ts_sector_range *range = fcb_ts_range(ts, sector);
+
+	range->min_ts = UINT64_MAX;
+	range->max_ts = 0;
+}
+
+static void fcb_ts_range_add(struct fcb_ts *ts, const struct flash_sector *sector,
+			     uint64_t min_ts, uint64_t max_ts)
+{
+	struct fcb_ts_sector_range *range = fcb_ts_range(ts, sector);
+
+	range->min_ts = MIN(range->min_ts, min_ts);
+	range->max_ts = MAX(range->max_ts, max_ts);
+}
+
+/* Reads the batch header of an FCB entry, -EBADMSG when the entry is not a
+ * batch of this store.
+ */
+static int fcb_ts_read_hdr(struct fcb_ts *ts, const struct fcb_entry *loc,
+			   struct fcb_ts_batch_hdr *hdr)
+{
+	int rc;
+
+	if (loc->fe_data_len < sizeof(*hdr)) {
+		return -EBADMSG;
+	}
+
+	rc = fcb_flash_read(ts->fcb, loc->fe_sector, loc->fe_data_off, hdr, sizeof(*hdr));
+	if (rc) {
+		return rc;
+	}
+
+	if (hdr->rec_len != ts->rec_len || hdr->count == 0U ||
+	    loc->fe_data_len != sizeof(*hdr) + hdr->count * fcb_ts_rec_sz(ts)) {
+		return -EBADMSG;
+	}
+
+	return 0;
+}
+
+static int fcb_ts_read_delta(struct fcb_ts *ts, const struct fcb_entry *loc, uint16_t idx,
+			     uint32_t *delta)
+{
+	off_t off = loc->fe_data_off + sizeof(struct fcb_ts_batch_hdr) + idx * fcb_ts_rec_sz(ts);
+
+	return fcb_flash_read(ts->fcb, loc->fe_sector, off, delta, sizeof(*delta));
+}
+
+static int fcb_ts_init_cb(struct fcb_entry_ctx *loc_ctx, void *arg)
+{
+	struct fcb_ts *ts = arg;
+	struct fcb_ts_batch_hdr hdr;
+	uint64_t last;
+	int rc;
+
+	rc = fcb_ts_read_hdr(ts, &loc_ctx->loc, &hdr);
+	if (rc == -EBADMSG) {
+		return 0;
+	}
+	if (rc) {
+		return rc;
+	}
+
+	last = hdr.base_ts + hdr.last_delta;
+	fcb_ts_range_add(ts, loc_ctx->loc.fe_sector, hdr.base_ts, last);
+
+	if (!ts->has_last || last > ts->last_ts) {
+		ts->last_ts = last;
+		ts->has_last = true;
+	}
+
+	return 0;
+}
+
+int fcb_ts_init(struct fcb_ts *ts)
+{
+	struct fcb *fcbp = ts->fcb;
+
+	if (fcbp == NULL || ts->buf == NULL || ts->ranges == NULL || ts->rec_len == 0U) {
+		return -EINVAL;
+	}
+
+	/* A batch that does not fit in an empty sector could never be written,
+	 * and would make the retention rotate out every stored record.
+	 */
+	ts->batch_max = MIN(ts->buf_size, FCB_MAX_LEN);
+	for (int i = 0; i < fcbp->f_sector_cnt; i++) {
+		ts->batch_max = MIN(ts->batch_max,
+				    fcb_ts_sector_cap(fcbp, fcbp->f_sectors[i].fs_size));
+	}
+
+	if (ts->batch_max < sizeof(struct fcb_ts_batch_hdr) + fcb_ts_rec_sz(ts)) {
+		return -EINVAL;
+	}
+
+	k_mutex_init(&ts->mtx);
+	ts->batch_len = 0;
+	ts->batch_cnt = 0;
+	ts->has_last = false;
+	ts->last_ts = 0;
+
+	for (int i = 0; i < fcbp->f_sector_cnt; i++) {
+		fcb_ts_range_clear(ts, &fcbp->f_sectors[i]);
+	}
+
+	return fcb_walk(fcbp, NULL, fcb_ts_init_cb, ts);
+}
+
+/* Writes the staged batch as one FCB entry: one length header, one aligned
+ * write of the records plus at most one padded tail, and one end marker.
+ */
+static int fcb_ts_flush_locked(struct fcb_ts *ts)
+{
+	struct fcb *fcbp = ts->fcb;
+	struct flash_sector *sector;
+	struct fcb_ts_batch_hdr hdr;
+	struct fcb_entry loc;
+	size_t aligned;
+	int rc;
+
+	if (ts->batch_cnt == 0U) {
+		return 0;
+	}
+
+	/* Rotating cannot make room for an entry larger than a sector */
+	if (ts->batch_len > fcb_ts_batch_cap(ts)) {
+		return -ENOSPC;
+	}
+
+	hdr = (struct fcb_ts_batch_hdr){
+		.base_ts = ts->batch_base,
+		.last_delta = (uint32_t)(ts->last_ts - ts->batch_base),
+		.count = ts->batch_cnt,
+		.rec_len = ts->rec_len,
+	};
+	memcpy(ts->buf, &hdr, sizeof(hdr));
+
+	for (int i = 0;; i++) {
+		rc = fcb_append(fcbp, ts->batch_len, &loc);
+		if (rc != -ENOSPC || i >= fcbp->f_sector_cnt) {
+			break;
+		}
+
+		/* Retention: drop the oldest records to make room */
+		sector = fcbp->f_oldest;
+		rc = fcb_rotate(fcbp);
+		if (rc) {
+			return rc;
+		}
+		fcb_ts_range_clear(ts, sector);
+	}
+	if (rc) {
+		return rc;
+	}
+
+	/* The range of a sector that has just been taken into use may be left
+	 * over from before it was erased.
+	 */
+	if (loc.fe_elem_off == fcb_len_in_flash(fcbp, sizeof(struct fcb_disk_area))) {
+		fcb_ts_range_clear(ts, loc.fe_sector);
+	}
+
+	aligned = ts->batch_len & ~(size_t)(fcbp->f_align - 1U);
+	if (aligned > 0) {
+		rc = fcb_flash_write(fcbp, loc.fe_sector, loc.fe_data_off, ts->buf, aligned);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	if (aligned < ts->batch_len) {
+		uint8_t tail[fcbp->f_align];
+
+		memset(tail, fcbp->f_erase_value, sizeof(tail));
+		memcpy(tail, &ts->buf[aligned], ts->batch_len - aligned);
+		rc = fcb_flash_write(fcbp, loc.fe_sector, loc.fe_data_off + aligned, tail,
+				     sizeof(tail));
+		if (rc) {
+			return rc;
+		}
+	}
+
+	rc = fcb_append_finish(fcbp, &loc);
+	if (rc) {
+		return rc;
+	}
+
+	fcb_ts_range_add(ts, loc.fe_sector, ts->batch_base, ts->last_ts);
+	ts->batch_len = 0;
+	ts->batch_cnt = 0;
+
+	return 0;
+}
+
+static int fcb_ts_add_locked(struct fcb_ts *ts, uint64_t timestamp, const void *data)
+{
+	const size_t rec_sz = fcb_ts_rec_sz(ts);
+	uint32_t delta;
+	int rc;
+
+	if (ts->has_last && timestamp < ts->last_ts) {
+		return -EINVAL;
+	}
+
+	if (ts->batch_cnt > 0U &&
+	    (ts->batch_len + rec_sz > fcb_ts_batch_cap(ts) ||
+	     timestamp - ts->batch_base > UINT32_MAX || ts->batch_cnt == UINT16_MAX)) {
+		rc = fcb_ts_flush_locked(ts);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	if (ts->batch_cnt == 0U) {
+		ts->batch_base = timestamp;
+		ts->batch_len = sizeof(struct fcb_ts_batch_hdr);
+	}
+
+	delta = (uint32_t)(timestamp - ts->batch_base);
+	memcpy(&ts->buf[ts->batch_len], &delta, sizeof(delta));
+	memcpy(&ts->buf[ts->batch_len + sizeof(delta)], data, ts->rec_len);
+
+	ts->batch_len += rec_sz;
+	ts->batch_cnt++;
+	ts->last_ts = timestamp;
+	ts->has_last = true;
+
+	return 0;
+}
+
+int fcb_ts_add(struct fcb_ts *ts, uint64_t timestamp, const void *data)
+{
+	int rc;
+
+	k_mutex_lock(&ts->mtx, K_FOREVER);
+	rc = fcb_ts_add_locked(ts, timestamp, data);
+	k_mutex_unlock(&ts->mtx);
+
+	return rc;
+}
+
+int fcb_ts_append(struct fcb_ts *ts, const struct fcb_ts_record *recs, size_t cnt)
+{
+	int rc = 0;
+
+	k_mutex_lock(&ts->mtx, K_FOREVER);
+	for (size_t i = 0; i < cnt && rc == 0; i++) {
+		rc = fcb_ts_add_locked(ts, recs[i].timestamp, recs[i].data);
+	}
+	if (rc == 0) {
+		rc = fcb_ts_flush_locked(ts);
+	}
+	k_mutex_unlock(&ts->mtx);
+
+	return rc;
+}
+
+int fcb_ts_flush(struct fcb_ts *ts)
+{
+	int rc;
+
+	k_mutex_lock(&ts->mtx, K_FOREVER);
+	rc = fcb_ts_flush_locked(ts);
+	k_mutex_unlock(&ts->mtx);
+
+	return rc;
+}
+
+int fcb_ts_iter_init(struct fcb_ts *ts, struct fcb_ts_iter *it, uint64_t from, uint64_t to)
+{
+	struct fcb *fcbp = ts->fcb;
+	struct flash_sector *sector;
+	const struct fcb_ts_sector_range *range;
+
+	*it = (struct fcb_ts_iter){
+		.ts = ts,
+		.from = from,
+		.to = to,
+		.done = from > to,
+	};
+
+	if (it->done) {
+		return 0;
+	}
+
+	k_mutex_lock(&ts->mtx, K_FOREVER);
+	k_mutex_lock(&fcbp->f_mtx, K_FOREVER);
+
+	/* Skip sectors that end before the range without reading them */
+	sector = fcbp->f_oldest;
+	while (true) {
+		range = fcb_ts_range(ts, sector);
+		if (range->min_ts <= range->max_ts) {
+			if (range->min_ts > to) {
+				it->done = true;
+				break;
+			}
+			if (range->max_ts >= from) {
+				break;
+			}
+		}
+
+		if (sector == fcbp->f_active.fe_sector) {
+			it->done = true;
+			break;
+		}
+		sector = fcb_getnext_sector(fcbp, sector);
+	}
+
+	k_mutex_unlock(&fcbp->f_mtx);
+	k_mutex_unlock(&ts->mtx);
+
+	it->loc.fe_sector = sector;
+	it->loc.fe_elem_off = 0U;
+
+	return 0;
+}
+
+/* Moves to the next batch that may hold records of the range and positions
+ * rec_idx at its first record not older than the range start.
+ */
+static int fcb_ts_iter_load(struct fcb_ts_iter *it)
+{
+	struct fcb_ts *ts = it->ts;
+	uint16_t lo;
+	uint16_t hi;
+	uint32_t target;
+	uint32_t delta;
+	int rc;
+
+	it->hdr.count = 0;
+	it->rec_idx = 0;
+
+	rc = fcb_getnext(ts->fcb, &it->loc);
+	if (rc) {
+		it->done = true;
+		return (rc == -ENOTSUP) ? 0 : rc;
+	}
+
+	rc = fcb_ts_read_hdr(ts, &it->loc, &it->hdr);
+	if (rc) {
+		it->hdr.count = 0;
+		return (rc == -EBADMSG) ? 0 : rc;
+	}
+
+	if (it->hdr.base_ts > it->to) {
+		it->done = true;
+		return 0;
+	}
+
+	if (it->hdr.base_ts + it->hdr.last_delta < it->from) {
+		it->hdr.count = 0;
+		return 0;
+	}
+
+	if (it->hdr.base_ts >= it->from) {
+		return 0;
+	}
+
+	/* Records are ordered, the last one is known to be in the range */
+	target = (uint32_t)(it->from - it->hdr.base_ts);
+	lo = 0;
+	hi = it->hdr.count - 1;
+	while (lo < hi) {
+		uint16_t mid = lo + (hi - lo) / 2;
+
+		rc = fcb_ts_read_delta(ts, &it->loc, mid, &delta);
+		if (rc) {
+			return rc;
+		}
+
+		if (delta < target) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	it->rec_idx = lo;
+
+	return 0;
+}
+
+int fcb_ts_iter_next(struct fcb_ts_iter *it, uint64_t *timestamp, void *data)
+{
+	struct fcb_ts *ts = it->ts;
+	uint64_t rec_ts;
+	uint32_t delta;
+	off_t off;
+	int rc;
+
+	while (!it->done) {
+		if (it->rec_idx >= it->hdr.count) {
+			rc = fcb_ts_iter_load(it);
+			if (rc) {
+				return rc;
+			}
+			continue;
+		}
+
+		rc = fcb_ts_read_delta(ts, &it->loc, it->rec_idx, &delta);
+		if (rc) {
+			return rc;
+		}
+
+		rec_ts = it->hdr.base_ts + delta;
+		if (rec_ts > it->to) {
+			it->done = true;
+			break;
+		}
+
+		if (data != NULL) {
+			off = it->loc.fe_data_off + sizeof(struct fcb_ts_batch_hdr) +
+			      it->rec_idx * fcb_ts_rec_sz(ts) + FCB_TS_DELTA_SZ;
+			rc = fcb_flash_read(ts->fcb, it->loc.fe_sector, off, data, ts->rec_len);
+			if (rc) {
+				return rc;
+			}
+		}
+
+		it->rec_idx++;
+		*timestamp = rec_ts;
+		return 0;
+	}
+
+	return -ENOENT;
+}
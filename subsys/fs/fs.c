@@ -22,9 +22,14 @@ LOG_MODULE_REGISTER(fs, CONFIG_FS_LOG_LEVEL);
 /* list of mounted file systems */
 static sys_dlist_t fs_mnt_list = SYS_DLIST_STATIC_INIT(&fs_mnt_list);
 
-/* lock to protect mount list operations */
+/* lock to serialize mount, unmount and registry operations */
 static K_MUTEX_DEFINE(mutex);
 
+/* lock to protect the mount list itself, held only while walking it so that
+ * path resolution never waits for a file system being mounted or unmounted
+ */
+static struct k_spinlock mnt_list_lock;
+
 /* Maps an identifier used in mount points to the file system
  * implementation.
  */
@@ -84,8 +89,9 @@ static int fs_get_mnt_point(struct fs_mount_t **mnt_pntp,
 	size_t longest_match = 0;
 	size_t len, name_len = strlen(name);
 	sys_dnode_t *node;
+	k_spinlock_key_t key;
 
-	k_mutex_lock(&mutex, K_FOREVER);
+	key = k_spin_lock(&mnt_list_lock);
 	SYS_DLIST_FOR_EACH_NODE(&fs_mnt_list, node) {
 		itr = CONTAINER_OF(node, struct fs_mount_t, node);
 		len = itr->mountp_len;
@@ -113,7 +119,7 @@ static int fs_get_mnt_point(struct fs_mount_t **mnt_pntp,
 			longest_match = len;
 		}
 	}
-	k_mutex_unlock(&mutex);
+	k_spin_unlock(&mnt_list_lock, key);
 
 	if (mnt_p == NULL) {
 		return -ENOENT;
@@ -259,6 +265,157 @@ ssize_t fs_write(struct fs_file_t *zfp, const void *ptr, size_t size)
 	return rc;
 }
 
+#if defined(CONFIG_FILE_SYSTEM_VECTORED_IO)
+ssize_t fs_readv(struct fs_file_t *zfp, const struct fs_iovec *iov, size_t iovcnt)
+{
+	ssize_t rc;
+	ssize_t total = 0;
+
+	if (zfp->mp == NULL) {
+		return -EBADF;
+	}
+
+	CHECKIF(zfp->mp->fs->read == NULL) {
+		return -ENOTSUP;
+	}
+
+	for (size_t i = 0; i < iovcnt; i++) {
+		rc = zfp->mp->fs->read(zfp, iov[i].iov_base, iov[i].iov_len);
+		if (rc < 0) {
+			LOG_ERR("file readv error (%zd)", rc);
+			return total > 0 ? total : rc;
+		}
+
+		total += rc;
+		if ((size_t)rc < iov[i].iov_len) {
+			break;
+		}
+	}
+
+	return total;
+}
+
+ssize_t fs_writev(struct fs_file_t *zfp, const struct fs_iovec *iov, size_t iovcnt)
+{
+	ssize_t rc;
+	ssize_t total = 0;
+
+	if (zfp->mp == NULL) {
+		return -EBADF;
+	}
+
+	CHECKIF(zfp->mp->fs->write == NULL) {
+		return -ENOTSUP;
+	}
+
+	for (size_t i = 0; i < iovcnt; i++) {
+		rc = zfp->mp->fs->write(zfp, iov[i].iov_base, iov[i].iov_len);
+		if (rc < 0) {
+			LOG_ERR("file writev error (%zd)", rc);
+			return total > 0 ? total : rc;
+		}
+
+		total += rc;
+		if ((size_t)rc < iov[i].iov_len) {
+			break;
+		}
+	}
+
+	return total;
+}
+
+/* Emulates a positional transfer by moving the file position to @p offset,
+ * calling @p read or @p write depending on @p write and restoring the
+ * original position. @p ptr is the source of a write, the destination of
+ * a read.
+ */
+static ssize_t fs_positional_fallback(struct fs_file_t *zfp, bool write, void *ptr,
+				      size_t size, off_t offset)
+{
+	const struct fs_file_system_t *fs = zfp->mp->fs;
+	off_t pos;
+	ssize_t rc;
+	int seek_rc;
+
+	CHECKIF(fs->tell == NULL || fs->lseek == NULL) {
+		return -ENOTSUP;
+	}
+
+	CHECKIF((write && fs->write == NULL) || (!write && fs->read == NULL)) {
+		return -ENOTSUP;
+	}
+
+	pos = fs->tell(zfp);
+	if (pos < 0) {
+		return pos;
+	}
+
+	rc = fs->lseek(zfp, offset, FS_SEEK_SET);
+	if (rc < 0) {
+		return rc;
+	}
+
+	rc = write ? fs->write(zfp, ptr, size) : fs->read(zfp, ptr, size);
+
+	seek_rc = fs->lseek(zfp, pos, FS_SEEK_SET);
+	if (rc >= 0 && seek_rc < 0) {
+		rc = seek_rc;
+	}
+
+	return rc;
+}
+
+ssize_t fs_pread(struct fs_file_t *zfp, void *ptr, size_t size, off_t offset)
+{
+	ssize_t rc;
+
+	if (zfp->mp == NULL) {
+		return -EBADF;
+	}
+
+	if (offset < 0) {
+		return -EINVAL;
+	}
+
+	if (zfp->mp->fs->pread != NULL) {
+		rc = zfp->mp->fs->pread(zfp, ptr, size, offset);
+	} else {
+		rc = fs_positional_fallback(zfp, false, ptr, size, offset);
+	}
+
+	if (rc < 0) {
+		LOG_ERR("file pread error (%zd)", rc);
+	}
+
+	return rc;
+}
+
+ssize_t fs_pwrite(struct fs_file_t *zfp, const void *ptr, size_t size, off_t offset)
+{
+	ssize_t rc;
+
+	if (zfp->mp == NULL) {
+		return -EBADF;
+	}
+
+	if (offset < 0) {
+		return -EINVAL;
+	}
+
+	if (zfp->mp->fs->pwrite != NULL) {
+		rc = zfp->mp->fs->pwrite(zfp, ptr, size, offset);
+	} else {
+		rc = fs_positional_fallback(zfp, true, (void *)ptr, size, offset);
+	}
+
+	if (rc < 0) {
+		LOG_ERR("file pwrite error (%zd)", rc);
+	}
+
+	return rc;
+}
+#endif /* CONFIG_FILE_SYSTEM_VECTORED_IO */
+
 int fs_seek(struct fs_file_t *zfp, off_t offset, int whence)
 {
 	int rc = -ENOTSUP;
@@ -319,6 +476,32 @@ int fs_truncate(struct fs_file_t *zfp, off_t length)
 	return rc;
 }
 
+#if defined(CONFIG_FILE_SYSTEM_EXPAND)
+int fs_expand(struct fs_file_t *zfp, off_t length)
+{
+	int rc;
+
+	if (zfp->mp == NULL) {
+		return -EBADF;
+	}
+
+	if (length < 0) {
+		return -EINVAL;
+	}
+
+	if (zfp->mp->fs->expand == NULL) {
+		return -ENOTSUP;
+	}
+
+	rc = zfp->mp->fs->expand(zfp, length);
+	if (rc < 0) {
+		LOG_ERR("file expand error (%d)", rc);
+	}
+
+	return rc;
+}
+#endif /* CONFIG_FILE_SYSTEM_EXPAND */
+
 int fs_sync(struct fs_file_t *zfp)
 {
 	int rc = -EINVAL;
@@ -358,12 +541,12 @@ int fs_opendir(struct fs_dir_t *zdp, const char *abs_path)
 
 	if (strcmp(abs_path, "/") == 0) {
 		/* Open VFS root dir, marked by zdp->mp == NULL */
-		k_mutex_lock(&mutex, K_FOREVER);
+		k_spinlock_key_t key = k_spin_lock(&mnt_list_lock);
 
 		zdp->mp = NULL;
 		zdp->dirp = sys_dlist_peek_head(&fs_mnt_list);
 
-		k_mutex_unlock(&mutex);
+		k_spin_unlock(&mnt_list_lock, key);
 
 		return 0;
 	}
@@ -433,8 +616,9 @@ int fs_readdir(struct fs_dir_t *zdp, struct fs_dirent *entry)
 	/* Find the current and next entries in the mount point dlist */
 	sys_dnode_t *node, *next = NULL;
 	bool found = false;
+	k_spinlock_key_t key;
 
-	k_mutex_lock(&mutex, K_FOREVER);
+	key = k_spin_lock(&mnt_list_lock);
 
 	SYS_DLIST_FOR_EACH_NODE(&fs_mnt_list, node) {
 		if (node == zdp->dirp) {
@@ -457,7 +641,7 @@ int fs_readdir(struct fs_dir_t *zdp, struct fs_dirent *entry)
 		}
 	}
 
-	k_mutex_unlock(&mutex);
+	k_spin_unlock(&mnt_list_lock, key);
 
 	if (!found) {
 		/* Current entry must have been removed before this
@@ -686,6 +870,7 @@ int fs_mount(struct fs_mount_t *mp)
 	struct fs_mount_t *itr;
 	const struct fs_file_system_t *fs;
 	sys_dnode_t *node;
+	k_spinlock_key_t key;
 	int rc = -EINVAL;
 	size_t len = 0;
 
@@ -761,7 +946,9 @@ int fs_mount(struct fs_mount_t *mp)
 	mp->mountp_len = len;
 	mp->fs = fs;
 
+	key = k_spin_lock(&mnt_list_lock);
 	sys_dlist_append(&fs_mnt_list, &mp->node);
+	k_spin_unlock(&mnt_list_lock, key);
 	LOG_DBG("fs mounted at %s", mp->mnt_point);
 
 mount_err:
@@ -808,6 +995,8 @@ mount_err:
 
 int fs_unmount(struct fs_mount_t *mp)
 {
+	k_spinlock_key_t key;
+	sys_dnode_t *next;
 	int rc = -EINVAL;
 
 	if (mp == NULL) {
@@ -827,14 +1016,29 @@ int fs_unmount(struct fs_mount_t *mp)
 		goto unmount_err;
 	}
 
+	/* Remove the mount node from the list before the file system goes
+	 * away, so that path resolution, which does not take the mutex, can
+	 * no longer find it. The mutex keeps the rest of the list unchanged,
+	 * so the node can be put back at the same place if unmount fails.
+	 */
+	key = k_spin_lock(&mnt_list_lock);
+	next = sys_dlist_peek_next(&fs_mnt_list, &mp->node);
+	sys_dlist_remove(&mp->node);
+	k_spin_unlock(&mnt_list_lock, key);
+
 	rc = mp->fs->unmount(mp);
 	if (rc < 0) {
 		LOG_ERR("fs unmount error (%d)", rc);
+		key = k_spin_lock(&mnt_list_lock);
+		if (next != NULL) {
+			sys_dlist_insert(next, &mp->node);
+		} else {
+			sys_dlist_append(&fs_mnt_list, &mp->node);
+		}
+		k_spin_unlock(&mnt_list_lock, key);
 		goto unmount_err;
 	}
 
-	/* remove mount node from the list */
-	sys_dlist_remove(&mp->node);
 	LOG_DBG("fs unmounted from %s", mp->mnt_point);
 
 unmount_err:
@@ -848,10 +1052,11 @@ int fs_readmount(int *index, const char **name)
 	int rc = -ENOENT;
 	int cnt = 0;
 	struct fs_mount_t *itr = NULL;
+	k_spinlock_key_t key;
 
 	*name = NULL;
 
-	k_mutex_lock(&mutex, K_FOREVER);
+	key = k_spin_lock(&mnt_list_lock);
 
 	SYS_DLIST_FOR_EACH_NODE(&fs_mnt_list, node) {
 		if (*index == cnt) {
@@ -862,7 +1067,7 @@ int fs_readmount(int *index, const char **name)
 		++cnt;
 	}
 
-	k_mutex_unlock(&mutex);
+	k_spin_unlock(&mnt_list_lock, key);
 
 	if (itr != NULL) {
 		rc = 0;
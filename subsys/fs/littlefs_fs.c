@@ -429,6 +429,57 @@ static off_t littlefs_tell(struct fs_file_t *fp)
 	return ret;
 }
 
+#if defined(CONFIG_FILE_SYSTEM_VECTORED_IO)
+/* Seeks, transfers and restores the file position without dropping the lock. */
+static ssize_t littlefs_prw(struct fs_file_t *fp, bool write, void *ptr, size_t len,
+			    off_t off)
+{
+	struct fs_littlefs *fs = fp->mp->fs_data;
+	lfs_file_t *file = LFS_FILEP(fp);
+	lfs_soff_t pos;
+	lfs_soff_t seek_ret;
+	lfs_ssize_t ret;
+
+	fs_lock(fs);
+
+	pos = lfs_file_tell(&fs->lfs, file);
+	if (pos < 0) {
+		ret = pos;
+		goto out;
+	}
+
+	ret = lfs_file_seek(&fs->lfs, file, off, LFS_SEEK_SET);
+	if (ret < 0) {
+		goto out;
+	}
+
+	if (write) {
+		ret = lfs_file_write(&fs->lfs, file, ptr, len);
+	} else {
+		ret = lfs_file_read(&fs->lfs, file, ptr, len);
+	}
+
+	seek_ret = lfs_file_seek(&fs->lfs, file, pos, LFS_SEEK_SET);
+	if (ret >= 0 && seek_ret < 0) {
+		ret = seek_ret;
+	}
+
+out:
+	fs_unlock(fs);
+	return lfs_to_errno(ret);
+}
+
+static ssize_t littlefs_pread(struct fs_file_t *fp, void *ptr, size_t len, off_t off)
+{
+	return littlefs_prw(fp, false, ptr, len, off);
+}
+
+static ssize_t littlefs_pwrite(struct fs_file_t *fp, const void *ptr, size_t len, off_t off)
+{
+	return littlefs_prw(fp, true, (void *)ptr, len, off);
+}
+#endif /* CONFIG_FILE_SYSTEM_VECTORED_IO */
+
 static int littlefs_truncate(struct fs_file_t *fp, off_t length)
 {
 	struct fs_littlefs *fs = fp->mp->fs_data;
@@ -1073,6 +1124,10 @@ static const struct fs_file_system_t littlefs_fs = {
 	.tell = littlefs_tell,
 	.truncate = littlefs_truncate,
 	.sync = littlefs_sync,
+#if defined(CONFIG_FILE_SYSTEM_VECTORED_IO)
+	.pread = littlefs_pread,
+	.pwrite = littlefs_pwrite,
+#endif
 	.opendir = littlefs_opendir,
 	.readdir = littlefs_readdir,
 	.closedir = littlefs_closedir,
@@ -11,6 +11,8 @@
 #include <inttypes.h>
 #include <zephyr/fs/nvs.h>
 #include <zephyr/sys/crc.h>
+#include <zephyr/init.h>
+#include <zephyr/stats/stats.h>
 #include "nvs_priv.h"
 
 #include <zephyr/logging/log.h>
@@ -36,14 +38,115 @@ static inline size_t nvs_lookup_cache_pos(uint16_t id)
 	return hash % CONFIG_NVS_LOOKUP_CACHE_SIZE;
 }
 
+#ifdef CONFIG_NVS_LOOKUP_INDEX
+
+/* Remove the index entry at 'pos' and close the gap in its probe sequence */
+static void nvs_lookup_index_remove(struct nvs_fs *fs, size_t pos)
+{
+	size_t next = pos;
+	size_t home;
+
+	fs->lookup_cache[pos] = NVS_LOOKUP_CACHE_NO_ADDR;
+
+	while (true) {
+		next = (next + 1) % CONFIG_NVS_LOOKUP_CACHE_SIZE;
+
+		if (fs->lookup_cache[next] == NVS_LOOKUP_CACHE_NO_ADDR) {
+			return;
+		}
+
+		home = nvs_lookup_cache_pos(fs->lookup_ids[next]);
+
+		/* Entries whose home slot lies cyclically in (pos, next] stay put */
+		if ((pos < next) ? (home > pos && home <= next) : (home > pos || home <= next)) {
+			continue;
+		}
+
+		fs->lookup_cache[pos] = fs->lookup_cache[next];
+		fs->lookup_ids[pos] = fs->lookup_ids[next];
+		fs->lookup_cache[next] = NVS_LOOKUP_CACHE_NO_ADDR;
+		pos = next;
+	}
+}
+
+#endif /* CONFIG_NVS_LOOKUP_INDEX */
+
+/*
+ * Return the address of the ATE to start looking for 'id' from, or
+ * NVS_LOOKUP_CACHE_NO_ADDR if 'id' is known not to be stored.
+ */
+static uint32_t nvs_lookup_cache_get(struct nvs_fs *fs, uint16_t id)
+{
+#ifdef CONFIG_NVS_LOOKUP_INDEX
+	size_t pos = nvs_lookup_cache_pos(id);
+
+	for (size_t i = 0; i < CONFIG_NVS_LOOKUP_CACHE_SIZE; i++) {
+		if (fs->lookup_cache[pos] == NVS_LOOKUP_CACHE_NO_ADDR) {
+			break;
+		}
+
+		if (fs->lookup_ids[pos] == id) {
+			return fs->lookup_cache[pos];
+		}
+
+		pos = (pos + 1) % CONFIG_NVS_LOOKUP_CACHE_SIZE;
+	}
+
+	/* IDs that did not fit in the index can only be found by a full scan */
+	return fs->lookup_overflow ? fs->ate_wra : NVS_LOOKUP_CACHE_NO_ADDR;
+#else
+	return fs->lookup_cache[nvs_lookup_cache_pos(id)];
+#endif
+}
+
+static void nvs_lookup_cache_set(struct nvs_fs *fs, uint16_t id, uint32_t addr)
+{
+#ifdef CONFIG_NVS_LOOKUP_INDEX
+	size_t pos = nvs_lookup_cache_pos(id);
+
+	for (size_t i = 0; i < CONFIG_NVS_LOOKUP_CACHE_SIZE; i++) {
+		if (fs->lookup_cache[pos] == NVS_LOOKUP_CACHE_NO_ADDR ||
+		    fs->lookup_ids[pos] == id) {
+			fs->lookup_ids[pos] = id;
+			fs->lookup_cache[pos] = addr;
+			return;
+		}
+
+		pos = (pos + 1) % CONFIG_NVS_LOOKUP_CACHE_SIZE;
+	}
+
+	if (!fs->lookup_overflow) {
+		LOG_WRN("Lookup index full, falling back to scanning");
+		fs->lookup_overflow = true;
+	}
+#else
+	fs->lookup_cache[nvs_lookup_cache_pos(id)] = addr;
+#endif
+}
+
+/* Make every lookup start from the most recent ATE until the cache is rebuilt */
+static void nvs_lookup_cache_scan_all(struct nvs_fs *fs)
+{
+#ifdef CONFIG_NVS_LOOKUP_INDEX
+	memset(fs->lookup_cache, 0xff, sizeof(fs->lookup_cache));
+	fs->lookup_overflow = true;
+#else
+	for (size_t i = 0; i < CONFIG_NVS_LOOKUP_CACHE_SIZE; i++) {
+		fs->lookup_cache[i] = fs->ate_wra;
+	}
+#endif
+}
+
 static int nvs_lookup_cache_rebuild(struct nvs_fs *fs)
 {
 	int rc;
 	uint32_t addr, ate_addr;
-	uint32_t *cache_entry;
 	struct nvs_ate ate;
 
 	memset(fs->lookup_cache, 0xff, sizeof(fs->lookup_cache));
+#ifdef CONFIG_NVS_LOOKUP_INDEX
+	fs->lookup_overflow = false;
+#endif
 	addr = fs->ate_wra;
 
 	while (true) {
@@ -55,11 +158,10 @@ static int nvs_lookup_cache_rebuild(struct nvs_fs *fs)
 			return rc;
 		}
 
-		cache_entry = &fs->lookup_cache[nvs_lookup_cache_pos(ate.id)];
-
-		if (ate.id != 0xFFFF && *cache_entry == NVS_LOOKUP_CACHE_NO_ADDR &&
+		if (ate.id != 0xFFFF &&
+		    nvs_lookup_cache_get(fs, ate.id) == NVS_LOOKUP_CACHE_NO_ADDR &&
 		    nvs_ate_valid(fs, &ate)) {
-			*cache_entry = ate_addr;
+			nvs_lookup_cache_set(fs, ate.id, ate_addr);
 		}
 
 		if (addr == fs->ate_wra) {
@@ -72,6 +174,20 @@ static int nvs_lookup_cache_rebuild(struct nvs_fs *fs)
 
 static void nvs_lookup_cache_invalidate(struct nvs_fs *fs, uint32_t sector)
 {
+#ifdef CONFIG_NVS_LOOKUP_INDEX
+	size_t pos = 0;
+
+	while (pos < CONFIG_NVS_LOOKUP_CACHE_SIZE) {
+		if (fs->lookup_cache[pos] != NVS_LOOKUP_CACHE_NO_ADDR &&
+		    (fs->lookup_cache[pos] >> ADDR_SECT_SHIFT) == sector) {
+			/* Removal may shift another entry into 'pos', so check it again */
+			nvs_lookup_index_remove(fs, pos);
+			continue;
+		}
+
+		pos++;
+	}
+#else
 	uint32_t *cache_entry = fs->lookup_cache;
 	uint32_t *const cache_end = &fs->lookup_cache[CONFIG_NVS_LOOKUP_CACHE_SIZE];
 
@@ -80,10 +196,99 @@ static void nvs_lookup_cache_invalidate(struct nvs_fs *fs, uint32_t sector)
 			*cache_entry = NVS_LOOKUP_CACHE_NO_ADDR;
 		}
 	}
+#endif
 }
 
 #endif /* CONFIG_NVS_LOOKUP_CACHE */
 
+#ifdef CONFIG_NVS_GC_STATS
+
+STATS_SECT_START(nvs_gc_stats)
+STATS_SECT_ENTRY32(sync_lt_1ms)   /* foreground gc runs shorter than 1 ms */
+STATS_SECT_ENTRY32(sync_lt_10ms)  /* foreground gc runs shorter than 10 ms */
+STATS_SECT_ENTRY32(sync_lt_100ms) /* foreground gc runs shorter than 100 ms */
+STATS_SECT_ENTRY32(sync_ge_100ms) /* foreground gc runs of 100 ms or more */
+STATS_SECT_ENTRY32(sync_max_us)   /* longest foreground gc run */
+STATS_SECT_ENTRY32(bg_lt_1ms)     /* background gc steps shorter than 1 ms */
+STATS_SECT_ENTRY32(bg_lt_10ms)    /* background gc steps shorter than 10 ms */
+STATS_SECT_ENTRY32(bg_lt_100ms)   /* background gc steps shorter than 100 ms */
+STATS_SECT_ENTRY32(bg_ge_100ms)   /* background gc steps of 100 ms or more */
+STATS_SECT_ENTRY32(bg_moved)      /* entries moved by background gc */
+STATS_SECT_ENTRY32(bg_rotations)  /* sectors rotated by background gc */
+STATS_SECT_END;
+
+STATS_NAME_START(nvs_gc_stats)
+STATS_NAME(nvs_gc_stats, sync_lt_1ms)
+STATS_NAME(nvs_gc_stats, sync_lt_10ms)
+STATS_NAME(nvs_gc_stats, sync_lt_100ms)
+STATS_NAME(nvs_gc_stats, sync_ge_100ms)
+STATS_NAME(nvs_gc_stats, sync_max_us)
+STATS_NAME(nvs_gc_stats, bg_lt_1ms)
+STATS_NAME(nvs_gc_stats, bg_lt_10ms)
+STATS_NAME(nvs_gc_stats, bg_lt_100ms)
+STATS_NAME(nvs_gc_stats, bg_ge_100ms)
+STATS_NAME(nvs_gc_stats, bg_moved)
+STATS_NAME(nvs_gc_stats, bg_rotations)
+STATS_NAME_END(nvs_gc_stats);
+
+static STATS_SECT_DECL(nvs_gc_stats) nvs_gc_stats;
+
+static int nvs_gc_stats_init(void)
+{
+	return STATS_INIT_AND_REG(nvs_gc_stats, STATS_SIZE_32, "nvs_gc");
+}
+
+SYS_INIT(nvs_gc_stats_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+#endif /* CONFIG_NVS_GC_STATS */
+
+static inline uint32_t nvs_gc_stats_start(void)
+{
+#ifdef CONFIG_NVS_GC_STATS
+	return k_cycle_get_32();
+#else
+	return 0;
+#endif
+}
+
+/* Account a garbage collection run that began at cycle count 'start' */
+static void nvs_gc_stats_record(bool background, uint32_t start)
+{
+#ifdef CONFIG_NVS_GC_STATS
+	uint32_t us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+
+	if (background) {
+		if (us < 1000U) {
+			STATS_INC(nvs_gc_stats, bg_lt_1ms);
+		} else if (us < 10000U) {
+			STATS_INC(nvs_gc_stats, bg_lt_10ms);
+		} else if (us < 100000U) {
+			STATS_INC(nvs_gc_stats, bg_lt_100ms);
+		} else {
+			STATS_INC(nvs_gc_stats, bg_ge_100ms);
+		}
+		return;
+	}
+
+	if (us < 1000U) {
+		STATS_INC(nvs_gc_stats, sync_lt_1ms);
+	} else if (us < 10000U) {
+		STATS_INC(nvs_gc_stats, sync_lt_10ms);
+	} else if (us < 100000U) {
+		STATS_INC(nvs_gc_stats, sync_lt_100ms);
+	} else {
+		STATS_INC(nvs_gc_stats, sync_ge_100ms);
+	}
+
+	if (us > nvs_gc_stats.sync_max_us) {
+		STATS_SET(nvs_gc_stats, sync_max_us, us);
+	}
+#else
+	ARG_UNUSED(background);
+	ARG_UNUSED(start);
+#endif
+}
+
 /* basic routines */
 /* nvs_al_size returns size aligned to fs->write_block_size */
 static inline size_t nvs_al_size(struct nvs_fs *fs, size_t len)
@@ -166,7 +371,7 @@ static int nvs_flash_ate_wrt(struct nvs_fs *fs, const struct nvs_ate *entry)
 #ifdef CONFIG_NVS_LOOKUP_CACHE
 	/* 0xFFFF is a special-purpose identifier. Exclude it from the cache */
 	if (entry->id != 0xFFFF) {
-		fs->lookup_cache[nvs_lookup_cache_pos(entry->id)] = fs->ate_wra;
+		nvs_lookup_cache_set(fs, entry->id, fs->ate_wra);
 	}
 #endif
 	fs->ate_wra -= nvs_al_size(fs, sizeof(struct nvs_ate));
@@ -620,6 +825,71 @@ static int nvs_add_gc_done_ate(struct nvs_fs *fs)
 	return nvs_flash_ate_wrt(fs, &gc_done_ate);
 }
 
+/* move the entry gc_ate, stored at gc_ate_addr, to the write location if it is
+ * the most recent one for its id and not a deleted item.
+ * return 1 if the entry was moved, 0 if not, errorcode on error.
+ */
+static int nvs_gc_move_entry(struct nvs_fs *fs, uint32_t gc_ate_addr, struct nvs_ate *gc_ate)
+{
+	int rc;
+	struct nvs_ate wlk_ate;
+	uint32_t wlk_addr, wlk_prev_addr, data_addr;
+
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	wlk_addr = nvs_lookup_cache_get(fs, gc_ate->id);
+
+	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
+		wlk_addr = fs->ate_wra;
+	}
+#else
+	wlk_addr = fs->ate_wra;
+#endif
+	do {
+		wlk_prev_addr = wlk_addr;
+		rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
+		if (rc) {
+			return rc;
+		}
+		/* if ate with same id is reached we might need to copy.
+		 * only consider valid wlk_ate's. Something wrong might
+		 * have been written that has the same ate but is
+		 * invalid, don't consider these as a match.
+		 */
+		if ((wlk_ate.id == gc_ate->id) &&
+		    (nvs_ate_valid(fs, &wlk_ate))) {
+			break;
+		}
+	} while (wlk_addr != fs->ate_wra);
+
+	/* if walk has reached the same address as gc_ate_addr copy is
+	 * needed unless it is a deleted item.
+	 */
+	if ((wlk_prev_addr != gc_ate_addr) || !gc_ate->len) {
+		return 0;
+	}
+
+	/* copy needed */
+	LOG_DBG("Moving %d, len %d", gc_ate->id, gc_ate->len);
+
+	data_addr = (gc_ate_addr & ADDR_SECT_MASK);
+	data_addr += gc_ate->offset;
+
+	gc_ate->offset = (uint16_t)(fs->data_wra & ADDR_OFFS_MASK);
+	nvs_ate_crc8_update(gc_ate);
+
+	rc = nvs_flash_block_move(fs, data_addr, gc_ate->len);
+	if (rc) {
+		return rc;
+	}
+
+	rc = nvs_flash_ate_wrt(fs, gc_ate);
+	if (rc) {
+		return rc;
+	}
+
+	return 1;
+}
+
 /* garbage collection: the address ate_wra has been updated to the new sector
  * that has just been started. The data to gc is in the sector after this new
  * sector.
@@ -627,13 +897,17 @@ static int nvs_add_gc_done_ate(struct nvs_fs *fs)
 static int nvs_gc(struct nvs_fs *fs)
 {
 	int rc;
-	struct nvs_ate close_ate, gc_ate, wlk_ate;
-	uint32_t sec_addr, gc_addr, gc_prev_addr, wlk_addr, wlk_prev_addr,
-	      data_addr, stop_addr;
+	struct nvs_ate close_ate, gc_ate;
+	uint32_t sec_addr, gc_addr, gc_prev_addr, stop_addr;
 	size_t ate_size;
 
 	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
 
+#ifdef CONFIG_NVS_GC_BACKGROUND
+	/* any background progress referred to the previous write sector */
+	fs->gc_bg_addr = NVS_GC_BG_IDLE;
+#endif
+
 	sec_addr = (fs->ate_wra & ADDR_SECT_MASK);
 	nvs_sector_advance(fs, &sec_addr);
 	gc_addr = sec_addr + fs->sector_size - ate_size;
@@ -673,54 +947,9 @@ static int nvs_gc(struct nvs_fs *fs)
 			continue;
 		}
 
-#ifdef CONFIG_NVS_LOOKUP_CACHE
-		wlk_addr = fs->lookup_cache[nvs_lookup_cache_pos(gc_ate.id)];
-
-		if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
-			wlk_addr = fs->ate_wra;
-		}
-#else
-		wlk_addr = fs->ate_wra;
-#endif
-		do {
-			wlk_prev_addr = wlk_addr;
-			rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
-			if (rc) {
-				return rc;
-			}
-			/* if ate with same id is reached we might need to copy.
-			 * only consider valid wlk_ate's. Something wrong might
-			 * have been written that has the same ate but is
-			 * invalid, don't consider these as a match.
-			 */
-			if ((wlk_ate.id == gc_ate.id) &&
-			    (nvs_ate_valid(fs, &wlk_ate))) {
-				break;
-			}
-		} while (wlk_addr != fs->ate_wra);
-
-		/* if walk has reached the same address as gc_addr copy is
-		 * needed unless it is a deleted item.
-		 */
-		if ((wlk_prev_addr == gc_prev_addr) && gc_ate.len) {
-			/* copy needed */
-			LOG_DBG("Moving %d, len %d", gc_ate.id, gc_ate.len);
-
-			data_addr = (gc_prev_addr & ADDR_SECT_MASK);
-			data_addr += gc_ate.offset;
-
-			gc_ate.offset = (uint16_t)(fs->data_wra & ADDR_OFFS_MASK);
-			nvs_ate_crc8_update(&gc_ate);
-
-			rc = nvs_flash_block_move(fs, data_addr, gc_ate.len);
-			if (rc) {
-				return rc;
-			}
-
-			rc = nvs_flash_ate_wrt(fs, &gc_ate);
-			if (rc) {
-				return rc;
-			}
+		rc = nvs_gc_move_entry(fs, gc_prev_addr, &gc_ate);
+		if (rc < 0) {
+			return rc;
 		}
 	} while (gc_prev_addr != stop_addr);
 
@@ -742,9 +971,210 @@ gc_done:
 	/* Erase the gc'ed sector */
 	rc = nvs_flash_erase_sector(fs, sec_addr);
 
+#ifdef CONFIG_NVS_GC_BACKGROUND
+	fs->gc_bg_base = fs->ate_wra - fs->data_wra;
+#endif
+
 	return rc;
 }
 
+#ifdef CONFIG_NVS_GC_BACKGROUND
+
+static struct k_work_q nvs_gc_workq;
+static K_THREAD_STACK_DEFINE(nvs_gc_workq_stack, CONFIG_NVS_GC_BACKGROUND_STACK_SIZE);
+
+static int nvs_gc_workq_init(void)
+{
+	const struct k_work_queue_config cfg = {
+		.name = "nvs_gc",
+	};
+
+	k_work_queue_start(&nvs_gc_workq, nvs_gc_workq_stack,
+			   K_THREAD_STACK_SIZEOF(nvs_gc_workq_stack),
+			   CONFIG_NVS_GC_BACKGROUND_PRIORITY, &cfg);
+
+	return 0;
+}
+
+SYS_INIT(nvs_gc_workq_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+/* The write sector is due for rotation when its free space drops below the
+ * threshold. To avoid rotating over and over a sector that gc has already
+ * filled, at least the same amount must have been written to it since.
+ */
+static bool nvs_gc_bg_needed(struct nvs_fs *fs)
+{
+	uint32_t free_space = fs->ate_wra - fs->data_wra;
+	uint32_t threshold = fs->sector_size * CONFIG_NVS_GC_BACKGROUND_THRESHOLD / 100U;
+
+	return (free_space < threshold) && (fs->gc_bg_base >= (free_space + threshold));
+}
+
+/* Start background gc: point gc_bg_addr at the last ate of the sector that
+ * will be garbage collected at the next rotation, i.e. two sectors after the
+ * write sector, or mark migration as done if there is nothing to move.
+ */
+static int nvs_gc_bg_start(struct nvs_fs *fs)
+{
+	int rc;
+	struct nvs_ate close_ate;
+	uint32_t gc_addr;
+	size_t ate_size;
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+
+	fs->gc_bg_addr = NVS_GC_BG_DONE;
+
+	/* with two sectors the gc sector is the write sector itself */
+	if (fs->sector_count < 3) {
+		return 0;
+	}
+
+	gc_addr = fs->ate_wra & ADDR_SECT_MASK;
+	nvs_sector_advance(fs, &gc_addr);
+	nvs_sector_advance(fs, &gc_addr);
+	gc_addr += fs->sector_size - ate_size;
+
+	rc = nvs_flash_ate_rd(fs, gc_addr, &close_ate);
+	if (rc < 0) {
+		return rc;
+	}
+
+	rc = nvs_ate_cmp_const(&close_ate, fs->flash_parameters->erase_value);
+	if (!rc) {
+		return 0;
+	}
+
+	if (nvs_close_ate_valid(fs, &close_ate)) {
+		gc_addr &= ADDR_SECT_MASK;
+		gc_addr += close_ate.offset;
+	} else {
+		rc = nvs_recover_last_ate(fs, &gc_addr);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	fs->gc_bg_addr = gc_addr;
+
+	return 0;
+}
+
+/* One bounded step of background gc. Live entries of the sector that the next
+ * rotation will collect are rewritten to the write sector, at most
+ * CONFIG_NVS_GC_BACKGROUND_CHUNK ates per step. Once they are all moved, or the
+ * write sector is full, the write sector is closed and the gc of the next
+ * rotation, which has (almost) nothing left to copy, is run.
+ * return 1 if another step is needed, 0 when done, errorcode on error.
+ */
+static int nvs_gc_bg_step(struct nvs_fs *fs)
+{
+	int rc;
+	struct nvs_ate gc_ate;
+	uint32_t gc_prev_addr, stop_addr;
+	size_t ate_size;
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+
+	if (fs->gc_bg_addr == NVS_GC_BG_IDLE) {
+		rc = nvs_gc_bg_start(fs);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	stop_addr = (fs->gc_bg_addr & ADDR_SECT_MASK) + fs->sector_size - 2 * ate_size;
+
+	for (int i = 0; i < CONFIG_NVS_GC_BACKGROUND_CHUNK; i++) {
+		if (fs->gc_bg_addr == NVS_GC_BG_DONE) {
+			break;
+		}
+
+		gc_prev_addr = fs->gc_bg_addr;
+		rc = nvs_prev_ate(fs, &fs->gc_bg_addr, &gc_ate);
+		if (rc) {
+			return rc;
+		}
+
+		if (gc_prev_addr == stop_addr) {
+			fs->gc_bg_addr = NVS_GC_BG_DONE;
+		}
+
+		if (!nvs_ate_valid(fs, &gc_ate)) {
+			continue;
+		}
+
+		/* keep room for a delete ate and the gc done ate */
+		if (fs->ate_wra < (fs->data_wra + nvs_al_size(fs, gc_ate.len) + 3 * ate_size)) {
+			fs->gc_bg_addr = NVS_GC_BG_DONE;
+			break;
+		}
+
+		rc = nvs_gc_move_entry(fs, gc_prev_addr, &gc_ate);
+		if (rc < 0) {
+			return rc;
+		}
+#ifdef CONFIG_NVS_GC_STATS
+		STATS_INCN(nvs_gc_stats, bg_moved, rc);
+#endif
+	}
+
+	if (fs->gc_bg_addr != NVS_GC_BG_DONE) {
+		return 1;
+	}
+
+	rc = nvs_sector_close(fs);
+	if (rc) {
+		return rc;
+	}
+
+	rc = nvs_gc(fs);
+	if (rc) {
+		return rc;
+	}
+
+#ifdef CONFIG_NVS_GC_STATS
+	STATS_INC(nvs_gc_stats, bg_rotations);
+#endif
+
+	return 0;
+}
+
+static void nvs_gc_work_handler(struct k_work *work)
+{
+	struct nvs_fs *fs = CONTAINER_OF(work, struct nvs_fs, gc_work);
+	uint32_t start;
+	int rc = 0;
+
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+
+	if (fs->ready && ((fs->gc_bg_addr != NVS_GC_BG_IDLE) || nvs_gc_bg_needed(fs))) {
+		start = nvs_gc_stats_start();
+		rc = nvs_gc_bg_step(fs);
+		nvs_gc_stats_record(true, start);
+		if (rc < 0) {
+			LOG_ERR("Background gc failed: %d", rc);
+			fs->gc_bg_addr = NVS_GC_BG_IDLE;
+		}
+	}
+
+	k_mutex_unlock(&fs->nvs_lock);
+
+	if (rc > 0) {
+		(void)k_work_submit_to_queue(&nvs_gc_workq, &fs->gc_work);
+	}
+}
+
+/* Called with the lock held after a write */
+static void nvs_gc_bg_kick(struct nvs_fs *fs)
+{
+	if ((fs->gc_bg_addr == NVS_GC_BG_IDLE) && nvs_gc_bg_needed(fs)) {
+		(void)k_work_submit_to_queue(&nvs_gc_workq, &fs->gc_work);
+	}
+}
+
+#endif /* CONFIG_NVS_GC_BACKGROUND */
+
 static int nvs_startup(struct nvs_fs *fs)
 {
 	int rc;
@@ -923,9 +1353,7 @@ static int nvs_startup(struct nvs_fs *fs)
 		 * So, temporarily, we set the lookup cache to the end of the fs.
 		 * The cache will be rebuilt afterwards
 		 **/
-		for (i = 0; i < CONFIG_NVS_LOOKUP_CACHE_SIZE; i++) {
-			fs->lookup_cache[i] = fs->ate_wra;
-		}
+		nvs_lookup_cache_scan_all(fs);
 #endif
 		rc = nvs_gc(fs);
 		goto end;
@@ -975,6 +1403,14 @@ end:
 
 		rc = nvs_add_gc_done_ate(fs);
 	}
+#ifdef CONFIG_NVS_GC_BACKGROUND
+	/* How much free space the write sector had when it was started is not
+	 * known, so allow background gc to start right away if the sector is
+	 * already below the threshold.
+	 */
+	fs->gc_bg_addr = NVS_GC_BG_IDLE;
+	fs->gc_bg_base = fs->sector_size;
+#endif
 	k_mutex_unlock(&fs->nvs_lock);
 	return rc;
 }
@@ -989,6 +1425,12 @@ int nvs_clear(struct nvs_fs *fs)
 		return -EACCES;
 	}
 
+#ifdef CONFIG_NVS_GC_BACKGROUND
+	struct k_work_sync sync;
+
+	(void)k_work_cancel_sync(&fs->gc_work, &sync);
+#endif
+
 	for (uint16_t i = 0; i < fs->sector_count; i++) {
 		addr = i << ADDR_SECT_SHIFT;
 		rc = nvs_flash_erase_sector(fs, addr);
@@ -1009,6 +1451,13 @@ int nvs_mount(struct nvs_fs *fs)
 	struct flash_pages_info info;
 	size_t write_block_size;
 
+#ifdef CONFIG_NVS_GC_BACKGROUND
+	/* on a remount the work item can still be queued or running, its
+	 * state cannot be read before it is initialized, so wait for the queue
+	 */
+	(void)k_work_queue_drain(&nvs_gc_workq, false);
+	k_work_init(&fs->gc_work, nvs_gc_work_handler);
+#endif
 	k_mutex_init(&fs->nvs_lock);
 
 	fs->flash_parameters = flash_get_parameters(fs->flash_device);
@@ -1057,6 +1506,12 @@ int nvs_mount(struct nvs_fs *fs)
 	/* nvs is ready for use */
 	fs->ready = true;
 
+#ifdef CONFIG_NVS_GC_BACKGROUND
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+	nvs_gc_bg_kick(fs);
+	k_mutex_unlock(&fs->nvs_lock);
+#endif
+
 	LOG_INF("%d Sectors of %d bytes", fs->sector_count, fs->sector_size);
 	LOG_INF("alloc wra: %d, %x",
 		(fs->ate_wra >> ADDR_SECT_SHIFT),
@@ -1075,6 +1530,7 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 	struct nvs_ate wlk_ate;
 	uint32_t wlk_addr, rd_addr;
 	uint16_t required_space = 0U; /* no space, appropriate for delete ate */
+	uint32_t gc_start;
 	bool prev_found = false;
 
 	if (!fs->ready) {
@@ -1098,7 +1554,7 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 
 	/* find latest entry with same id */
 #ifdef CONFIG_NVS_LOOKUP_CACHE
-	wlk_addr = fs->lookup_cache[nvs_lookup_cache_pos(id)];
+	wlk_addr = nvs_lookup_cache_get(fs, id);
 
 	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
 		goto no_cached_entry;
@@ -1185,6 +1641,7 @@ no_cached_entry:
 			break;
 		}
 
+		gc_start = nvs_gc_stats_start();
 
 		rc = nvs_sector_close(fs);
 		if (rc) {
@@ -1192,11 +1649,15 @@ no_cached_entry:
 		}
 
 		rc = nvs_gc(fs);
+		nvs_gc_stats_record(false, gc_start);
 		if (rc) {
 			goto end;
 		}
 		gc_count++;
 	}
+#ifdef CONFIG_NVS_GC_BACKGROUND
+	nvs_gc_bg_kick(fs);
+#endif
 	rc = len;
 end:
 	k_mutex_unlock(&fs->nvs_lock);
@@ -1234,7 +1695,7 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len,
 	cnt_his = 0U;
 
 #ifdef CONFIG_NVS_LOOKUP_CACHE
-	wlk_addr = fs->lookup_cache[nvs_lookup_cache_pos(id)];
+	wlk_addr = nvs_lookup_cache_get(fs, id);
 
 	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
 		rc = -ENOENT;
@@ -1391,6 +1852,7 @@ size_t nvs_sector_max_data_size(struct nvs_fs *fs)
 int nvs_sector_use_next(struct nvs_fs *fs)
 {
 	int ret;
+	uint32_t gc_start;
 
 	if (!fs->ready) {
 		LOG_ERR("NVS not initialized");
@@ -1399,12 +1861,15 @@ int nvs_sector_use_next(struct nvs_fs *fs)
 
 	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
 
+	gc_start = nvs_gc_stats_start();
+
 	ret = nvs_sector_close(fs);
 	if (ret != 0) {
 		goto end;
 	}
 
 	ret = nvs_gc(fs);
+	nvs_gc_stats_record(false, gc_start);
 
 end:
 	k_mutex_unlock(&fs->nvs_lock);
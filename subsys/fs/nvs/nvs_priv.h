@@ -32,6 +32,13 @@ extern "C" {
 
 #define NVS_LOOKUP_CACHE_NO_ADDR 0xFFFFFFFF
 
+/*
+ * Background garbage collection states, other values of gc_bg_addr are the
+ * address of the next ate to move
+ */
+#define NVS_GC_BG_IDLE 0xFFFFFFFF
+#define NVS_GC_BG_DONE 0xFFFFFFFE
+
 /*
  * Allow to use the NVS_DATA_CRC_SIZE macro in computations whether data CRC is enabled or not
  */
@@ -11,6 +11,8 @@
 #include <inttypes.h>
 #include <zephyr/fs/zms.h>
 #include <zephyr/sys/crc.h>
+#include <zephyr/init.h>
+#include <zephyr/stats/stats.h>
 #include "zms_priv.h"
 #ifdef CONFIG_ZMS_LOOKUP_CACHE_FOR_SETTINGS
 #include <settings/settings_zms.h>
@@ -26,6 +28,7 @@ static int zms_get_sector_header(struct zms_fs *fs, uint64_t addr, struct zms_at
 				 struct zms_ate *close_ate);
 static int zms_ate_valid_different_sector(struct zms_fs *fs, const struct zms_ate *entry,
 					  uint8_t cycle_cnt);
+static int zms_add_empty_ate(struct zms_fs *fs, uint64_t addr);
 
 #ifdef CONFIG_ZMS_LOOKUP_CACHE
 
@@ -81,17 +84,118 @@ static inline size_t zms_lookup_cache_pos(zms_id_t id)
 	return hash % CONFIG_ZMS_LOOKUP_CACHE_SIZE;
 }
 
+#ifdef CONFIG_ZMS_LOOKUP_INDEX
+
+/* Remove the index entry at 'pos' and close the gap in its probe sequence */
+static void zms_lookup_index_remove(struct zms_fs *fs, size_t pos)
+{
+	size_t next = pos;
+	size_t home;
+
+	fs->lookup_cache[pos] = ZMS_LOOKUP_CACHE_NO_ADDR;
+
+	while (true) {
+		next = (next + 1) % CONFIG_ZMS_LOOKUP_CACHE_SIZE;
+
+		if (fs->lookup_cache[next] == ZMS_LOOKUP_CACHE_NO_ADDR) {
+			return;
+		}
+
+		home = zms_lookup_cache_pos(fs->lookup_ids[next]);
+
+		/* Entries whose home slot lies cyclically in (pos, next] stay put */
+		if ((pos < next) ? (home > pos && home <= next) : (home > pos || home <= next)) {
+			continue;
+		}
+
+		fs->lookup_cache[pos] = fs->lookup_cache[next];
+		fs->lookup_ids[pos] = fs->lookup_ids[next];
+		fs->lookup_cache[next] = ZMS_LOOKUP_CACHE_NO_ADDR;
+		pos = next;
+	}
+}
+
+#endif /* CONFIG_ZMS_LOOKUP_INDEX */
+
+/*
+ * Return the address of the ATE to start looking for 'id' from, or
+ * ZMS_LOOKUP_CACHE_NO_ADDR if 'id' is known not to be stored.
+ */
+static uint64_t zms_lookup_cache_get(struct zms_fs *fs, zms_id_t id)
+{
+#ifdef CONFIG_ZMS_LOOKUP_INDEX
+	size_t pos = zms_lookup_cache_pos(id);
+
+	for (size_t i = 0; i < CONFIG_ZMS_LOOKUP_CACHE_SIZE; i++) {
+		if (fs->lookup_cache[pos] == ZMS_LOOKUP_CACHE_NO_ADDR) {
+			break;
+		}
+
+		if (fs->lookup_ids[pos] == id) {
+			return fs->lookup_cache[pos];
+		}
+
+		pos = (pos + 1) % CONFIG_ZMS_LOOKUP_CACHE_SIZE;
+	}
+
+	/* IDs that did not fit in the index can only be found by a full scan */
+	return fs->lookup_overflow ? fs->ate_wra : ZMS_LOOKUP_CACHE_NO_ADDR;
+#else
+	return fs->lookup_cache[zms_lookup_cache_pos(id)];
+#endif
+}
+
+static void zms_lookup_cache_set(struct zms_fs *fs, zms_id_t id, uint64_t addr)
+{
+#ifdef CONFIG_ZMS_LOOKUP_INDEX
+	size_t pos = zms_lookup_cache_pos(id);
+
+	for (size_t i = 0; i < CONFIG_ZMS_LOOKUP_CACHE_SIZE; i++) {
+		if (fs->lookup_cache[pos] == ZMS_LOOKUP_CACHE_NO_ADDR ||
+		    fs->lookup_ids[pos] == id) {
+			fs->lookup_ids[pos] = id;
+			fs->lookup_cache[pos] = addr;
+			return;
+		}
+
+		pos = (pos + 1) % CONFIG_ZMS_LOOKUP_CACHE_SIZE;
+	}
+
+	if (!fs->lookup_overflow) {
+		LOG_WRN("Lookup index full, falling back to scanning");
+		fs->lookup_overflow = true;
+	}
+#else
+	fs->lookup_cache[zms_lookup_cache_pos(id)] = addr;
+#endif
+}
+
+/* Make every lookup start from the most recent ATE until the cache is rebuilt */
+static void zms_lookup_cache_scan_all(struct zms_fs *fs)
+{
+#ifdef CONFIG_ZMS_LOOKUP_INDEX
+	memset(fs->lookup_cache, 0xff, sizeof(fs->lookup_cache));
+	fs->lookup_overflow = true;
+#else
+	for (size_t i = 0; i < CONFIG_ZMS_LOOKUP_CACHE_SIZE; i++) {
+		fs->lookup_cache[i] = fs->ate_wra;
+	}
+#endif
+}
+
 static int zms_lookup_cache_rebuild(struct zms_fs *fs)
 {
 	int rc;
 	int previous_sector_num = ZMS_INVALID_SECTOR_NUM;
 	uint64_t addr;
 	uint64_t ate_addr;
-	uint64_t *cache_entry;
 	uint8_t current_cycle;
 	struct zms_ate ate;
 
 	memset(fs->lookup_cache, 0xff, sizeof(fs->lookup_cache));
+#ifdef CONFIG_ZMS_LOOKUP_INDEX
+	fs->lookup_overflow = false;
+#endif
 	addr = fs->ate_wra;
 
 	while (true) {
@@ -103,9 +207,8 @@ static int zms_lookup_cache_rebuild(struct zms_fs *fs)
 			return rc;
 		}
 
-		cache_entry = &fs->lookup_cache[zms_lookup_cache_pos(ate.id)];
-
-		if (ate.id != ZMS_HEAD_ID && *cache_entry == ZMS_LOOKUP_CACHE_NO_ADDR) {
+		if (ate.id != ZMS_HEAD_ID &&
+		    zms_lookup_cache_get(fs, ate.id) == ZMS_LOOKUP_CACHE_NO_ADDR) {
 			/* read the ate cycle only when we change the sector
 			 * or if it is the first read
 			 */
@@ -120,7 +223,7 @@ static int zms_lookup_cache_rebuild(struct zms_fs *fs)
 				}
 			}
 			if (zms_ate_valid_different_sector(fs, &ate, current_cycle)) {
-				*cache_entry = ate_addr;
+				zms_lookup_cache_set(fs, ate.id, ate_addr);
 			}
 			previous_sector_num = SECTOR_NUM(ate_addr);
 		}
@@ -135,6 +238,20 @@ static int zms_lookup_cache_rebuild(struct zms_fs *fs)
 
 static void zms_lookup_cache_invalidate(struct zms_fs *fs, uint32_t sector)
 {
+#ifdef CONFIG_ZMS_LOOKUP_INDEX
+	size_t pos = 0;
+
+	while (pos < CONFIG_ZMS_LOOKUP_CACHE_SIZE) {
+		if (fs->lookup_cache[pos] != ZMS_LOOKUP_CACHE_NO_ADDR &&
+		    SECTOR_NUM(fs->lookup_cache[pos]) == sector) {
+			/* Removal may shift another entry into 'pos', so check it again */
+			zms_lookup_index_remove(fs, pos);
+			continue;
+		}
+
+		pos++;
+	}
+#else
 	uint64_t *cache_entry = fs->lookup_cache;
 	uint64_t *const cache_end = &fs->lookup_cache[CONFIG_ZMS_LOOKUP_CACHE_SIZE];
 
@@ -143,10 +260,99 @@ static void zms_lookup_cache_invalidate(struct zms_fs *fs, uint32_t sector)
 			*cache_entry = ZMS_LOOKUP_CACHE_NO_ADDR;
 		}
 	}
+#endif
 }
 
 #endif /* CONFIG_ZMS_LOOKUP_CACHE */
 
+#ifdef CONFIG_ZMS_GC_STATS
+
+STATS_SECT_START(zms_gc_stats)
+STATS_SECT_ENTRY32(sync_lt_1ms)   /* foreground GC runs shorter than 1 ms */
+STATS_SECT_ENTRY32(sync_lt_10ms)  /* foreground GC runs shorter than 10 ms */
+STATS_SECT_ENTRY32(sync_lt_100ms) /* foreground GC runs shorter than 100 ms */
+STATS_SECT_ENTRY32(sync_ge_100ms) /* foreground GC runs of 100 ms or more */
+STATS_SECT_ENTRY32(sync_max_us)   /* longest foreground GC run */
+STATS_SECT_ENTRY32(bg_lt_1ms)     /* background GC steps shorter than 1 ms */
+STATS_SECT_ENTRY32(bg_lt_10ms)    /* background GC steps shorter than 10 ms */
+STATS_SECT_ENTRY32(bg_lt_100ms)   /* background GC steps shorter than 100 ms */
+STATS_SECT_ENTRY32(bg_ge_100ms)   /* background GC steps of 100 ms or more */
+STATS_SECT_ENTRY32(bg_moved)      /* entries moved by background GC */
+STATS_SECT_ENTRY32(bg_rotations)  /* sectors rotated by background GC */
+STATS_SECT_END;
+
+STATS_NAME_START(zms_gc_stats)
+STATS_NAME(zms_gc_stats, sync_lt_1ms)
+STATS_NAME(zms_gc_stats, sync_lt_10ms)
+STATS_NAME(zms_gc_stats, sync_lt_100ms)
+STATS_NAME(zms_gc_stats, sync_ge_100ms)
+STATS_NAME(zms_gc_stats, sync_max_us)
+STATS_NAME(zms_gc_stats, bg_lt_1ms)
+STATS_NAME(zms_gc_stats, bg_lt_10ms)
+STATS_NAME(zms_gc_stats, bg_lt_100ms)
+STATS_NAME(zms_gc_stats, bg_ge_100ms)
+STATS_NAME(zms_gc_stats, bg_moved)
+STATS_NAME(zms_gc_stats, bg_rotations)
+STATS_NAME_END(zms_gc_stats);
+
+static STATS_SECT_DECL(zms_gc_stats) zms_gc_stats;
+
+static int zms_gc_stats_init(void)
+{
+	return STATS_INIT_AND_REG(zms_gc_stats, STATS_SIZE_32, "zms_gc");
+}
+
+SYS_INIT(zms_gc_stats_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+#endif /* CONFIG_ZMS_GC_STATS */
+
+static inline uint32_t zms_gc_stats_start(void)
+{
+#ifdef CONFIG_ZMS_GC_STATS
+	return k_cycle_get_32();
+#else
+	return 0;
+#endif
+}
+
+/* Account a GC run that began at cycle count 'start' */
+static void zms_gc_stats_record(bool background, uint32_t start)
+{
+#ifdef CONFIG_ZMS_GC_STATS
+	uint32_t us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+
+	if (background) {
+		if (us < 1000U) {
+			STATS_INC(zms_gc_stats, bg_lt_1ms);
+		} else if (us < 10000U) {
+			STATS_INC(zms_gc_stats, bg_lt_10ms);
+		} else if (us < 100000U) {
+			STATS_INC(zms_gc_stats, bg_lt_100ms);
+		} else {
+			STATS_INC(zms_gc_stats, bg_ge_100ms);
+		}
+		return;
+	}
+
+	if (us < 1000U) {
+		STATS_INC(zms_gc_stats, sync_lt_1ms);
+	} else if (us < 10000U) {
+		STATS_INC(zms_gc_stats, sync_lt_10ms);
+	} else if (us < 100000U) {
+		STATS_INC(zms_gc_stats, sync_lt_100ms);
+	} else {
+		STATS_INC(zms_gc_stats, sync_ge_100ms);
+	}
+
+	if (us > zms_gc_stats.sync_max_us) {
+		STATS_SET(zms_gc_stats, sync_max_us, us);
+	}
+#else
+	ARG_UNUSED(background);
+	ARG_UNUSED(start);
+#endif
+}
+
 /* Helper to compute offset given the address */
 static inline off_t zms_addr_to_offset(struct zms_fs *fs, uint64_t addr)
 {
@@ -252,7 +458,7 @@ static int zms_flash_ate_wrt(struct zms_fs *fs, const struct zms_ate *entry)
 #ifdef CONFIG_ZMS_LOOKUP_CACHE
 	/* ZMS_HEAD_ID is a special-purpose identifier. Exclude it from the cache */
 	if (entry->id != ZMS_HEAD_ID) {
-		fs->lookup_cache[zms_lookup_cache_pos(entry->id)] = fs->ate_wra;
+		zms_lookup_cache_set(fs, entry->id, fs->ate_wra);
 	}
 #endif
 	fs->ate_wra -= zms_al_size(fs, sizeof(struct zms_ate));
@@ -365,10 +571,11 @@ static int zms_flash_block_move(struct zms_fs *fs, uint64_t addr, size_t len)
 	return 0;
 }
 
-/* erase a sector and verify erase was OK.
+/* erase a sector and verify erase was OK. The file system state is not
+ * touched, so background GC can call this without holding the lock.
  * return 0 if OK, errorcode on error.
  */
-static int zms_flash_erase_sector(struct zms_fs *fs, uint64_t addr)
+static int zms_flash_erase(struct zms_fs *fs, uint64_t addr)
 {
 	int rc;
 	off_t offset;
@@ -386,9 +593,6 @@ static int zms_flash_erase_sector(struct zms_fs *fs, uint64_t addr)
 	LOG_DBG("Erasing flash at offset 0x%lx ( 0x%llx ), len %u", (long)offset, addr,
 		fs->sector_size);
 
-#ifdef CONFIG_ZMS_LOOKUP_CACHE
-	zms_lookup_cache_invalidate(fs, SECTOR_NUM(addr));
-#endif
 	rc = flash_erase(fs->flash_device, offset, fs->sector_size);
 
 	if (rc) {
@@ -403,6 +607,19 @@ static int zms_flash_erase_sector(struct zms_fs *fs, uint64_t addr)
 	return rc;
 }
 
+/* erase a sector, drop its lookup cache entries and verify erase was OK.
+ * return 0 if OK, errorcode on error.
+ */
+static int zms_flash_erase_sector(struct zms_fs *fs, uint64_t addr)
+{
+#ifdef CONFIG_ZMS_LOOKUP_CACHE
+	if (flash_params_get_erase_cap(fs->flash_parameters) & FLASH_ERASE_C_EXPLICIT) {
+		zms_lookup_cache_invalidate(fs, SECTOR_NUM(addr & ADDR_SECT_MASK));
+	}
+#endif
+	return zms_flash_erase(fs, addr);
+}
+
 /* crc update on allocation entry */
 static void zms_ate_crc8_update(struct zms_ate *entry)
 {
@@ -619,6 +836,18 @@ static int zms_recover_last_ate(struct zms_fs *fs, uint64_t *addr, uint64_t *dat
 	/* Initialize the data_wra to the first address of the sector */
 	*data_wra = data_end_addr;
 
+	/* A sector started by garbage collection holds its first copied ATE right
+	 * after the header ATEs, account for its data as well.
+	 */
+	rc = zms_flash_ate_rd(fs, *addr + fs->ate_size, &end_ate);
+	if (rc) {
+		return rc;
+	}
+	if (zms_ate_valid(fs, &end_ate) && (end_ate.len > ZMS_DATA_IN_ATE_SIZE)) {
+		data_end_addr += end_ate.offset + zms_al_size(fs, end_ate.len);
+		*data_wra = data_end_addr;
+	}
+
 	while (ate_end_addr > data_end_addr) {
 		rc = zms_flash_ate_rd(fs, ate_end_addr, &end_ate);
 		if (rc) {
@@ -701,6 +930,35 @@ static void zms_sector_advance(struct zms_fs *fs, uint64_t *addr)
 	}
 }
 
+#ifdef CONFIG_ZMS_GC_BACKGROUND
+/* Complete the erase of the sector garbage collected by the last background
+ * rotation, waiting for background GC if it is still erasing it.
+ * return 0 if OK, errorcode on error.
+ */
+static int zms_gc_bg_erase_done(struct zms_fs *fs)
+{
+	uint64_t addr = fs->gc_bg_erase_addr;
+	int rc = 0;
+
+	if (addr == ZMS_GC_BG_IDLE) {
+		return 0;
+	}
+
+	k_mutex_lock(&fs->gc_bg_erase_lock, K_FOREVER);
+	if (!fs->gc_bg_erased) {
+		rc = zms_flash_erase(fs, addr);
+	}
+	k_mutex_unlock(&fs->gc_bg_erase_lock);
+	if (rc) {
+		return rc;
+	}
+
+	fs->gc_bg_erase_addr = ZMS_GC_BG_IDLE;
+
+	return zms_add_empty_ate(fs, addr);
+}
+#endif
+
 /* allocation entry close (this closes the current sector) by writing offset
  * of last ate to the sector end.
  */
@@ -710,6 +968,14 @@ static int zms_sector_close(struct zms_fs *fs)
 	struct zms_ate close_ate;
 	struct zms_ate garbage_ate;
 
+#ifdef CONFIG_ZMS_GC_BACKGROUND
+	/* the next sector can still be waiting for its erase */
+	rc = zms_gc_bg_erase_done(fs);
+	if (rc) {
+		return rc;
+	}
+#endif
+
 	/* Initialize all members to 0xff */
 	memset(&close_ate, 0xff, sizeof(struct zms_ate));
 
@@ -964,27 +1230,98 @@ static int zms_find_ate_with_id(struct zms_fs *fs, zms_id_t id, uint64_t start_a
 	return prev_found;
 }
 
+/* move the entry gc_ate, stored at gc_ate_addr, to the write location if it is
+ * the most recent one for its ID. The moved ATE gets the cycle_cnt of the
+ * write sector, cycle.
+ * return 1 if the entry was moved, 0 if not, errorcode on error.
+ */
+static int zms_gc_move_entry(struct zms_fs *fs, uint64_t gc_ate_addr, struct zms_ate *gc_ate,
+			     uint8_t cycle)
+{
+	int rc;
+	struct zms_ate wlk_ate;
+	uint64_t wlk_addr;
+	uint64_t wlk_prev_addr;
+	uint64_t data_addr;
+
+#ifdef CONFIG_ZMS_LOOKUP_CACHE
+	wlk_addr = zms_lookup_cache_get(fs, gc_ate->id);
+
+	if (wlk_addr == ZMS_LOOKUP_CACHE_NO_ADDR) {
+		wlk_addr = fs->ate_wra;
+	}
+#else
+	wlk_addr = fs->ate_wra;
+#endif
+
+	/* Initialize the wlk_prev_addr as if no previous ID will be found */
+	wlk_prev_addr = gc_ate_addr;
+	/* Search for a previous valid ATE with the same ID. If it doesn't exist
+	 * then wlk_prev_addr will be equal to gc_ate_addr.
+	 */
+	rc = zms_find_ate_with_id(fs, gc_ate->id, wlk_addr, fs->ate_wra, &wlk_ate,
+				  &wlk_prev_addr);
+	if (rc < 0) {
+		return rc;
+	}
+
+	/* if walk_addr has reached the same address as gc_ate_addr, a copy is
+	 * needed.
+	 */
+	if (wlk_prev_addr != gc_ate_addr) {
+		return 0;
+	}
+
+	/* copy needed */
+	LOG_DBG("Moving %lld, len %d", (long long)gc_ate->id, gc_ate->len);
+
+	if (gc_ate->len > ZMS_DATA_IN_ATE_SIZE) {
+		/* Copy Data only when len > ZMS_DATA_IN_ATE_SIZE
+		 * Otherwise, Data is already inside ATE
+		 */
+		data_addr = (gc_ate_addr & ADDR_SECT_MASK);
+		data_addr += gc_ate->offset;
+		gc_ate->offset = (uint32_t)SECTOR_OFFSET(fs->data_wra);
+
+		rc = zms_flash_block_move(fs, data_addr, gc_ate->len);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	gc_ate->cycle_cnt = cycle;
+	zms_ate_crc8_update(gc_ate);
+	rc = zms_flash_ate_wrt(fs, gc_ate);
+	if (rc) {
+		return rc;
+	}
+
+	return 1;
+}
+
 /* garbage collection: the address ate_wra has been updated to the new sector
  * that has just been started. The data to gc is in the sector after this new
- * sector.
+ * sector. With defer_erase, that sector is left for background GC to erase
+ * once the lock is released.
  */
-static int zms_gc(struct zms_fs *fs)
+static int zms_gc(struct zms_fs *fs, bool defer_erase)
 {
 	int rc;
 	int sec_closed;
 	struct zms_ate close_ate;
 	struct zms_ate gc_ate;
-	struct zms_ate wlk_ate;
 	struct zms_ate empty_ate;
 	uint64_t sec_addr;
 	uint64_t gc_addr;
 	uint64_t gc_prev_addr;
-	uint64_t wlk_addr;
-	uint64_t wlk_prev_addr;
-	uint64_t data_addr;
 	uint64_t stop_addr;
 	uint8_t previous_cycle = 0;
 
+#ifdef CONFIG_ZMS_GC_BACKGROUND
+	/* any background progress referred to the previous write sector */
+	fs->gc_bg_addr = ZMS_GC_BG_IDLE;
+#endif
+
 	rc = zms_get_sector_cycle(fs, fs->ate_wra, &fs->sector_cycle);
 	if (rc == -ENOENT) {
 		/* Erase this new unused sector if needed */
@@ -1047,55 +1384,10 @@ static int zms_gc(struct zms_fs *fs)
 			continue;
 		}
 
-#ifdef CONFIG_ZMS_LOOKUP_CACHE
-		wlk_addr = fs->lookup_cache[zms_lookup_cache_pos(gc_ate.id)];
-
-		if (wlk_addr == ZMS_LOOKUP_CACHE_NO_ADDR) {
-			wlk_addr = fs->ate_wra;
-		}
-#else
-		wlk_addr = fs->ate_wra;
-#endif
-
-		/* Initialize the wlk_prev_addr as if no previous ID will be found */
-		wlk_prev_addr = gc_prev_addr;
-		/* Search for a previous valid ATE with the same ID. If it doesn't exist
-		 * then wlk_prev_addr will be equal to gc_prev_addr.
-		 */
-		rc = zms_find_ate_with_id(fs, gc_ate.id, wlk_addr, fs->ate_wra, &wlk_ate,
-					  &wlk_prev_addr);
+		rc = zms_gc_move_entry(fs, gc_prev_addr, &gc_ate, previous_cycle);
 		if (rc < 0) {
 			return rc;
 		}
-
-		/* if walk_addr has reached the same address as gc_addr, a copy is
-		 * needed unless it is a deleted item.
-		 */
-		if (wlk_prev_addr == gc_prev_addr) {
-			/* copy needed */
-			LOG_DBG("Moving %lld, len %d", (long long)gc_ate.id, gc_ate.len);
-
-			if (gc_ate.len > ZMS_DATA_IN_ATE_SIZE) {
-				/* Copy Data only when len > ZMS_DATA_IN_ATE_SIZE
-				 * Otherwise, Data is already inside ATE
-				 */
-				data_addr = (gc_prev_addr & ADDR_SECT_MASK);
-				data_addr += gc_ate.offset;
-				gc_ate.offset = (uint32_t)SECTOR_OFFSET(fs->data_wra);
-
-				rc = zms_flash_block_move(fs, data_addr, gc_ate.len);
-				if (rc) {
-					return rc;
-				}
-			}
-
-			gc_ate.cycle_cnt = previous_cycle;
-			zms_ate_crc8_update(&gc_ate);
-			rc = zms_flash_ate_wrt(fs, &gc_ate);
-			if (rc) {
-				return rc;
-			}
-		}
 	} while (gc_prev_addr != stop_addr);
 
 gc_done:
@@ -1111,6 +1403,24 @@ gc_done:
 		return rc;
 	}
 
+#ifdef CONFIG_ZMS_GC_BACKGROUND
+	fs->gc_bg_base = fs->ate_wra - fs->data_wra;
+
+	if (defer_erase) {
+		/* Every entry of the sector is shadowed by a newer one now, and
+		 * the next sector close waits for the erase to complete.
+		 */
+#ifdef CONFIG_ZMS_LOOKUP_CACHE
+		zms_lookup_cache_invalidate(fs, sec_addr >> ADDR_SECT_SHIFT);
+#endif
+		fs->gc_bg_erase_addr = sec_addr;
+		fs->gc_bg_erased = false;
+		return 0;
+	}
+#else
+	ARG_UNUSED(defer_erase);
+#endif
+
 	/* Erase the GC'ed sector when needed */
 	rc = zms_flash_erase_sector(fs, sec_addr);
 	if (rc) {
@@ -1125,6 +1435,228 @@ gc_done:
 	return rc;
 }
 
+#ifdef CONFIG_ZMS_GC_BACKGROUND
+
+static struct k_work_q zms_gc_workq;
+static K_THREAD_STACK_DEFINE(zms_gc_workq_stack, CONFIG_ZMS_GC_BACKGROUND_STACK_SIZE);
+
+static int zms_gc_workq_init(void)
+{
+	const struct k_work_queue_config cfg = {
+		.name = "zms_gc",
+	};
+
+	k_work_queue_start(&zms_gc_workq, zms_gc_workq_stack,
+			   K_THREAD_STACK_SIZEOF(zms_gc_workq_stack),
+			   CONFIG_ZMS_GC_BACKGROUND_PRIORITY, &cfg);
+
+	return 0;
+}
+
+SYS_INIT(zms_gc_workq_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+/* The write sector is due for rotation when its free space drops below the
+ * threshold, and at least the same amount has been written to it since it was
+ * started, so that a sector already filled by GC is not rotated over and over.
+ */
+static bool zms_gc_bg_needed(struct zms_fs *fs)
+{
+	uint64_t free_space = fs->ate_wra - fs->data_wra;
+	uint64_t threshold = (uint64_t)fs->sector_size * CONFIG_ZMS_GC_BACKGROUND_THRESHOLD / 100U;
+
+	return (free_space < threshold) && (fs->gc_bg_base >= (free_space + threshold));
+}
+
+/* Start background GC: point gc_bg_addr at the last ATE of the sector that the
+ * next rotation will garbage collect, i.e. two sectors after the write sector,
+ * or mark the migration as done if there is nothing to move.
+ */
+static int zms_gc_bg_start(struct zms_fs *fs)
+{
+	int sec_closed;
+	struct zms_ate close_ate;
+	struct zms_ate empty_ate;
+	uint64_t gc_addr;
+
+	fs->gc_bg_addr = ZMS_GC_BG_DONE;
+
+	/* with two sectors the GC sector is the write sector itself */
+	if (fs->sector_count < 3) {
+		return 0;
+	}
+
+	gc_addr = fs->ate_wra & ADDR_SECT_MASK;
+	zms_sector_advance(fs, &gc_addr);
+	zms_sector_advance(fs, &gc_addr);
+
+	sec_closed = zms_validate_closed_sector(fs, gc_addr, &empty_ate, &close_ate);
+	if (sec_closed < 0) {
+		return sec_closed;
+	}
+
+	if (!sec_closed) {
+		return 0;
+	}
+
+	fs->gc_bg_cycle = empty_ate.cycle_cnt;
+	fs->gc_bg_addr = (gc_addr & ADDR_SECT_MASK) + close_ate.offset;
+
+	return 0;
+}
+
+/* One bounded step of background GC. Live entries of the sector that the next
+ * rotation will garbage collect are rewritten to the write sector, at most
+ * CONFIG_ZMS_GC_BACKGROUND_CHUNK ATEs per step. Once they are all moved, or the
+ * write sector is full, the write sector is closed and the GC of the next
+ * rotation, which has (almost) nothing left to copy, is run. The emptied
+ * sector is erased by the work handler once the lock is released.
+ * return 1 if another step is needed, 0 when done, errorcode on error.
+ */
+static int zms_gc_bg_step(struct zms_fs *fs)
+{
+	int rc = 0;
+	struct zms_ate gc_ate;
+	uint64_t gc_prev_addr;
+	uint64_t stop_addr;
+	size_t data_size;
+	uint8_t current_cycle;
+
+	if (fs->gc_bg_addr == ZMS_GC_BG_IDLE) {
+		rc = zms_gc_bg_start(fs);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	/* stop_addr points to the first ATE before the header ATEs */
+	stop_addr = (fs->gc_bg_addr & ADDR_SECT_MASK) + fs->sector_size - 3 * fs->ate_size;
+
+	/* ATEs of the GC sector are validated against its own cycle_cnt */
+	current_cycle = fs->sector_cycle;
+	fs->sector_cycle = fs->gc_bg_cycle;
+
+	for (int i = 0; i < CONFIG_ZMS_GC_BACKGROUND_CHUNK; i++) {
+		if (fs->gc_bg_addr == ZMS_GC_BG_DONE) {
+			break;
+		}
+
+		gc_prev_addr = fs->gc_bg_addr;
+		rc = zms_prev_ate(fs, &fs->gc_bg_addr, &gc_ate);
+		if (rc) {
+			goto end;
+		}
+
+		if (gc_prev_addr == stop_addr) {
+			fs->gc_bg_addr = ZMS_GC_BG_DONE;
+		}
+
+		if (!zms_ate_valid(fs, &gc_ate) || !gc_ate.len) {
+			continue;
+		}
+
+		/* keep room for a delete ATE and the GC done ATE */
+		data_size = (gc_ate.len > ZMS_DATA_IN_ATE_SIZE) ? zms_al_size(fs, gc_ate.len) : 0;
+		if (fs->ate_wra < (fs->data_wra + data_size + 3 * fs->ate_size)) {
+			fs->gc_bg_addr = ZMS_GC_BG_DONE;
+			break;
+		}
+
+		rc = zms_gc_move_entry(fs, gc_prev_addr, &gc_ate, current_cycle);
+		if (rc < 0) {
+			goto end;
+		}
+#ifdef CONFIG_ZMS_GC_STATS
+		STATS_INCN(zms_gc_stats, bg_moved, rc);
+#endif
+		rc = 0;
+	}
+
+end:
+	fs->sector_cycle = current_cycle;
+	if (rc) {
+		return rc;
+	}
+
+	if (fs->gc_bg_addr != ZMS_GC_BG_DONE) {
+		return 1;
+	}
+
+	rc = zms_sector_close(fs);
+	if (rc) {
+		return rc;
+	}
+
+	rc = zms_gc(fs, true);
+	if (rc) {
+		return rc;
+	}
+
+#ifdef CONFIG_ZMS_GC_STATS
+	STATS_INC(zms_gc_stats, bg_rotations);
+#endif
+
+	return 0;
+}
+
+static void zms_gc_work_handler(struct k_work *work)
+{
+	struct zms_fs *fs = CONTAINER_OF(work, struct zms_fs, gc_work);
+	uint64_t erase_addr = ZMS_GC_BG_IDLE;
+	uint32_t start;
+	int erase_rc;
+	int rc = 0;
+
+	k_mutex_lock(&fs->zms_lock, K_FOREVER);
+
+	if (fs->ready && ((fs->gc_bg_addr != ZMS_GC_BG_IDLE) || zms_gc_bg_needed(fs))) {
+		start = zms_gc_stats_start();
+		rc = zms_gc_bg_step(fs);
+		zms_gc_stats_record(true, start);
+		if (rc < 0) {
+			LOG_ERR("Background garbage collection failed, returned = %d", rc);
+			fs->gc_bg_addr = ZMS_GC_BG_IDLE;
+		}
+	}
+
+	/* Take the erase lock before releasing the ZMS lock, so that a sector
+	 * close waits for the erase instead of writing to the sector.
+	 */
+	if ((fs->gc_bg_erase_addr != ZMS_GC_BG_IDLE) && !fs->gc_bg_erased) {
+		erase_addr = fs->gc_bg_erase_addr;
+		k_mutex_lock(&fs->gc_bg_erase_lock, K_FOREVER);
+	}
+
+	k_mutex_unlock(&fs->zms_lock);
+
+	if (erase_addr != ZMS_GC_BG_IDLE) {
+		fs->gc_bg_erased = (zms_flash_erase(fs, erase_addr) == 0);
+		k_mutex_unlock(&fs->gc_bg_erase_lock);
+
+		k_mutex_lock(&fs->zms_lock, K_FOREVER);
+		if (fs->gc_bg_erase_addr == erase_addr) {
+			erase_rc = zms_gc_bg_erase_done(fs);
+			if (erase_rc) {
+				LOG_ERR("Background sector erase failed, returned = %d", erase_rc);
+			}
+		}
+		k_mutex_unlock(&fs->zms_lock);
+	}
+
+	if (rc > 0) {
+		(void)k_work_submit_to_queue(&zms_gc_workq, &fs->gc_work);
+	}
+}
+
+/* Called with the lock held after a write */
+static void zms_gc_bg_kick(struct zms_fs *fs)
+{
+	if ((fs->gc_bg_addr == ZMS_GC_BG_IDLE) && zms_gc_bg_needed(fs)) {
+		(void)k_work_submit_to_queue(&zms_gc_workq, &fs->gc_work);
+	}
+}
+
+#endif /* CONFIG_ZMS_GC_BACKGROUND */
+
 int zms_clear(struct zms_fs *fs)
 {
 	int rc;
@@ -1140,6 +1672,12 @@ int zms_clear(struct zms_fs *fs)
 		return -EACCES;
 	}
 
+#ifdef CONFIG_ZMS_GC_BACKGROUND
+	struct k_work_sync sync;
+
+	(void)k_work_cancel_sync(&fs->gc_work, &sync);
+#endif
+
 	k_mutex_lock(&fs->zms_lock, K_FOREVER);
 	for (uint32_t i = 0; i < fs->sector_count; i++) {
 		addr = (uint64_t)i << ADDR_SECT_SHIFT;
@@ -1434,11 +1972,9 @@ static int zms_init(struct zms_fs *fs)
 		 * So, temporarily, we set the lookup cache to the end of the fs.
 		 * The cache will be rebuilt afterwards
 		 **/
-		for (i = 0; i < CONFIG_ZMS_LOOKUP_CACHE_SIZE; i++) {
-			fs->lookup_cache[i] = fs->ate_wra;
-		}
+		zms_lookup_cache_scan_all(fs);
 #endif
-		rc = zms_gc(fs);
+		rc = zms_gc(fs, false);
 		goto end;
 	}
 
@@ -1454,6 +1990,15 @@ end:
 	if ((!rc) && (SECTOR_OFFSET(fs->ate_wra) == (fs->sector_size - 3 * fs->ate_size))) {
 		rc = zms_add_gc_done_ate(fs);
 	}
+#ifdef CONFIG_ZMS_GC_BACKGROUND
+	/* How much free space the write sector had when it was opened is not
+	 * known, so allow background GC to start right away if the sector is
+	 * already below the threshold.
+	 */
+	fs->gc_bg_addr = ZMS_GC_BG_IDLE;
+	fs->gc_bg_base = fs->sector_size;
+	fs->gc_bg_erase_addr = ZMS_GC_BG_IDLE;
+#endif
 	k_mutex_unlock(&fs->zms_lock);
 
 	return rc;
@@ -1470,6 +2015,14 @@ int zms_mount(struct zms_fs *fs)
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_ZMS_GC_BACKGROUND
+	/* On a remount the work item can still be queued or running. Its state
+	 * cannot be read before it is initialized, so wait for the queue.
+	 */
+	(void)k_work_queue_drain(&zms_gc_workq, false);
+	k_work_init(&fs->gc_work, zms_gc_work_handler);
+	k_mutex_init(&fs->gc_bg_erase_lock);
+#endif
 	k_mutex_init(&fs->zms_lock);
 
 	fs->flash_parameters = flash_get_parameters(fs->flash_device);
@@ -1526,6 +2079,12 @@ int zms_mount(struct zms_fs *fs)
 	/* zms is ready for use */
 	fs->ready = true;
 
+#ifdef CONFIG_ZMS_GC_BACKGROUND
+	k_mutex_lock(&fs->zms_lock, K_FOREVER);
+	zms_gc_bg_kick(fs);
+	k_mutex_unlock(&fs->zms_lock);
+#endif
+
 	LOG_INF("%u Sectors of %u bytes", fs->sector_count, fs->sector_size);
 	LOG_INF("alloc wra: %llu, %llx", SECTOR_NUM(fs->ate_wra), SECTOR_OFFSET(fs->ate_wra));
 	LOG_INF("data wra: %llu, %llx", SECTOR_NUM(fs->data_wra), SECTOR_OFFSET(fs->data_wra));
@@ -1538,6 +2097,7 @@ ssize_t zms_write(struct zms_fs *fs, zms_id_t id, const void *data, size_t len)
 	int rc;
 	size_t data_size;
 	uint32_t gc_count;
+	uint32_t gc_start;
 	uint32_t required_space = 0U; /* no space, appropriate for delete ate */
 
 	if (!fs) {
@@ -1567,7 +2127,7 @@ ssize_t zms_write(struct zms_fs *fs, zms_id_t id, const void *data, size_t len)
 
 	/* find latest entry with same id */
 #ifdef CONFIG_ZMS_LOOKUP_CACHE
-	wlk_addr = fs->lookup_cache[zms_lookup_cache_pos(id)];
+	wlk_addr = zms_lookup_cache_get(fs, id);
 
 	if (wlk_addr == ZMS_LOOKUP_CACHE_NO_ADDR) {
 		if (len > 0) {
@@ -1667,18 +2227,23 @@ no_cached_entry:
 			}
 			break;
 		}
+		gc_start = zms_gc_stats_start();
 		rc = zms_sector_close(fs);
 		if (rc) {
 			LOG_ERR("Failed to close the sector, returned = %d", rc);
 			goto end;
 		}
-		rc = zms_gc(fs);
+		rc = zms_gc(fs, false);
+		zms_gc_stats_record(false, gc_start);
 		if (rc) {
 			LOG_ERR("Garbage collection failed, returned = %d", rc);
 			goto end;
 		}
 		gc_count++;
 	}
+#ifdef CONFIG_ZMS_GC_BACKGROUND
+	zms_gc_bg_kick(fs);
+#endif
 	rc = len;
 end:
 	k_mutex_unlock(&fs->zms_lock);
@@ -1715,7 +2280,7 @@ ssize_t zms_read_hist(struct zms_fs *fs, zms_id_t id, void *data, size_t len, ui
 	cnt_his = 0U;
 
 #ifdef CONFIG_ZMS_LOOKUP_CACHE
-	wlk_addr = fs->lookup_cache[zms_lookup_cache_pos(id)];
+	wlk_addr = zms_lookup_cache_get(fs, id);
 
 	if (wlk_addr == ZMS_LOOKUP_CACHE_NO_ADDR) {
 		rc = -ENOENT;
@@ -1952,6 +2517,7 @@ ssize_t zms_active_sector_free_space(struct zms_fs *fs)
 int zms_sector_use_next(struct zms_fs *fs)
 {
 	int ret;
+	uint32_t gc_start;
 
 	if (!fs) {
 		LOG_ERR("Invalid fs");
@@ -1965,12 +2531,15 @@ int zms_sector_use_next(struct zms_fs *fs)
 
 	k_mutex_lock(&fs->zms_lock, K_FOREVER);
 
+	gc_start = zms_gc_stats_start();
+
 	ret = zms_sector_close(fs);
 	if (ret != 0) {
 		goto end;
 	}
 
-	ret = zms_gc(fs);
+	ret = zms_gc(fs, false);
+	zms_gc_stats_record(false, gc_start);
 
 end:
 	k_mutex_unlock(&fs->zms_lock);
@@ -29,6 +29,12 @@
 
 #define ZMS_LOOKUP_CACHE_NO_ADDR GENMASK64(63, 0)
 
+/* Background garbage collection states, other values of gc_bg_addr are the
+ * address of the next ATE to move
+ */
+#define ZMS_GC_BG_IDLE GENMASK64(63, 0)
+#define ZMS_GC_BG_DONE GENMASK64(63, 1)
+
 #define ZMS_VERSION_MASK        GENMASK(7, 0)
 #define ZMS_GET_VERSION(x)      FIELD_GET(ZMS_VERSION_MASK, x)
 #define ZMS_DEFAULT_VERSION     1
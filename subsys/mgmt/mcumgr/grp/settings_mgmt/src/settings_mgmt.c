@@ -6,6 +6,7 @@
 
 #include <zephyr/kernel.h>
 #include <zephyr/sys/util.h>
+#include <zephyr/sys/arena.h>
 #include <zephyr/settings/settings.h>
 #include <zephyr/mgmt/mcumgr/mgmt/mgmt.h>
 #include <zephyr/mgmt/mcumgr/smp/smp.h>
@@ -26,6 +27,36 @@
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(settings_mgmt);
 
+#if defined(CONFIG_MCUMGR_GRP_SETTINGS_BUFFER_TYPE_HEAP)
+#define SETTINGS_MGMT_DYNAMIC_BUFFERS
+
+#define settings_mgmt_buf_alloc(size) malloc(size)
+#define settings_mgmt_buf_free(ptr)   free(ptr)
+
+#elif defined(CONFIG_MCUMGR_GRP_SETTINGS_BUFFER_TYPE_ARENA)
+#define SETTINGS_MGMT_DYNAMIC_BUFFERS
+
+/* Requests are processed one at a time on the SMP work queue and each one
+ * needs at most a name and a value, so they all share one arena.
+ */
+SYS_ARENA_DEFINE(settings_mgmt_arena,
+		 CONFIG_MCUMGR_GRP_SETTINGS_NAME_LEN + CONFIG_MCUMGR_GRP_SETTINGS_VALUE_LEN);
+
+static inline void *settings_mgmt_buf_alloc(size_t size)
+{
+	return sys_arena_aligned_alloc(&settings_mgmt_arena, size, 1);
+}
+
+/* Handlers release all their buffers before returning, so freeing any of
+ * them can release the whole arena
+ */
+static inline void settings_mgmt_buf_free(void *ptr)
+{
+	ARG_UNUSED(ptr);
+	sys_arena_reset(&settings_mgmt_arena);
+}
+#endif
+
 /**
  * Command handler: settings read
  */
@@ -40,7 +71,7 @@ static int settings_mgmt_read(struct smp_streamer *ctxt)
 	uint32_t max_size = CONFIG_MCUMGR_GRP_SETTINGS_VALUE_LEN;
 	bool limited_size = false;
 
-#ifdef CONFIG_MCUMGR_GRP_SETTINGS_BUFFER_TYPE_HEAP
+#ifdef SETTINGS_MGMT_DYNAMIC_BUFFERS
 	char *key_name = NULL;
 	uint8_t *data = NULL;
 #else
@@ -74,13 +105,13 @@ static int settings_mgmt_read(struct smp_streamer *ctxt)
 		limited_size = true;
 	}
 
-#ifdef CONFIG_MCUMGR_GRP_SETTINGS_BUFFER_TYPE_HEAP
-	key_name = (char *)malloc(key.len + 1);
-	data = (uint8_t *)malloc(max_size);
+#ifdef SETTINGS_MGMT_DYNAMIC_BUFFERS
+	key_name = (char *)settings_mgmt_buf_alloc(key.len + 1);
+	data = (uint8_t *)settings_mgmt_buf_alloc(max_size);
 
 	if (data == NULL || key_name == NULL) {
 		if (key_name != NULL) {
-			free(key_name);
+			settings_mgmt_buf_free(key_name);
 		}
 
 		return MGMT_ERR_ENOMEM;
@@ -107,6 +138,10 @@ static int settings_mgmt_read(struct smp_streamer *ctxt)
 
 		if (status != MGMT_CB_OK) {
 			if (status == MGMT_CB_ERROR_RC) {
+#ifdef SETTINGS_MGMT_DYNAMIC_BUFFERS
+				settings_mgmt_buf_free(key_name);
+				settings_mgmt_buf_free(data);
+#endif
 				return ret_rc;
 			}
 
@@ -142,9 +177,9 @@ static int settings_mgmt_read(struct smp_streamer *ctxt)
 	}
 
 end:
-#ifdef CONFIG_MCUMGR_GRP_SETTINGS_BUFFER_TYPE_HEAP
-	free(key_name);
-	free(data);
+#ifdef SETTINGS_MGMT_DYNAMIC_BUFFERS
+	settings_mgmt_buf_free(key_name);
+	settings_mgmt_buf_free(data);
 #endif
 
 	return MGMT_RETURN_CHECK(ok);
@@ -163,7 +198,7 @@ static int settings_mgmt_write(struct smp_streamer *ctxt)
 	size_t decoded;
 	struct zcbor_string key = { 0 };
 
-#ifdef CONFIG_MCUMGR_GRP_SETTINGS_BUFFER_TYPE_HEAP
+#ifdef SETTINGS_MGMT_DYNAMIC_BUFFERS
 	char *key_name = NULL;
 #else
 	char key_name[CONFIG_MCUMGR_GRP_SETTINGS_NAME_LEN];
@@ -190,8 +225,8 @@ static int settings_mgmt_write(struct smp_streamer *ctxt)
 		goto end;
 	}
 
-#ifdef CONFIG_MCUMGR_GRP_SETTINGS_BUFFER_TYPE_HEAP
-	key_name = (char *)malloc(key.len + 1);
+#ifdef SETTINGS_MGMT_DYNAMIC_BUFFERS
+	key_name = (char *)settings_mgmt_buf_alloc(key.len + 1);
 
 	if (key_name == NULL) {
 		return MGMT_ERR_ENOMEM;
@@ -220,6 +255,9 @@ static int settings_mgmt_write(struct smp_streamer *ctxt)
 
 		if (status != MGMT_CB_OK) {
 			if (status == MGMT_CB_ERROR_RC) {
+#ifdef SETTINGS_MGMT_DYNAMIC_BUFFERS
+				settings_mgmt_buf_free(key_name);
+#endif
 				return ret_rc;
 			}
 
@@ -246,8 +284,8 @@ static int settings_mgmt_write(struct smp_streamer *ctxt)
 	}
 
 end:
-#ifdef CONFIG_MCUMGR_GRP_SETTINGS_BUFFER_TYPE_HEAP
-	free(key_name);
+#ifdef SETTINGS_MGMT_DYNAMIC_BUFFERS
+	settings_mgmt_buf_free(key_name);
 #endif
 
 	return MGMT_RETURN_CHECK(ok);
@@ -265,7 +303,7 @@ static int settings_mgmt_delete(struct smp_streamer *ctxt)
 	size_t decoded;
 	struct zcbor_string key = { 0 };
 
-#ifdef CONFIG_MCUMGR_GRP_SETTINGS_BUFFER_TYPE_HEAP
+#ifdef SETTINGS_MGMT_DYNAMIC_BUFFERS
 	char *key_name = NULL;
 #else
 	char key_name[CONFIG_MCUMGR_GRP_SETTINGS_NAME_LEN];
@@ -291,8 +329,8 @@ static int settings_mgmt_delete(struct smp_streamer *ctxt)
 		goto end;
 	}
 
-#ifdef CONFIG_MCUMGR_GRP_SETTINGS_BUFFER_TYPE_HEAP
-	key_name = (char *)malloc(key.len + 1);
+#ifdef SETTINGS_MGMT_DYNAMIC_BUFFERS
+	key_name = (char *)settings_mgmt_buf_alloc(key.len + 1);
 
 	if (key_name == NULL) {
 		return MGMT_ERR_ENOMEM;
@@ -319,10 +357,16 @@ static int settings_mgmt_delete(struct smp_streamer *ctxt)
 
 		if (status != MGMT_CB_OK) {
 			if (status == MGMT_CB_ERROR_RC) {
+#ifdef SETTINGS_MGMT_DYNAMIC_BUFFERS
+				settings_mgmt_buf_free(key_name);
+#endif
 				return ret_rc;
 			}
 
 			ok = smp_add_cmd_err(zse, ret_group, (uint16_t)ret_rc);
+#ifdef SETTINGS_MGMT_DYNAMIC_BUFFERS
+			settings_mgmt_buf_free(key_name);
+#endif
 			goto end;
 		}
 	}
@@ -330,8 +374,8 @@ static int settings_mgmt_delete(struct smp_streamer *ctxt)
 	/* Delete requested key from settings */
 	rc = settings_delete(key_name);
 
-#ifdef CONFIG_MCUMGR_GRP_SETTINGS_BUFFER_TYPE_HEAP
-	free(key_name);
+#ifdef SETTINGS_MGMT_DYNAMIC_BUFFERS
+	settings_mgmt_buf_free(key_name);
 #endif
 
 	if (rc < 0) {
@@ -442,7 +486,7 @@ static int settings_mgmt_save(struct smp_streamer *ctxt)
 	bool name_found = false;
 	bool save_subtree = false;
 
-#ifdef CONFIG_MCUMGR_GRP_SETTINGS_BUFFER_TYPE_HEAP
+#ifdef SETTINGS_MGMT_DYNAMIC_BUFFERS
 	char *key_name = NULL;
 #else
 	char key_name[CONFIG_MCUMGR_GRP_SETTINGS_NAME_LEN];
@@ -475,8 +519,8 @@ static int settings_mgmt_save(struct smp_streamer *ctxt)
 			goto end;
 		}
 
-#ifdef CONFIG_MCUMGR_GRP_SETTINGS_BUFFER_TYPE_HEAP
-		key_name = (char *)malloc(key.len + 1);
+#ifdef SETTINGS_MGMT_DYNAMIC_BUFFERS
+		key_name = (char *)settings_mgmt_buf_alloc(key.len + 1);
 
 		if (key_name == NULL) {
 			return MGMT_ERR_ENOMEM;
@@ -503,8 +547,8 @@ static int settings_mgmt_save(struct smp_streamer *ctxt)
 
 		if (status != MGMT_CB_OK) {
 			if (status == MGMT_CB_ERROR_RC) {
-#ifdef CONFIG_MCUMGR_GRP_SETTINGS_BUFFER_TYPE_HEAP
-				free(key_name);
+#ifdef SETTINGS_MGMT_DYNAMIC_BUFFERS
+				settings_mgmt_buf_free(key_name);
 #endif
 				return ret_rc;
 			}
@@ -550,8 +594,8 @@ static int settings_mgmt_save(struct smp_streamer *ctxt)
 	}
 
 end:
-#ifdef CONFIG_MCUMGR_GRP_SETTINGS_BUFFER_TYPE_HEAP
-	free(key_name);
+#ifdef SETTINGS_MGMT_DYNAMIC_BUFFERS
+	settings_mgmt_buf_free(key_name);
 #endif
 
 	return MGMT_RETURN_CHECK(ok);
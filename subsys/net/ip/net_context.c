@@ -2124,45 +2124,29 @@ static int get_context_ipv6_mcast_loop(struct net_context *context,
 }
 
 /* If buf is not NULL, then use it. Otherwise read the data to be written
- * to net_pkt from msghdr.
+ * to net_pkt from msghdr. If chksum is set, the Internet checksum of the
+ * written data is computed while copying it into the packet.
  */
 static int context_write_data(struct net_pkt *pkt, const void *buf,
-			      int buf_len, const struct net_msghdr *msghdr)
+			      int buf_len, const struct net_msghdr *msghdr,
+			      uint16_t *chksum)
 {
-	int ret = 0;
-
 	if (msghdr) {
-		int i;
-
-		for (i = 0; i < msghdr->msg_iovlen; i++) {
-			int len = MIN(msghdr->msg_iov[i].iov_len, buf_len);
-
-			ret = net_pkt_write(pkt, msghdr->msg_iov[i].iov_base,
-					    len);
-			if (ret < 0) {
-				break;
-			}
+		return net_pkt_write_iov(pkt, msghdr->msg_iov,
+					 msghdr->msg_iovlen, buf_len, chksum);
+	}
 
-			buf_len -= len;
-			if (buf_len == 0) {
-				break;
-			}
-		}
-	} else {
-		ret = net_pkt_write(pkt, buf, buf_len);
+	if (chksum) {
+		return net_pkt_write_chksum(pkt, buf, buf_len, chksum);
 	}
 
-	return ret;
+	return net_pkt_write(pkt, buf, buf_len);
 }
 
-static int context_setup_udp_packet(struct net_context *context,
-				    net_sa_family_t family,
-				    struct net_pkt *pkt,
-				    const void *buf,
-				    size_t len,
-				    const struct net_msghdr *msg,
-				    const struct net_sockaddr *dst_addr,
-				    net_socklen_t addrlen)
+static int context_create_udp_hdr(struct net_context *context,
+				  net_sa_family_t family,
+				  struct net_pkt *pkt,
+				  const struct net_sockaddr *dst_addr)
 {
 	int ret = -EINVAL;
 	uint16_t dst_port = 0U;
@@ -2192,15 +2176,44 @@ static int context_setup_udp_packet(struct net_context *context,
 		return ret;
 	}
 
-	ret = net_udp_create(pkt,
-			     net_sin((struct net_sockaddr *)
-				     &context->local)->sin_port,
-			     dst_port);
+	return net_udp_create(pkt,
+			      net_sin((struct net_sockaddr *)
+				      &context->local)->sin_port,
+			      dst_port);
+}
+
+static int context_setup_udp_packet(struct net_context *context,
+				    net_sa_family_t family,
+				    struct net_pkt *pkt,
+				    const void *buf,
+				    size_t len,
+				    const struct net_msghdr *msg,
+				    const struct net_sockaddr *dst_addr,
+				    net_socklen_t addrlen)
+{
+	int ret;
+
+	ret = context_create_udp_hdr(context, family, pkt, dst_addr);
 	if (ret) {
 		return ret;
 	}
 
-	ret = context_write_data(pkt, buf, len, msg);
+	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt),
+					 family == NET_AF_INET6 ?
+					 NET_IF_CHECKSUM_IPV6_UDP :
+					 NET_IF_CHECKSUM_IPV4_UDP)) {
+		uint16_t chksum = 0U;
+
+		ret = context_write_data(pkt, buf, len, msg, &chksum);
+		if (ret) {
+			return ret;
+		}
+
+		ret = net_udp_set_payload_chksum(pkt, chksum);
+	} else {
+		ret = context_write_data(pkt, buf, len, msg, NULL);
+	}
+
 	if (ret) {
 		return ret;
 	}
@@ -2226,7 +2239,7 @@ static int context_setup_raw_ip_packet(net_sa_family_t family,
 {
 	int ret;
 
-	ret = context_write_data(pkt, buf, len, msg);
+	ret = context_write_data(pkt, buf, len, msg, NULL);
 	if (ret < 0) {
 		return ret;
 	}
@@ -2721,7 +2734,7 @@ static int context_sendto(struct net_context *context,
 skip_alloc:
 	if (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
 	    net_if_is_ip_offloaded(net_context_get_iface(context))) {
-		ret = context_write_data(pkt, buf, len, msghdr);
+		ret = context_write_data(pkt, buf, len, msghdr, NULL);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -2769,7 +2782,7 @@ skip_alloc:
 
 		ret = net_tcp_send_data(context, cb, user_data);
 	} else if (IS_ENABLED(CONFIG_NET_SOCKETS_PACKET) && family == NET_AF_PACKET) {
-		ret = context_write_data(pkt, buf, len, msghdr);
+		ret = context_write_data(pkt, buf, len, msghdr, NULL);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -2797,7 +2810,7 @@ skip_alloc:
 		net_if_try_queue_tx(net_pkt_iface(pkt), pkt, timeout);
 	} else if (IS_ENABLED(CONFIG_NET_SOCKETS_CAN) && family == NET_AF_CAN &&
 		   net_context_get_proto(context) == NET_CAN_RAW) {
-		ret = context_write_data(pkt, buf, len, msghdr);
+		ret = context_write_data(pkt, buf, len, msghdr, NULL);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -2968,6 +2981,92 @@ int net_context_sendmsg(struct net_context *context,
 	return ret;
 }
 
+int net_context_send_buf(struct net_context *context,
+			 struct net_buf *buf,
+			 net_context_send_cb_t cb,
+			 k_timeout_t timeout,
+			 void *user_data)
+{
+	net_sa_family_t family = net_context_get_family(context);
+	size_t len = net_buf_frags_len(buf);
+	struct net_pkt *pkt = NULL;
+	struct net_if *iface;
+	int ret;
+
+	k_mutex_lock(&context->lock, K_FOREVER);
+
+	if (!IS_ENABLED(CONFIG_NET_UDP) ||
+	    net_context_get_proto(context) != NET_IPPROTO_UDP ||
+	    !((IS_ENABLED(CONFIG_NET_IPV4) && family == NET_AF_INET) ||
+	      (IS_ENABLED(CONFIG_NET_IPV6) && family == NET_AF_INET6))) {
+		ret = -EOPNOTSUPP;
+		goto unlock;
+	}
+
+	if (!(context->flags & NET_CONTEXT_REMOTE_ADDR_SET) ||
+	    net_sin(&context->remote)->sin_port == 0) {
+		ret = -EDESTADDRREQ;
+		goto unlock;
+	}
+
+	iface = net_context_get_iface(context);
+	if (iface && !net_if_is_up(iface)) {
+		ret = -ENETDOWN;
+		goto unlock;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_OFFLOAD) && net_if_is_ip_offloaded(iface)) {
+		ret = -EOPNOTSUPP;
+		goto unlock;
+	}
+
+	context->send_cb = cb;
+	context->user_data = user_data;
+
+	/* Only the headers go to the packet buffers */
+	pkt = context_alloc_pkt(context, family, 0, PKT_WAIT_TIME);
+	if (!pkt) {
+		NET_ERR("Failed to allocate net_pkt");
+		ret = -ENOBUFS;
+		goto unlock;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_CONTEXT_PRIORITY)) {
+		uint8_t priority;
+
+		get_context_priority(context, &priority, NULL);
+		net_pkt_set_priority(pkt, priority);
+	}
+
+	ret = context_create_udp_hdr(context, family, pkt, &context->remote);
+	if (ret < 0) {
+		goto fail;
+	}
+
+	/* The packet holds its own reference, so that the caller keeps the
+	 * buffer if sending fails.
+	 */
+	net_pkt_append_buffer(pkt, net_buf_ref(buf));
+
+	context_finalize_packet(context, family, pkt);
+
+	ret = net_try_send_data(pkt, timeout);
+	if (ret < 0) {
+		goto fail;
+	}
+
+	net_buf_unref(buf);
+	ret = len;
+	goto unlock;
+
+fail:
+	net_pkt_unref(pkt);
+unlock:
+	k_mutex_unlock(&context->lock);
+
+	return ret;
+}
+
 int net_context_sendto(struct net_context *context,
 		       const void *buf,
 		       size_t len,
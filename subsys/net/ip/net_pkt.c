@@ -1831,13 +1831,32 @@ static void pkt_cursor_update(struct net_pkt *pkt,
 	}
 }
 
-/* Internal function that does all operation (skip/read/write/memset) */
+/* Add the ones' complement sum of a chunk to a running checksum. A chunk
+ * starting at an odd offset contributes its byte swapped sum.
+ */
+static inline void pkt_chksum_add(uint16_t *chksum, uint16_t sum, bool odd)
+{
+	if (odd) {
+		sum = BSWAP_16(sum);
+	}
+
+	*chksum += sum;
+	if (*chksum < sum) {
+		(*chksum)++;
+	}
+}
+
+/* Internal function that does all operation (skip/read/write/memset).
+ * If chksum is set, the Internet checksum of the bytes processed is
+ * accumulated into it while they are still hot in the cache.
+ */
 static int net_pkt_cursor_operate(struct net_pkt *pkt,
 				  void *data, size_t length,
-				  bool copy, bool write)
+				  bool copy, bool write, uint16_t *chksum)
 {
 	/* We use such variable to avoid lengthy lines */
 	struct net_pkt_cursor *c_op = &pkt->cursor;
+	size_t done = 0;
 
 	while (c_op->buf && length) {
 		size_t d_len, len;
@@ -1873,6 +1892,11 @@ static int net_pkt_cursor_operate(struct net_pkt *pkt,
 			memset(c_op->pos, *(int *)data, len);
 		}
 
+		if (chksum) {
+			pkt_chksum_add(chksum, calc_chksum(0, c_op->pos, len),
+				       done % 2);
+		}
+
 		if (write && !net_pkt_is_being_overwritten(pkt)) {
 			net_buf_add(c_op->buf, len);
 		}
@@ -1884,6 +1908,7 @@ static int net_pkt_cursor_operate(struct net_pkt *pkt,
 		}
 
 		length -= len;
+		done += len;
 	}
 
 	if (length) {
@@ -1898,21 +1923,21 @@ int net_pkt_skip(struct net_pkt *pkt, size_t skip)
 {
 	NET_DBG("pkt %p skip %zu", pkt, skip);
 
-	return net_pkt_cursor_operate(pkt, NULL, skip, false, true);
+	return net_pkt_cursor_operate(pkt, NULL, skip, false, true, NULL);
 }
 
 int net_pkt_memset(struct net_pkt *pkt, int byte, size_t amount)
 {
 	NET_DBG("pkt %p byte %d amount %zu", pkt, byte, amount);
 
-	return net_pkt_cursor_operate(pkt, &byte, amount, false, true);
+	return net_pkt_cursor_operate(pkt, &byte, amount, false, true, NULL);
 }
 
 int net_pkt_read(struct net_pkt *pkt, void *data, size_t length)
 {
 	NET_DBG("pkt %p data %p length %zu", pkt, data, length);
 
-	return net_pkt_cursor_operate(pkt, data, length, true, false);
+	return net_pkt_cursor_operate(pkt, data, length, true, false, NULL);
 }
 
 int net_pkt_read_be16(struct net_pkt *pkt, uint16_t *data)
@@ -1960,7 +1985,45 @@ int net_pkt_write(struct net_pkt *pkt, const void *data, size_t length)
 		return net_pkt_skip(pkt, length);
 	}
 
-	return net_pkt_cursor_operate(pkt, (void *)data, length, true, true);
+	return net_pkt_cursor_operate(pkt, (void *)data, length, true, true, NULL);
+}
+
+int net_pkt_write_chksum(struct net_pkt *pkt, const void *data, size_t length,
+			 uint16_t *chksum)
+{
+	NET_DBG("pkt %p data %p length %zu", pkt, data, length);
+
+	return net_pkt_cursor_operate(pkt, (void *)data, length, true, true,
+				      chksum);
+}
+
+int net_pkt_write_iov(struct net_pkt *pkt, const struct net_iovec *iov,
+		      size_t iovcnt, size_t length, uint16_t *chksum)
+{
+	size_t offset = 0;
+	size_t i;
+
+	NET_DBG("pkt %p iov %p iovcnt %zu length %zu", pkt, iov, iovcnt, length);
+
+	for (i = 0; i < iovcnt && offset < length; i++) {
+		size_t len = MIN(iov[i].iov_len, length - offset);
+		uint16_t sum = 0U;
+		int ret;
+
+		ret = net_pkt_cursor_operate(pkt, iov[i].iov_base, len, true, true,
+					     chksum ? &sum : NULL);
+		if (ret < 0) {
+			return ret;
+		}
+
+		if (chksum) {
+			pkt_chksum_add(chksum, sum, offset % 2);
+		}
+
+		offset += len;
+	}
+
+	return 0;
 }
 
 int net_pkt_copy(struct net_pkt *pkt_dst,
@@ -2050,6 +2113,7 @@ static void clone_pkt_attributes(struct net_pkt *pkt, struct net_pkt *clone_pkt)
 	net_pkt_set_rx_timestamping(clone_pkt, net_pkt_is_rx_timestamping(pkt));
 	net_pkt_set_forwarding(clone_pkt, net_pkt_forwarding(pkt));
 	net_pkt_set_chksum_done(clone_pkt, net_pkt_is_chksum_done(pkt));
+	net_pkt_set_chksum_payload(clone_pkt, net_pkt_is_chksum_payload(pkt));
 	net_pkt_set_loopback(pkt, net_pkt_is_loopback(pkt));
 	net_pkt_set_ip_reassembled(pkt, net_pkt_is_ip_reassembled(pkt));
 	net_pkt_set_cooked_mode(clone_pkt, net_pkt_is_cooked_mode(pkt));
@@ -303,6 +303,11 @@ extern char *net_sprint_ll_addr_buf(const uint8_t *ll, uint8_t ll_len,
 				    char *buf, int buflen);
 extern uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len);
 extern uint16_t net_calc_chksum(struct net_pkt *pkt, uint8_t proto);
+/* Like net_calc_chksum(), but only the first hdr_len bytes of the transport
+ * header are read from the packet, the rest is covered by payload_chksum.
+ */
+extern uint16_t net_calc_chksum_hdr(struct net_pkt *pkt, uint8_t proto,
+				    size_t hdr_len, uint16_t payload_chksum);
 
 /**
  * @brief Deliver the incoming packet through the recv_cb of the net_context
@@ -364,6 +369,16 @@ static inline uint16_t net_calc_chksum_udp(struct net_pkt *pkt)
 	return chksum == 0U ? 0xffff : chksum;
 }
 
+static inline uint16_t net_calc_chksum_udp_hdr(struct net_pkt *pkt,
+					       uint16_t payload_chksum)
+{
+	uint16_t chksum = net_calc_chksum_hdr(pkt, NET_IPPROTO_UDP,
+					      sizeof(struct net_udp_hdr),
+					      payload_chksum);
+
+	return chksum == 0U ? 0xffff : chksum;
+}
+
 static inline uint16_t net_calc_verify_chksum_udp(struct net_pkt *pkt)
 {
 	return net_calc_chksum(pkt, NET_IPPROTO_UDP);
@@ -54,13 +54,48 @@ int net_udp_finalize(struct net_pkt *pkt, bool force_chksum)
 	udp_hdr->len = net_htons(length);
 
 	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt), type) || force_chksum) {
-		udp_hdr->chksum = net_calc_chksum_udp(pkt);
+		if (net_pkt_is_chksum_payload(pkt)) {
+			uint16_t payload_chksum = udp_hdr->chksum;
+
+			udp_hdr->chksum = 0U;
+			udp_hdr->chksum = net_calc_chksum_udp_hdr(pkt, payload_chksum);
+		} else {
+			udp_hdr->chksum = net_calc_chksum_udp(pkt);
+		}
+
 		net_pkt_set_chksum_done(pkt, true);
+	} else if (net_pkt_is_chksum_payload(pkt)) {
+		udp_hdr->chksum = 0U;
 	}
 
+	net_pkt_set_chksum_payload(pkt, false);
+
 	return net_pkt_set_data(pkt, &udp_access);
 }
 
+int net_udp_set_payload_chksum(struct net_pkt *pkt, uint16_t chksum)
+{
+	struct net_udp_hdr hdr, *udp_hdr;
+
+	udp_hdr = net_udp_get_hdr(pkt, &hdr);
+	if (!udp_hdr) {
+		return -ENOBUFS;
+	}
+
+	/* Stash the payload checksum in the header checksum field until
+	 * net_udp_finalize() folds in the pseudo and UDP headers.
+	 */
+	udp_hdr->chksum = chksum;
+
+	if (!net_udp_set_hdr(pkt, udp_hdr)) {
+		return -ENOBUFS;
+	}
+
+	net_pkt_set_chksum_payload(pkt, true);
+
+	return 0;
+}
+
 struct net_udp_hdr *net_udp_get_hdr(struct net_pkt *pkt,
 				    struct net_udp_hdr *hdr)
 {
@@ -74,6 +74,31 @@ static inline int net_udp_finalize(struct net_pkt *pkt, bool force_chksum)
 }
 #endif
 
+/**
+ * @brief Store the checksum of the UDP payload already written to net_pkt
+ *
+ * Note: lets net_udp_finalize() compute the UDP checksum over the headers
+ *       only, instead of walking the whole payload again.
+ *
+ * @param pkt Network packet
+ * @param chksum Ones' complement sum of the payload, as computed by
+ *        net_pkt_write_chksum()
+ *
+ * @return 0 on success, negative errno otherwise.
+ */
+#if defined(CONFIG_NET_NATIVE_UDP)
+int net_udp_set_payload_chksum(struct net_pkt *pkt, uint16_t chksum);
+#else
+static inline int net_udp_set_payload_chksum(struct net_pkt *pkt,
+					     uint16_t chksum)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(chksum);
+
+	return 0;
+}
+#endif
+
 /**
  * @brief Get pointer to UDP header in net_pkt
  *
@@ -684,7 +684,38 @@ static inline uint16_t pkt_calc_chksum(struct net_pkt *pkt, uint16_t sum)
 	return sum;
 }
 
-uint16_t net_calc_chksum(struct net_pkt *pkt, uint8_t proto)
+/* Sum hdr_len bytes of transport header at the cursor and add the
+ * precomputed checksum of the payload following it.
+ */
+static inline uint16_t pkt_calc_hdr_chksum(struct net_pkt *pkt, uint16_t sum,
+					   size_t hdr_len,
+					   uint16_t payload_chksum)
+{
+	uint8_t hdr[16];
+
+	__ASSERT_NO_MSG(hdr_len % 2 == 0);
+
+	while (hdr_len > 0) {
+		size_t len = MIN(hdr_len, sizeof(hdr));
+
+		if (net_pkt_read(pkt, hdr, len) < 0) {
+			break;
+		}
+
+		sum = calc_chksum(sum, hdr, len);
+		hdr_len -= len;
+	}
+
+	sum += payload_chksum;
+	if (sum < payload_chksum) {
+		sum++;
+	}
+
+	return sum;
+}
+
+static uint16_t calc_chksum_pkt(struct net_pkt *pkt, uint8_t proto,
+				size_t hdr_len, const uint16_t *payload_chksum)
 {
 	size_t len = 0U;
 	uint16_t sum = 0U;
@@ -721,7 +752,11 @@ uint16_t net_calc_chksum(struct net_pkt *pkt, uint8_t proto)
 	sum = calc_chksum(sum, pkt->cursor.pos, len);
 	net_pkt_skip(pkt, len + net_pkt_ip_opts_len(pkt));
 
-	sum = pkt_calc_chksum(pkt, sum);
+	if (payload_chksum != NULL) {
+		sum = pkt_calc_hdr_chksum(pkt, sum, hdr_len, *payload_chksum);
+	} else {
+		sum = pkt_calc_chksum(pkt, sum);
+	}
 
 	sum = (sum == 0U) ? 0xffff : net_htons(sum);
 
@@ -731,6 +766,17 @@ uint16_t net_calc_chksum(struct net_pkt *pkt, uint8_t proto)
 
 	return ~sum;
 }
+
+uint16_t net_calc_chksum(struct net_pkt *pkt, uint8_t proto)
+{
+	return calc_chksum_pkt(pkt, proto, 0, NULL);
+}
+
+uint16_t net_calc_chksum_hdr(struct net_pkt *pkt, uint8_t proto,
+			     size_t hdr_len, uint16_t payload_chksum)
+{
+	return calc_chksum_pkt(pkt, proto, hdr_len, &payload_chksum);
+}
 #endif
 
 #if defined(CONFIG_NET_NATIVE_IPV4)
@@ -457,7 +457,9 @@ static int handle_http_preface(struct http_client_ctx *client)
 
 	if (IS_ENABLED(CONFIG_HTTP_SERVER_CAPTURE_HEADERS)) {
 		client->header_capture_ctx.count = 0;
-		client->header_capture_ctx.cursor = 0;
+		sys_arena_init(&client->header_capture_ctx.arena,
+			       client->header_capture_ctx.buffer,
+			       sizeof(client->header_capture_ctx.buffer), NULL, 0);
 		client->header_capture_ctx.status = HTTP_HEADER_STATUS_OK;
 	}
 
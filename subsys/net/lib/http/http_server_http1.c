@@ -702,8 +702,7 @@ not_supported:
 static void check_user_request_headers(struct http_header_capture_ctx *ctx, const char *buf)
 {
 	size_t header_len;
-	char *dest = &ctx->buffer[ctx->cursor];
-	size_t remaining = sizeof(ctx->buffer) - ctx->cursor;
+	char *dest;
 
 	ctx->store_next_value = false;
 
@@ -717,7 +716,9 @@ static void check_user_request_headers(struct http_header_capture_ctx *ctx, cons
 				break;
 			}
 
-			if (remaining < header_len + 1) {
+			ctx->name_mark = sys_arena_checkpoint(&ctx->arena);
+			dest = sys_arena_aligned_alloc(&ctx->arena, header_len + 1, 1);
+			if (dest == NULL) {
 				LOG_DBG("Header '%s' dropped: buffer too small for name",
 					header->name);
 				ctx->status = HTTP_HEADER_STATUS_DROPPED;
@@ -727,7 +728,6 @@ static void check_user_request_headers(struct http_header_capture_ctx *ctx, cons
 			memcpy(dest, header->name, header_len + 1);
 
 			ctx->headers[ctx->count].name = dest;
-			ctx->cursor += (header_len + 1);
 			ctx->store_next_value = true;
 			break;
 		}
@@ -784,7 +784,6 @@ static void populate_user_request_header(struct http_header_capture_ctx *ctx, co
 {
 	char *dest;
 	size_t value_len;
-	size_t remaining;
 
 	if (ctx->store_next_value == false) {
 		return;
@@ -792,18 +791,18 @@ static void populate_user_request_header(struct http_header_capture_ctx *ctx, co
 
 	ctx->store_next_value = false;
 	value_len = strlen(buf);
-	remaining = sizeof(ctx->buffer) - ctx->cursor;
 
-	if (value_len + 1 >= remaining) {
+	dest = sys_arena_aligned_alloc(&ctx->arena, value_len + 1, 1);
+	if (dest == NULL) {
 		LOG_DBG("Header '%s' dropped: buffer too small for value",
 			ctx->headers[ctx->count].name);
 		ctx->status = HTTP_HEADER_STATUS_DROPPED;
+		/* give back the space of the name */
+		sys_arena_rollback(&ctx->arena, &ctx->name_mark);
 		return;
 	}
 
-	dest = &ctx->buffer[ctx->cursor];
 	memcpy(dest, buf, value_len + 1);
-	ctx->cursor += (value_len + 1);
 
 	ctx->headers[ctx->count].value = dest;
 	ctx->count++;
@@ -826,6 +825,8 @@ static int on_header_value(struct http_parser *parser,
 		    ctx->header_capture_ctx.store_next_value) {
 			ctx->header_capture_ctx.store_next_value = false;
 			ctx->header_capture_ctx.status = HTTP_HEADER_STATUS_DROPPED;
+			sys_arena_rollback(&ctx->header_capture_ctx.arena,
+					   &ctx->header_capture_ctx.name_mark);
 		}
 	} else {
 		memcpy(ctx->header_buffer + offset, at, length);
@@ -1343,6 +1343,149 @@ fail:
 	return -1;
 }
 
+#if defined(CONFIG_NET_SOCKETS_SEND_BUF)
+ssize_t zsock_send_buf(int sock, struct net_buf *buf, int flags)
+{
+	const struct fd_op_vtable *vtable;
+	struct net_context *ctx;
+	struct k_mutex *lock;
+	k_timeout_t timeout = K_FOREVER;
+	uint32_t retry_timeout = WAIT_BUFS_INITIAL_MS;
+	k_timepoint_t buf_timeout, end;
+	ssize_t ret;
+
+	if (buf == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	ctx = zvfs_get_fd_obj_and_vtable(sock, &vtable, &lock);
+	if (ctx == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable != (const struct fd_op_vtable *)&sock_fd_op_vtable ||
+	    net_context_get_type(ctx) != NET_SOCK_DGRAM) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+		buf_timeout = sys_timepoint_calc(K_NO_WAIT);
+	} else {
+		net_context_get_option(ctx, NET_OPT_SNDTIMEO, &timeout, NULL);
+		buf_timeout = sys_timepoint_calc(MAX_WAIT_BUFS);
+	}
+	end = sys_timepoint_calc(timeout);
+
+	/* Register the callback before sending in order to receive the response
+	 * from the peer.
+	 */
+	if (!sock_is_eof(ctx)) {
+		ret = net_context_recv(ctx, zsock_received_cb, K_NO_WAIT, ctx->user_data);
+		if (ret < 0) {
+			errno = -ret;
+			ret = -1;
+			goto unlock;
+		}
+	}
+
+	while (1) {
+		ret = net_context_send_buf(ctx, buf, NULL, timeout, ctx->user_data);
+		if (ret < 0) {
+			ret = send_check_and_wait(ctx, ret, buf_timeout, timeout,
+						  &retry_timeout);
+			if (ret < 0) {
+				goto unlock;
+			}
+
+			timeout = sys_timepoint_timeout(end);
+
+			continue;
+		}
+
+		break;
+	}
+
+unlock:
+	k_mutex_unlock(lock);
+
+	return ret;
+}
+#endif /* CONFIG_NET_SOCKETS_SEND_BUF */
+
+#if defined(CONFIG_NET_SOCKETS_RECV_PKT)
+ssize_t zsock_recv_pkt(int sock, struct net_pkt **pkt, int flags)
+{
+	const struct fd_op_vtable *vtable;
+	struct net_context *ctx;
+	struct k_mutex *lock;
+	k_timeout_t timeout = K_FOREVER;
+	enum net_sock_type sock_type;
+	ssize_t ret;
+
+	if (pkt == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	ctx = zvfs_get_fd_obj_and_vtable(sock, &vtable, &lock);
+	if (ctx == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable != (const struct fd_op_vtable *)&sock_fd_op_vtable) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	sock_type = net_context_get_type(ctx);
+	if (sock_type != NET_SOCK_DGRAM && sock_type != NET_SOCK_RAW) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	} else {
+		net_context_get_option(ctx, NET_OPT_RCVTIMEO, &timeout, NULL);
+
+		ret = zsock_wait_data(ctx, &timeout);
+		if (ret < 0) {
+			errno = -ret;
+			ret = -1;
+			goto unlock;
+		}
+	}
+
+	*pkt = k_fifo_get(&ctx->recv_q, timeout);
+	if (*pkt == NULL) {
+		errno = EAGAIN;
+		ret = -1;
+		goto unlock;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS) ||
+	    IS_ENABLED(CONFIG_TRACING_NET_CORE)) {
+		net_socket_update_tc_rx_time(*pkt, k_cycle_get_32());
+	}
+
+	ret = net_pkt_remaining_data(*pkt);
+
+unlock:
+	k_mutex_unlock(lock);
+
+	return ret;
+}
+#endif /* CONFIG_NET_SOCKETS_RECV_PKT */
+
 static size_t zsock_recv_stream_immediate(struct net_context *ctx, uint8_t **buf, size_t *max_len,
 					  int flags)
 {
@@ -9,6 +9,7 @@ LOG_MODULE_DECLARE(net_zperf, CONFIG_NET_ZPERF_LOG_LEVEL);
 
 #include <zephyr/kernel.h>
 
+#include <zephyr/net_buf.h>
 #include <zephyr/net/socket.h>
 #include <zephyr/net/zperf.h>
 
@@ -23,6 +24,41 @@ static uint8_t sample_packet[sizeof(struct zperf_udp_datagram) +
 static struct zperf_async_upload_context udp_async_upload_ctx;
 #endif /* CONFIG_ZPERF_SESSION_PER_THREAD */
 
+#if defined(CONFIG_NET_ZPERF_UDP_ZERO_COPY)
+/* Header and payload buffers of the packets in flight */
+#define ZPERF_UDP_TX_BUFS 8
+
+NET_BUF_POOL_FIXED_DEFINE(zperf_udp_tx_pool, ZPERF_UDP_TX_BUFS,
+			  sizeof(struct zperf_udp_datagram) +
+			  sizeof(struct zperf_client_hdr_v1),
+			  0, NULL);
+
+/* Copy the headers, and send the payload of sample_packet in place. The
+ * buffer allocation waits for the stack to release earlier packets.
+ */
+static int zperf_udp_send_zero_copy(int sock, size_t header_size,
+				    uint32_t packet_size)
+{
+	struct net_buf *hdr, *data;
+	int ret;
+
+	hdr = net_buf_alloc(&zperf_udp_tx_pool, K_FOREVER);
+	net_buf_add_mem(hdr, sample_packet, header_size);
+
+	data = net_buf_alloc_with_data(&zperf_udp_tx_pool,
+				       sample_packet + header_size,
+				       packet_size - header_size, K_FOREVER);
+	net_buf_frag_add(hdr, data);
+
+	ret = zsock_send_buf(sock, hdr, 0);
+	if (ret < 0) {
+		net_buf_unref(hdr);
+	}
+
+	return ret;
+}
+#endif /* CONFIG_NET_ZPERF_UDP_ZERO_COPY */
+
 static inline void zperf_upload_decode_stat(const uint8_t *data,
 					    size_t datalen,
 					    struct zperf_results *results)
@@ -346,7 +382,15 @@ static int udp_upload(int sock, int port,
 		data_offset += packet_size - header_size;
 
 		/* Send the packet */
+#if defined(CONFIG_NET_ZPERF_UDP_ZERO_COPY)
+		if (param->data_loader == NULL && packet_size > header_size) {
+			ret = zperf_udp_send_zero_copy(sock, header_size, packet_size);
+		} else {
+			ret = zsock_send(sock, sample_packet, packet_size, 0);
+		}
+#else
 		ret = zsock_send(sock, sample_packet, packet_size, 0);
+#endif
 		if (ret < 0) {
 			NET_ERR("Failed to send the packet (%d)", errno);
 			return -errno;
@@ -48,6 +48,16 @@ struct settings_nvs {
 	uint16_t cache_total;
 	bool loaded;
 #endif
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+	struct {
+		uint16_t name_hash;
+		uint16_t root_hash;
+		uint16_t name_id;
+	} index[CONFIG_SETTINGS_NVS_NAME_INDEX_SIZE];
+
+	/* Set while the index holds every stored name */
+	bool index_complete;
+#endif
 };
 
 /* register nvs to be a source of settings */
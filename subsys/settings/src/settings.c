@@ -27,6 +27,98 @@ sys_slist_t settings_handlers;
 static K_MUTEX_DEFINE(settings_lock);
 #endif
 
+#if defined(CONFIG_SETTINGS_HANDLER_INDEX)
+/* Handlers sorted by name, valid once settings_init() has filled it */
+static struct settings_handler_static *handler_index[CONFIG_SETTINGS_HANDLER_INDEX_SIZE];
+static size_t handler_index_count;
+static bool handler_index_valid;
+
+static void settings_handler_index_add(struct settings_handler_static *handler)
+{
+	size_t pos = handler_index_count;
+
+	if (handler->name == NULL) {
+		/* Never matches any name */
+		return;
+	}
+
+	if (handler_index_count == ARRAY_SIZE(handler_index)) {
+		handler_index_valid = false;
+		return;
+	}
+
+	while ((pos > 0) && (strcmp(handler_index[pos - 1]->name, handler->name) > 0)) {
+		handler_index[pos] = handler_index[pos - 1];
+		pos--;
+	}
+
+	handler_index[pos] = handler;
+	handler_index_count++;
+}
+
+/* Find the handler named exactly as the first len characters of name */
+static struct settings_handler_static *settings_handler_index_find(const char *name, size_t len)
+{
+	size_t lo = 0;
+	size_t hi = handler_index_count;
+
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+		const char *hname = handler_index[mid]->name;
+		int rc = strncmp(hname, name, len);
+
+		if (rc == 0) {
+			if (hname[len] == '\0') {
+				return handler_index[mid];
+			}
+
+			/* Longer handler names sort after their prefixes */
+			rc = 1;
+		}
+
+		if (rc < 0) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	return NULL;
+}
+
+static struct settings_handler_static *settings_handler_index_lookup(const char *name,
+								     const char **next)
+{
+	struct settings_handler_static *bestmatch = NULL;
+	struct settings_handler_static *ch;
+	size_t match_len = 0;
+	size_t len = 0;
+
+	/* Try every name prefix ending at a separator, keeping the longest match */
+	while (true) {
+		len += settings_name_next(&name[len], NULL);
+
+		ch = settings_handler_index_find(name, len);
+		if (ch) {
+			bestmatch = ch;
+			match_len = len;
+		}
+
+		if (name[len] != SETTINGS_NAME_SEPARATOR) {
+			break;
+		}
+
+		len++;
+	}
+
+	if (next && bestmatch && (name[match_len] == SETTINGS_NAME_SEPARATOR)) {
+		*next = &name[match_len + 1];
+	}
+
+	return bestmatch;
+}
+#endif /* CONFIG_SETTINGS_HANDLER_INDEX */
+
 void settings_store_init(void);
 
 void settings_init(void)
@@ -34,6 +126,14 @@ void settings_init(void)
 #if defined(CONFIG_SETTINGS_DYNAMIC_HANDLERS)
 	sys_slist_init(&settings_handlers);
 #endif /* CONFIG_SETTINGS_DYNAMIC_HANDLERS */
+#if defined(CONFIG_SETTINGS_HANDLER_INDEX)
+	handler_index_count = 0;
+	handler_index_valid = true;
+
+	STRUCT_SECTION_FOREACH(settings_handler_static, ch) {
+		settings_handler_index_add(ch);
+	}
+#endif /* CONFIG_SETTINGS_HANDLER_INDEX */
 	settings_store_init();
 }
 
@@ -60,6 +160,9 @@ int settings_register_with_cprio(struct settings_handler *handler, int cprio)
 
 	handler->cprio = cprio;
 	sys_slist_append(&settings_handlers, &handler->node);
+#if defined(CONFIG_SETTINGS_HANDLER_INDEX)
+	settings_handler_index_add((struct settings_handler_static *)handler);
+#endif /* CONFIG_SETTINGS_HANDLER_INDEX */
 
 end:
 	settings_lock_release();
@@ -154,6 +257,12 @@ struct settings_handler_static *settings_parse_and_lookup(const char *name,
 		*next = NULL;
 	}
 
+#if defined(CONFIG_SETTINGS_HANDLER_INDEX)
+	if (handler_index_valid && name) {
+		return settings_handler_index_lookup(name, next);
+	}
+#endif /* CONFIG_SETTINGS_HANDLER_INDEX */
+
 	STRUCT_SECTION_FOREACH(settings_handler_static, ch) {
 		if (!settings_name_steq(name, ch->name, &tmpnext)) {
 			continue;
@@ -120,6 +120,161 @@ static uint16_t settings_nvs_cache_match(struct settings_nvs *cf, const char *na
 }
 #endif /* CONFIG_SETTINGS_NVS_NAME_CACHE */
 
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+#define SETTINGS_NVS_INDEX_SIZE CONFIG_SETTINGS_NVS_NAME_INDEX_SIZE
+
+static uint16_t settings_nvs_name_hash(const char *name)
+{
+	return crc16_ccitt(0xffff, name, strlen(name));
+}
+
+/* Hash of the first name component, used to select the items of a subtree */
+static uint16_t settings_nvs_root_hash(const char *name)
+{
+	return crc16_ccitt(0xffff, name, settings_name_next(name, NULL));
+}
+
+static void settings_nvs_index_clear(struct settings_nvs *cf)
+{
+	memset(cf->index, 0, sizeof(cf->index));
+	cf->index_complete = false;
+}
+
+static int settings_nvs_index_add(struct settings_nvs *cf, const char *name,
+				  uint16_t name_id)
+{
+	uint16_t name_hash = settings_nvs_name_hash(name);
+	size_t pos = name_hash % SETTINGS_NVS_INDEX_SIZE;
+
+	for (size_t i = 0; i < SETTINGS_NVS_INDEX_SIZE; i++) {
+		if (cf->index[pos].name_id == 0 || cf->index[pos].name_id == name_id) {
+			cf->index[pos].name_hash = name_hash;
+			cf->index[pos].root_hash = settings_nvs_root_hash(name);
+			cf->index[pos].name_id = name_id;
+			return 0;
+		}
+
+		pos = (pos + 1) % SETTINGS_NVS_INDEX_SIZE;
+	}
+
+	return -ENOMEM;
+}
+
+static void settings_nvs_index_remove(struct settings_nvs *cf, const char *name,
+				      uint16_t name_id)
+{
+	size_t pos = settings_nvs_name_hash(name) % SETTINGS_NVS_INDEX_SIZE;
+	size_t next, home;
+	size_t i;
+
+	for (i = 0; i < SETTINGS_NVS_INDEX_SIZE; i++) {
+		if (cf->index[pos].name_id == 0) {
+			return;
+		}
+
+		if (cf->index[pos].name_id == name_id) {
+			break;
+		}
+
+		pos = (pos + 1) % SETTINGS_NVS_INDEX_SIZE;
+	}
+
+	if (i == SETTINGS_NVS_INDEX_SIZE) {
+		return;
+	}
+
+	/* Close the gap so that the probe sequences of other names stay intact */
+	cf->index[pos].name_id = 0;
+	next = pos;
+
+	while (true) {
+		next = (next + 1) % SETTINGS_NVS_INDEX_SIZE;
+
+		if (cf->index[next].name_id == 0) {
+			return;
+		}
+
+		home = cf->index[next].name_hash % SETTINGS_NVS_INDEX_SIZE;
+
+		if ((pos < next) ? (home > pos && home <= next) : (home > pos || home <= next)) {
+			continue;
+		}
+
+		cf->index[pos] = cf->index[next];
+		cf->index[next].name_id = 0;
+		pos = next;
+	}
+}
+
+static uint16_t settings_nvs_index_match(struct settings_nvs *cf, const char *name,
+					 char *rdname, size_t len)
+{
+	uint16_t name_hash = settings_nvs_name_hash(name);
+	size_t pos = name_hash % SETTINGS_NVS_INDEX_SIZE;
+	int rc;
+
+	for (size_t i = 0; i < SETTINGS_NVS_INDEX_SIZE; i++) {
+		if (cf->index[pos].name_id == 0) {
+			break;
+		}
+
+		if (cf->index[pos].name_hash == name_hash) {
+			rc = nvs_read(&cf->cf_nvs, cf->index[pos].name_id, rdname, len);
+			if (rc >= 0) {
+				rdname[rc] = '\0';
+
+				if (strcmp(name, rdname) == 0) {
+					return cf->index[pos].name_id;
+				}
+			}
+		}
+
+		pos = (pos + 1) % SETTINGS_NVS_INDEX_SIZE;
+	}
+
+	return NVS_NAMECNT_ID;
+}
+
+/* Load the items of a subtree, reading only the names that share its root */
+static int settings_nvs_index_load_subtree(struct settings_nvs *cf,
+					   const struct settings_load_arg *arg)
+{
+	struct settings_nvs_read_fn_arg read_fn_arg;
+	char name[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
+	uint16_t root_hash = settings_nvs_root_hash(arg->subtree);
+	uint16_t name_id;
+	char buf;
+	ssize_t rc1, rc2;
+	int ret;
+
+	for (size_t i = 0; i < SETTINGS_NVS_INDEX_SIZE; i++) {
+		name_id = cf->index[i].name_id;
+
+		if (name_id == 0 || cf->index[i].root_hash != root_hash) {
+			continue;
+		}
+
+		rc1 = nvs_read(&cf->cf_nvs, name_id, &name, sizeof(name));
+		rc2 = nvs_read(&cf->cf_nvs, name_id + NVS_NAME_ID_OFFSET, &buf, sizeof(buf));
+		if ((rc1 <= 0) || (rc2 <= 0)) {
+			continue;
+		}
+
+		name[rc1] = '\0';
+		read_fn_arg.fs = &cf->cf_nvs;
+		read_fn_arg.id = name_id + NVS_NAME_ID_OFFSET;
+
+		ret = settings_call_set_handler(name, rc2, settings_nvs_read_fn, &read_fn_arg,
+						(void *)arg);
+		if (ret) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+#endif /* CONFIG_SETTINGS_NVS_NAME_INDEX */
+
 static int settings_nvs_load(struct settings_store *cs,
 			     const struct settings_load_arg *arg)
 {
@@ -137,6 +292,16 @@ static int settings_nvs_load(struct settings_store *cs,
 	cf->loaded = false;
 #endif
 
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+	bool indexed = true;
+
+	if (cf->index_complete && arg && arg->subtree) {
+		return settings_nvs_index_load_subtree(cf, arg);
+	}
+
+	settings_nvs_index_clear(cf);
+#endif
+
 	name_id = cf->last_name_id + 1;
 
 	while (1) {
@@ -146,6 +311,10 @@ static int settings_nvs_load(struct settings_store *cs,
 #if CONFIG_SETTINGS_NVS_NAME_CACHE
 			cf->loaded = true;
 			cf->cache_total = cached;
+#endif
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+			/* Names that did not fit can only be found by a scan */
+			cf->index_complete = indexed;
 #endif
 			break;
 		}
@@ -200,6 +369,11 @@ static int settings_nvs_load(struct settings_store *cs,
 		settings_nvs_cache_add(cf, name, name_id);
 		cached++;
 #endif
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+		if (settings_nvs_index_add(cf, name, name_id)) {
+			indexed = false;
+		}
+#endif
 
 		ret = settings_call_set_handler(
 			name, rc2,
@@ -240,10 +414,30 @@ static int settings_nvs_save(struct settings_store *cs, const char *name,
 	}
 #endif
 
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+	name_id = settings_nvs_index_match(cf, name, rdname, sizeof(rdname));
+	if (name_id != NVS_NAMECNT_ID) {
+		write_name_id = name_id;
+		write_name = false;
+		goto found;
+	}
+
+	/* A name missing from a complete index is not stored */
+	if (cf->index_complete && delete) {
+		return 0;
+	}
+#endif
+
 	name_id = cf->last_name_id + 1;
 	write_name_id = cf->last_name_id + 1;
 	write_name = true;
 
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+	if (cf->index_complete) {
+		goto found;
+	}
+#endif
+
 #if CONFIG_SETTINGS_NVS_NAME_CACHE
 	/* We can skip reading NVS if we know that the cache wasn't overflowed. */
 	if (cf->loaded && !SETTINGS_NVS_CACHE_OVFL(cf)) {
@@ -297,6 +491,10 @@ found:
 			return rc;
 		}
 
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+		settings_nvs_index_remove(cf, name, name_id);
+#endif
+
 		if (name_id == cf->last_name_id) {
 			cf->last_name_id--;
 			rc = nvs_write(&cf->cf_nvs, NVS_NAMECNT_ID,
@@ -342,6 +540,12 @@ found:
 		}
 	}
 
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+	if (settings_nvs_index_add(cf, name, write_name_id)) {
+		cf->index_complete = false;
+	}
+#endif
+
 #if CONFIG_SETTINGS_NVS_NAME_CACHE
 	if (!name_in_cache) {
 		settings_nvs_cache_add(cf, name, write_name_id);
@@ -370,6 +574,10 @@ int settings_nvs_backend_init(struct settings_nvs *cf)
 		return rc;
 	}
 
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+	settings_nvs_index_clear(cf);
+#endif
+
 	rc = nvs_read(&cf->cf_nvs, NVS_NAMECNT_ID, &last_name_id,
 		      sizeof(last_name_id));
 	if (rc < 0) {
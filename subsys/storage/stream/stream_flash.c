@@ -16,6 +16,11 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME, CONFIG_STREAM_FLASH_LOG_LEVEL);
 
 #include <zephyr/storage/stream_flash.h>
 
+#ifdef CONFIG_STREAM_FLASH_PIPELINE
+#include <zephyr/drivers/flash/rtio.h>
+#include <zephyr/rtio/rtio.h>
+#endif
+
 #ifdef CONFIG_STREAM_FLASH_PROGRESS
 #include <zephyr/settings/settings.h>
 
@@ -72,6 +77,17 @@ static int settings_direct_loader(const char *key, size_t len,
 
 #endif /* CONFIG_STREAM_FLASH_PROGRESS */
 
+/* Number of bytes handed to the flash device but not yet confirmed written */
+static inline size_t stream_flash_pending_bytes(const struct stream_flash_ctx *ctx)
+{
+#ifdef CONFIG_STREAM_FLASH_PIPELINE
+	return ctx->pending_bytes;
+#else
+	ARG_UNUSED(ctx);
+	return 0;
+#endif
+}
+
 /* Will erase at most what is required to append given size, If already
  * erased space can accommodate requested size, then no new page will
  * be erased.
@@ -129,6 +145,169 @@ static int stream_flash_erase_to_append(struct stream_flash_ctx *ctx, size_t siz
 	return rc;
 }
 
+static int stream_flash_verify(struct stream_flash_ctx *ctx, uint8_t *buf,
+			       size_t len, size_t addr)
+{
+#if defined(CONFIG_STREAM_FLASH_POST_WRITE_CALLBACK)
+	int rc;
+
+	if (ctx->callback) {
+		/* Invert to ensure that caller is able to discover a faulty
+		 * flash_read() even if no error code is returned.
+		 */
+		for (int i = 0; i < len; i++) {
+			buf[i] = ~buf[i];
+		}
+
+		rc = flash_read(ctx->fdev, addr, buf, len);
+		if (rc != 0) {
+			LOG_ERR("flash read failed: %d", rc);
+			return rc;
+		}
+
+		rc = ctx->callback(buf, len, addr);
+		if (rc != 0) {
+			LOG_ERR("callback failed: %d", rc);
+			return rc;
+		}
+	}
+#else
+	ARG_UNUSED(ctx);
+	ARG_UNUSED(buf);
+	ARG_UNUSED(len);
+	ARG_UNUSED(addr);
+#endif
+
+	return 0;
+}
+
+#ifdef CONFIG_STREAM_FLASH_PIPELINE
+
+/* Wait for the operations in flight and account for the written buffer */
+static int stream_flash_pipeline_wait(struct stream_flash_ctx *ctx)
+{
+	size_t write_addr = ctx->offset + ctx->bytes_written;
+	struct rtio_cqe *cqe;
+	int rc = 0;
+
+	while (ctx->pending_ops > 0) {
+		cqe = rtio_cqe_consume_block(ctx->rtio);
+		if (rc == 0 && cqe->result < 0) {
+			rc = cqe->result;
+		}
+		rtio_cqe_release(ctx->rtio, cqe);
+		ctx->pending_ops--;
+	}
+
+	if (ctx->pending_bytes == 0) {
+		return 0;
+	}
+
+	if (rc != 0) {
+		LOG_ERR("flash_write error %d offset=0x%08zx", rc, write_addr);
+#ifdef CONFIG_STREAM_FLASH_ERASE
+		/* The erase ahead may not have happened */
+		ctx->erased_up_to = ctx->erase_ahead_from;
+#endif
+	} else {
+		rc = stream_flash_verify(ctx, ctx->pending_buf, ctx->pending_bytes,
+					 write_addr);
+	}
+
+	if (rc == 0) {
+		ctx->bytes_written += ctx->pending_bytes;
+	}
+
+	ctx->pending_bytes = 0;
+
+	return rc;
+}
+
+/* Queue an erase of the page following the erased range, so that it is ready
+ * by the time the next buffer has been filled.
+ */
+static void stream_flash_prep_erase_ahead(struct stream_flash_ctx *ctx,
+					  struct rtio_sqe *write_sqe)
+{
+#if defined(CONFIG_STREAM_FLASH_ERASE)
+	struct flash_pages_info page;
+	struct rtio_sqe *sqe;
+#if defined(CONFIG_STREAM_FLASH_ERASE_ONLY_WHEN_SUPPORTED)
+	const struct flash_parameters *fparams = flash_get_parameters(ctx->fdev);
+#endif
+
+	ctx->erase_ahead_from = ctx->erased_up_to;
+
+#if defined(CONFIG_STREAM_FLASH_ERASE_ONLY_WHEN_SUPPORTED)
+	if (!(flash_params_get_erase_cap(fparams) & FLASH_ERASE_C_EXPLICIT)) {
+		return;
+	}
+#endif
+
+	if (ctx->bytes_written + ctx->buf_bytes + ctx->buf_len <= ctx->erased_up_to ||
+	    ctx->erased_up_to >= ctx->available) {
+		return;
+	}
+
+	if (flash_get_page_info_by_offs(ctx->fdev, ctx->offset + ctx->erased_up_to,
+					&page) != 0) {
+		/* Left to stream_flash_erase_to_append() to report */
+		return;
+	}
+
+	sqe = rtio_sqe_acquire(ctx->rtio);
+	if (sqe == NULL) {
+		return;
+	}
+
+	LOG_DBG("Erasing ahead page at offset 0x%08lx", (long)page.start_offset);
+
+	rtio_sqe_prep_storage_erase(sqe, &ctx->iodev, RTIO_PRIO_NORM, page.start_offset,
+				    page.size, ctx);
+	write_sqe->flags |= RTIO_SQE_CHAINED;
+	ctx->pending_ops++;
+	ctx->erased_up_to += page.size;
+#else
+	ARG_UNUSED(ctx);
+	ARG_UNUSED(write_sqe);
+#endif
+}
+
+/* Hand the filled buffer to the flash device and continue in the spare one */
+static int stream_flash_pipeline_submit(struct stream_flash_ctx *ctx, size_t len)
+{
+	struct rtio_sqe *sqe;
+	uint8_t *spare;
+	int rc;
+
+	sqe = rtio_sqe_acquire(ctx->rtio);
+	if (sqe == NULL) {
+		LOG_ERR("No RTIO submission available");
+		return -ENOMEM;
+	}
+
+	rtio_sqe_prep_storage_write(sqe, &ctx->iodev, RTIO_PRIO_NORM,
+				    ctx->offset + ctx->bytes_written, ctx->buf, len, ctx);
+	ctx->pending_ops = 1;
+
+	stream_flash_prep_erase_ahead(ctx, sqe);
+
+	rc = rtio_submit(ctx->rtio, 0);
+	if (rc != 0) {
+		return rc;
+	}
+
+	spare = ctx->pending_buf;
+	ctx->pending_buf = ctx->buf;
+	ctx->pending_bytes = ctx->buf_bytes;
+	ctx->buf = spare;
+	ctx->buf_bytes = 0U;
+
+	return 0;
+}
+
+#endif /* CONFIG_STREAM_FLASH_PIPELINE */
+
 #if defined(CONFIG_STREAM_FLASH_ERASE)
 
 int stream_flash_erase_page(struct stream_flash_ctx *ctx, off_t off)
@@ -142,6 +321,15 @@ int stream_flash_erase_page(struct stream_flash_ctx *ctx, off_t off)
 		return -ERANGE;
 	}
 
+#if defined(CONFIG_STREAM_FLASH_PIPELINE)
+	if (ctx->rtio != NULL) {
+		rc = stream_flash_pipeline_wait(ctx);
+		if (rc != 0) {
+			return rc;
+		}
+	}
+#endif
+
 	/* Do not allow pages that have already been erased */
 	if ((off - ctx->offset) < ctx->erased_up_to) {
 		return -EINVAL;
@@ -197,6 +385,19 @@ static int flash_sync(struct stream_flash_ctx *ctx)
 		return 0;
 	}
 
+#ifdef CONFIG_STREAM_FLASH_PIPELINE
+	if (ctx->rtio != NULL) {
+		/* The previous buffer must be written before its space is
+		 * reused and before anything is appended after it.
+		 */
+		rc = stream_flash_pipeline_wait(ctx);
+		if (rc != 0) {
+			return rc;
+		}
+		write_addr = ctx->offset + ctx->bytes_written;
+	}
+#endif
+
 	if (IS_ENABLED(CONFIG_STREAM_FLASH_ERASE)) {
 
 		rc = stream_flash_erase_to_append(ctx, ctx->buf_bytes);
@@ -218,6 +419,13 @@ static int flash_sync(struct stream_flash_ctx *ctx)
 	}
 
 	buf_bytes_aligned = ctx->buf_bytes + fill_length;
+
+#ifdef CONFIG_STREAM_FLASH_PIPELINE
+	if (ctx->rtio != NULL) {
+		return stream_flash_pipeline_submit(ctx, buf_bytes_aligned);
+	}
+#endif
+
 	rc = flash_write(ctx->fdev, write_addr, ctx->buf, buf_bytes_aligned);
 
 	if (rc != 0) {
@@ -226,32 +434,11 @@ static int flash_sync(struct stream_flash_ctx *ctx)
 		return rc;
 	}
 
-#if defined(CONFIG_STREAM_FLASH_POST_WRITE_CALLBACK)
-
-	if (ctx->callback) {
-		/* Invert to ensure that caller is able to discover a faulty
-		 * flash_read() even if no error code is returned.
-		 */
-		for (int i = 0; i < ctx->buf_bytes; i++) {
-			ctx->buf[i] = ~ctx->buf[i];
-		}
-
-		rc = flash_read(ctx->fdev, write_addr, ctx->buf,
-				ctx->buf_bytes);
-		if (rc != 0) {
-			LOG_ERR("flash read failed: %d", rc);
-			return rc;
-		}
-
-		rc = ctx->callback(ctx->buf, ctx->buf_bytes, write_addr);
-		if (rc != 0) {
-			LOG_ERR("callback failed: %d", rc);
-			return rc;
-		}
+	rc = stream_flash_verify(ctx, ctx->buf, ctx->buf_bytes, write_addr);
+	if (rc != 0) {
+		return rc;
 	}
 
-#endif
-
 	ctx->bytes_written += ctx->buf_bytes;
 	ctx->buf_bytes = 0U;
 
@@ -269,7 +456,8 @@ int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *dat
 		return -EFAULT;
 	}
 
-	if (ctx->bytes_written + ctx->buf_bytes + len > ctx->available) {
+	if (ctx->bytes_written + stream_flash_pending_bytes(ctx) + ctx->buf_bytes + len >
+	    ctx->available) {
 		return -ENOMEM;
 	}
 
@@ -299,6 +487,12 @@ int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *dat
 		rc = flash_sync(ctx);
 	}
 
+#ifdef CONFIG_STREAM_FLASH_PIPELINE
+	if (flush && rc == 0 && ctx->rtio != NULL) {
+		rc = stream_flash_pipeline_wait(ctx);
+	}
+#endif
+
 	return rc;
 }
 
@@ -309,7 +503,7 @@ size_t stream_flash_bytes_written(const struct stream_flash_ctx *ctx)
 
 size_t stream_flash_bytes_buffered(const struct stream_flash_ctx *ctx)
 {
-	return ctx->buf_bytes;
+	return stream_flash_pending_bytes(ctx) + ctx->buf_bytes;
 }
 
 #ifdef CONFIG_STREAM_FLASH_INSPECT
@@ -410,6 +604,11 @@ int stream_flash_init(struct stream_flash_ctx *ctx, const struct device *fdev,
 
 #ifdef CONFIG_STREAM_FLASH_ERASE
 	ctx->erased_up_to = 0;
+#endif
+#ifdef CONFIG_STREAM_FLASH_PIPELINE
+	ctx->rtio = NULL;
+	ctx->pending_bytes = 0U;
+	ctx->pending_ops = 0U;
 #endif
 	ctx->erase_value = params->erase_value;
 
@@ -427,6 +626,36 @@ int stream_flash_init(struct stream_flash_ctx *ctx, const struct device *fdev,
 	return 0;
 }
 
+#ifdef CONFIG_STREAM_FLASH_PIPELINE
+int stream_flash_init_pipelined(struct stream_flash_ctx *ctx, const struct device *fdev,
+				uint8_t *buf, size_t buf_len, size_t offset, size_t size,
+				stream_flash_callback_t cb, struct rtio *r)
+{
+	int rc;
+
+	if (!r) {
+		return -EFAULT;
+	}
+
+	if (buf_len % 2) {
+		LOG_ERR("Buffer can not be split in two");
+		return -EFAULT;
+	}
+
+	rc = stream_flash_init(ctx, fdev, buf, buf_len / 2, offset, size, cb);
+	if (rc != 0) {
+		return rc;
+	}
+
+	ctx->pending_buf = buf + buf_len / 2;
+	ctx->iodev.api = &flash_iodev_api;
+	ctx->iodev.data = (void *)fdev;
+	ctx->rtio = r;
+
+	return 0;
+}
+#endif /* CONFIG_STREAM_FLASH_PIPELINE */
+
 #ifdef CONFIG_STREAM_FLASH_PROGRESS
 static int stream_flash_settings_init(void)
 {
@@ -369,6 +369,15 @@ extern "C" {
 	sys_trace_k_mem_slab_alloc_exit(slab, timeout, ret)
 #define sys_port_trace_k_mem_slab_free_enter(slab) sys_trace_k_mem_slab_free_enter(slab)
 #define sys_port_trace_k_mem_slab_free_exit(slab)  sys_trace_k_mem_slab_free_exit(slab)
+/* The event id space is used up, the bulk operations are traced as named events */
+#define sys_port_trace_k_mem_slab_alloc_bulk_enter(slab, count)                                    \
+	sys_trace_named_event("mslab_alloc_bulk", (uint32_t)(uintptr_t)slab, (uint32_t)count)
+#define sys_port_trace_k_mem_slab_alloc_bulk_exit(slab, count, ret)                                \
+	sys_trace_named_event("mslab_alloc_bulk_rc", (uint32_t)(uintptr_t)slab, (uint32_t)ret)
+#define sys_port_trace_k_mem_slab_free_bulk_enter(slab, count)                                     \
+	sys_trace_named_event("mslab_free_bulk", (uint32_t)(uintptr_t)slab, (uint32_t)count)
+#define sys_port_trace_k_mem_slab_free_bulk_exit(slab, count)                                      \
+	sys_trace_named_event("mslab_free_bulk_end", (uint32_t)(uintptr_t)slab, (uint32_t)count)
 
 #define sys_port_trace_k_event_init(event) sys_trace_k_event_init(event)
 #define sys_port_trace_k_event_post_enter(event, events, events_mask)                              \
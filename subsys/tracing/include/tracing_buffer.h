@@ -41,34 +41,38 @@ uint32_t tracing_buffer_space_get(void);
 uint32_t tracing_buffer_capacity_get(void);
 
 /**
- * @brief Try to allocate buffer in the tracing buffer.
+ * @brief Reserve a block for writing in place in the tracing buffer.
  *
- * @param data Pointer to the address. It's set to a location
- *             within the tracing buffer.
- * @param size Requested buffer size (in bytes).
+ * May be called concurrently from any context. The block is reserved
+ * entirely or not at all and may wrap around the end of the buffer. Each
+ * successful reservation must be followed by one call to
+ * tracing_buffer_put_commit().
+ *
+ * @param data Set to the start of the block.
+ * @param wrap Set to the start of the part of the block past the end of
+ *             the buffer.
+ * @param size Block size (in bytes).
  *
- * @return Size of allocated buffer which can be smaller than
- *         requested if there isn't enough free space or buffer wraps.
+ * @retval Number of bytes of the block starting at @a data, 0 if there is
+ *         not enough free space.
  */
-uint32_t tracing_buffer_put_claim(uint8_t **data, uint32_t size);
+uint32_t tracing_buffer_put_reserve(uint8_t **data, uint8_t **wrap, uint32_t size);
 
 /**
- * @brief Indicate number of bytes written to the allocated buffer.
- *
- * @param size Number of bytes written to the allocated buffer.
- *
- * @retval 0 Successful operation.
- * @retval -EINVAL Given @a size exceeds free space of tracing buffer.
+ * @brief Commit a block reserved with tracing_buffer_put_reserve().
  */
-int tracing_buffer_put_finish(uint32_t size);
+void tracing_buffer_put_commit(void);
 
 /**
  * @brief Write data to tracing buffer.
  *
+ * May be called concurrently from any context. The data is written as one
+ * block, or not at all if there is not enough free space.
+ *
  * @param data Address of data.
  * @param size Data size (in bytes).
  *
- * @retval Number of bytes written to tracing buffer.
+ * @retval Number of bytes written to tracing buffer, either size or 0.
  */
 uint32_t tracing_buffer_put(uint8_t *data, uint32_t size);
 
@@ -21,6 +21,10 @@ extern "C" {
 typedef struct {
 	int status;
 	uint32_t length;
+	/* Block reserved in the tracing buffer, NULL while measuring */
+	uint8_t *data;
+	uint8_t *wrap;
+	uint32_t first;
 } tracing_ctx_t;
 
 /**
@@ -715,6 +715,19 @@ void sys_trace_thread_info(struct k_thread *thread);
 
 #define sys_port_trace_k_mem_slab_free_exit(slab) SEGGER_SYSVIEW_RecordEndCall(TID_MSLAB_FREE)
 
+#define sys_port_trace_k_mem_slab_alloc_bulk_enter(slab, count)                                    \
+	SEGGER_SYSVIEW_RecordU32x2(TID_MSLAB_ALLOC_BULK, (uint32_t)(uintptr_t)slab,                \
+				   (uint32_t)count)
+
+#define sys_port_trace_k_mem_slab_alloc_bulk_exit(slab, count, ret)                                \
+	SEGGER_SYSVIEW_RecordEndCallU32(TID_MSLAB_ALLOC_BULK, (uint32_t)ret)
+
+#define sys_port_trace_k_mem_slab_free_bulk_enter(slab, count)                                     \
+	SEGGER_SYSVIEW_RecordU32x2(TID_MSLAB_FREE_BULK, (uint32_t)(uintptr_t)slab, (uint32_t)count)
+
+#define sys_port_trace_k_mem_slab_free_bulk_exit(slab, count)                                      \
+	SEGGER_SYSVIEW_RecordEndCall(TID_MSLAB_FREE_BULK)
+
 #define sys_port_trace_k_timer_init(timer)                                                         \
 	SEGGER_SYSVIEW_RecordU32(TID_TIMER_INIT, (uint32_t)(uintptr_t)timer)
 
@@ -419,6 +419,10 @@
 	sys_trace_k_mem_slab_alloc_exit(slab, mem, timeout, ret)
 #define sys_port_trace_k_mem_slab_free_enter(slab)
 #define sys_port_trace_k_mem_slab_free_exit(slab) sys_trace_k_mem_slab_free_exit(slab, mem)
+#define sys_port_trace_k_mem_slab_alloc_bulk_enter(slab, count)
+#define sys_port_trace_k_mem_slab_alloc_bulk_exit(slab, count, ret)
+#define sys_port_trace_k_mem_slab_free_bulk_enter(slab, count)
+#define sys_port_trace_k_mem_slab_free_bulk_exit(slab, count)
 
 #define sys_port_trace_k_timer_init(timer) sys_trace_k_timer_init(timer, expiry_fn, stop_fn)
 #define sys_port_trace_k_timer_start(timer, duration, period)					   \
@@ -6,8 +6,16 @@
 
 #include <zephyr/sys/ring_buffer.h>
 
-static struct ring_buf tracing_ring_buf;
-static uint8_t tracing_buffer[CONFIG_TRACING_BUFFER_SIZE + 1];
+/* Traced contexts produce concurrently without locking; the tracing thread,
+ * or the traced context holding the lock in synchronous mode, consumes.
+ */
+#define TRACING_RING_BUF_SIZE NHPOT(CONFIG_TRACING_BUFFER_SIZE)
+
+BUILD_ASSERT(TRACING_RING_BUF_SIZE <= RING_BUF_MP_MAX_SIZE,
+	     "CONFIG_TRACING_BUFFER_SIZE too big");
+
+static struct ring_buf_mp tracing_ring_buf;
+static uint8_t tracing_buffer[TRACING_RING_BUF_SIZE];
 static uint8_t tracing_cmd_buffer[CONFIG_TRACING_CMD_BUFFER_SIZE];
 
 uint32_t tracing_cmd_buffer_alloc(uint8_t **data)
@@ -17,53 +25,53 @@ uint32_t tracing_cmd_buffer_alloc(uint8_t **data)
 	return sizeof(tracing_cmd_buffer);
 }
 
-uint32_t tracing_buffer_put_claim(uint8_t **data, uint32_t size)
+uint32_t tracing_buffer_put_reserve(uint8_t **data, uint8_t **wrap, uint32_t size)
 {
-	return ring_buf_put_claim(&tracing_ring_buf, data, size);
+	return ring_buf_mp_put_reserve(&tracing_ring_buf, data, wrap, size);
 }
 
-int tracing_buffer_put_finish(uint32_t size)
+void tracing_buffer_put_commit(void)
 {
-	return ring_buf_put_finish(&tracing_ring_buf, size);
+	ring_buf_mp_put_finish(&tracing_ring_buf);
 }
 
 uint32_t tracing_buffer_put(uint8_t *data, uint32_t size)
 {
-	return ring_buf_put(&tracing_ring_buf, data, size);
+	return ring_buf_mp_put(&tracing_ring_buf, data, size);
 }
 
 uint32_t tracing_buffer_get_claim(uint8_t **data, uint32_t size)
 {
-	return ring_buf_get_claim(&tracing_ring_buf, data, size);
+	return ring_buf_mp_get_claim(&tracing_ring_buf, data, size);
 }
 
 int tracing_buffer_get_finish(uint32_t size)
 {
-	return ring_buf_get_finish(&tracing_ring_buf, size);
+	return ring_buf_mp_get_finish(&tracing_ring_buf, size);
 }
 
 uint32_t tracing_buffer_get(uint8_t *data, uint32_t size)
 {
-	return ring_buf_get(&tracing_ring_buf, data, size);
+	return ring_buf_mp_get(&tracing_ring_buf, data, size);
 }
 
 void tracing_buffer_init(void)
 {
-	ring_buf_init(&tracing_ring_buf,
-		      sizeof(tracing_buffer), tracing_buffer);
+	ring_buf_mp_init(&tracing_ring_buf,
+			 sizeof(tracing_buffer), tracing_buffer);
 }
 
 bool tracing_buffer_is_empty(void)
 {
-	return ring_buf_is_empty(&tracing_ring_buf);
+	return ring_buf_mp_is_empty(&tracing_ring_buf);
 }
 
 uint32_t tracing_buffer_capacity_get(void)
 {
-	return ring_buf_capacity_get(&tracing_ring_buf);
+	return ring_buf_mp_capacity_get(&tracing_ring_buf);
 }
 
 uint32_t tracing_buffer_space_get(void)
 {
-	return ring_buf_space_get(&tracing_ring_buf);
+	return ring_buf_mp_space_get(&tracing_ring_buf);
 }
@@ -21,10 +21,8 @@ void tracing_format_string(const char *str, ...)
 
 	va_start(args, str);
 
-	TRACING_LOCK();
 	before_put_is_empty = tracing_buffer_is_empty();
 	put_success = tracing_format_string_put(str, args);
-	TRACING_UNLOCK();
 
 	va_end(args);
 
@@ -43,10 +41,8 @@ void tracing_format_raw_data(uint8_t *data, uint32_t length)
 		return;
 	}
 
-	TRACING_LOCK();
 	before_put_is_empty = tracing_buffer_is_empty();
 	put_success = tracing_format_raw_data_put(data, length);
-	TRACING_UNLOCK();
 
 	if (put_success) {
 		tracing_trigger_output(before_put_is_empty);
@@ -63,10 +59,8 @@ void tracing_format_data(tracing_data_t *tracing_data_array, uint32_t count)
 		return;
 	}
 
-	TRACING_LOCK();
 	before_put_is_empty = tracing_buffer_is_empty();
 	put_success = tracing_format_data_put(tracing_data_array, count);
-	TRACING_UNLOCK();
 
 	if (put_success) {
 		tracing_trigger_output(before_put_is_empty);
@@ -5,6 +5,7 @@
  */
 
 #include <string.h>
+#include <zephyr/sys/__assert.h>
 #include <zephyr/sys/cbprintf.h>
 #include <tracing_buffer.h>
 #include <tracing_format_common.h>
@@ -13,18 +14,14 @@ static int str_put(int c, void *ctx)
 {
 	tracing_ctx_t *str_ctx = (tracing_ctx_t *)ctx;
 
-	if (str_ctx->status == 0) {
-		uint8_t *buf;
-		uint32_t claimed_size;
-
-		claimed_size = tracing_buffer_put_claim(&buf, 1);
-		if (claimed_size) {
-			*buf = (uint8_t)c;
-			str_ctx->length++;
+	if (str_ctx->data != NULL) {
+		if (str_ctx->length < str_ctx->first) {
+			str_ctx->data[str_ctx->length] = (uint8_t)c;
 		} else {
-			str_ctx->status = -1;
+			str_ctx->wrap[str_ctx->length - str_ctx->first] = (uint8_t)c;
 		}
 	}
+	str_ctx->length++;
 
 	return 0;
 }
@@ -32,54 +29,78 @@ static int str_put(int c, void *ctx)
 bool tracing_format_string_put(const char *str, va_list args)
 {
 	tracing_ctx_t str_ctx = {0};
+	uint32_t length;
+	va_list args_copy;
+
+	/* Measure the string first, then format it again in place into a
+	 * block reserved as a whole, so that concurrent producers never
+	 * interleave and no copy of the packet is kept on the stack.
+	 */
+	va_copy(args_copy, args);
+	(void)cbvprintf(str_put, (void *)&str_ctx, str, args_copy);
+	va_end(args_copy);
+
+	length = str_ctx.length;
+	if (length == 0U) {
+		return true;
+	}
 
+	str_ctx.first = tracing_buffer_put_reserve(&str_ctx.data, &str_ctx.wrap, length);
+	if (str_ctx.first == 0U) {
+		return false;
+	}
+
+	str_ctx.length = 0U;
 	(void)cbvprintf(str_put, (void *)&str_ctx, str, args);
+	__ASSERT_NO_MSG(str_ctx.length == length);
 
-	if (str_ctx.status == 0) {
-		tracing_buffer_put_finish(str_ctx.length);
-		return true;
-	}
+	tracing_buffer_put_commit();
 
-	tracing_buffer_put_finish(0);
-	return false;
+	return true;
 }
 
 bool tracing_format_raw_data_put(uint8_t *data, uint32_t size)
 {
-	uint32_t space = tracing_buffer_space_get();
-
-	if (space >= size) {
-		tracing_buffer_put(data, size);
-		return true;
-	}
-
-	return false;
+	return tracing_buffer_put(data, size) == size;
 }
 
 bool tracing_format_data_put(tracing_data_t *tracing_data_array, uint32_t count)
 {
 	uint32_t total_size = 0U;
+	uint32_t first, part;
+	uint8_t *buf, *wrap;
+
+	for (uint32_t i = 0; i < count; i++) {
+		total_size += tracing_data_array[i].length;
+	}
+
+	if (total_size == 0U) {
+		return true;
+	}
+
+	first = tracing_buffer_put_reserve(&buf, &wrap, total_size);
+	if (first == 0U) {
+		return false;
+	}
 
 	for (uint32_t i = 0; i < count; i++) {
 		tracing_data_t *tracing_data =
 				tracing_data_array + i;
-		uint8_t *data = tracing_data->data, *buf;
-		uint32_t length = tracing_data->length, claimed_size;
-
-		do {
-			claimed_size = tracing_buffer_put_claim(&buf, length);
-			memcpy(buf, data, claimed_size);
-			total_size += claimed_size;
-			length -= claimed_size;
-			data += claimed_size;
-		} while (length && claimed_size);
-
-		if (length && claimed_size == 0) {
-			tracing_buffer_put_finish(0);
-			return false;
+		uint8_t *data = tracing_data->data;
+		uint32_t length = tracing_data->length;
+
+		part = MIN(length, first);
+		memcpy(buf, data, part);
+		buf += part;
+		first -= part;
+
+		if (part < length) {
+			memcpy(wrap, data + part, length - part);
+			wrap += length - part;
 		}
 	}
 
-	tracing_buffer_put_finish(total_size);
+	tracing_buffer_put_commit();
+
 	return true;
 }
@@ -387,6 +387,10 @@ void sys_trace_rtio_chain_next_exit(const struct rtio *r, const struct rtio_iode
 #define sys_port_trace_k_mem_slab_alloc_exit(slab, timeout, ret)
 #define sys_port_trace_k_mem_slab_free_enter(slab)
 #define sys_port_trace_k_mem_slab_free_exit(slab)
+#define sys_port_trace_k_mem_slab_alloc_bulk_enter(slab, count)
+#define sys_port_trace_k_mem_slab_alloc_bulk_exit(slab, count, ret)
+#define sys_port_trace_k_mem_slab_free_bulk_enter(slab, count)
+#define sys_port_trace_k_mem_slab_free_bulk_exit(slab, count)
 
 #define sys_port_trace_k_timer_init(timer)
 #define sys_port_trace_k_timer_start(timer, duration, period)
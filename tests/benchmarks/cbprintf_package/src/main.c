@@ -0,0 +1,86 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Cycles per call of packaging a log-like message with arguments of mixed
+ * types, with the runtime packager (cbprintf_package()) and with the
+ * compile time one (CBPRINTF_STATIC_PACKAGE). The runtime packager has to
+ * scan the whole format string, so a format with a long literal text is
+ * measured next to a short one.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/cbprintf.h>
+#include <zephyr/ztest.h>
+
+#define ITERATIONS 1000
+
+#define FMT_SHORT "%d %u %c %lld %p %s"
+#define FMT_LONG                                                                           \
+	"connection %d from port %u, state %c: received %lld bytes into buffer %p "        \
+	"while the peer %s kept the window open"
+
+/* Like logging, record where the copied string arguments are */
+#define FLAGS CBPRINTF_PACKAGE_ADD_RW_STR_POS
+
+static uint8_t __aligned(CBPRINTF_PACKAGE_ALIGNMENT) package[256];
+static char peer[] = "192.0.2.1";
+
+static void report(const char *packager, const char *fmt_name, uint32_t cycles)
+{
+	TC_PRINT("%-7s %-5s format: %u cycles/call\n", packager, fmt_name,
+		 cycles / ITERATIONS);
+}
+
+#define BENCH_RUNTIME(fmt_name, fmt)                                                       \
+	do {                                                                               \
+		uint32_t start;                                                            \
+		int len;                                                                   \
+                                                                                           \
+		len = cbprintf_package(package, sizeof(package), FLAGS, fmt, -42, 42U,     \
+				       'x', -42LL, (void *)package, peer);                 \
+		zassert_true(len > 0, "packaging failed: %d", len);                        \
+                                                                                           \
+		start = k_cycle_get_32();                                                  \
+		for (int i = 0; i < ITERATIONS; i++) {                                     \
+			(void)cbprintf_package(package, sizeof(package), FLAGS, fmt,       \
+					       -42 - i, 42U, 'x', -42LL, (void *)package,  \
+					       peer);                                      \
+		}                                                                          \
+		report("runtime", fmt_name, k_cycle_get_32() - start);                     \
+	} while (false)
+
+#define BENCH_STATIC(fmt_name, fmt)                                                        \
+	do {                                                                               \
+		uint32_t start;                                                            \
+		int len;                                                                   \
+                                                                                           \
+		CBPRINTF_STATIC_PACKAGE(package, sizeof(package), len, 0, FLAGS, fmt,      \
+					-42, 42U, 'x', -42LL, (void *)package, peer);      \
+		zassert_true(len > 0, "packaging failed: %d", len);                        \
+                                                                                           \
+		start = k_cycle_get_32();                                                  \
+		for (int i = 0; i < ITERATIONS; i++) {                                     \
+			CBPRINTF_STATIC_PACKAGE(package, sizeof(package), len, 0, FLAGS,   \
+						fmt, -42 - i, 42U, 'x', -42LL,             \
+						(void *)package, peer);                    \
+		}                                                                          \
+		report("static", fmt_name, k_cycle_get_32() - start);                      \
+	} while (false)
+
+ZTEST(cbprintf_package_benchmark, test_package_runtime)
+{
+	BENCH_RUNTIME("short", FMT_SHORT);
+	BENCH_RUNTIME("long", FMT_LONG);
+}
+
+ZTEST(cbprintf_package_benchmark, test_package_static)
+{
+	BENCH_STATIC("short", FMT_SHORT);
+	BENCH_STATIC("long", FMT_LONG);
+}
+
+ZTEST_SUITE(cbprintf_package_benchmark, NULL, NULL, NULL, NULL, NULL);
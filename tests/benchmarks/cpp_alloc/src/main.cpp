@@ -0,0 +1,166 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Cost of container workloads that allocate many small objects, in CPU
+ * cycles per round, with the default allocator (operator new, which uses
+ * the CONFIG_CPP_NEW_POOLS slabs when enabled) and with the std::pmr
+ * memory resources over a k_heap and over a monotonic arena.
+ */
+
+#include <map>
+#include <memory_resource>
+#include <string>
+#include <vector>
+#include <zephyr/cpp/memory_resource.hpp>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#define ROUNDS   32
+#define ELEMENTS 64
+
+K_HEAP_DEFINE(bench_k_heap, 32768);
+
+/* Released after every round, so it only needs to hold one round */
+static zephyr::pmr::arena_resource<16384> arena;
+
+/* Grows a vector one element at a time */
+template <typename Vec, typename Alloc> static size_t vector_round(const Alloc &alloc)
+{
+	Vec vec(alloc);
+	size_t sum = 0;
+
+	for (int i = 0; i < ELEMENTS * 4; i++) {
+		vec.push_back(i);
+	}
+	for (int v : vec) {
+		sum += v;
+	}
+
+	return sum;
+}
+
+/* Fills a map, erases every other node and fills the holes again */
+template <typename Map, typename Alloc> static size_t map_round(const Alloc &alloc)
+{
+	Map map(alloc);
+
+	for (int i = 0; i < ELEMENTS; i++) {
+		map.emplace(i, i);
+	}
+	for (int i = 0; i < ELEMENTS; i += 2) {
+		map.erase(i);
+	}
+	for (int i = 0; i < ELEMENTS; i += 2) {
+		map.emplace(i, i);
+	}
+
+	return map.size();
+}
+
+/* Builds strings too long for the small string buffer */
+template <typename Str, typename Vec, typename Alloc> static size_t string_round(const Alloc &alloc)
+{
+	Vec strs(alloc);
+	size_t len = 0;
+
+	strs.reserve(ELEMENTS);
+	for (int i = 0; i < ELEMENTS; i++) {
+		Str s("benchmark string of forty-odd bytes: ", alloc);
+
+		s += static_cast<char>('a' + i % 26);
+		strs.push_back(std::move(s));
+	}
+	for (const auto &s : strs) {
+		len += s.size();
+	}
+
+	return len;
+}
+
+template <typename Fn> static void bench(const char *workload, const char *alloc, Fn fn)
+{
+	volatile size_t sink;
+	uint64_t start;
+	uint64_t cycles;
+
+	/* warm up, so the heaps are in a steady state */
+	sink = fn();
+
+	start = k_cycle_get_64();
+	for (int i = 0; i < ROUNDS; i++) {
+		sink = fn();
+	}
+	cycles = k_cycle_get_64() - start;
+
+	(void)sink;
+	TC_PRINT("%-7s %-14s: %llu cycles/round\n", workload, alloc,
+		 (unsigned long long)(cycles / ROUNDS));
+}
+
+ZTEST(cpp_alloc, test_vector)
+{
+	zephyr::pmr::k_heap_resource heap(&bench_k_heap);
+
+	bench("vector",
+	      IS_ENABLED(CONFIG_CPP_NEW_POOLS) ? "new (pools)" : "new (malloc)", [] {
+		      return vector_round<std::vector<int>>(std::allocator<int>());
+	      });
+	bench("vector", "pmr k_heap", [&] {
+		return vector_round<std::pmr::vector<int>>(
+			std::pmr::polymorphic_allocator<int>(&heap));
+	});
+	bench("vector", "pmr arena", [&] {
+		size_t ret = vector_round<std::pmr::vector<int>>(
+			std::pmr::polymorphic_allocator<int>(&arena));
+
+		arena.release();
+		return ret;
+	});
+}
+
+ZTEST(cpp_alloc, test_map)
+{
+	zephyr::pmr::k_heap_resource heap(&bench_k_heap);
+
+	bench("map", IS_ENABLED(CONFIG_CPP_NEW_POOLS) ? "new (pools)" : "new (malloc)", [] {
+		return map_round<std::map<int, int>>(std::allocator<std::pair<const int, int>>());
+	});
+	bench("map", "pmr k_heap", [&] {
+		return map_round<std::pmr::map<int, int>>(
+			std::pmr::polymorphic_allocator<std::byte>(&heap));
+	});
+	bench("map", "pmr arena", [&] {
+		size_t ret = map_round<std::pmr::map<int, int>>(
+			std::pmr::polymorphic_allocator<std::byte>(&arena));
+
+		arena.release();
+		return ret;
+	});
+}
+
+ZTEST(cpp_alloc, test_string)
+{
+	zephyr::pmr::k_heap_resource heap(&bench_k_heap);
+
+	bench("string", IS_ENABLED(CONFIG_CPP_NEW_POOLS) ? "new (pools)" : "new (malloc)", [] {
+		return string_round<std::string, std::vector<std::string>>(
+			std::allocator<char>());
+	});
+	bench("string", "pmr k_heap", [&] {
+		return string_round<std::pmr::string, std::pmr::vector<std::pmr::string>>(
+			std::pmr::polymorphic_allocator<std::byte>(&heap));
+	});
+	bench("string", "pmr arena", [&] {
+		size_t ret = string_round<std::pmr::string, std::pmr::vector<std::pmr::string>>(
+			std::pmr::polymorphic_allocator<std::byte>(&arena));
+
+		arena.release();
+		return ret;
+	});
+}
+
+ZTEST_SUITE(cpp_alloc, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,66 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Throughput of the CRC implementations, in CPU cycles per byte, for the
+ * table size and CPU instruction options selected in Kconfig.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/sys/crc.h>
+
+#define BUF_SIZE   4096
+#define ITERATIONS 16
+
+static uint8_t buf[BUF_SIZE];
+
+/* Prints cycles per byte with two decimals */
+static void report(const char *name, uint64_t cycles)
+{
+	uint64_t centi = cycles * 100U / ((uint64_t)BUF_SIZE * ITERATIONS);
+
+	TC_PRINT("%-12s %llu.%02llu cycles/byte\n", name, centi / 100U, centi % 100U);
+}
+
+#define BENCH(name, expr)                                                                          \
+	do {                                                                                       \
+		volatile uint32_t sink;                                                            \
+		uint64_t start = k_cycle_get_64();                                                 \
+                                                                                                   \
+		for (int i = 0; i < ITERATIONS; i++) {                                             \
+			sink = (expr);                                                             \
+		}                                                                                  \
+		report(name, k_cycle_get_64() - start);                                            \
+		(void)sink;                                                                        \
+	} while (false)
+
+ZTEST(crc_benchmark, test_throughput)
+{
+	for (size_t i = 0; i < sizeof(buf); i++) {
+		buf[i] = (uint8_t)(i * 131U + 7U);
+	}
+
+	BENCH("crc8_ccitt", crc8_ccitt(0xff, buf, sizeof(buf)));
+	BENCH("crc16_ccitt", crc16_ccitt(0xffff, buf, sizeof(buf)));
+	BENCH("crc16_itu_t", crc16_itu_t(0xffff, buf, sizeof(buf)));
+	BENCH("crc24_pgp", crc24_pgp(buf, sizeof(buf)));
+	BENCH("crc32_ieee", crc32_ieee(buf, sizeof(buf)));
+	BENCH("crc32_c", crc32_c(0, buf, sizeof(buf), true, true));
+}
+
+ZTEST(crc_benchmark, test_combine)
+{
+	uint32_t crc1 = crc32_ieee(buf, BUF_SIZE / 2);
+	uint32_t crc2 = crc32_ieee(buf + BUF_SIZE / 2, BUF_SIZE / 2);
+	uint64_t start = k_cycle_get_64();
+	uint32_t crc = crc32_ieee_combine(crc1, crc2, BUF_SIZE / 2);
+
+	TC_PRINT("crc32_ieee_combine: %llu cycles\n", k_cycle_get_64() - start);
+	zassert_equal(crc, crc32_ieee(buf, BUF_SIZE));
+}
+
+ZTEST_SUITE(crc_benchmark, NULL, NULL, NULL, NULL, NULL);
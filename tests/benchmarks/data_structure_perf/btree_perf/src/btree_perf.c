@@ -0,0 +1,152 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Insert, remove and minimum extraction cost of the B-tree compared against
+ * the red/black tree, for several tree sizes. Both trees are ordered by the
+ * same random keys, ties being broken by insertion order.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/sys/btree.h>
+#include <zephyr/sys/rb.h>
+
+#define MAX_ELEMS 1024
+
+struct elem {
+	struct rbnode rb;
+	struct btnode bt;
+	int32_t key;
+	uint32_t seq;
+};
+
+static struct elem elems[MAX_ELEMS];
+/* Order in which elements are removed, a permutation of elems */
+static struct elem *remove_order[MAX_ELEMS];
+static const size_t sizes[] = {16, 128, MAX_ELEMS};
+
+BTREE_DEFINE(bench_btree, MAX_ELEMS);
+
+static bool elem_lessthan(struct rbnode *a, struct rbnode *b)
+{
+	struct elem *ea = CONTAINER_OF(a, struct elem, rb);
+	struct elem *eb = CONTAINER_OF(b, struct elem, rb);
+
+	return (ea->key != eb->key) ? (ea->key < eb->key) : (ea->seq < eb->seq);
+}
+
+static struct rbtree bench_rbtree = {
+	.lessthan_fn = elem_lessthan,
+};
+
+static uint32_t next_rand(void)
+{
+	static uint32_t state = 2463534242;
+
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+
+	return state;
+}
+
+static void setup_elems(size_t n)
+{
+	for (size_t i = 0; i < n; i++) {
+		elems[i].key = (int32_t)next_rand();
+		elems[i].seq = i;
+		remove_order[i] = &elems[i];
+	}
+
+	/* Fisher-Yates shuffle */
+	for (size_t i = n - 1; i > 0; i--) {
+		size_t j = next_rand() % (i + 1);
+		struct elem *tmp = remove_order[i];
+
+		remove_order[i] = remove_order[j];
+		remove_order[j] = tmp;
+	}
+}
+
+static uint64_t cycles_per_op(uint64_t start, size_t n)
+{
+	return (k_cycle_get_64() - start) / n;
+}
+
+static void run_btree(size_t n)
+{
+	uint64_t insert, remove, extract, start;
+
+	start = k_cycle_get_64();
+	for (size_t i = 0; i < n; i++) {
+		zassert_ok(btree_insert(&bench_btree, &elems[i].bt, elems[i].key));
+	}
+	insert = cycles_per_op(start, n);
+
+	start = k_cycle_get_64();
+	for (size_t i = 0; i < n; i++) {
+		btree_remove(&bench_btree, &remove_order[i]->bt);
+	}
+	remove = cycles_per_op(start, n);
+	zassert_true(btree_is_empty(&bench_btree));
+
+	for (size_t i = 0; i < n; i++) {
+		zassert_ok(btree_insert(&bench_btree, &elems[i].bt, elems[i].key));
+	}
+	start = k_cycle_get_64();
+	for (size_t i = 0; i < n; i++) {
+		zassert_not_null(btree_remove_min(&bench_btree));
+	}
+	extract = cycles_per_op(start, n);
+
+	TC_PRINT("btree  %4zu elements: insert %5llu remove %5llu extract-min %5llu cycles\n", n,
+		 insert, remove, extract);
+}
+
+static void run_rbtree(size_t n)
+{
+	uint64_t insert, remove, extract, start;
+	struct rbnode *min;
+
+	start = k_cycle_get_64();
+	for (size_t i = 0; i < n; i++) {
+		rb_insert(&bench_rbtree, &elems[i].rb);
+	}
+	insert = cycles_per_op(start, n);
+
+	start = k_cycle_get_64();
+	for (size_t i = 0; i < n; i++) {
+		rb_remove(&bench_rbtree, &remove_order[i]->rb);
+	}
+	remove = cycles_per_op(start, n);
+	zassert_is_null(rb_get_min(&bench_rbtree));
+
+	for (size_t i = 0; i < n; i++) {
+		rb_insert(&bench_rbtree, &elems[i].rb);
+	}
+	start = k_cycle_get_64();
+	for (size_t i = 0; i < n; i++) {
+		min = rb_get_min(&bench_rbtree);
+		zassert_not_null(min);
+		rb_remove(&bench_rbtree, min);
+	}
+	extract = cycles_per_op(start, n);
+
+	TC_PRINT("rbtree %4zu elements: insert %5llu remove %5llu extract-min %5llu cycles\n", n,
+		 insert, remove, extract);
+}
+
+ZTEST(btree_perf, test_btree_vs_rbtree)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(sizes); i++) {
+		setup_elems(sizes[i]);
+		run_rbtree(sizes[i]);
+		run_btree(sizes[i]);
+	}
+}
+
+ZTEST_SUITE(btree_perf, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,188 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Timeout queue workloads on a sorted dlist, as used by the kernel timeout
+ * queue, on the min-heap with index tracking and on the radix heap. The
+ * queue is filled with N timers, then each step either expires the
+ * earliest timer and re-arms it, or cancels and re-arms a random one.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/sys/dlist.h>
+#include <zephyr/sys/min_heap.h>
+#include <zephyr/sys/radix_heap.h>
+
+#define MAX_TIMERS 1024
+#define STEPS      4096
+#define MAX_DELAY  10000U
+
+struct timer {
+	sys_dnode_t dnode;
+	struct radix_heap_node rnode;
+	size_t heap_index;
+	uint64_t deadline;
+};
+
+enum bench_op {
+	BENCH_EXPIRE,
+	BENCH_CANCEL,
+};
+
+static struct timer timers[MAX_TIMERS];
+static const size_t sizes[] = {16, 128, MAX_TIMERS};
+
+static sys_dlist_t list;
+static struct radix_heap radix;
+
+static int cmp_timer(const void *a, const void *b)
+{
+	const struct timer *ta = *(struct timer *const *)a;
+	const struct timer *tb = *(struct timer *const *)b;
+
+	return (ta->deadline > tb->deadline) - (ta->deadline < tb->deadline);
+}
+
+static void index_timer(void *elem, size_t index)
+{
+	(*(struct timer **)elem)->heap_index = index;
+}
+
+MIN_HEAP_DEFINE_STATIC(heap, MAX_TIMERS, sizeof(struct timer *), __alignof__(struct timer *),
+		       cmp_timer);
+
+static uint32_t next_rand(void)
+{
+	static uint32_t state = 88172645;
+
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+
+	return state;
+}
+
+static void list_add(struct timer *t)
+{
+	struct timer *pos;
+
+	SYS_DLIST_FOR_EACH_CONTAINER(&list, pos, dnode) {
+		if (t->deadline < pos->deadline) {
+			sys_dlist_insert(&pos->dnode, &t->dnode);
+			return;
+		}
+	}
+	sys_dlist_append(&list, &t->dnode);
+}
+
+static uint64_t run_list(size_t n, enum bench_op op)
+{
+	uint64_t now = 0;
+	uint64_t start;
+	struct timer *t;
+
+	sys_dlist_init(&list);
+	for (size_t i = 0; i < n; i++) {
+		timers[i].deadline = next_rand() % MAX_DELAY;
+		list_add(&timers[i]);
+	}
+
+	start = k_cycle_get_64();
+	for (int s = 0; s < STEPS; s++) {
+		if (op == BENCH_EXPIRE) {
+			t = SYS_DLIST_PEEK_HEAD_CONTAINER(&list, t, dnode);
+			now = t->deadline;
+		} else {
+			t = &timers[next_rand() % n];
+		}
+		sys_dlist_remove(&t->dnode);
+		t->deadline = now + next_rand() % MAX_DELAY;
+		list_add(t);
+	}
+
+	return (k_cycle_get_64() - start) / STEPS;
+}
+
+static uint64_t run_min_heap(size_t n, enum bench_op op)
+{
+	uint64_t now = 0;
+	uint64_t start;
+	struct timer *t;
+
+	min_heap_init(&heap, heap.storage, MAX_TIMERS, sizeof(struct timer *), cmp_timer);
+	min_heap_set_index_cb(&heap, index_timer);
+	for (size_t i = 0; i < n; i++) {
+		t = &timers[i];
+		t->deadline = next_rand() % MAX_DELAY;
+		zassert_ok(min_heap_push(&heap, &t));
+	}
+
+	start = k_cycle_get_64();
+	for (int s = 0; s < STEPS; s++) {
+		if (op == BENCH_EXPIRE) {
+			t = *(struct timer **)min_heap_peek(&heap);
+			now = t->deadline;
+		} else {
+			t = &timers[next_rand() % n];
+		}
+		/* re-arming in place avoids a pop and a push */
+		t->deadline = now + next_rand() % MAX_DELAY;
+		min_heap_update(&heap, t->heap_index);
+	}
+
+	return (k_cycle_get_64() - start) / STEPS;
+}
+
+static uint64_t run_radix_heap(size_t n, enum bench_op op)
+{
+	uint64_t now = 0;
+	uint64_t start;
+	struct timer *t;
+
+	radix_heap_init(&radix, now);
+	for (size_t i = 0; i < n; i++) {
+		radix_heap_push(&radix, &timers[i].rnode, next_rand() % MAX_DELAY);
+	}
+
+	start = k_cycle_get_64();
+	for (int s = 0; s < STEPS; s++) {
+		if (op == BENCH_EXPIRE) {
+			/* only a pop advances the lowest key that can be pushed */
+			t = CONTAINER_OF(radix_heap_pop(&radix), struct timer, rnode);
+			now = radix_heap_node_key(&t->rnode);
+			radix_heap_push(&radix, &t->rnode, now + next_rand() % MAX_DELAY);
+		} else {
+			t = &timers[next_rand() % n];
+			radix_heap_update(&radix, &t->rnode, now + next_rand() % MAX_DELAY);
+		}
+	}
+
+	return (k_cycle_get_64() - start) / STEPS;
+}
+
+static void bench(const char *name, uint64_t (*run)(size_t n, enum bench_op op))
+{
+	uint64_t expire, cancel;
+
+	for (size_t i = 0; i < ARRAY_SIZE(sizes); i++) {
+		expire = run(sizes[i], BENCH_EXPIRE);
+		cancel = run(sizes[i], BENCH_CANCEL);
+
+		TC_PRINT("%-11s %4zu timers: expire+rearm %6llu cancel+rearm %6llu cycles\n", name,
+			 sizes[i], expire, cancel);
+	}
+}
+
+ZTEST(heap_perf, test_timeout_queue)
+{
+	bench("dlist", run_list);
+	TC_PRINT("min_heap arity %d:\n", CONFIG_MIN_HEAP_ARITY);
+	bench("min_heap", run_min_heap);
+	bench("radix_heap", run_radix_heap);
+}
+
+ZTEST_SUITE(heap_perf, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,136 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Sequential write and read throughput of a FAT file on a RAM disk, plus
+ * backward seeks, which follow the FAT chain unless the cluster link map
+ * of CONFIG_FS_FATFS_FASTSEEK is enabled.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/fs/fs.h>
+#include <ff.h>
+
+#define DISK_NAME  "RAM:"
+#define FATFS_MNTP "/" DISK_NAME
+#define TEST_FILE  FATFS_MNTP "/bench.bin"
+
+#define FILE_SIZE  (256 * 1024)
+#define CHUNK_SIZE 4096
+#define SEEK_COUNT 256
+
+static FATFS fat_fs;
+static struct fs_mount_t fatfs_mnt = {
+	.type = FS_FATFS,
+	.mnt_point = FATFS_MNTP,
+	.fs_data = &fat_fs,
+};
+
+static uint8_t buf[CHUNK_SIZE];
+
+static void fill_chunk(uint32_t idx)
+{
+	for (size_t i = 0; i < sizeof(buf); i++) {
+		buf[i] = (uint8_t)(idx * 31U + i);
+	}
+}
+
+static bool check_chunk(uint32_t idx, size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		if (buf[i] != (uint8_t)(idx * 31U + i)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static void report(const char *name, size_t bytes, uint64_t cycles)
+{
+	uint64_t us = MAX(k_cyc_to_us_floor64(cycles), 1U);
+
+	TC_PRINT("%s: %zu bytes in %llu us, %llu KiB/s\n", name, bytes, us,
+		 (uint64_t)bytes * USEC_PER_SEC / 1024U / us);
+}
+
+ZTEST(fat_fs_sequential, test_sequential)
+{
+	struct fs_file_t file;
+	uint64_t start;
+	ssize_t len;
+
+	fs_file_t_init(&file);
+	zassert_ok(fs_open(&file, TEST_FILE, FS_O_CREATE | FS_O_RDWR));
+
+#if defined(CONFIG_FILE_SYSTEM_EXPAND)
+	/* Preallocated files are contiguous and written without allocation */
+	start = k_cycle_get_64();
+	zassert_ok(fs_expand(&file, FILE_SIZE));
+	report("expand", FILE_SIZE, k_cycle_get_64() - start);
+#endif
+
+	start = k_cycle_get_64();
+	for (uint32_t i = 0; i < FILE_SIZE / CHUNK_SIZE; i++) {
+		fill_chunk(i);
+		len = fs_write(&file, buf, sizeof(buf));
+		zassert_equal(len, sizeof(buf), "write failed: %zd", len);
+	}
+	zassert_ok(fs_sync(&file));
+	report("write", FILE_SIZE, k_cycle_get_64() - start);
+
+	zassert_ok(fs_close(&file));
+	zassert_ok(fs_open(&file, TEST_FILE, FS_O_READ));
+
+	start = k_cycle_get_64();
+	for (uint32_t i = 0; i < FILE_SIZE / CHUNK_SIZE; i++) {
+		len = fs_read(&file, buf, sizeof(buf));
+		zassert_equal(len, sizeof(buf), "read failed: %zd", len);
+		zassert_true(check_chunk(i, sizeof(buf)), "bad data in chunk %u", i);
+	}
+	report("read", FILE_SIZE, k_cycle_get_64() - start);
+
+	/* Walk the file backwards, one unaligned chunk at a time */
+	start = k_cycle_get_64();
+	for (uint32_t i = 0; i < SEEK_COUNT; i++) {
+		uint32_t idx = (FILE_SIZE / CHUNK_SIZE) - 1U - (i % (FILE_SIZE / CHUNK_SIZE));
+
+		zassert_ok(fs_seek(&file, (off_t)idx * CHUNK_SIZE, FS_SEEK_SET));
+		len = fs_read(&file, buf, 16);
+		zassert_equal(len, 16, "read failed: %zd", len);
+		zassert_true(check_chunk(idx, 16), "bad data in chunk %u", idx);
+	}
+	report("backward seek and read", SEEK_COUNT * 16, k_cycle_get_64() - start);
+
+	zassert_ok(fs_close(&file));
+	zassert_ok(fs_unlink(TEST_FILE));
+}
+
+static void *fat_fs_sequential_setup(void)
+{
+	/* One sector per cluster, so that FatFs splits transfers the most */
+	MKFS_PARM cfg = {
+		.fmt = FM_ANY | FM_SFD,
+		.n_fat = 1,
+		.au_size = 512,
+	};
+
+	zassert_ok(fs_mkfs(FS_FATFS, (uintptr_t)DISK_NAME, &cfg, 0));
+	zassert_ok(fs_mount(&fatfs_mnt));
+
+	return NULL;
+}
+
+static void fat_fs_sequential_teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	fs_unmount(&fatfs_mnt);
+}
+
+ZTEST_SUITE(fat_fs_sequential, NULL, fat_fs_sequential_setup, NULL, NULL,
+	    fat_fs_sequential_teardown);
@@ -0,0 +1,97 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Single-threaded insert, get (hit and miss) and remove cost of each
+ * Hashmap backend, in CPU cycles per operation.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/sys/hash_map.h>
+
+#define N_KEYS     1024
+#define GET_ROUNDS 8
+
+SYS_HASHMAP_SC_DEFINE_STATIC(sc);
+SYS_HASHMAP_OA_LP_DEFINE_STATIC(oa_lp);
+SYS_HASHMAP_SWISS_DEFINE_STATIC(swiss);
+SYS_HASHMAP_CONCURRENT_DEFINE_STATIC(concurrent);
+
+/* spread the keys over the whole 64-bit range */
+static inline uint64_t bench_key(uint32_t i)
+{
+	return (uint64_t)i * 0x9e3779b97f4a7c15ULL;
+}
+
+static void report(const char *map_name, const char *op_name, uint64_t cycles, size_t n_ops)
+{
+	uint64_t centi = cycles * 100U / n_ops;
+
+	TC_PRINT("%-10s %-8s %llu.%02llu cycles/op\n", map_name, op_name, centi / 100U,
+		 centi % 100U);
+}
+
+static void bench_backend(struct sys_hashmap *map, const char *name)
+{
+	uint64_t start;
+	uint64_t value;
+	size_t found = 0;
+
+	start = k_cycle_get_64();
+	for (uint32_t i = 0; i < N_KEYS; i++) {
+		zassert_equal(sys_hashmap_insert(map, bench_key(i), i, NULL), 1);
+	}
+	report(name, "insert", k_cycle_get_64() - start, N_KEYS);
+
+	start = k_cycle_get_64();
+	for (int r = 0; r < GET_ROUNDS; r++) {
+		for (uint32_t i = 0; i < N_KEYS; i++) {
+			found += sys_hashmap_get(map, bench_key(i), &value);
+		}
+	}
+	report(name, "get hit", k_cycle_get_64() - start, N_KEYS * GET_ROUNDS);
+	zassert_equal(found, N_KEYS * GET_ROUNDS);
+
+	start = k_cycle_get_64();
+	for (int r = 0; r < GET_ROUNDS; r++) {
+		for (uint32_t i = 0; i < N_KEYS; i++) {
+			found += sys_hashmap_get(map, bench_key(i) + 1, &value);
+		}
+	}
+	report(name, "get miss", k_cycle_get_64() - start, N_KEYS * GET_ROUNDS);
+	zassert_equal(found, N_KEYS * GET_ROUNDS);
+
+	start = k_cycle_get_64();
+	for (uint32_t i = 0; i < N_KEYS; i++) {
+		zassert_true(sys_hashmap_remove(map, bench_key(i), NULL));
+	}
+	report(name, "remove", k_cycle_get_64() - start, N_KEYS);
+
+	zassert_true(sys_hashmap_is_empty(map));
+}
+
+ZTEST(hash_map_backends, test_separate_chaining)
+{
+	bench_backend(&sc, "sc");
+}
+
+ZTEST(hash_map_backends, test_open_addressing)
+{
+	bench_backend(&oa_lp, "oa_lp");
+}
+
+ZTEST(hash_map_backends, test_swiss)
+{
+	bench_backend(&swiss, "swiss");
+}
+
+ZTEST(hash_map_backends, test_concurrent)
+{
+	bench_backend(&concurrent, "concurrent");
+}
+
+ZTEST_SUITE(hash_map_backends, NULL, NULL, NULL, NULL, NULL);
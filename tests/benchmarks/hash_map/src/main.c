@@ -0,0 +1,143 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Multithreaded insert, get and remove throughput of the concurrent Hashmap,
+ * compared against the separate-chaining Hashmap behind a single lock. One
+ * worker thread is started per CPU and each works on its own range of keys.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/sys/hash_map.h>
+
+#define N_THREADS       CONFIG_MP_MAX_NUM_CPUS
+#define KEYS_PER_THREAD 512
+#define GET_ROUNDS      8
+#define STACK_SIZE      (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+enum bench_op {
+	BENCH_INSERT,
+	BENCH_GET,
+	BENCH_REMOVE,
+};
+
+struct bench_map {
+	const char *name;
+	struct sys_hashmap *map;
+	/* serializes every operation when the backend is not thread-safe */
+	struct k_mutex *lock;
+};
+
+SYS_HASHMAP_SC_DEFINE_STATIC(sc_map);
+SYS_HASHMAP_CONCURRENT_DEFINE_STATIC(concurrent_map);
+static K_MUTEX_DEFINE(sc_lock);
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, N_THREADS, STACK_SIZE);
+static struct k_thread threads[N_THREADS];
+static atomic_t failures;
+
+static void bench_worker(void *p1, void *p2, void *p3)
+{
+	const struct bench_map *bm = p1;
+	const enum bench_op op = POINTER_TO_UINT(p2);
+	const uint64_t first = (uint64_t)POINTER_TO_UINT(p3) * KEYS_PER_THREAD;
+	const int rounds = (op == BENCH_GET) ? GET_ROUNDS : 1;
+	uint64_t value;
+	bool ok;
+
+	for (int r = 0; r < rounds; r++) {
+		for (uint64_t k = first; k < first + KEYS_PER_THREAD; k++) {
+			if (bm->lock != NULL) {
+				k_mutex_lock(bm->lock, K_FOREVER);
+			}
+
+			switch (op) {
+			case BENCH_INSERT:
+				ok = sys_hashmap_insert(bm->map, k, ~k, NULL) == 1;
+				break;
+			case BENCH_GET:
+				ok = sys_hashmap_get(bm->map, k, &value) && value == ~k;
+				break;
+			case BENCH_REMOVE:
+			default:
+				ok = sys_hashmap_remove(bm->map, k, NULL);
+				break;
+			}
+
+			if (bm->lock != NULL) {
+				k_mutex_unlock(bm->lock);
+			}
+
+			if (!ok) {
+				atomic_inc(&failures);
+			}
+		}
+	}
+}
+
+static void bench_run(const struct bench_map *bm, enum bench_op op, const char *op_name)
+{
+	const int rounds = (op == BENCH_GET) ? GET_ROUNDS : 1;
+	const size_t n_ops = (size_t)N_THREADS * KEYS_PER_THREAD * rounds;
+	uint64_t start;
+	uint64_t us;
+
+	atomic_set(&failures, 0);
+
+	for (int i = 0; i < N_THREADS; i++) {
+		k_thread_create(&threads[i], stacks[i], K_THREAD_STACK_SIZEOF(stacks[i]),
+				bench_worker, (void *)bm, UINT_TO_POINTER(op), UINT_TO_POINTER(i),
+				K_PRIO_PREEMPT(1), 0, K_FOREVER);
+	}
+
+	start = k_cycle_get_64();
+	for (int i = 0; i < N_THREADS; i++) {
+		k_thread_start(&threads[i]);
+	}
+	for (int i = 0; i < N_THREADS; i++) {
+		zassert_ok(k_thread_join(&threads[i], K_FOREVER));
+	}
+	us = MAX(k_cyc_to_us_floor64(k_cycle_get_64() - start), 1U);
+
+	zassert_equal(atomic_get(&failures), 0, "%s %s: %ld operations failed", bm->name, op_name,
+		      (long)atomic_get(&failures));
+
+	TC_PRINT("%-10s %-6s %d threads: %zu ops in %llu us, %llu ops/s\n", bm->name, op_name,
+		 N_THREADS, n_ops, us, (uint64_t)n_ops * USEC_PER_SEC / us);
+}
+
+static void bench_all(const struct bench_map *bm)
+{
+	bench_run(bm, BENCH_INSERT, "insert");
+	zassert_equal(sys_hashmap_size(bm->map), (size_t)N_THREADS * KEYS_PER_THREAD);
+	bench_run(bm, BENCH_GET, "get");
+	bench_run(bm, BENCH_REMOVE, "remove");
+	zassert_true(sys_hashmap_is_empty(bm->map));
+}
+
+ZTEST(hash_map_benchmark, test_sc_locked)
+{
+	const struct bench_map bm = {
+		.name = "sc+lock",
+		.map = &sc_map,
+		.lock = &sc_lock,
+	};
+
+	bench_all(&bm);
+}
+
+ZTEST(hash_map_benchmark, test_concurrent)
+{
+	const struct bench_map bm = {
+		.name = "concurrent",
+		.map = &concurrent_map,
+	};
+
+	bench_all(&bm);
+}
+
+ZTEST_SUITE(hash_map_benchmark, NULL, NULL, NULL, NULL, NULL);
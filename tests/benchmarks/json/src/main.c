@@ -0,0 +1,177 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Throughput of the JSON library, in MB/s of JSON text, when encoding and
+ * parsing long strings with and without characters that need escaping, and
+ * when parsing objects with many fields listed in descriptor order or in
+ * reverse order.
+ */
+
+#include <string.h>
+#include <zephyr/data/json.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#define STRING_LEN 1024
+#define ITERATIONS 16
+#define FIELD_COUNT 32
+
+struct string_obj {
+	const char *value;
+};
+
+static const struct json_obj_descr string_obj_descr[] = {
+	JSON_OBJ_DESCR_PRIM(struct string_obj, value, JSON_TOK_STRING),
+};
+
+/* Sized for the escaped length, which is what decoding checks against */
+struct string_buf_obj {
+	char value[2 * STRING_LEN + 1];
+};
+
+static const struct json_obj_descr string_buf_obj_descr[] = {
+	JSON_OBJ_DESCR_PRIM(struct string_buf_obj, value, JSON_TOK_STRING_BUF),
+};
+
+#define FIELD_MEMBER(i, _) f##i
+#define FIELD_DESCR(i, _)  JSON_OBJ_DESCR_PRIM(struct fields_obj, f##i, JSON_TOK_NUMBER)
+
+struct fields_obj {
+	int32_t LISTIFY(FIELD_COUNT, FIELD_MEMBER, (,));
+};
+
+static const struct json_obj_descr fields_obj_descr[] = {
+	LISTIFY(FIELD_COUNT, FIELD_DESCR, (,)),
+};
+
+static char plain[STRING_LEN + 1];
+static char escaped[STRING_LEN + 1];
+/* Room for every character of a string to be escaped */
+static char encoded[2 * STRING_LEN + 32];
+static struct string_buf_obj decoded;
+static char fields_ordered[FIELD_COUNT * 16];
+static char fields_reverse[FIELD_COUNT * 16];
+static struct fields_obj fields;
+
+/* Prints MB/s of JSON text with two decimals */
+static void report(const char *name, const char *input, size_t len, uint64_t cycles)
+{
+	uint64_t centi = (uint64_t)len * ITERATIONS * sys_clock_hw_cycles_per_sec() /
+			 MAX(cycles, 1U) / 10000U;
+
+	TC_PRINT("%-6s %-8s %5zu bytes: %llu.%02llu MB/s\n", name, input, len, centi / 100U,
+		 centi % 100U);
+}
+
+static void *json_benchmark_setup(void)
+{
+	for (size_t i = 0; i < STRING_LEN; i++) {
+		plain[i] = 'a' + i % 26;
+		/* a newline or a quote every 16 characters */
+		escaped[i] = (i % 16) == 15 ? ((i % 32) == 15 ? '\n' : '"') : plain[i];
+	}
+
+	/* {"f0":1000,"f1":1001,...} and the same fields from last to first */
+	for (int i = 0, pos = 0, rpos = 0; i < FIELD_COUNT; i++) {
+		int r = FIELD_COUNT - 1 - i;
+
+		pos += snprintk(fields_ordered + pos, sizeof(fields_ordered) - pos,
+				"%c\"f%d\":%d", i == 0 ? '{' : ',', i, 1000 + i);
+		rpos += snprintk(fields_reverse + rpos, sizeof(fields_reverse) - rpos,
+				 "%c\"f%d\":%d", i == 0 ? '{' : ',', r, 1000 + r);
+	}
+	strcat(fields_ordered, "}");
+	strcat(fields_reverse, "}");
+
+	return NULL;
+}
+
+static void bench_encode(const char *input_name, const char *input)
+{
+	struct string_obj obj = {.value = input};
+	uint64_t start;
+	int ret;
+
+	ret = json_obj_encode_buf(string_obj_descr, ARRAY_SIZE(string_obj_descr), &obj, encoded,
+				  sizeof(encoded));
+	zassert_equal(ret, 0, "encoding failed: %d", ret);
+
+	start = k_cycle_get_64();
+	for (int i = 0; i < ITERATIONS; i++) {
+		(void)json_obj_encode_buf(string_obj_descr, ARRAY_SIZE(string_obj_descr), &obj,
+					  encoded, sizeof(encoded));
+	}
+	report("encode", input_name, strlen(encoded), k_cycle_get_64() - start);
+}
+
+static void bench_parse(const char *input_name, const char *input)
+{
+	struct string_obj obj = {.value = input};
+	size_t len;
+	uint64_t start;
+	int ret;
+
+	ret = json_obj_encode_buf(string_obj_descr, ARRAY_SIZE(string_obj_descr), &obj, encoded,
+				  sizeof(encoded));
+	zassert_equal(ret, 0, "encoding failed: %d", ret);
+	len = strlen(encoded);
+
+	ret = json_obj_parse(encoded, len, string_buf_obj_descr, ARRAY_SIZE(string_buf_obj_descr),
+			     &decoded);
+	zassert_equal(ret, 1, "parsing failed: %d", ret);
+	zassert_str_equal(decoded.value, input, "parsed string is not correct");
+
+	start = k_cycle_get_64();
+	for (int i = 0; i < ITERATIONS; i++) {
+		(void)json_obj_parse(encoded, len, string_buf_obj_descr,
+				     ARRAY_SIZE(string_buf_obj_descr), &decoded);
+	}
+	report("parse", input_name, len, k_cycle_get_64() - start);
+}
+
+static void bench_parse_fields(const char *input_name, char *input)
+{
+	size_t len = strlen(input);
+	int32_t *values = (int32_t *)&fields;
+	uint64_t start;
+	int64_t ret;
+
+	ret = json_obj_parse(input, len, fields_obj_descr, ARRAY_SIZE(fields_obj_descr),
+			     &fields);
+	zassert_equal(ret, BIT64_MASK(FIELD_COUNT), "parsing failed: %d", (int)ret);
+	for (int i = 0; i < FIELD_COUNT; i++) {
+		zassert_equal(values[i], 1000 + i, "field %d parsed wrong", i);
+	}
+
+	/* Numbers are not decoded in place, the input can be parsed again */
+	start = k_cycle_get_64();
+	for (int i = 0; i < ITERATIONS; i++) {
+		(void)json_obj_parse(input, len, fields_obj_descr, ARRAY_SIZE(fields_obj_descr),
+				     &fields);
+	}
+	report("fields", input_name, len, k_cycle_get_64() - start);
+}
+
+ZTEST(json_benchmark, test_encode_string)
+{
+	bench_encode("plain", plain);
+	bench_encode("escaped", escaped);
+}
+
+ZTEST(json_benchmark, test_parse_string)
+{
+	bench_parse("plain", plain);
+	bench_parse("escaped", escaped);
+}
+
+ZTEST(json_benchmark, test_parse_fields)
+{
+	bench_parse_fields("ordered", fields_ordered);
+	bench_parse_fields("reverse", fields_reverse);
+}
+
+ZTEST_SUITE(json_benchmark, NULL, json_benchmark_setup, NULL, NULL, NULL);
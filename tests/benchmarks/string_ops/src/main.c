@@ -0,0 +1,138 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Throughput of the string functions of the C library, in bytes per CPU
+ * cycle, for several block sizes and alignments. Every result is checked
+ * against a byte-at-a-time reference first.
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#define MAX_SIZE   4096
+#define ITERATIONS 16
+/* Room for the misalignment and for guard bytes on both sides */
+#define BUF_SIZE   (MAX_SIZE + 64)
+
+static const size_t sizes[] = {8, 64, 256, 1024, MAX_SIZE};
+static const struct {
+	size_t dst;
+	size_t src;
+} aligns[] = {{0, 0}, {1, 1}, {0, 3}, {5, 2}};
+
+static uint8_t src_buf[BUF_SIZE] __aligned(64);
+static uint8_t dst_buf[BUF_SIZE] __aligned(64);
+static uint8_t ref_buf[BUF_SIZE] __aligned(64);
+
+/* Sizes go through a volatile so the compiler calls the library functions */
+static volatile size_t size_v;
+
+/* Prints bytes per cycle with two decimals */
+static void report(const char *name, size_t size, size_t dst, size_t src, uint64_t cycles)
+{
+	uint64_t centi = (uint64_t)size * ITERATIONS * 100U / MAX(cycles, 1U);
+
+	TC_PRINT("%-7s %4zu bytes dst+%zu src+%zu: %llu.%02llu bytes/cycle\n", name, size, dst, src,
+		 centi / 100U, centi % 100U);
+}
+
+#define BENCH(name, size, dst, src, expr)                                                          \
+	do {                                                                                       \
+		volatile uintptr_t sink;                                                           \
+		uint64_t start = k_cycle_get_64();                                                 \
+                                                                                                   \
+		for (int i = 0; i < ITERATIONS; i++) {                                             \
+			sink = (uintptr_t)(expr);                                                  \
+		}                                                                                  \
+		report(name, size, dst, src, k_cycle_get_64() - start);                            \
+		(void)sink;                                                                        \
+	} while (false)
+
+static void fill(uint8_t *buf, uint8_t seed)
+{
+	for (size_t i = 0; i < BUF_SIZE; i++) {
+		buf[i] = (uint8_t)(i * 131U + seed) | 1U;
+	}
+}
+
+static void check_memcpy(uint8_t *d, const uint8_t *s, size_t n)
+{
+	fill(dst_buf, 7);
+	fill(ref_buf, 7);
+	for (size_t i = 0; i < n; i++) {
+		ref_buf[d - dst_buf + i] = s[i];
+	}
+
+	zassert_equal_ptr(memcpy(d, s, size_v), d);
+	for (size_t i = 0; i < BUF_SIZE; i++) {
+		zassert_equal(dst_buf[i], ref_buf[i], "memcpy of %zu bytes wrong at %d", n,
+			      (int)(i - (d - dst_buf)));
+	}
+}
+
+static void check_memset(uint8_t *d, size_t n)
+{
+	fill(dst_buf, 7);
+	fill(ref_buf, 7);
+	for (size_t i = 0; i < n; i++) {
+		ref_buf[d - dst_buf + i] = 0xa5;
+	}
+
+	zassert_equal_ptr(memset(d, 0xa5, size_v), d);
+	for (size_t i = 0; i < BUF_SIZE; i++) {
+		zassert_equal(dst_buf[i], ref_buf[i], "memset of %zu bytes wrong at %d", n,
+			      (int)(i - (d - dst_buf)));
+	}
+}
+
+static void check_scans(uint8_t *d, const uint8_t *s, size_t n)
+{
+	/* identical blocks, then a difference in the last byte */
+	memcpy(d, s, n);
+	zassert_equal(memcmp(d, s, size_v), 0);
+	d[n - 1] ^= 0x40;
+	zassert_not_equal(memcmp(d, s, size_v), 0, "memcmp missed last byte of %zu", n);
+	d[n - 1] ^= 0x40;
+
+	/* the only zero byte is the last one */
+	d[n - 1] = 0;
+	zassert_equal(strlen((const char *)d), n - 1);
+	zassert_equal_ptr(memchr(d, 0, size_v), &d[n - 1]);
+	zassert_is_null(memchr(d, 0, n - 1));
+}
+
+ZTEST(string_ops_benchmark, test_throughput)
+{
+	fill(src_buf, 3);
+
+	for (size_t a = 0; a < ARRAY_SIZE(aligns); a++) {
+		uint8_t *d = &dst_buf[32 + aligns[a].dst];
+		const uint8_t *s = &src_buf[32 + aligns[a].src];
+
+		for (size_t i = 0; i < ARRAY_SIZE(sizes); i++) {
+			size_t n = sizes[i];
+
+			size_v = n;
+			check_memcpy(d, s, n);
+			check_memset(d, n);
+			check_scans(d, s, n);
+
+			BENCH("memcpy", n, aligns[a].dst, aligns[a].src, memcpy(d, s, size_v));
+			BENCH("memset", n, aligns[a].dst, aligns[a].src, memset(d, 0, size_v));
+
+			memcpy(d, s, n);
+			BENCH("memcmp", n, aligns[a].dst, aligns[a].src, memcmp(d, s, size_v));
+
+			d[n - 1] = 0;
+			BENCH("strlen", n, aligns[a].dst, aligns[a].src, strlen((const char *)d));
+			BENCH("memchr", n, aligns[a].dst, aligns[a].src, memchr(d, 0, size_v));
+		}
+	}
+}
+
+ZTEST_SUITE(string_ops_benchmark, NULL, NULL, NULL, NULL, NULL);
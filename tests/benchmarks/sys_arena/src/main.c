@@ -0,0 +1,113 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Cost of the allocations made while handling a request, in CPU cycles
+ * per request: a number of small buffers of varying sizes are allocated,
+ * written and then all freed, with malloc(), a k_heap and a sys_arena
+ * working from a static buffer or from chunks of a k_heap.
+ */
+
+#include <stdlib.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/sys/arena.h>
+
+#define REQUESTS     64
+#define ALLOCS       32
+#define ARENA_SIZE   2048
+#define CHUNK_SIZE   512
+
+/* Sizes of the buffers of one request, e.g. tokens of a parsed message */
+static const uint16_t sizes[ALLOCS] = {
+	12, 40, 7,  64, 24, 3,  16, 33, 8,  48, 5,  20, 60, 9,  28, 14,
+	36, 4,  52, 18, 11, 44, 6,  30, 22, 58, 10, 26, 2,  38, 15, 32,
+};
+
+K_HEAP_DEFINE(bench_heap, 4096);
+SYS_ARENA_DEFINE(bench_arena, ARENA_SIZE);
+
+static void *ptrs[ALLOCS];
+
+static void report(const char *name, uint64_t cycles)
+{
+	TC_PRINT("%-20s: %llu cycles/request\n", name, (unsigned long long)(cycles / REQUESTS));
+}
+
+ZTEST(sys_arena_bench, test_malloc)
+{
+	uint64_t start = k_cycle_get_64();
+
+	for (int r = 0; r < REQUESTS; r++) {
+		for (int i = 0; i < ALLOCS; i++) {
+			ptrs[i] = malloc(sizes[i]);
+			zassert_not_null(ptrs[i]);
+			memset(ptrs[i], i, sizes[i]);
+		}
+		for (int i = 0; i < ALLOCS; i++) {
+			free(ptrs[i]);
+		}
+	}
+
+	report("malloc/free", k_cycle_get_64() - start);
+}
+
+ZTEST(sys_arena_bench, test_k_heap)
+{
+	uint64_t start = k_cycle_get_64();
+
+	for (int r = 0; r < REQUESTS; r++) {
+		for (int i = 0; i < ALLOCS; i++) {
+			ptrs[i] = k_heap_alloc(&bench_heap, sizes[i], K_NO_WAIT);
+			zassert_not_null(ptrs[i]);
+			memset(ptrs[i], i, sizes[i]);
+		}
+		for (int i = 0; i < ALLOCS; i++) {
+			k_heap_free(&bench_heap, ptrs[i]);
+		}
+	}
+
+	report("k_heap", k_cycle_get_64() - start);
+}
+
+ZTEST(sys_arena_bench, test_arena)
+{
+	uint64_t start = k_cycle_get_64();
+
+	for (int r = 0; r < REQUESTS; r++) {
+		for (int i = 0; i < ALLOCS; i++) {
+			ptrs[i] = sys_arena_alloc(&bench_arena, sizes[i]);
+			zassert_not_null(ptrs[i]);
+			memset(ptrs[i], i, sizes[i]);
+		}
+		sys_arena_reset(&bench_arena);
+	}
+
+	report("sys_arena", k_cycle_get_64() - start);
+}
+
+ZTEST(sys_arena_bench, test_arena_chained)
+{
+	struct sys_arena arena;
+	uint64_t start;
+
+	/* no initial buffer, so every request takes chunks from the heap */
+	sys_arena_init(&arena, NULL, 0, &bench_heap, CHUNK_SIZE);
+
+	start = k_cycle_get_64();
+	for (int r = 0; r < REQUESTS; r++) {
+		for (int i = 0; i < ALLOCS; i++) {
+			ptrs[i] = sys_arena_alloc(&arena, sizes[i]);
+			zassert_not_null(ptrs[i]);
+			memset(ptrs[i], i, sizes[i]);
+		}
+		sys_arena_reset(&arena);
+	}
+
+	report("sys_arena (chained)", k_cycle_get_64() - start);
+}
+
+ZTEST_SUITE(sys_arena_bench, NULL, NULL, NULL, NULL, NULL);
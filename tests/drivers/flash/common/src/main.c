@@ -10,6 +10,10 @@
 #include <zephyr/devicetree.h>
 #include <zephyr/storage/flash_map.h>
 #include <zephyr/drivers/gpio.h>
+#if defined(CONFIG_FLASH_RTIO)
+#include <zephyr/drivers/flash/rtio.h>
+#include <zephyr/rtio/rtio.h>
+#endif
 
 #if defined(CONFIG_TEST_FORCE_STORAGE_PARTITION)
 #define TEST_AREA	storage_partition
@@ -545,4 +549,54 @@ ZTEST(flash_driver, test_flash_copy)
 			      page_info.size - (page_info.size / 4), buf, sizeof(buf), -EINVAL);
 }
 
+#if defined(CONFIG_FLASH_RTIO)
+RTIO_DEFINE(flash_rtio_ctx, 4, 4);
+RTIO_IODEV_DEFINE(flash_iodev, &flash_iodev_api, (void *)TEST_AREA_DEVICE);
+
+ZTEST(flash_driver, test_flash_rtio)
+{
+	uint8_t read_buf[EXPECTED_SIZE];
+	struct rtio_sqe *sqe;
+	struct rtio_cqe *cqe;
+	uint32_t count = 0;
+	int rc;
+
+	/* Queue erase, write and read back as one chain */
+	if (ebw_required) {
+		sqe = rtio_sqe_acquire(&flash_rtio_ctx);
+		zassert_not_null(sqe);
+		rtio_sqe_prep_storage_erase(sqe, &flash_iodev, RTIO_PRIO_NORM,
+					    page_info.start_offset,
+					    page_info.size * DIV_ROUND_UP(EXPECTED_SIZE, page_info.size),
+					    NULL);
+		sqe->flags |= RTIO_SQE_CHAINED;
+		count++;
+	}
+
+	sqe = rtio_sqe_acquire(&flash_rtio_ctx);
+	zassert_not_null(sqe);
+	rtio_sqe_prep_storage_write(sqe, &flash_iodev, RTIO_PRIO_NORM, page_info.start_offset,
+				    expected, EXPECTED_SIZE, NULL);
+	sqe->flags |= RTIO_SQE_CHAINED;
+	count++;
+
+	sqe = rtio_sqe_acquire(&flash_rtio_ctx);
+	zassert_not_null(sqe);
+	rtio_sqe_prep_storage_read(sqe, &flash_iodev, RTIO_PRIO_NORM, page_info.start_offset,
+				   read_buf, EXPECTED_SIZE, read_buf);
+	count++;
+
+	rc = rtio_submit(&flash_rtio_ctx, count);
+	zassert_equal(rc, 0, "Cannot submit flash operations");
+
+	while (count-- > 0) {
+		cqe = rtio_cqe_consume_block(&flash_rtio_ctx);
+		zassert_equal(cqe->result, 0, "Flash operation failed");
+		rtio_cqe_release(&flash_rtio_ctx, cqe);
+	}
+
+	zassert_mem_equal(read_buf, expected, EXPECTED_SIZE, "Read back data differs");
+}
+#endif /* CONFIG_FLASH_RTIO */
+
 ZTEST_SUITE(flash_driver, NULL, NULL, flash_driver_before, NULL, NULL);
@@ -543,6 +543,84 @@ ZTEST(bitarray, test_bitarray_alloc_free)
 	alloc_and_free_interval();
 }
 
+/**
+ * @brief Test allocation and free of scattered bits
+ *
+ * @see sys_bitarray_alloc_bits()
+ * @see sys_bitarray_free_bits()
+ */
+ZTEST(bitarray, test_bitarray_alloc_free_bits)
+{
+	size_t offsets[40];
+	size_t expected;
+	int ret;
+
+	/* Bitarrays have embedded spinlocks and can't on the stack. */
+	if (IS_ENABLED(CONFIG_KERNEL_COHERENCE)) {
+		ztest_test_skip();
+	}
+
+	/* Not a multiple of 32 so the last bundle has padding bits */
+	SYS_BITARRAY_DEFINE(ba, 72);
+
+	/* Every other bit is taken, the second bundle is full */
+	ba.bundles[0] = 0x55555555;
+	ba.bundles[1] = 0xFFFFFFFF;
+
+	ret = sys_bitarray_alloc_bits(&ba, 0, offsets);
+	zassert_equal(ret, -EINVAL, "sys_bitarray_alloc_bits() should fail with 0 bits");
+
+	ret = sys_bitarray_alloc_bits(&ba, 73, offsets);
+	zassert_equal(ret, -EINVAL, "sys_bitarray_alloc_bits() should fail with 73 bits");
+
+	/* 16 free bits in the first bundle and 8 in the last one */
+	ret = sys_bitarray_alloc_bits(&ba, 25, offsets);
+	zassert_equal(ret, -ENOSPC, "sys_bitarray_alloc_bits() should fail (%d)", ret);
+	zassert_equal(ba.bundles[0], 0x55555555, "bits allocated on failure");
+	zassert_equal(ba.bundles[2], 0, "bits allocated on failure");
+
+	ret = sys_bitarray_alloc_bits(&ba, 20, offsets);
+	zassert_equal(ret, 0, "sys_bitarray_alloc_bits() failed (%d)", ret);
+
+	for (size_t i = 0; i < 20; i++) {
+		expected = (i < 16) ? (i * 2 + 1) : (64 + i - 16);
+		zassert_equal(offsets[i], expected, "offset %zu expected %zu, got %zu",
+			      i, expected, offsets[i]);
+	}
+	zassert_equal(ba.bundles[0], 0xFFFFFFFF, "bundle 0 not fully allocated");
+	zassert_equal(ba.bundles[2], 0x0F, "bundle 2 expected 0x0F, got 0x%x", ba.bundles[2]);
+
+	/* A bit listed twice must not be freed twice */
+	offsets[1] = offsets[0];
+	ret = sys_bitarray_free_bits(&ba, 2, offsets);
+	zassert_equal(ret, -EFAULT, "sys_bitarray_free_bits() should fail (%d)", ret);
+	zassert_equal(ba.bundles[0], 0xFFFFFFFF, "bits freed on failure");
+
+	offsets[0] = 72;
+	ret = sys_bitarray_free_bits(&ba, 1, offsets);
+	zassert_equal(ret, -EINVAL, "sys_bitarray_free_bits() should fail (%d)", ret);
+
+	offsets[0] = 1;
+	offsets[1] = 64;
+	offsets[2] = 34;
+	ret = sys_bitarray_free_bits(&ba, 3, offsets);
+	zassert_equal(ret, 0, "sys_bitarray_free_bits() failed (%d)", ret);
+	zassert_equal(ba.bundles[0], 0xFFFFFFFD, "bundle 0 got 0x%x", ba.bundles[0]);
+	zassert_equal(ba.bundles[1], 0xFFFFFFFB, "bundle 1 got 0x%x", ba.bundles[1]);
+	zassert_equal(ba.bundles[2], 0x0E, "bundle 2 got 0x%x", ba.bundles[2]);
+
+	/* Freed bits are found again, in increasing order */
+	ret = sys_bitarray_alloc_bits(&ba, 7, offsets);
+	zassert_equal(ret, 0, "sys_bitarray_alloc_bits() failed (%d)", ret);
+	zassert_equal(offsets[0], 1, "got %zu", offsets[0]);
+	zassert_equal(offsets[1], 34, "got %zu", offsets[1]);
+	zassert_equal(offsets[2], 64, "got %zu", offsets[2]);
+	zassert_equal(offsets[6], 71, "got %zu", offsets[6]);
+
+	ret = sys_bitarray_alloc_bits(&ba, 1, offsets);
+	zassert_equal(ret, -ENOSPC, "sys_bitarray_alloc_bits() should fail (%d)", ret);
+}
+
 ZTEST(bitarray, test_bitarray_popcount_region)
 {
 	int ret;
@@ -15,6 +15,8 @@ K_SEM_DEFINE(SEM_HELPERDONE, 0, 1);
 K_SEM_DEFINE(SEM_REGRESSDONE, 0, 1);
 static K_THREAD_STACK_DEFINE(stack, STACKSIZE);
 static struct k_thread HELPER;
+static K_THREAD_STACK_DEFINE(waiter_stack, STACKSIZE);
+static struct k_thread waiter;
 
 void *mslab_setup(void)
 {
@@ -289,6 +291,115 @@ ZTEST(mslab_api, test_mslab_used_get)
 	tmslab_used_get(&kmslab);
 }
 
+/**
+ * @brief Verify bulk allocation and free of memory blocks
+ *
+ * @details A bulk allocation either gets all blocks or none, and
+ * blocks freed in bulk can be allocated again one by one.
+ *
+ * @ingroup kernel_memory_slab_tests
+ *
+ * @see k_mem_slab_alloc_bulk(), k_mem_slab_free_bulk()
+ */
+ZTEST(mslab_api, test_mslab_alloc_free_bulk)
+{
+	void *blocks[BLK_NUM + 1];
+	void *b;
+
+	zassert_equal(k_mem_slab_alloc_bulk(&kmslab, blocks, BLK_NUM + 1), -ENOMEM);
+	zassert_equal(k_mem_slab_num_used_get(&kmslab), 0);
+
+	zassert_ok(k_mem_slab_alloc_bulk(&kmslab, blocks, BLK_NUM));
+	zassert_equal(k_mem_slab_num_used_get(&kmslab), BLK_NUM);
+	zassert_equal(k_mem_slab_num_free_get(&kmslab), 0);
+	for (int i = 0; i < BLK_NUM; i++) {
+		zassert_not_null(blocks[i]);
+		for (int j = 0; j < i; j++) {
+			zassert_not_equal(blocks[i], blocks[j], "block handed out twice");
+		}
+	}
+
+	zassert_equal(k_mem_slab_alloc_bulk(&kmslab, &b, 1), -ENOMEM);
+	zassert_ok(k_mem_slab_alloc_bulk(&kmslab, &b, 0));
+
+	k_mem_slab_free_bulk(&kmslab, blocks, BLK_NUM);
+	zassert_equal(k_mem_slab_num_used_get(&kmslab), 0);
+
+	for (int i = 0; i < BLK_NUM; i++) {
+		zassert_ok(k_mem_slab_alloc(&kmslab, &blocks[i], K_NO_WAIT));
+	}
+	k_mem_slab_free_bulk(&kmslab, blocks, BLK_NUM);
+	zassert_equal(k_mem_slab_num_free_get(&kmslab), BLK_NUM);
+}
+
+static void *waiter_blocks[2];
+
+static void bulk_waiter(void *p1, void *p2, void *p3)
+{
+	void **blk = p1;
+
+	zassert_ok(k_mem_slab_alloc(&kmslab, blk, K_FOREVER));
+}
+
+/**
+ * @brief Verify bulk free hands blocks to pending allocators
+ *
+ * @details Threads pending on an empty slab get blocks from the freed
+ * array first, the rest goes back to the free list, and the waiters
+ * run before k_mem_slab_free_bulk() returns.
+ *
+ * @ingroup kernel_memory_slab_tests
+ *
+ * @see k_mem_slab_free_bulk()
+ */
+ZTEST(mslab_api, test_mslab_free_bulk_pending)
+{
+	if (!IS_ENABLED(CONFIG_MULTITHREADING)) {
+		ztest_test_skip();
+		return;
+	}
+
+	void *blocks[BLK_NUM];
+	int prio = k_thread_priority_get(k_current_get());
+
+	zassert_ok(k_mem_slab_alloc_bulk(&kmslab, blocks, BLK_NUM));
+
+	/* The waiters preempt this thread and pend on the empty slab */
+	k_thread_priority_set(k_current_get(), K_PRIO_PREEMPT(2));
+	waiter_blocks[0] = NULL;
+	waiter_blocks[1] = NULL;
+	(void)k_thread_create(&HELPER, stack, STACKSIZE,
+			      bulk_waiter, &waiter_blocks[0], NULL, NULL,
+			      K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	(void)k_thread_create(&waiter, waiter_stack, STACKSIZE,
+			      bulk_waiter, &waiter_blocks[1], NULL, NULL,
+			      K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	zassert_is_null(waiter_blocks[0]);
+	zassert_is_null(waiter_blocks[1]);
+
+	k_mem_slab_free_bulk(&kmslab, blocks, BLK_NUM);
+
+	/* Both waiters ran on the reschedule in k_mem_slab_free_bulk() */
+	for (int i = 0; i < 2; i++) {
+		bool found = false;
+
+		for (int j = 0; j < BLK_NUM; j++) {
+			found = found || waiter_blocks[i] == blocks[j];
+		}
+		zassert_true(found, "waiter %d got no block from the freed array", i);
+	}
+	zassert_not_equal(waiter_blocks[0], waiter_blocks[1], "block handed out twice");
+	zassert_equal(k_mem_slab_num_used_get(&kmslab), 2);
+	zassert_equal(k_mem_slab_num_free_get(&kmslab), BLK_NUM - 2);
+
+	k_thread_join(&HELPER, K_FOREVER);
+	k_thread_join(&waiter, K_FOREVER);
+	k_thread_priority_set(k_current_get(), prio);
+
+	k_mem_slab_free_bulk(&kmslab, waiter_blocks, 2);
+	zassert_equal(k_mem_slab_num_free_get(&kmslab), BLK_NUM);
+}
+
 /**
  * @brief Verify pending of allocating blocks
  *
@@ -0,0 +1,171 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <zephyr/types.h>
+
+#if __has_include(<memory_resource>)
+#include <map>
+#include <string>
+#include <zephyr/cpp/memory_resource.hpp>
+
+K_HEAP_DEFINE(test_k_heap, 4096);
+
+static bool is_aligned(const void *ptr, std::size_t align)
+{
+	return (reinterpret_cast<std::uintptr_t>(ptr) & (align - 1)) == 0;
+}
+
+ZTEST(libcxx_memory_resource, test_k_heap_resource)
+{
+	zephyr::pmr::k_heap_resource res(&test_k_heap);
+	zephyr::pmr::k_heap_resource other(&test_k_heap);
+
+	zassert_true(res.is_equal(res));
+	zassert_false(res.is_equal(other));
+
+	void *p = res.allocate(100, 64);
+
+	zassert_not_null(p);
+	zassert_true(is_aligned(p, 64));
+	res.deallocate(p, 100, 64);
+
+	{
+		std::pmr::map<int, std::pmr::string> map(&res);
+
+		for (int i = 0; i < 16; i++) {
+			map.emplace(i, "a string long enough to need an allocation");
+		}
+		zassert_equal(map.size(), 16);
+		zassert_equal(map.at(7).get_allocator().resource(), &res);
+	}
+
+#if defined(__cpp_exceptions)
+	bool thrown = false;
+
+	try {
+		(void)res.allocate(8192);
+	} catch (const std::bad_alloc &) {
+		thrown = true;
+	}
+	zassert_true(thrown, "heap exhaustion not reported");
+#endif
+}
+
+ZTEST(libcxx_memory_resource, test_sys_heap_resource)
+{
+	alignas(8) static uint8_t heap_mem[2048];
+	struct sys_heap heap;
+
+	sys_heap_init(&heap, heap_mem, sizeof(heap_mem));
+
+	zephyr::pmr::sys_heap_resource res(&heap);
+	std::pmr::vector<uint32_t> vec(&res);
+
+	for (uint32_t i = 0; i < 100; i++) {
+		vec.push_back(i);
+	}
+	zassert_equal(vec.size(), 100);
+	zassert_equal(vec[99], 99);
+	zassert_true((const uint8_t *)vec.data() >= heap_mem &&
+		     (const uint8_t *)vec.data() < heap_mem + sizeof(heap_mem),
+		     "vector storage not on the heap");
+}
+
+ZTEST(libcxx_memory_resource, test_arena_resource)
+{
+	zephyr::pmr::arena_resource<512> arena;
+	void *prev = nullptr;
+
+	/* allocations are carved out of the buffer in order */
+	for (int i = 0; i < 4; i++) {
+		void *p = arena.allocate(24, 8);
+
+		zassert_true(is_aligned(p, 8));
+		zassert_true(prev == nullptr || p != prev);
+		prev = p;
+	}
+
+	arena.release();
+
+	std::pmr::vector<int> vec(&arena);
+
+	vec.reserve(64);
+	zassert_equal(vec.capacity(), 64);
+
+#if defined(__cpp_exceptions)
+	bool thrown = false;
+
+	try {
+		(void)arena.allocate(1024);
+	} catch (const std::bad_alloc &) {
+		thrown = true;
+	}
+	zassert_true(thrown, "arena fell back to another resource");
+#endif
+}
+
+#endif /* __has_include(<memory_resource>) */
+
+#ifdef CONFIG_CPP_NEW_POOLS
+extern "C" struct k_mem_slab z_cpp_new_slab_16;
+#endif
+
+ZTEST(libcxx_memory_resource, test_new_size_classes)
+{
+	std::vector<std::unique_ptr<uint8_t[]>> ptrs;
+#ifdef CONFIG_CPP_NEW_POOLS
+	uint32_t used = k_mem_slab_num_used_get(&z_cpp_new_slab_16);
+	auto small = std::make_unique<uint8_t[]>(16);
+	const char *buf = z_cpp_new_slab_16.buffer;
+	const char *p = reinterpret_cast<const char *>(small.get());
+
+	zassert_true(p >= buf && p < buf + CONFIG_CPP_NEW_POOL_BLOCKS * 16,
+		     "16 byte object not allocated from its pool");
+	zassert_equal(k_mem_slab_num_used_get(&z_cpp_new_slab_16), used + 1);
+	small.reset();
+	zassert_equal(k_mem_slab_num_used_get(&z_cpp_new_slab_16), used);
+#endif
+
+	/* more objects of each size than a CONFIG_CPP_NEW_POOLS size class
+	 * holds, so both the pools and the heap fallback are exercised
+	 */
+	for (std::size_t size = 1; size <= 2048; size *= 2) {
+		for (int i = 0; i < 40; i++) {
+			auto p = std::make_unique<uint8_t[]>(size);
+
+			zassert_not_null(p.get());
+			zassert_true((reinterpret_cast<std::uintptr_t>(p.get()) &
+				      (__alignof__(z_max_align_t) - 1)) == 0);
+			memset(p.get(), (int)size, size);
+			ptrs.push_back(std::move(p));
+		}
+	}
+
+	for (std::size_t i = 0, size = 1; size <= 2048; size *= 2) {
+		for (int j = 0; j < 40; j++, i++) {
+			zassert_equal(ptrs[i][size - 1], (uint8_t)size);
+		}
+	}
+
+#ifdef CONFIG_CPP_NEW_POOLS
+	zassert_equal(k_mem_slab_num_free_get(&z_cpp_new_slab_16), 0,
+		      "smallest size class was not used up");
+#endif
+
+	ptrs.clear();
+
+#ifdef CONFIG_CPP_NEW_POOLS
+	zassert_equal(k_mem_slab_num_used_get(&z_cpp_new_slab_16), used,
+		      "pool blocks were not freed");
+#endif
+}
+
+ZTEST_SUITE(libcxx_memory_resource, NULL, NULL, NULL, NULL, NULL);
@@ -604,6 +604,29 @@ ZTEST(lib_json_test, test_json_decoding)
 			  "String buffer in second object array element not decoded correctly");
 }
 
+ZTEST(lib_json_test, test_json_decoding_field_order)
+{
+	struct escape_test_data data = { 0 };
+	char encoded[] = "{\"integer_value\":7,"
+		"\"string_buf\":\"second\","
+		"\"unknown\":[1,2],"
+		"\"integer_value\":8,"
+		"\"string_value\":\"first\"}";
+	int64_t ret;
+
+	ret = json_obj_parse(encoded, sizeof(encoded) - 1, escape_test_descr,
+			     ARRAY_SIZE(escape_test_descr), &data);
+
+	zassert_equal(ret, (1 << ARRAY_SIZE(escape_test_descr)) - 1,
+		      "Not all out-of-order fields decoded");
+	zassert_str_equal(data.string_value, "first",
+			  "Wrapped-around field not decoded correctly");
+	zassert_str_equal(data.string_buf, "second",
+			  "Out-of-order field not decoded correctly");
+	zassert_equal(data.integer_value, 7,
+		      "Duplicate field must not overwrite the first value");
+}
+
 ZTEST(lib_json_test, test_json_limits)
 {
 	int ret = 0;
@@ -2494,6 +2517,80 @@ ZTEST(lib_json_test, test_json_escape_encoding_correctness)
 	zassert_is_null(strchr(buffer, '\t'), "Raw tab found in encoded JSON");
 }
 
+/**
+ * @brief Test escaping of strings where plain runs and escapes alternate
+ *
+ * Escapes at the start and at the end of the string, next to each other and
+ * between runs of plain characters must all come out in order.
+ */
+ZTEST(lib_json_test, test_json_escape_runs)
+{
+	struct escape_test_data test_data = {
+		.string_value = "\"plain run\\\n\tmore plain text\bx\"",
+		.string_buf = "\r",
+		.integer_value = 7,
+	};
+	const char *expected = "{\"string_value\":"
+			       "\"\\\"plain run\\\\\\n\\tmore plain text\\bx\\\"\","
+			       "\"string_buf\":\"\\r\","
+			       "\"integer_value\":7}";
+	struct escape_test_data decoded = {0};
+	char buffer[256];
+	int ret;
+
+	ret = json_obj_encode_buf(escape_test_descr, ARRAY_SIZE(escape_test_descr), &test_data,
+				  buffer, sizeof(buffer));
+	zassert_equal(ret, 0, "Encoding failed");
+	zassert_str_equal(buffer, expected, "Encoded value is not correct");
+	zassert_equal(json_calc_encoded_len(escape_test_descr, ARRAY_SIZE(escape_test_descr),
+					    &test_data),
+		      (ssize_t)strlen(expected), "Length mismatch");
+
+	ret = json_obj_parse(buffer, strlen(buffer), escape_test_descr,
+			     ARRAY_SIZE(escape_test_descr), &decoded);
+	zassert_equal(ret, (1 << ARRAY_SIZE(escape_test_descr)) - 1, "Decoding failed");
+	zassert_str_equal(decoded.string_value, test_data.string_value,
+			  "String value changed after decode");
+	zassert_str_equal(decoded.string_buf, test_data.string_buf,
+			  "String buffer changed after decode");
+}
+
+/**
+ * @brief Test unescaping of strings where plain runs and escapes alternate
+ */
+ZTEST(lib_json_test, test_json_unescape_runs)
+{
+	char encoded[] = "{\"string_value\":"
+			 "\"\\/start\\\"quoted run\\\" \\u0041 tail\\\\\","
+			 "\"string_buf\":\"\\n\\t\","
+			 "\"integer_value\":1}";
+	struct escape_test_data decoded = {0};
+	int ret;
+
+	ret = json_obj_parse(encoded, sizeof(encoded) - 1, escape_test_descr,
+			     ARRAY_SIZE(escape_test_descr), &decoded);
+	zassert_equal(ret, (1 << ARRAY_SIZE(escape_test_descr)) - 1, "Decoding failed");
+	/* Unicode escapes are kept as they are */
+	zassert_str_equal(decoded.string_value, "/start\"quoted run\" \\u0041 tail\\",
+			  "String value is not correct");
+	zassert_str_equal(decoded.string_buf, "\n\t", "String buffer is not correct");
+}
+
+/**
+ * @brief Test that a string running up to the end of the input is rejected
+ */
+ZTEST(lib_json_test, test_json_string_run_bounds)
+{
+	char encoded[] = "{\"string_value\":\"a plain run that is cut\"}";
+	struct escape_test_data decoded = {0};
+	int ret;
+
+	/* The closing quote and brace are outside of the parsed length */
+	ret = json_obj_parse(encoded, sizeof(encoded) - 3, escape_test_descr,
+			     ARRAY_SIZE(escape_test_descr), &decoded);
+	zassert_true(ret < 0, "Unterminated string was accepted");
+}
+
 /**
  * @brief Test multiple encode/decode cycles to catch gradual corruption
  */
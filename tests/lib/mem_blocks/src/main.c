@@ -21,6 +21,10 @@ SYS_MEM_BLOCKS_DEFINE_STATIC_WITH_EXT_BUF(mem_block_02,
 					  BLK_SZ, NUM_BLOCKS,
 					  mem_block_02_buf);
 
+/* Spans several batches of sys_mem_blocks_alloc() and sys_mem_blocks_free() */
+#define NUM_BULK_BLOCKS 40
+SYS_MEM_BLOCKS_DEFINE_STATIC(mem_block_03, 16, NUM_BULK_BLOCKS, 4);
+
 static sys_multi_mem_blocks_t alloc_group;
 
 static ZTEST_DMEM volatile int expected_reason = -1;
@@ -631,6 +635,53 @@ ZTEST(lib_mem_block, test_multi_mem_block_alloc_free)
 		      "sys_multi_mem_blocks_free failed (%d)", ret);
 }
 
+ZTEST(lib_mem_block, test_mem_block_alloc_free_bulk)
+{
+	void *blocks[NUM_BULK_BLOCKS + 1];
+	void *ptr;
+	int ret;
+
+	ret = sys_mem_blocks_alloc(&mem_block_03, NUM_BULK_BLOCKS - 1, blocks);
+	zassert_equal(ret, 0, "sys_mem_blocks_alloc failed (%d)", ret);
+
+	/* Not enough blocks left, the whole allocation must be undone */
+	ret = sys_mem_blocks_alloc(&mem_block_03, 2, &blocks[NUM_BULK_BLOCKS - 1]);
+	zassert_equal(ret, -ENOMEM,
+		      "sys_mem_blocks_alloc should fail with -ENOMEM but not");
+	zassert_true(sys_mem_blocks_is_region_free(&mem_block_03,
+						   mem_block_03.buffer + 16 * (NUM_BULK_BLOCKS - 1),
+						   1),
+		     "failed allocation was not undone");
+
+	ret = sys_mem_blocks_alloc(&mem_block_03, 1, &blocks[NUM_BULK_BLOCKS - 1]);
+	zassert_equal(ret, 0, "sys_mem_blocks_alloc failed (%d)", ret);
+
+	for (int i = 0; i < NUM_BULK_BLOCKS; i++) {
+		zassert_true(check_buffer_bound(&mem_block_03, blocks[i]),
+			     "allocated memory is out of bound");
+		zassert_equal(blocks[i], mem_block_03.buffer + 16 * i,
+			      "block %d is %p", i, blocks[i]);
+	}
+
+	/* Invalid pointers fail but do not keep the valid ones from being freed */
+	ptr = blocks[20];
+	blocks[20] = mem_block_03.buffer + 16 * NUM_BULK_BLOCKS;
+	ret = sys_mem_blocks_free(&mem_block_03, NUM_BULK_BLOCKS, blocks);
+	zassert_equal(ret, -EFAULT,
+		      "sys_mem_blocks_free should fail with -EFAULT but not");
+
+	ret = sys_mem_blocks_free(&mem_block_03, 1, blocks);
+	zassert_equal(ret, -EFAULT,
+		      "sys_mem_blocks_free should fail with -EFAULT but not");
+
+	ret = sys_mem_blocks_free(&mem_block_03, 1, &ptr);
+	zassert_equal(ret, 0, "sys_mem_blocks_free failed (%d)", ret);
+
+	zassert_true(sys_mem_blocks_is_region_free(&mem_block_03, mem_block_03.buffer,
+						   NUM_BULK_BLOCKS),
+		     "not all blocks were freed");
+}
+
 ZTEST(lib_mem_block, test_mem_block_invalid_params_panic_1)
 {
 	void *blocks[2] = {0};
@@ -0,0 +1,119 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/min_heap.h>
+#include <zephyr/ztest.h>
+
+#define N_TIMERS 32
+
+/* Heap elements point to the timers, which keep track of their index */
+struct timer {
+	uint32_t deadline;
+	size_t heap_index;
+};
+
+static struct timer timers[N_TIMERS];
+
+static int cmp_timer(const void *a, const void *b)
+{
+	const struct timer *ta = *(struct timer *const *)a;
+	const struct timer *tb = *(struct timer *const *)b;
+
+	return (ta->deadline > tb->deadline) - (ta->deadline < tb->deadline);
+}
+
+static void index_timer(void *elem, size_t index)
+{
+	(*(struct timer **)elem)->heap_index = index;
+}
+
+MIN_HEAP_DEFINE_STATIC(timer_heap, N_TIMERS, sizeof(struct timer *), __alignof__(struct timer *),
+		       cmp_timer);
+
+static void check_indexes(void)
+{
+	struct timer **elem;
+
+	MIN_HEAP_FOREACH(&timer_heap, elem) {
+		zassert_equal_ptr(min_heap_get_element(&timer_heap, (*elem)->heap_index), elem,
+				  "stale index for deadline %u", (*elem)->deadline);
+	}
+}
+
+static void push_timer(struct timer *t, uint32_t deadline)
+{
+	t->deadline = deadline;
+	zassert_ok(min_heap_push(&timer_heap, &t));
+	zassert_not_equal(t->heap_index, MIN_HEAP_INDEX_NONE);
+}
+
+static void check_pop_order(void)
+{
+	struct timer *t;
+	uint32_t prev = 0;
+
+	while (min_heap_pop(&timer_heap, &t)) {
+		zassert_true(t->deadline >= prev, "pop order violated");
+		zassert_equal(t->heap_index, MIN_HEAP_INDEX_NONE);
+		prev = t->deadline;
+		check_indexes();
+	}
+}
+
+static void *min_heap_index_setup(void)
+{
+	min_heap_set_index_cb(&timer_heap, index_timer);
+
+	return NULL;
+}
+
+static void min_heap_index_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	for (int i = 0; i < N_TIMERS; i++) {
+		push_timer(&timers[i], (i * 7919U) % 1000U + 1U);
+	}
+	check_indexes();
+}
+
+ZTEST(min_heap_index, test_remove_by_index)
+{
+	struct timer *removed;
+
+	/* remove every third timer through its tracked index */
+	for (int i = 0; i < N_TIMERS; i += 3) {
+		zassert_true(min_heap_remove(&timer_heap, timers[i].heap_index, &removed));
+		zassert_equal_ptr(removed, &timers[i]);
+		zassert_equal(timers[i].heap_index, MIN_HEAP_INDEX_NONE);
+		check_indexes();
+	}
+
+	check_pop_order();
+}
+
+ZTEST(min_heap_index, test_update)
+{
+	struct timer **top;
+
+	/* move some deadlines earlier and some later */
+	for (int i = 0; i < N_TIMERS; i++) {
+		timers[i].deadline = (i % 2) ? timers[i].deadline / 2 : timers[i].deadline * 3;
+		zassert_true(min_heap_update(&timer_heap, timers[i].heap_index));
+		check_indexes();
+	}
+
+	timers[N_TIMERS / 2].deadline = 0;
+	zassert_true(min_heap_update(&timer_heap, timers[N_TIMERS / 2].heap_index));
+	top = min_heap_peek(&timer_heap);
+	zassert_equal_ptr(*top, &timers[N_TIMERS / 2]);
+	zassert_false(min_heap_update(&timer_heap, N_TIMERS));
+
+	check_pop_order();
+}
+
+ZTEST_SUITE(min_heap_index, NULL, min_heap_index_setup, min_heap_index_before, NULL, NULL);
@@ -0,0 +1,152 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/radix_heap.h>
+#include <zephyr/ztest.h>
+
+#define N_NODES 64
+
+struct deadline {
+	struct radix_heap_node node;
+	bool queued;
+};
+
+static struct deadline deadlines[N_NODES];
+static struct radix_heap heap;
+
+static uint32_t next_rand(void)
+{
+	static uint32_t state = 0x2545f491;
+
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+
+	return state;
+}
+
+ZTEST(radix_heap, test_empty)
+{
+	radix_heap_init(&heap, 0);
+
+	zassert_true(radix_heap_is_empty(&heap));
+	zassert_is_null(radix_heap_peek(&heap));
+	zassert_is_null(radix_heap_pop(&heap));
+}
+
+ZTEST(radix_heap, test_pop_order)
+{
+	const uint64_t start = UINT32_MAX - 100U;
+	struct radix_heap_node *n;
+	uint64_t prev;
+
+	/* cross a 32-bit roll-over, as tick deadlines do */
+	radix_heap_init(&heap, start);
+	for (int i = 0; i < N_NODES; i++) {
+		radix_heap_push(&heap, &deadlines[i].node, start + (i * 37) % 200);
+	}
+	zassert_equal(radix_heap_size(&heap), N_NODES);
+
+	prev = radix_heap_last(&heap);
+	while ((n = radix_heap_pop(&heap)) != NULL) {
+		zassert_true(radix_heap_node_key(n) >= prev, "pop order violated");
+		zassert_equal(radix_heap_last(&heap), radix_heap_node_key(n));
+		prev = radix_heap_node_key(n);
+	}
+	zassert_true(radix_heap_is_empty(&heap));
+}
+
+/* Peeking at the next expiry must not stop an earlier timeout from being
+ * queued after it.
+ */
+ZTEST(radix_heap, test_push_after_peek)
+{
+	struct radix_heap_node *a = &deadlines[0].node;
+	struct radix_heap_node *b = &deadlines[1].node;
+	struct radix_heap_node *c = &deadlines[2].node;
+
+	radix_heap_init(&heap, 0);
+	radix_heap_push(&heap, a, 1000);
+	radix_heap_push(&heap, b, 1200);
+
+	zassert_equal_ptr(radix_heap_peek(&heap), a);
+	zassert_equal(radix_heap_last(&heap), 0);
+
+	radix_heap_push(&heap, c, 10);
+	zassert_equal_ptr(radix_heap_peek(&heap), c);
+
+	zassert_equal_ptr(radix_heap_pop(&heap), c);
+	zassert_equal(radix_heap_last(&heap), 10);
+
+	/* Again once a pop has moved the lowest key that can be pushed */
+	zassert_equal_ptr(radix_heap_peek(&heap), a);
+	radix_heap_push(&heap, c, 11);
+	zassert_equal_ptr(radix_heap_pop(&heap), c);
+	zassert_equal_ptr(radix_heap_pop(&heap), a);
+	zassert_equal_ptr(radix_heap_pop(&heap), b);
+	zassert_equal(radix_heap_last(&heap), 1200);
+	zassert_true(radix_heap_is_empty(&heap));
+}
+
+/* Interleaves pushes, pops, removals and updates as a timeout queue does,
+ * checking every pop against a linear scan for the lowest key.
+ */
+ZTEST(radix_heap, test_random_ops)
+{
+	struct radix_heap_node *n;
+	struct deadline *d;
+	uint64_t now = 0;
+	uint64_t min;
+
+	radix_heap_init(&heap, now);
+	memset(deadlines, 0, sizeof(deadlines));
+
+	for (int op = 0; op < 5000; op++) {
+		d = &deadlines[next_rand() % N_NODES];
+
+		switch (next_rand() % 4) {
+		case 0:
+			if (!d->queued) {
+				radix_heap_push(&heap, &d->node, now + next_rand() % 10000U);
+				d->queued = true;
+			}
+			break;
+		case 1:
+			if (d->queued) {
+				radix_heap_remove(&heap, &d->node);
+				d->queued = false;
+			}
+			break;
+		case 2:
+			if (d->queued) {
+				radix_heap_update(&heap, &d->node, now + next_rand() % 10000U);
+			}
+			break;
+		default:
+			min = UINT64_MAX;
+			for (int i = 0; i < N_NODES; i++) {
+				if (deadlines[i].queued) {
+					min = MIN(min, radix_heap_node_key(&deadlines[i].node));
+				}
+			}
+
+			n = radix_heap_peek(&heap);
+			zassert_equal_ptr(radix_heap_pop(&heap), n);
+			if (min == UINT64_MAX) {
+				zassert_is_null(n);
+				break;
+			}
+			zassert_not_null(n);
+			zassert_equal(radix_heap_node_key(n), min);
+			CONTAINER_OF(n, struct deadline, node)->queued = false;
+			now = min;
+			break;
+		}
+	}
+}
+
+ZTEST_SUITE(radix_heap, NULL, NULL, NULL, NULL, NULL);
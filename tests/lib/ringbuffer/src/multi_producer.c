@@ -0,0 +1,147 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/ztest.h>
+#include <zephyr/ztress.h>
+#include <zephyr/sys/ring_buffer.h>
+#include <stdint.h>
+
+#define MP_PRODUCERS 2
+
+/* Records never cross the end of the buffer as its size is a multiple of them */
+struct mp_record {
+	uint32_t producer;
+	uint32_t seq;
+};
+
+RING_BUF_MP_DECLARE(mp_ringbuf, 128);
+
+static uint32_t mp_produced[MP_PRODUCERS];
+static uint32_t mp_consumed[MP_PRODUCERS];
+
+ZTEST(ringbuffer_api, test_ringbuffer_mp_put_get)
+{
+	static uint8_t data[13];
+	uint8_t out[sizeof(data)];
+	uint8_t *claimed;
+	uint8_t *wrap;
+	uint32_t len;
+
+	for (int i = 0; i < sizeof(data); i++) {
+		data[i] = i;
+	}
+
+	ring_buf_mp_reset(&mp_ringbuf);
+	/* start close to the index roll-over and the end of the buffer */
+	ring_buf_mp_internal_reset(&mp_ringbuf, (ring_buf_idx_t)-5);
+	zassert_true(ring_buf_mp_is_empty(&mp_ringbuf));
+	zassert_equal(ring_buf_mp_space_get(&mp_ringbuf), 128);
+
+	/* a block is written across the end of the buffer */
+	zassert_equal(ring_buf_mp_put(&mp_ringbuf, data, sizeof(data)), sizeof(data));
+	zassert_false(ring_buf_mp_is_empty(&mp_ringbuf));
+	zassert_equal(ring_buf_mp_size_get(&mp_ringbuf), sizeof(data));
+	zassert_equal(ring_buf_mp_get(&mp_ringbuf, out, sizeof(out)), sizeof(out));
+	zassert_mem_equal(out, data, sizeof(data));
+
+	/* claims stay contiguous and data is only visible once all are finished */
+	len = ring_buf_mp_put_claim(&mp_ringbuf, &claimed, 200);
+	zassert_equal(len, 128 - 8, "Got %u", len);
+	zassert_equal(ring_buf_mp_put_claim(&mp_ringbuf, &claimed, 16), 8);
+	zassert_equal(ring_buf_mp_put_claim(&mp_ringbuf, &claimed, 1), 0);
+	zassert_equal(ring_buf_mp_space_get(&mp_ringbuf), 0);
+	ring_buf_mp_put_finish(&mp_ringbuf);
+	zassert_equal(ring_buf_mp_size_get(&mp_ringbuf), 0);
+	ring_buf_mp_put_finish(&mp_ringbuf);
+	zassert_equal(ring_buf_mp_size_get(&mp_ringbuf), 128);
+
+	/* a block that does not fit is not written at all */
+	zassert_equal(ring_buf_mp_get(&mp_ringbuf, NULL, 8), 8);
+	zassert_equal(ring_buf_mp_put(&mp_ringbuf, data, 9), 0);
+	zassert_equal(ring_buf_mp_put(&mp_ringbuf, data, 8), 8);
+	zassert_equal(ring_buf_mp_get(&mp_ringbuf, NULL, 200), 128);
+	zassert_true(ring_buf_mp_is_empty(&mp_ringbuf));
+
+	/* a reserved block wraps around the end of the buffer */
+	zassert_equal(ring_buf_mp_put_claim(&mp_ringbuf, &claimed, 104), 104);
+	ring_buf_mp_put_finish(&mp_ringbuf);
+	zassert_equal(ring_buf_mp_get(&mp_ringbuf, NULL, 104), 104);
+	zassert_equal(ring_buf_mp_put_reserve(&mp_ringbuf, &claimed, &wrap, 200), 0);
+	len = ring_buf_mp_put_reserve(&mp_ringbuf, &claimed, &wrap, sizeof(data));
+	zassert_equal(len, 8, "Got %u", len);
+	memcpy(claimed, data, len);
+	memcpy(wrap, &data[len], sizeof(data) - len);
+	zassert_equal(ring_buf_mp_size_get(&mp_ringbuf), 0);
+	ring_buf_mp_put_finish(&mp_ringbuf);
+	zassert_equal(ring_buf_mp_get(&mp_ringbuf, out, sizeof(out)), sizeof(out));
+	zassert_mem_equal(out, data, sizeof(data));
+}
+
+static bool mp_produce(void *user_data, uint32_t iter_cnt, bool last, int prio)
+{
+	uintptr_t id = (uintptr_t)user_data;
+	struct mp_record rec = {
+		.producer = id,
+		.seq = mp_produced[id],
+	};
+	uint8_t *data;
+
+	if (iter_cnt & 1) {
+		if (ring_buf_mp_put(&mp_ringbuf, (uint8_t *)&rec, sizeof(rec)) == 0) {
+			return true;
+		}
+	} else {
+		if (ring_buf_mp_put_claim(&mp_ringbuf, &data, sizeof(rec)) == 0) {
+			return true;
+		}
+		memcpy(data, &rec, sizeof(rec));
+		ring_buf_mp_put_finish(&mp_ringbuf);
+	}
+
+	mp_produced[id]++;
+
+	return true;
+}
+
+static bool mp_consume(void *user_data, uint32_t iter_cnt, bool last, int prio)
+{
+	struct mp_record rec;
+
+	while (ring_buf_mp_get(&mp_ringbuf, (uint8_t *)&rec, sizeof(rec)) != 0) {
+		zassert_true(rec.producer < MP_PRODUCERS);
+		zassert_equal(rec.seq, mp_consumed[rec.producer],
+			      "Producer %u: got %u, exp: %u", rec.producer, rec.seq,
+			      mp_consumed[rec.producer]);
+		mp_consumed[rec.producer]++;
+	}
+
+	return true;
+}
+
+/* Multi-producer API. Test is validating a producer in an ISR and one in a
+ * thread writing concurrently, without a lock, to a single consumer.
+ */
+ZTEST(ringbuffer_api, test_ringbuffer_mp_stress)
+{
+	k_timeout_t timeout;
+
+	ring_buf_mp_reset(&mp_ringbuf);
+	/* force internal index roll-over */
+	ring_buf_mp_internal_reset(&mp_ringbuf, (ring_buf_idx_t)-64);
+	memset(mp_produced, 0, sizeof(mp_produced));
+	memset(mp_consumed, 0, sizeof(mp_consumed));
+
+	timeout = (CONFIG_SYS_CLOCK_TICKS_PER_SEC < 10000) ? K_MSEC(1000) : K_MSEC(10000);
+
+	ztress_set_timeout(timeout);
+	ZTRESS_EXECUTE(ZTRESS_TIMER(mp_produce, (void *)0, 0, Z_TIMEOUT_TICKS(20)),
+		       ZTRESS_THREAD(mp_produce, (void *)1, 0, 2000, Z_TIMEOUT_TICKS(20)),
+		       ZTRESS_THREAD(mp_consume, NULL, 0, 2000, Z_TIMEOUT_TICKS(20)));
+
+	mp_consume(NULL, 0, true, 0);
+	for (int i = 0; i < MP_PRODUCERS; i++) {
+		zassert_equal(mp_consumed[i], mp_produced[i]);
+	}
+}
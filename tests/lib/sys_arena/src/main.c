@@ -0,0 +1,141 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/sys/arena.h>
+
+#define PARENT_SIZE 2048
+
+SYS_ARENA_DEFINE(fixed_arena, 64);
+K_HEAP_DEFINE(parent_heap, PARENT_SIZE);
+
+static bool in_buf(const void *ptr, size_t len, const uint8_t *buf, size_t size)
+{
+	const uint8_t *p = ptr;
+
+	return p >= buf && p + len <= buf + size;
+}
+
+/* Checks that the parent heap got all chunks back by taking most of it */
+static void assert_parent_free(void)
+{
+	void *p = k_heap_alloc(&parent_heap, PARENT_SIZE / 2, K_NO_WAIT);
+
+	zassert_not_null(p, "chunks not returned to the parent heap");
+	k_heap_free(&parent_heap, p);
+}
+
+ZTEST(sys_arena, test_fixed)
+{
+	uint8_t *a, *b, *c;
+
+	sys_arena_reset(&fixed_arena);
+
+	a = sys_arena_aligned_alloc(&fixed_arena, 3, 1);
+	b = sys_arena_aligned_alloc(&fixed_arena, 5, 1);
+	zassert_not_null(a);
+	zassert_equal_ptr(b, a + 3, "byte allocations are not packed");
+
+	c = sys_arena_alloc(&fixed_arena, 8);
+	zassert_true(IS_ALIGNED(c, sizeof(void *)));
+	zassert_true(c >= b + 5);
+
+	c = sys_arena_aligned_alloc(&fixed_arena, 1, 32);
+	zassert_true(IS_ALIGNED(c, 32));
+
+	/* no parent heap: allocations that do not fit fail */
+	zassert_is_null(sys_arena_aligned_alloc(&fixed_arena, 64, 1));
+	zassert_not_null(sys_arena_aligned_alloc(&fixed_arena, 1, 1));
+
+	sys_arena_reset(&fixed_arena);
+	zassert_equal_ptr(sys_arena_aligned_alloc(&fixed_arena, 64, 1), a);
+	zassert_is_null(sys_arena_aligned_alloc(&fixed_arena, 1, 1));
+}
+
+ZTEST(sys_arena, test_checkpoint)
+{
+	struct sys_arena_mark mark;
+	uint8_t *a, *b;
+
+	sys_arena_reset(&fixed_arena);
+	(void)sys_arena_aligned_alloc(&fixed_arena, 10, 1);
+
+	mark = sys_arena_checkpoint(&fixed_arena);
+	a = sys_arena_aligned_alloc(&fixed_arena, 20, 1);
+	(void)sys_arena_aligned_alloc(&fixed_arena, 20, 1);
+
+	sys_arena_rollback(&fixed_arena, &mark);
+	b = sys_arena_aligned_alloc(&fixed_arena, 20, 1);
+	zassert_equal_ptr(a, b, "rollback did not free the later allocations");
+}
+
+ZTEST(sys_arena, test_chained)
+{
+	uint8_t buf[32] __aligned(sizeof(void *));
+	struct sys_arena arena;
+	struct sys_arena_mark mark;
+	uint8_t *p;
+
+	sys_arena_init(&arena, buf, sizeof(buf), &parent_heap, 128);
+
+	/* the initial buffer is used first */
+	p = sys_arena_alloc(&arena, 24);
+	zassert_true(in_buf(p, 24, buf, sizeof(buf)));
+
+	/* then chunks of the parent heap */
+	p = sys_arena_alloc(&arena, 24);
+	zassert_not_null(p);
+	zassert_false(in_buf(p, 24, buf, sizeof(buf)));
+	memset(p, 0xaa, 24);
+
+	mark = sys_arena_checkpoint(&arena);
+
+	/* several allocations share a chunk */
+	for (int i = 0; i < 4; i++) {
+		p = sys_arena_alloc(&arena, 16);
+		zassert_not_null(p);
+		memset(p, i, 16);
+	}
+
+	/* larger allocations than the chunk size get their own chunk */
+	p = sys_arena_aligned_alloc(&arena, 512, 64);
+	zassert_not_null(p);
+	zassert_true(IS_ALIGNED(p, 64));
+	memset(p, 0x55, 512);
+
+	/* the parent heap running out makes allocations fail */
+	zassert_is_null(sys_arena_alloc(&arena, PARENT_SIZE));
+
+	sys_arena_rollback(&arena, &mark);
+	zassert_not_null(sys_arena_alloc(&arena, 16));
+
+	sys_arena_reset(&arena);
+	assert_parent_free();
+	zassert_true(in_buf(sys_arena_alloc(&arena, 32), 32, buf, sizeof(buf)));
+	sys_arena_reset(&arena);
+}
+
+ZTEST(sys_arena, test_no_buffer)
+{
+	struct sys_arena arena;
+	void *ptrs[32];
+
+	sys_arena_init(&arena, NULL, 0, &parent_heap, 64);
+
+	for (int i = 0; i < ARRAY_SIZE(ptrs); i++) {
+		ptrs[i] = sys_arena_alloc(&arena, 12);
+		zassert_not_null(ptrs[i]);
+		for (int j = 0; j < i; j++) {
+			zassert_not_equal(ptrs[i], ptrs[j]);
+		}
+	}
+
+	sys_arena_reset(&arena);
+	assert_parent_free();
+}
+
+ZTEST_SUITE(sys_arena, NULL, NULL, NULL, NULL, NULL);
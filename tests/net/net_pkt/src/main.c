@@ -668,6 +668,103 @@ ZTEST(net_pkt_test_suite, test_net_pkt_copy)
 
 #define PULL_TEST_PKT_DATA_SIZE 600
 
+static uint16_t ref_chksum(const uint8_t *data, size_t len)
+{
+	uint32_t sum = 0U;
+	size_t i;
+
+	for (i = 0; i < len; i++) {
+		sum += (i % 2) ? data[i] : (uint32_t)data[i] << 8;
+	}
+
+	while (sum >> 16) {
+		sum = (sum & 0xffff) + (sum >> 16);
+	}
+
+	return sum;
+}
+
+ZTEST(net_pkt_test_suite, test_net_pkt_write_chksum)
+{
+	static uint8_t data[PULL_TEST_PKT_DATA_SIZE];
+	static uint8_t readback[PULL_TEST_PKT_DATA_SIZE];
+	struct net_pkt *pkt;
+	uint16_t chksum = 0U;
+	uint16_t expected;
+	size_t i;
+	int ret;
+
+	for (i = 0; i < sizeof(data); i++) {
+		data[i] = (uint8_t)(i * 7 + 3);
+	}
+
+	pkt = net_pkt_alloc_with_buffer(eth_if, sizeof(data), NET_AF_UNSPEC,
+					0, K_NO_WAIT);
+	zassert_not_null(pkt, "Pkt not allocated");
+
+	/* Write through all the fragments of the packet */
+	ret = net_pkt_write_chksum(pkt, data, sizeof(data), &chksum);
+	zassert_equal(ret, 0, "Pkt write failed");
+
+	expected = ref_chksum(data, sizeof(data));
+	zassert_equal(chksum % 0xffff, expected % 0xffff,
+		      "Wrong checksum 0x%04x, expected 0x%04x",
+		      chksum, expected);
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+	ret = net_pkt_read(pkt, readback, sizeof(data));
+	zassert_equal(ret, 0, "Pkt read failed");
+	zassert_mem_equal(readback, data, sizeof(data), "Data mismatch");
+
+	net_pkt_unref(pkt);
+}
+
+ZTEST(net_pkt_test_suite, test_net_pkt_write_iov)
+{
+	static uint8_t data[PULL_TEST_PKT_DATA_SIZE];
+	static uint8_t readback[PULL_TEST_PKT_DATA_SIZE];
+	/* Odd sized buffers, so chunks start at odd offsets */
+	struct net_iovec iov[] = {
+		{ .iov_base = data, .iov_len = 1 },
+		{ .iov_base = data + 1, .iov_len = 0 },
+		{ .iov_base = data + 1, .iov_len = 333 },
+		{ .iov_base = data + 334, .iov_len = sizeof(data) - 334 },
+	};
+	struct net_pkt *pkt;
+	uint16_t chksum = 0U;
+	uint16_t expected;
+	size_t i;
+	int ret;
+
+	for (i = 0; i < sizeof(data); i++) {
+		data[i] = (uint8_t)(i * 13 + 5);
+	}
+
+	pkt = net_pkt_alloc_with_buffer(eth_if, sizeof(data), NET_AF_UNSPEC,
+					0, K_NO_WAIT);
+	zassert_not_null(pkt, "Pkt not allocated");
+
+	/* The last buffer is cut short by the length */
+	ret = net_pkt_write_iov(pkt, iov, ARRAY_SIZE(iov), sizeof(data) - 7,
+				&chksum);
+	zassert_equal(ret, 0, "Pkt write failed");
+	zassert_equal(net_pkt_get_len(pkt), sizeof(data) - 7, "Wrong length");
+
+	expected = ref_chksum(data, sizeof(data) - 7);
+	zassert_equal(chksum % 0xffff, expected % 0xffff,
+		      "Wrong checksum 0x%04x, expected 0x%04x",
+		      chksum, expected);
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+	ret = net_pkt_read(pkt, readback, sizeof(data) - 7);
+	zassert_equal(ret, 0, "Pkt read failed");
+	zassert_mem_equal(readback, data, sizeof(data) - 7, "Data mismatch");
+
+	net_pkt_unref(pkt);
+}
+
 ZTEST(net_pkt_test_suite, test_net_pkt_pull)
 {
 	const int PULL_AMOUNT = 8;
@@ -325,6 +325,114 @@ ZTEST(net_socket_udp, test_send_recv_2_sock)
 	zassert_equal(rv, 0, "close failed");
 }
 
+#if defined(CONFIG_NET_SOCKETS_RECV_PKT)
+ZTEST(net_socket_udp, test_recv_pkt)
+{
+	int sock1, sock2;
+	struct net_sockaddr_in bind_addr, conn_addr;
+	struct net_pkt *pkt;
+	char buf[sizeof(TEST_STR2)];
+	ssize_t len;
+	int rv;
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, 55555, &sock1, &bind_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, 55555, &sock2, &conn_addr);
+
+	rv = zsock_bind(sock1, (struct net_sockaddr *)&bind_addr, sizeof(bind_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	rv = zsock_connect(sock2, (struct net_sockaddr *)&conn_addr, sizeof(conn_addr));
+	zassert_equal(rv, 0, "connect failed");
+
+	len = zsock_recv_pkt(sock1, &pkt, ZSOCK_MSG_DONTWAIT);
+	zassert_equal(len, -1, "recv_pkt on empty socket should fail");
+	zassert_equal(errno, EAGAIN, "Unexpected errno %d", errno);
+
+	len = zsock_send(sock2, BUF_AND_SIZE(TEST_STR2), 0);
+	zassert_equal(len, STRLEN(TEST_STR2), "invalid send len");
+
+	len = zsock_recv_pkt(sock1, &pkt, 0);
+	zassert_equal(len, STRLEN(TEST_STR2), "Invalid recv_pkt len");
+
+	clear_buf(buf);
+	rv = net_pkt_read(pkt, buf, len);
+	zassert_equal(rv, 0, "Cannot read packet payload");
+	zassert_mem_equal(buf, BUF_AND_SIZE(TEST_STR2), "Wrong data");
+	net_pkt_unref(pkt);
+
+	rv = zsock_close(sock1);
+	zassert_equal(rv, 0, "close failed");
+	rv = zsock_close(sock2);
+	zassert_equal(rv, 0, "close failed");
+}
+#endif /* CONFIG_NET_SOCKETS_RECV_PKT */
+
+#if defined(CONFIG_NET_SOCKETS_SEND_BUF)
+static K_SEM_DEFINE(send_buf_done, 0, 2);
+
+static void send_buf_destroy(struct net_buf *buf)
+{
+	k_sem_give(&send_buf_done);
+	net_buf_destroy(buf);
+}
+
+NET_BUF_POOL_FIXED_DEFINE(send_buf_pool, 2, sizeof(TEST_STR_SMALL), 0, send_buf_destroy);
+
+static char send_buf_payload[] = TEST_STR2;
+
+ZTEST(net_socket_udp, test_send_buf)
+{
+	int sock1, sock2;
+	struct net_sockaddr_in bind_addr, conn_addr;
+	struct net_buf *hdr, *data;
+	char buf[sizeof(TEST_STR_SMALL) + sizeof(TEST_STR2)];
+	ssize_t len;
+	int rv;
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, 55555, &sock1, &bind_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, 55555, &sock2, &conn_addr);
+
+	rv = zsock_bind(sock1, (struct net_sockaddr *)&bind_addr, sizeof(bind_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	/* A chain of a copied header and a payload sent from where it is */
+	hdr = net_buf_alloc(&send_buf_pool, K_NO_WAIT);
+	zassert_not_null(hdr, "Cannot allocate header buffer");
+	net_buf_add_mem(hdr, TEST_STR_SMALL, STRLEN(TEST_STR_SMALL));
+	data = net_buf_alloc_with_data(&send_buf_pool, send_buf_payload,
+				       STRLEN(TEST_STR2), K_NO_WAIT);
+	zassert_not_null(data, "Cannot allocate payload buffer");
+	net_buf_frag_add(hdr, data);
+
+	len = zsock_send_buf(sock2, hdr, 0);
+	zassert_equal(len, -1, "send_buf on unconnected socket should fail");
+	zassert_equal(errno, EDESTADDRREQ, "Unexpected errno %d", errno);
+	zassert_equal(k_sem_count_get(&send_buf_done), 0, "Buffers released on failure");
+
+	rv = zsock_connect(sock2, (struct net_sockaddr *)&conn_addr, sizeof(conn_addr));
+	zassert_equal(rv, 0, "connect failed");
+
+	len = zsock_send_buf(sock2, hdr, 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL) + STRLEN(TEST_STR2), "invalid send_buf len");
+
+	clear_buf(buf);
+	len = zsock_recv(sock1, buf, sizeof(buf), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL) + STRLEN(TEST_STR2), "Invalid recv len");
+	zassert_mem_equal(buf, TEST_STR_SMALL, STRLEN(TEST_STR_SMALL), "Wrong header");
+	zassert_mem_equal(buf + STRLEN(TEST_STR_SMALL), TEST_STR2, STRLEN(TEST_STR2),
+			  "Wrong payload");
+
+	/* Both buffers are released once the packet is done with */
+	zassert_ok(k_sem_take(&send_buf_done, K_MSEC(100)), "Header not released");
+	zassert_ok(k_sem_take(&send_buf_done, K_MSEC(100)), "Payload not released");
+
+	rv = zsock_close(sock1);
+	zassert_equal(rv, 0, "close failed");
+	rv = zsock_close(sock2);
+	zassert_equal(rv, 0, "close failed");
+}
+#endif /* CONFIG_NET_SOCKETS_SEND_BUF */
+
 ZTEST(net_socket_udp, test_so_priority)
 {
 	struct net_sockaddr_in bind_addr4;
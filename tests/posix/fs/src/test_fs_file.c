@@ -258,6 +258,44 @@ ZTEST(posix_fs_file_test, test_fs_unlink)
 	zassert_true(test_file_delete() == TC_PASS);
 }
 
+#if defined(CONFIG_FILE_SYSTEM_VECTORED_IO)
+/* Not yet declared in a public header */
+ssize_t pread(int fd, void *buf, size_t count, off_t offset);
+ssize_t pwrite(int fd, void *buf, size_t count, off_t offset);
+
+/**
+ * @brief Test for POSIX pread and pwrite APIs
+ *
+ * @details Test reads and writes at an offset, which must not move the
+ * file position.
+ */
+ZTEST(posix_fs_file_test, test_fs_pread_pwrite)
+{
+	char hello[] = "HELLO";
+	char read_buff[80];
+	off_t pos = strlen(test_str);
+
+	zassert_true(test_file_open() == TC_PASS);
+	zassert_true(test_file_write() == TC_PASS);
+	zassert_equal(lseek(file, 0, SEEK_CUR), pos);
+
+	zassert_equal(pwrite(file, hello, strlen(hello), 0), strlen(hello));
+	zassert_equal(lseek(file, 0, SEEK_CUR), pos, "pwrite moved file position");
+
+	memset(read_buff, 0, sizeof(read_buff));
+	zassert_equal(pread(file, read_buff, sizeof(read_buff), 0), strlen(test_str));
+	zassert_str_equal(read_buff, "HELLO world!");
+	zassert_equal(lseek(file, 0, SEEK_CUR), pos, "pread moved file position");
+
+	memset(read_buff, 0, sizeof(read_buff));
+	zassert_equal(pread(file, read_buff, sizeof(read_buff), 6), strlen(test_str) - 6);
+	zassert_str_equal(read_buff, "world!");
+
+	zassert_equal(pread(file, read_buff, sizeof(read_buff), -1), -1);
+	zassert_equal(errno, EINVAL);
+}
+#endif /* CONFIG_FILE_SYSTEM_VECTORED_IO */
+
 ZTEST(posix_fs_file_test, test_fs_fd_leak)
 {
 	const int reps =
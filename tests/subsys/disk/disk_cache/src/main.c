@@ -0,0 +1,381 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/drivers/disk.h>
+#include <zephyr/storage/disk_access.h>
+
+#define SECTOR_SIZE    CONFIG_DISK_CACHE_SECTOR_SIZE
+#define SECTOR_COUNT   32
+/* Requests of more sectors than this bypass the cache */
+#define BYPASS_SECTORS (CONFIG_DISK_CACHE_BLOCKS / 2)
+#define FLUSH_WAIT     K_MSEC(CONFIG_DISK_CACHE_FLUSH_DELAY_MS * 3)
+#define STACK_SIZE     (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+/* RAM disk counting the driver calls */
+struct test_disk {
+	struct disk_info info;
+	uint8_t data[SECTOR_COUNT][SECTOR_SIZE];
+	uint32_t reads;
+	uint32_t writes;
+	int write_err;
+	bool block_reads;
+};
+
+static K_SEM_DEFINE(read_entered, 0, 1);
+static K_SEM_DEFINE(read_release, 0, 1);
+
+static int test_disk_init(struct disk_info *disk)
+{
+	return 0;
+}
+
+static int test_disk_status(struct disk_info *disk)
+{
+	return DISK_STATUS_OK;
+}
+
+static int test_disk_read(struct disk_info *disk, uint8_t *data_buf,
+			  uint32_t start_sector, uint32_t num_sector)
+{
+	struct test_disk *td = CONTAINER_OF(disk, struct test_disk, info);
+
+	if (start_sector >= SECTOR_COUNT || num_sector > SECTOR_COUNT - start_sector) {
+		return -EINVAL;
+	}
+
+	td->reads++;
+
+	if (td->block_reads) {
+		k_sem_give(&read_entered);
+		(void)k_sem_take(&read_release, K_FOREVER);
+	}
+
+	memcpy(data_buf, td->data[start_sector], num_sector * SECTOR_SIZE);
+
+	return 0;
+}
+
+static int test_disk_write(struct disk_info *disk, const uint8_t *data_buf,
+			   uint32_t start_sector, uint32_t num_sector)
+{
+	struct test_disk *td = CONTAINER_OF(disk, struct test_disk, info);
+
+	if (start_sector >= SECTOR_COUNT || num_sector > SECTOR_COUNT - start_sector) {
+		return -EINVAL;
+	}
+
+	td->writes++;
+
+	if (td->write_err != 0) {
+		return td->write_err;
+	}
+
+	memcpy(td->data[start_sector], data_buf, num_sector * SECTOR_SIZE);
+
+	return 0;
+}
+
+static int test_disk_ioctl(struct disk_info *disk, uint8_t cmd, void *buff)
+{
+	switch (cmd) {
+	case DISK_IOCTL_GET_SECTOR_COUNT:
+		*(uint32_t *)buff = SECTOR_COUNT;
+		return 0;
+	case DISK_IOCTL_GET_SECTOR_SIZE:
+		*(uint32_t *)buff = SECTOR_SIZE;
+		return 0;
+	case DISK_IOCTL_CTRL_SYNC:
+	case DISK_IOCTL_CTRL_INIT:
+	case DISK_IOCTL_CTRL_DEINIT:
+		return 0;
+	default:
+		return -EINVAL;
+	}
+}
+
+static const struct disk_operations test_disk_ops = {
+	.init = test_disk_init,
+	.status = test_disk_status,
+	.read = test_disk_read,
+	.write = test_disk_write,
+	.ioctl = test_disk_ioctl,
+};
+
+static struct test_disk disk_a = {
+	.info = {
+		.name = "CACHE_A",
+		.ops = &test_disk_ops,
+	},
+};
+
+static struct test_disk disk_b = {
+	.info = {
+		.name = "CACHE_B",
+		.ops = &test_disk_ops,
+	},
+};
+
+static uint8_t buf[CONFIG_DISK_CACHE_BLOCKS][SECTOR_SIZE];
+static uint8_t pattern[CONFIG_DISK_CACHE_BLOCKS][SECTOR_SIZE];
+
+static void fill_pattern(uint8_t seed)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(pattern); i++) {
+		memset(pattern[i], seed + i, SECTOR_SIZE);
+	}
+}
+
+static void reset_disk(struct test_disk *td)
+{
+	for (size_t i = 0; i < SECTOR_COUNT; i++) {
+		memset(td->data[i], i, SECTOR_SIZE);
+	}
+
+	td->reads = 0;
+	td->writes = 0;
+	td->write_err = 0;
+	td->block_reads = false;
+}
+
+static void *disk_cache_setup(void)
+{
+	zassert_ok(disk_access_register(&disk_a.info));
+	zassert_ok(disk_access_register(&disk_b.info));
+
+	return NULL;
+}
+
+static void disk_cache_before(void *fixture)
+{
+	reset_disk(&disk_a);
+	reset_disk(&disk_b);
+	zassert_ok(disk_access_init(disk_a.info.name));
+	zassert_ok(disk_access_init(disk_b.info.name));
+	disk_cache_stats_reset();
+}
+
+static void disk_cache_after(void *fixture)
+{
+	bool force = true;
+
+	disk_a.write_err = 0;
+	(void)disk_access_ioctl(disk_a.info.name, DISK_IOCTL_CTRL_DEINIT, &force);
+	(void)disk_access_ioctl(disk_b.info.name, DISK_IOCTL_CTRL_DEINIT, &force);
+}
+
+ZTEST(disk_cache, test_hit_miss)
+{
+	struct disk_cache_stats stats;
+
+	zassert_ok(disk_access_read(disk_a.info.name, buf[0], 0, 1));
+	zassert_ok(disk_access_read(disk_a.info.name, buf[1], 0, 1));
+	zassert_mem_equal(buf[0], disk_a.data[0], SECTOR_SIZE);
+	zassert_mem_equal(buf[1], disk_a.data[0], SECTOR_SIZE);
+
+	/* The same sector of another disk is not a hit */
+	zassert_ok(disk_access_read(disk_b.info.name, buf[0], 0, 1));
+
+	disk_cache_stats_get(&stats);
+	zassert_equal(stats.misses, 2);
+	zassert_equal(stats.hits, 1);
+	zassert_equal(disk_a.reads, 1);
+	zassert_equal(disk_b.reads, 1);
+}
+
+ZTEST(disk_cache, test_read_ahead)
+{
+	struct disk_cache_stats stats;
+
+	for (uint32_t sector = 10; sector < 14; sector++) {
+		zassert_ok(disk_access_read(disk_a.info.name, buf[0], sector, 1));
+		zassert_mem_equal(buf[0], disk_a.data[sector], SECTOR_SIZE);
+	}
+
+	/* Reading 11 continues the read of 10, so 12 and 13 come along */
+	disk_cache_stats_get(&stats);
+	zassert_equal(stats.misses, 2);
+	zassert_equal(stats.read_ahead, CONFIG_DISK_CACHE_READ_AHEAD);
+	zassert_equal(stats.hits, 2);
+	zassert_equal(disk_a.reads, 2);
+}
+
+ZTEST(disk_cache, test_write_back)
+{
+	struct disk_cache_stats stats;
+
+	fill_pattern(0xa0);
+
+	zassert_ok(disk_access_write(disk_a.info.name, pattern[0], 5, 1));
+	zassert_equal(disk_a.writes, 0, "write was not cached");
+
+	zassert_ok(disk_access_read(disk_a.info.name, buf[0], 5, 1));
+	zassert_mem_equal(buf[0], pattern[0], SECTOR_SIZE);
+	zassert_equal(disk_a.reads, 0);
+
+	zassert_ok(disk_access_ioctl(disk_a.info.name, DISK_IOCTL_CTRL_SYNC, NULL));
+	zassert_equal(disk_a.writes, 1);
+	zassert_mem_equal(disk_a.data[5], pattern[0], SECTOR_SIZE);
+
+	/* Nothing left to write */
+	zassert_ok(disk_access_ioctl(disk_a.info.name, DISK_IOCTL_CTRL_SYNC, NULL));
+	zassert_equal(disk_a.writes, 1);
+
+	disk_cache_stats_get(&stats);
+	zassert_equal(stats.writebacks, 1);
+}
+
+ZTEST(disk_cache, test_write_back_on_eviction_and_timeout)
+{
+	struct disk_cache_stats stats;
+
+	fill_pattern(0xb0);
+
+	/* One more dirty sector than the cache holds */
+	for (uint32_t i = 0; i < CONFIG_DISK_CACHE_BLOCKS; i++) {
+		zassert_ok(disk_access_write(disk_a.info.name, pattern[i], i, 1));
+	}
+	zassert_ok(disk_access_write(disk_b.info.name, pattern[0], 0, 1));
+
+	/* The least recently written sector was evicted */
+	zassert_equal(disk_a.writes, 1);
+	zassert_mem_equal(disk_a.data[0], pattern[0], SECTOR_SIZE);
+
+	k_sleep(FLUSH_WAIT);
+
+	zassert_equal(disk_a.writes, CONFIG_DISK_CACHE_BLOCKS);
+	zassert_equal(disk_b.writes, 1);
+	for (uint32_t i = 0; i < CONFIG_DISK_CACHE_BLOCKS; i++) {
+		zassert_mem_equal(disk_a.data[i], pattern[i], SECTOR_SIZE);
+	}
+
+	disk_cache_stats_get(&stats);
+	zassert_equal(stats.writebacks, CONFIG_DISK_CACHE_BLOCKS + 1);
+}
+
+ZTEST(disk_cache, test_write_back_delayed_by_writes)
+{
+	const k_timeout_t gap = K_MSEC(CONFIG_DISK_CACHE_FLUSH_DELAY_MS * 2 / 3);
+
+	fill_pattern(0x90);
+
+	/* Each write restarts the delay, so nothing is written back in between */
+	zassert_ok(disk_access_write(disk_a.info.name, pattern[0], 3, 1));
+	k_sleep(gap);
+	zassert_ok(disk_access_write(disk_a.info.name, pattern[1], 3, 1));
+	k_sleep(gap);
+	zassert_equal(disk_a.writes, 0, "write back did not wait for the writes to stop");
+
+	k_sleep(FLUSH_WAIT);
+
+	zassert_equal(disk_a.writes, 1);
+	zassert_mem_equal(disk_a.data[3], pattern[1], SECTOR_SIZE);
+}
+
+ZTEST(disk_cache, test_bypass_coherency)
+{
+	struct disk_cache_stats stats;
+	uint32_t count = BYPASS_SECTORS + 1;
+
+	fill_pattern(0xc0);
+
+	/* A large read returns the sector only written to the cache */
+	zassert_ok(disk_access_write(disk_a.info.name, pattern[3], 3, 1));
+	zassert_ok(disk_access_read(disk_a.info.name, buf[0], 0, count));
+	for (uint32_t i = 0; i < count; i++) {
+		zassert_mem_equal(buf[i], i == 3 ? pattern[3] : disk_a.data[i],
+				  SECTOR_SIZE, "sector %u", i);
+	}
+
+	/* A large write replaces the cached copy and its pending write */
+	fill_pattern(0xd0);
+	zassert_ok(disk_access_write(disk_a.info.name, pattern[0], 0, count));
+	zassert_equal(disk_a.writes, 1);
+
+	zassert_ok(disk_access_read(disk_a.info.name, buf[0], 3, 1));
+	zassert_mem_equal(buf[0], pattern[3], SECTOR_SIZE);
+
+	zassert_ok(disk_access_ioctl(disk_a.info.name, DISK_IOCTL_CTRL_SYNC, NULL));
+	zassert_equal(disk_a.writes, 1, "stale data written back");
+	zassert_mem_equal(disk_a.data[3], pattern[3], SECTOR_SIZE);
+
+	disk_cache_stats_get(&stats);
+	zassert_equal(stats.bypassed, 2);
+	zassert_equal(stats.hits, 1);
+}
+
+ZTEST(disk_cache, test_detach_drops_unwritten_blocks)
+{
+	bool force = true;
+
+	fill_pattern(0xe0);
+
+	zassert_ok(disk_access_write(disk_a.info.name, pattern[0], 2, 1));
+
+	disk_a.write_err = -EIO;
+	zassert_equal(disk_access_ioctl(disk_a.info.name, DISK_IOCTL_CTRL_DEINIT, NULL),
+		      -EIO);
+	zassert_ok(disk_access_ioctl(disk_a.info.name, DISK_IOCTL_CTRL_DEINIT, &force));
+	zassert_ok(disk_access_unregister(&disk_a.info));
+	disk_a.write_err = 0;
+	disk_a.writes = 0;
+
+	/* Flushing the cache must not reach the unregistered disk */
+	zassert_ok(disk_access_write(disk_b.info.name, pattern[1], 0, 1));
+	zassert_ok(disk_access_ioctl(disk_b.info.name, DISK_IOCTL_CTRL_SYNC, NULL));
+	zassert_ok(disk_access_write(disk_b.info.name, pattern[2], 1, 1));
+	k_sleep(FLUSH_WAIT);
+
+	zassert_equal(disk_a.writes, 0);
+	zassert_equal(disk_b.writes, 2);
+
+	zassert_ok(disk_access_register(&disk_a.info));
+}
+
+static K_THREAD_STACK_DEFINE(read_a_stack, STACK_SIZE);
+static struct k_thread read_a_thread;
+static K_THREAD_STACK_DEFINE(read_b_stack, STACK_SIZE);
+static struct k_thread read_b_thread;
+static K_SEM_DEFINE(read_b_done, 0, 1);
+static int read_a_rc;
+static int read_b_rc;
+
+static void read_a(void *p1, void *p2, void *p3)
+{
+	read_a_rc = disk_access_read(disk_a.info.name, buf[0], 0, 1);
+}
+
+static void read_b(void *p1, void *p2, void *p3)
+{
+	read_b_rc = disk_access_read(disk_b.info.name, buf[1], 0, 1);
+	k_sem_give(&read_b_done);
+}
+
+ZTEST(disk_cache, test_slow_disk_does_not_block_others)
+{
+	disk_a.block_reads = true;
+
+	k_thread_create(&read_a_thread, read_a_stack, K_THREAD_STACK_SIZEOF(read_a_stack),
+			read_a, NULL, NULL, NULL, K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	zassert_ok(k_sem_take(&read_entered, K_SECONDS(1)));
+
+	/* Disk A is stuck in its driver, disk B still gets served */
+	k_thread_create(&read_b_thread, read_b_stack, K_THREAD_STACK_SIZEOF(read_b_stack),
+			read_b, NULL, NULL, NULL, K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	zassert_ok(k_sem_take(&read_b_done, K_MSEC(500)), "disk B waited for disk A");
+	zassert_ok(read_b_rc);
+	zassert_mem_equal(buf[1], disk_b.data[0], SECTOR_SIZE);
+
+	k_sem_give(&read_release);
+	zassert_ok(k_thread_join(&read_a_thread, K_SECONDS(1)));
+	zassert_ok(read_a_rc);
+	zassert_mem_equal(buf[0], disk_a.data[0], SECTOR_SIZE);
+	(void)k_thread_join(&read_b_thread, K_SECONDS(1));
+}
+
+ZTEST_SUITE(disk_cache, NULL, disk_cache_setup, disk_cache_before, disk_cache_after, NULL);
@@ -0,0 +1,95 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/fs/fs.h>
+
+/* Mount point must be provided by test runner. */
+extern struct fs_mount_t *fs_vio_mp;
+
+static const char part1[] = "0123456789";
+static const char part2[] = "abcdef";
+static const char part3[] = "XYZ";
+
+void test_fs_vectored_io(void)
+{
+	struct fs_file_t file;
+	char path[32];
+	char buf[32];
+	char head[4];
+	char tail[32];
+	ssize_t ret;
+	const size_t total = strlen(part1) + strlen(part2) + strlen(part3);
+	struct fs_iovec wiov[] = {
+		{ .iov_base = (void *)part1, .iov_len = strlen(part1) },
+		{ .iov_base = (void *)part2, .iov_len = strlen(part2) },
+		{ .iov_base = (void *)part3, .iov_len = strlen(part3) },
+	};
+	struct fs_iovec riov[] = {
+		{ .iov_base = head, .iov_len = sizeof(head) },
+		{ .iov_base = tail, .iov_len = sizeof(tail) },
+	};
+
+	ret = fs_mount(fs_vio_mp);
+	zassert_equal(ret, 0, "Expected fs_mount success (%zd)", ret);
+
+	snprintf(path, sizeof(path), "%s/vio", fs_vio_mp->mnt_point);
+	fs_file_t_init(&file);
+	ret = fs_open(&file, path, FS_O_CREATE | FS_O_RDWR);
+	zassert_equal(ret, 0, "Expected fs_open success (%zd)", ret);
+
+	TC_PRINT("writev\n");
+	ret = fs_writev(&file, wiov, ARRAY_SIZE(wiov));
+	zassert_equal(ret, total, "Unexpected fs_writev result (%zd)", ret);
+	zassert_equal(fs_tell(&file), total, "writev did not advance position");
+
+	TC_PRINT("pwrite\n");
+	ret = fs_pwrite(&file, "--", 2, 4);
+	zassert_equal(ret, 2, "Unexpected fs_pwrite result (%zd)", ret);
+	zassert_equal(fs_tell(&file), total, "pwrite moved file position");
+
+	TC_PRINT("pread\n");
+	memset(buf, 0, sizeof(buf));
+	ret = fs_pread(&file, buf, sizeof(buf), 0);
+	zassert_equal(ret, total, "Unexpected fs_pread result (%zd)", ret);
+	zassert_mem_equal(buf, "0123--6789abcdefXYZ", total, "Unexpected pread data");
+	zassert_equal(fs_tell(&file), total, "pread moved file position");
+
+	ret = fs_pread(&file, buf, sizeof(buf), total);
+	zassert_equal(ret, 0, "Expected no data past end of file (%zd)", ret);
+
+	ret = fs_pread(&file, buf, sizeof(buf), -1);
+	zassert_equal(ret, -EINVAL, "Expected -EINVAL for negative offset (%zd)", ret);
+
+	/* An empty read past the end of file must not extend the file */
+	ret = fs_pread(&file, NULL, 0, total + 8);
+	zassert_equal(ret, 0, "Unexpected empty fs_pread result (%zd)", ret);
+	ret = fs_seek(&file, 0, FS_SEEK_END);
+	zassert_equal(ret, 0, "Expected fs_seek success (%zd)", ret);
+	zassert_equal(fs_tell(&file), total, "empty pread changed file size");
+
+	TC_PRINT("readv\n");
+	ret = fs_seek(&file, 0, FS_SEEK_SET);
+	zassert_equal(ret, 0, "Expected fs_seek success (%zd)", ret);
+	memset(tail, 0, sizeof(tail));
+	ret = fs_readv(&file, riov, ARRAY_SIZE(riov));
+	zassert_equal(ret, total, "Unexpected fs_readv result (%zd)", ret);
+	zassert_mem_equal(head, "0123", sizeof(head), "Unexpected readv data");
+	zassert_mem_equal(tail, "--6789abcdefXYZ", total - sizeof(head),
+			  "Unexpected readv data");
+
+	ret = fs_close(&file);
+	zassert_equal(ret, 0, "Expected fs_close success (%zd)", ret);
+
+	ret = fs_unlink(path);
+	zassert_equal(ret, 0, "Expected fs_unlink success (%zd)", ret);
+
+	ret = fs_unmount(fs_vio_mp);
+	zassert_equal(ret, 0, "Expected fs_unmount success (%zd)", ret);
+}
@@ -0,0 +1,20 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/fs/fs.h>
+
+#include "utils.h"
+
+void test_fs_vectored_io(void);
+
+/* Expected by test_fs_vectored_io() */
+struct fs_mount_t *fs_vio_mp = &testfs_mnt;
+
+ZTEST(ext2tests, test_vectored_io)
+{
+	test_fs_vectored_io();
+}
@@ -0,0 +1,144 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include "test_fat.h"
+
+#define EXPAND_FILE  FATFS_MNTP"/expand.bin"
+#define EXPAND_CHUNK 4096
+#define EXPAND_SIZE  (4 * EXPAND_CHUNK)
+
+static struct fs_mount_t fatfs_mnt = {
+	.type = FS_FATFS,
+	.mnt_point = FATFS_MNTP,
+	.fs_data = &fat_fs,
+};
+
+static uint8_t chunk[EXPAND_CHUNK];
+static uint8_t read_chunk[EXPAND_CHUNK];
+
+static void fill_chunk(int idx)
+{
+	for (size_t i = 0; i < sizeof(chunk); i++) {
+		chunk[i] = (uint8_t)(i * 7 + idx);
+	}
+}
+
+static off_t file_size(struct fs_file_t *file)
+{
+	struct fs_dirent entry;
+
+	zassert_ok(fs_sync(file));
+	zassert_ok(fs_stat(EXPAND_FILE, &entry));
+
+	return entry.size;
+}
+
+static void *fat_fs_expand_setup(void)
+{
+	zassert_ok(fs_mount(&fatfs_mnt));
+
+	return NULL;
+}
+
+static void fat_fs_expand_after(void *fixture)
+{
+	(void)fs_unlink(EXPAND_FILE);
+}
+
+static void fat_fs_expand_teardown(void *fixture)
+{
+	zassert_ok(fs_unmount(&fatfs_mnt));
+}
+
+/**
+ * @brief Test expanding an empty file
+ *
+ * @details The file gets its final size without moving the position, and
+ * data written over the reserved storage, in requests spanning several
+ * clusters, reads back intact.
+ */
+ZTEST(fat_fs_expand, test_fat_expand_empty)
+{
+	struct fs_file_t file;
+
+	fs_file_t_init(&file);
+	zassert_ok(fs_open(&file, EXPAND_FILE, FS_O_CREATE | FS_O_RDWR));
+
+	zassert_ok(fs_expand(&file, EXPAND_SIZE));
+	zassert_equal(fs_tell(&file), 0, "fs_expand moved file position");
+	zassert_equal(file_size(&file), EXPAND_SIZE);
+
+	for (int i = 0; i < EXPAND_SIZE / EXPAND_CHUNK; i++) {
+		fill_chunk(i);
+		zassert_equal(fs_write(&file, chunk, sizeof(chunk)), sizeof(chunk));
+	}
+	zassert_equal(file_size(&file), EXPAND_SIZE, "writes changed file size");
+
+	zassert_ok(fs_seek(&file, 0, FS_SEEK_SET));
+	for (int i = 0; i < EXPAND_SIZE / EXPAND_CHUNK; i++) {
+		fill_chunk(i);
+		zassert_equal(fs_read(&file, read_chunk, sizeof(read_chunk)),
+			      sizeof(read_chunk));
+		zassert_mem_equal(read_chunk, chunk, sizeof(chunk), "chunk %d", i);
+	}
+
+	zassert_ok(fs_close(&file));
+}
+
+/**
+ * @brief Test expanding a file that already holds data
+ *
+ * @details The existing data and the file position are kept.
+ */
+ZTEST(fat_fs_expand, test_fat_expand_non_empty)
+{
+	struct fs_file_t file;
+	char buf[sizeof(test_str)];
+	ssize_t len = strlen(test_str);
+
+	fs_file_t_init(&file);
+	zassert_ok(fs_open(&file, EXPAND_FILE, FS_O_CREATE | FS_O_RDWR));
+	zassert_equal(fs_write(&file, test_str, len), len);
+	zassert_ok(fs_seek(&file, 3, FS_SEEK_SET));
+
+	zassert_ok(fs_expand(&file, EXPAND_SIZE + 1));
+	zassert_equal(fs_tell(&file), 3, "fs_expand moved file position");
+	zassert_equal(file_size(&file), EXPAND_SIZE + 1);
+
+	/* The file position is still usable */
+	memset(buf, 0, sizeof(buf));
+	zassert_equal(fs_read(&file, buf, len - 3), len - 3);
+	zassert_mem_equal(buf, test_str + 3, len - 3);
+
+	zassert_ok(fs_seek(&file, 0, FS_SEEK_END));
+	zassert_equal(fs_tell(&file), EXPAND_SIZE + 1);
+
+	zassert_ok(fs_close(&file));
+}
+
+/**
+ * @brief Test fs_expand size limits
+ */
+ZTEST(fat_fs_expand, test_fat_expand_size)
+{
+	struct fs_file_t file;
+	ssize_t len = strlen(test_str);
+
+	fs_file_t_init(&file);
+	zassert_ok(fs_open(&file, EXPAND_FILE, FS_O_CREATE | FS_O_RDWR));
+	zassert_equal(fs_write(&file, test_str, len), len);
+
+	zassert_equal(fs_expand(&file, len - 1), -EINVAL);
+	zassert_ok(fs_expand(&file, len));
+	zassert_equal(fs_tell(&file), len);
+	zassert_equal(file_size(&file), len);
+
+	zassert_ok(fs_close(&file));
+}
+
+ZTEST_SUITE(fat_fs_expand, NULL, fat_fs_expand_setup, NULL, fat_fs_expand_after,
+	    fat_fs_expand_teardown);
@@ -0,0 +1,23 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "test_fat.h"
+
+void test_fs_vectored_io(void);
+
+static struct fs_mount_t fatfs_mnt = {
+	.type = FS_FATFS,
+	.mnt_point = FATFS_MNTP,
+	.fs_data = &fat_fs,
+};
+
+/* Expected by test_fs_vectored_io() */
+struct fs_mount_t *fs_vio_mp = &fatfs_mnt;
+
+ZTEST(fat_fs_basic, test_fat_vectored_io)
+{
+	test_fs_vectored_io();
+}
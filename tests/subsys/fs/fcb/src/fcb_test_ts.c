@@ -0,0 +1,160 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "fcb_test.h"
+#include <zephyr/fs/fcb_ts.h>
+
+#define TS_STEP 10
+#define TS_RECORDS 10000
+
+static uint8_t ts_buf[256];
+static struct fcb_ts_sector_range ts_ranges[4];
+
+static uint32_t ts_payload(uint64_t timestamp)
+{
+	return (uint32_t)(timestamp * 2654435761u);
+}
+
+ZTEST(fcb_test_with_4sectors_set, test_fcb_ts)
+{
+	struct fcb_ts ts = {
+		.fcb = &test_fcb,
+		.rec_len = sizeof(uint32_t),
+		.buf = ts_buf,
+		.buf_size = sizeof(ts_buf),
+		.ranges = ts_ranges,
+	};
+	struct fcb_ts_iter it;
+	uint64_t timestamp;
+	uint64_t oldest;
+	uint64_t newest = (TS_RECORDS - 1) * TS_STEP;
+	uint32_t data;
+	int cnt;
+	int rc;
+
+	rc = fcb_ts_init(&ts);
+	zassert_equal(rc, 0, "fcb_ts_init call failure");
+
+	/* Enough records to make the store rotate out its oldest sectors */
+	for (uint64_t i = 0; i < TS_RECORDS; i++) {
+		data = ts_payload(i * TS_STEP);
+		rc = fcb_ts_add(&ts, i * TS_STEP, &data);
+		zassert_equal(rc, 0, "fcb_ts_add call failure");
+	}
+
+	rc = fcb_ts_add(&ts, 0, &data);
+	zassert_equal(rc, -EINVAL, "out of order record should be rejected");
+
+	rc = fcb_ts_flush(&ts);
+	zassert_equal(rc, 0, "fcb_ts_flush call failure");
+
+	/* All retained records, oldest ones dropped by rotation */
+	rc = fcb_ts_iter_init(&ts, &it, 0, UINT64_MAX);
+	zassert_equal(rc, 0, "fcb_ts_iter_init call failure");
+
+	rc = fcb_ts_iter_next(&it, &oldest, &data);
+	zassert_equal(rc, 0, "fcb_ts_iter_next call failure");
+	zassert_true(oldest > 0, "oldest records should have been rotated out");
+
+	timestamp = oldest;
+	cnt = 1;
+	while (fcb_ts_iter_next(&it, &timestamp, &data) == 0) {
+		zassert_equal(timestamp, oldest + cnt * TS_STEP, "unexpected timestamp");
+		zassert_equal(data, ts_payload(timestamp), "unexpected payload");
+		cnt++;
+	}
+	zassert_equal(timestamp, newest, "newest record missing");
+
+	/* Range read starting in the middle of a batch */
+	rc = fcb_ts_iter_init(&ts, &it, newest - 1005, newest - 500);
+	zassert_equal(rc, 0, "fcb_ts_iter_init call failure");
+
+	cnt = 0;
+	while ((rc = fcb_ts_iter_next(&it, &timestamp, &data)) == 0) {
+		zassert_equal(timestamp, newest - 1000 + cnt * TS_STEP, "unexpected timestamp");
+		zassert_equal(data, ts_payload(timestamp), "unexpected payload");
+		cnt++;
+	}
+	zassert_equal(rc, -ENOENT, "iteration should end with -ENOENT");
+	zassert_equal(cnt, 51, "unexpected number of records in range");
+
+	/* Range entirely before the retained records */
+	rc = fcb_ts_iter_init(&ts, &it, 0, oldest - 1);
+	zassert_equal(rc, 0, "fcb_ts_iter_init call failure");
+	rc = fcb_ts_iter_next(&it, &timestamp, NULL);
+	zassert_equal(rc, -ENOENT, "no records expected");
+
+	/* Batched append, then the index must survive a re-initialization */
+	struct fcb_ts_record recs[] = {
+		{ .timestamp = newest + 1, .data = &data },
+		{ .timestamp = newest + 2, .data = &data },
+	};
+
+	data = 0xa5a5a5a5;
+	rc = fcb_ts_append(&ts, recs, ARRAY_SIZE(recs));
+	zassert_equal(rc, 0, "fcb_ts_append call failure");
+
+	rc = fcb_ts_init(&ts);
+	zassert_equal(rc, 0, "fcb_ts_init call failure");
+
+	rc = fcb_ts_add(&ts, newest, &data);
+	zassert_equal(rc, -EINVAL, "newest timestamp should be restored by fcb_ts_init");
+
+	rc = fcb_ts_iter_init(&ts, &it, newest + 1, UINT64_MAX);
+	zassert_equal(rc, 0, "fcb_ts_iter_init call failure");
+
+	cnt = 0;
+	while (fcb_ts_iter_next(&it, &timestamp, &data) == 0) {
+		zassert_equal(timestamp, newest + 1 + cnt, "unexpected timestamp");
+		zassert_equal(data, 0xa5a5a5a5, "unexpected payload");
+		cnt++;
+	}
+	zassert_equal(cnt, ARRAY_SIZE(recs), "unexpected number of batched records");
+}
+
+/* A staging buffer larger than a sector must not produce batches that can
+ * never be written, which would rotate out every stored record.
+ */
+ZTEST(fcb_test_with_4sectors_set, test_fcb_ts_batch_larger_than_sector)
+{
+	static uint8_t big_buf[FCB_MAX_LEN];
+	struct fcb_ts ts = {
+		.fcb = &test_fcb,
+		.rec_len = sizeof(uint32_t),
+		.buf = big_buf,
+		.buf_size = sizeof(big_buf),
+		.ranges = ts_ranges,
+	};
+	struct fcb_ts_iter it;
+	uint64_t timestamp;
+	/* Just over one sector worth of records */
+	const uint64_t records = test_fcb_sector[0].fs_size / 8 + 1;
+	uint32_t data;
+	int rc;
+
+	rc = fcb_ts_init(&ts);
+	zassert_equal(rc, 0, "fcb_ts_init call failure");
+
+	for (uint64_t i = 0; i < records; i++) {
+		data = ts_payload(i);
+		rc = fcb_ts_add(&ts, i, &data);
+		zassert_equal(rc, 0, "fcb_ts_add call failure (%d)", rc);
+	}
+
+	rc = fcb_ts_flush(&ts);
+	zassert_equal(rc, 0, "fcb_ts_flush call failure (%d)", rc);
+
+	/* Nothing was rotated out */
+	rc = fcb_ts_iter_init(&ts, &it, 0, UINT64_MAX);
+	zassert_equal(rc, 0, "fcb_ts_iter_init call failure");
+
+	for (uint64_t i = 0; i < records; i++) {
+		rc = fcb_ts_iter_next(&it, &timestamp, &data);
+		zassert_equal(rc, 0, "record %llu missing", i);
+		zassert_equal(timestamp, i, "unexpected timestamp");
+		zassert_equal(data, ts_payload(i), "unexpected payload");
+	}
+}
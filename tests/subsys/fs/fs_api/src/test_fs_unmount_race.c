@@ -0,0 +1,130 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include "test_fs.h"
+
+#define RACE_FS_TYPE   FS_TYPE_EXTERNAL_BASE
+#define RACE_FS_MNTP   "/RACE:"
+#define RACE_FILE      RACE_FS_MNTP"/file"
+#define RACE_ROUNDS    20
+#define RACE_STACKSIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static volatile bool unmounting;
+static volatile bool race_done;
+static int unmount_result;
+static atomic_t stat_while_mounted;
+static atomic_t stat_while_unmounting;
+
+static int race_mount(struct fs_mount_t *mountp)
+{
+	return 0;
+}
+
+static int race_unmount(struct fs_mount_t *mountp)
+{
+	unmounting = true;
+	/* Give the lookup thread time to resolve paths meanwhile */
+	k_sleep(K_MSEC(5));
+	unmounting = false;
+
+	return unmount_result;
+}
+
+static int race_stat(struct fs_mount_t *mountp, const char *path,
+		     struct fs_dirent *entry)
+{
+	if (unmounting) {
+		atomic_inc(&stat_while_unmounting);
+	} else {
+		atomic_inc(&stat_while_mounted);
+	}
+
+	entry->type = FS_DIR_ENTRY_FILE;
+	entry->size = 0;
+
+	return 0;
+}
+
+static const struct fs_file_system_t race_fs = {
+	.mount = race_mount,
+	.unmount = race_unmount,
+	.stat = race_stat,
+};
+
+static struct test_fs_data race_data;
+
+static struct fs_mount_t race_mnt = {
+	.type = RACE_FS_TYPE,
+	.mnt_point = RACE_FS_MNTP,
+	.fs_data = &race_data,
+};
+
+static K_THREAD_STACK_DEFINE(race_stack, RACE_STACKSIZE);
+static struct k_thread race_thread;
+
+/* Runs cooperatively, so every fs_stat() call completes before the test
+ * thread can run again, and the only place unmount can start is between
+ * two calls.
+ */
+static void race_lookup(void *p1, void *p2, void *p3)
+{
+	struct fs_dirent entry;
+
+	while (!race_done) {
+		(void)fs_stat(RACE_FILE, &entry);
+		k_sleep(K_MSEC(1));
+	}
+}
+
+/**
+ * @brief Test that path lookups never reach a file system being unmounted
+ *
+ * @details A cooperative thread resolves paths on a mount point in a loop
+ * while the test thread mounts and unmounts it. The backend unmount
+ * sleeps to let the lookups run while it is in progress.
+ */
+ZTEST(fs_api_unmount_race, test_unmount_lookup_race)
+{
+	struct fs_dirent entry;
+	int ret;
+
+	zassert_equal(fs_register(RACE_FS_TYPE, &race_fs), 0);
+
+	race_done = false;
+	k_thread_create(&race_thread, race_stack, K_THREAD_STACK_SIZEOF(race_stack),
+			race_lookup, NULL, NULL, NULL, K_PRIO_COOP(7), 0, K_NO_WAIT);
+
+	for (int i = 0; i < RACE_ROUNDS; i++) {
+		ret = fs_mount(&race_mnt);
+		zassert_equal(ret, 0, "mount failed (%d)", ret);
+		k_sleep(K_MSEC(3));
+
+		ret = fs_unmount(&race_mnt);
+		zassert_equal(ret, 0, "unmount failed (%d)", ret);
+		zassert_equal(fs_stat(RACE_FILE, &entry), -ENOENT);
+	}
+
+	race_done = true;
+	k_thread_join(&race_thread, K_FOREVER);
+
+	zassert_true(atomic_get(&stat_while_mounted) > 0, "lookups did not run");
+	zassert_equal(atomic_get(&stat_while_unmounting), 0,
+		      "%ld lookups reached a file system being unmounted",
+		      atomic_get(&stat_while_unmounting));
+
+	/* A failed unmount leaves the file system mounted */
+	zassert_equal(fs_mount(&race_mnt), 0);
+	unmount_result = -EBUSY;
+	zassert_equal(fs_unmount(&race_mnt), -EBUSY);
+	unmount_result = 0;
+	zassert_equal(fs_stat(RACE_FILE, &entry), 0);
+	zassert_equal(fs_unmount(&race_mnt), 0);
+
+	zassert_equal(fs_unregister(RACE_FS_TYPE, &race_fs), 0);
+}
+
+ZTEST_SUITE(fs_api_unmount_race, NULL, NULL, NULL, NULL, NULL);
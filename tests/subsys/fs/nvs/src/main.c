@@ -981,6 +981,308 @@ ZTEST_F(nvs, test_nvs_cache_hash_quality)
 #endif
 }
 
+/*
+ * Test that the NVS lookup index holds exactly one entry per stored NVS ID and
+ * falls back to scanning once it is full.
+ */
+ZTEST_F(nvs, test_nvs_cache_index)
+{
+#ifdef CONFIG_NVS_LOOKUP_INDEX
+	int err;
+	size_t i;
+	uint16_t id;
+	uint16_t data;
+	size_t num_ids = CONFIG_NVS_LOOKUP_CACHE_SIZE / 2;
+
+	fixture->fs.sector_count = 3;
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	for (id = 0; id < num_ids; id++) {
+		data = id;
+		err = nvs_write(&fixture->fs, id, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+	}
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+	zassert_false(fixture->fs.lookup_overflow, "unexpected index overflow");
+	zassert_equal(num_occupied_cache_entries(&fixture->fs), num_ids,
+		      "invalid index content after restart");
+
+	for (i = 0; i < CONFIG_NVS_LOOKUP_CACHE_SIZE; i++) {
+		if (fixture->fs.lookup_cache[i] != NVS_LOOKUP_CACHE_NO_ADDR) {
+			zassert_true(fixture->fs.lookup_ids[i] < num_ids, "unexpected ID indexed");
+		}
+	}
+
+	err = nvs_read(&fixture->fs, num_ids, &data, sizeof(data));
+	zassert_equal(err, -ENOENT, "missing ID found: %d", err);
+
+	/* Overflow the index and check that all IDs are still found */
+	for (id = num_ids; id < CONFIG_NVS_LOOKUP_CACHE_SIZE + 1; id++) {
+		data = id;
+		err = nvs_write(&fixture->fs, id, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+	}
+
+	zassert_true(fixture->fs.lookup_overflow, "index overflow not detected");
+
+	for (id = 0; id < CONFIG_NVS_LOOKUP_CACHE_SIZE + 1; id++) {
+		err = nvs_read(&fixture->fs, id, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_read call failure: %d", err);
+		zassert_equal(data, id, "incorrect data read");
+	}
+#endif
+}
+
+#ifdef CONFIG_TEST_NVS_SIMULATOR
+static int flash_sim_read_calls_find(struct stats_hdr *hdr, void *arg,
+				     const char *name, uint16_t off)
+{
+	if (!strcmp(name, "flash_read_calls")) {
+		uint32_t **flash_read_stat = (uint32_t **) arg;
+		*flash_read_stat = (uint32_t *)((uint8_t *)hdr + off);
+	}
+
+	return 0;
+}
+
+/*
+ * Report the flash reads and time needed to mount NVS and to read back
+ * every stored ID, for comparing the lookup cache configurations.
+ */
+ZTEST_F(nvs, test_nvs_lookup_benchmark)
+{
+	const uint16_t num_ids = 64;
+	uint32_t *flash_read_stat = NULL;
+	uint32_t reads;
+	int64_t start;
+	int64_t mount_us;
+	int64_t read_us;
+	int err;
+	uint16_t id;
+	uint16_t data;
+
+	stats_walk(fixture->sim_stats, flash_sim_read_calls_find, &flash_read_stat);
+	zassert_not_null(flash_read_stat, "flash_read_calls stat not found");
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	for (id = 0; id < num_ids; id++) {
+		data = id;
+		err = nvs_write(&fixture->fs, id, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+	}
+
+	reads = *flash_read_stat;
+	start = k_ticks_to_us_floor64(k_uptime_ticks());
+	err = nvs_mount(&fixture->fs);
+	mount_us = k_ticks_to_us_floor64(k_uptime_ticks()) - start;
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+	TC_PRINT("Mount: %u flash reads, %lld us\n", (unsigned int)(*flash_read_stat - reads),
+		 (long long)mount_us);
+
+	reads = *flash_read_stat;
+	start = k_ticks_to_us_floor64(k_uptime_ticks());
+	for (id = 0; id < num_ids; id++) {
+		err = nvs_read(&fixture->fs, id, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_read call failure: %d", err);
+	}
+	read_us = k_ticks_to_us_floor64(k_uptime_ticks()) - start;
+	reads = *flash_read_stat - reads;
+	TC_PRINT("Read of %u IDs: %u flash reads, %lld us\n", (unsigned int)num_ids,
+		 (unsigned int)reads, (long long)read_us);
+
+#if defined(CONFIG_NVS_LOOKUP_INDEX)
+	if (num_ids <= CONFIG_NVS_LOOKUP_CACHE_SIZE) {
+		/* ATE, data and optional data CRC, plus a close ATE at a sector boundary */
+		zassert_true(reads <= num_ids * 4U, "indexed reads should not scan");
+
+		reads = *flash_read_stat;
+		err = nvs_read(&fixture->fs, num_ids, &data, sizeof(data));
+		zassert_equal(err, -ENOENT, "missing ID found: %d", err);
+		zassert_equal(*flash_read_stat, reads, "missing ID lookup read flash");
+	}
+#endif
+}
+#endif /* CONFIG_TEST_NVS_SIMULATOR */
+
+#ifdef CONFIG_NVS_GC_BACKGROUND
+#define GC_BG_STATIC_ID		100U
+#define GC_BG_STATIC_COUNT	16U
+
+/* Entries that are written once and stay valid until garbage collected */
+static void write_static_content(struct nvs_fs *fs)
+{
+	uint8_t buf[32];
+	ssize_t len;
+
+	for (uint16_t i = 0; i < GC_BG_STATIC_COUNT; i++) {
+		memset(buf, GC_BG_STATIC_ID + i, sizeof(buf));
+		len = nvs_write(fs, GC_BG_STATIC_ID + i, buf, sizeof(buf));
+		zassert_true(len == sizeof(buf), "nvs_write failed: %d", len);
+	}
+}
+
+static void check_static_content(struct nvs_fs *fs)
+{
+	uint8_t rd_buf[32];
+	uint8_t buf[32];
+	ssize_t len;
+
+	for (uint16_t i = 0; i < GC_BG_STATIC_COUNT; i++) {
+		memset(buf, GC_BG_STATIC_ID + i, sizeof(buf));
+		len = nvs_read(fs, GC_BG_STATIC_ID + i, rd_buf, sizeof(rd_buf));
+		zassert_true(len == sizeof(rd_buf),
+			     "nvs_read unexpected failure: %d", len);
+		zassert_mem_equal(buf, rd_buf, sizeof(rd_buf),
+				  "RD buff should be equal to the WR buff");
+	}
+}
+#endif /* CONFIG_NVS_GC_BACKGROUND */
+
+/*
+ * Test that background garbage collection moves the valid entries of the
+ * sector collected by the next rotation in several steps, interleaved with
+ * foreground writes, and then rotates the write sector without losing data.
+ */
+ZTEST_F(nvs, test_nvs_gc_background)
+{
+#ifdef CONFIG_NVS_GC_BACKGROUND
+	int err;
+	const uint16_t max_id = 10;
+	int prio = k_thread_priority_get(k_current_get());
+	uint32_t threshold;
+	uint16_t i = 0;
+	int steps = 0;
+	int writes = 0;
+
+	fixture->fs.sector_count = 3;
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	threshold = fixture->fs.sector_size * CONFIG_NVS_GC_BACKGROUND_THRESHOLD / 100U;
+
+	/* The test thread is cooperative, so the work queue does not run while
+	 * sector 0 gets entries that stay valid and is filled up.
+	 */
+	write_static_content(&fixture->fs);
+	while ((fixture->fs.ate_wra >> ADDR_SECT_SHIFT) == 0) {
+		write_content(max_id, i, i + 1, &fixture->fs);
+		i++;
+	}
+
+	/* Fill sector 1 up to the threshold, the next rotation collects
+	 * sector 0.
+	 */
+	while ((fixture->fs.ate_wra - fixture->fs.data_wra) >= threshold) {
+		write_content(max_id, i, i + 1, &fixture->fs);
+		i++;
+	}
+	zassert_equal(fixture->fs.ate_wra >> ADDR_SECT_SHIFT, 1,
+		      "unexpected write sector");
+	zassert_equal(fixture->fs.gc_bg_addr, NVS_GC_BG_IDLE,
+		      "background gc started too early");
+
+	/* At the work queue priority each yield runs one background step,
+	 * as the work queue yields after each work item.
+	 */
+	k_thread_priority_set(k_current_get(), CONFIG_NVS_GC_BACKGROUND_PRIORITY);
+	for (int n = 0; n < 1000; n++) {
+		if ((fixture->fs.ate_wra >> ADDR_SECT_SHIFT) != 1) {
+			break;
+		}
+
+		k_yield();
+
+		if ((fixture->fs.gc_bg_addr == NVS_GC_BG_IDLE) ||
+		    (fixture->fs.gc_bg_addr == NVS_GC_BG_DONE)) {
+			continue;
+		}
+
+		steps++;
+		if ((steps % 4) == 0) {
+			write_content(max_id, i, i + 1, &fixture->fs);
+			i++;
+			writes++;
+		}
+	}
+	k_thread_priority_set(k_current_get(), prio);
+
+	zassert_equal(fixture->fs.ate_wra >> ADDR_SECT_SHIFT, 2,
+		      "write sector was not rotated in the background");
+	zassert_true(steps > 1, "background gc did not run in steps");
+	zassert_true(writes > 0, "no write was done during background gc");
+	zassert_equal(fixture->fs.gc_bg_addr, NVS_GC_BG_IDLE,
+		      "background gc did not complete");
+	check_content(max_id, &fixture->fs);
+	check_static_content(&fixture->fs);
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+	zassert_equal(fixture->fs.ate_wra >> ADDR_SECT_SHIFT, 2,
+		      "unexpected write sector");
+	check_content(max_id, &fixture->fs);
+	check_static_content(&fixture->fs);
+
+#ifdef CONFIG_NVS_GC_STATS
+	zassert_not_null(stats_group_find("nvs_gc"), "nvs_gc stats not registered");
+#endif
+#else
+	ztest_test_skip();
+#endif
+}
+
+/*
+ * Test that background garbage collection starts when the write sector is
+ * already below the threshold at mount.
+ */
+ZTEST_F(nvs, test_nvs_gc_background_mount)
+{
+#ifdef CONFIG_NVS_GC_BACKGROUND
+	int err;
+	const uint16_t max_id = 10;
+	uint32_t threshold;
+	uint16_t i = 0;
+	struct k_work_sync sync;
+
+	fixture->fs.sector_count = 3;
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	threshold = fixture->fs.sector_size * CONFIG_NVS_GC_BACKGROUND_THRESHOLD / 100U;
+
+	/* The work queue does not run before the remount */
+	while ((fixture->fs.ate_wra - fixture->fs.data_wra) >= threshold) {
+		write_content(max_id, i, i + 1, &fixture->fs);
+		i++;
+	}
+
+	/* Drop the work queued by the writes, as a reboot would */
+	(void)k_work_cancel_sync(&fixture->fs.gc_work, &sync);
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+	zassert_equal(fixture->fs.ate_wra >> ADDR_SECT_SHIFT, 0,
+		      "unexpected write sector");
+
+	/* Let the background work queue run */
+	k_sleep(K_MSEC(100));
+
+	zassert_equal(fixture->fs.ate_wra >> ADDR_SECT_SHIFT, 1,
+		      "write sector was not rotated in the background");
+	zassert_equal(fixture->fs.gc_bg_addr, NVS_GC_BG_IDLE,
+		      "background gc did not complete");
+	check_content(max_id, &fixture->fs);
+#else
+	ztest_test_skip();
+#endif
+}
+
 #ifdef CONFIG_TEST_NVS_SIMULATOR
 /*
  * Test NVS bad region initialization recovery.
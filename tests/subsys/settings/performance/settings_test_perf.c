@@ -89,6 +89,60 @@ static void store_pending(struct k_work *work)
 
 ZTEST_SUITE(settings_perf, NULL, NULL, NULL, NULL, NULL);
 
+#define TEST_LOAD_SUBTREE "perf/load"
+
+static uint32_t load_count;
+
+static int perf_load_set(const char *key, size_t len, settings_read_cb read_cb, void *cb_arg)
+{
+	load_count++;
+
+	return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(perf_load, TEST_LOAD_SUBTREE, NULL, perf_load_set, NULL, NULL);
+
+ZTEST(settings_perf, test_load_performance)
+{
+	int err;
+	char path[24];
+	int64_t ts;
+
+	err = settings_subsys_init();
+	zassert_equal(err, 0, "settings_subsys_init failed %d", err);
+
+	for (uint16_t i = 0; i < CONFIG_TEST_SETTINGS_LOAD_COUNT; i++) {
+		snprintk(path, sizeof(path), TEST_LOAD_SUBTREE "/%x", i);
+		err = settings_save_one(path, &i, sizeof(i));
+		zassert_equal(err, 0, "settings_save_one failed %d", err);
+	}
+
+	load_count = 0;
+	ts = k_uptime_get();
+	err = settings_load();
+	printk("settings_load() of %u items: %lld ms\n", load_count,
+	       (long long)k_uptime_delta(&ts));
+	zassert_equal(err, 0, "settings_load failed %d", err);
+	zassert_equal(load_count, CONFIG_TEST_SETTINGS_LOAD_COUNT, "not all items loaded");
+
+	load_count = 0;
+	ts = k_uptime_get();
+	err = settings_load_subtree(TEST_LOAD_SUBTREE);
+	printk("settings_load_subtree() of %u items: %lld ms\n", load_count,
+	       (long long)k_uptime_delta(&ts));
+	zassert_equal(err, 0, "settings_load_subtree failed %d", err);
+	zassert_equal(load_count, CONFIG_TEST_SETTINGS_LOAD_COUNT, "not all items loaded");
+
+	ts = k_uptime_get();
+	for (uint16_t i = 0; i < CONFIG_TEST_SETTINGS_LOAD_COUNT; i++) {
+		snprintk(path, sizeof(path), TEST_LOAD_SUBTREE "/%x", i);
+		err = settings_save_one(path, &i, sizeof(i));
+		zassert_equal(err, 0, "settings_save_one failed %d", err);
+	}
+	printk("settings_save_one() of %u existing items: %lld ms\n",
+	       CONFIG_TEST_SETTINGS_LOAD_COUNT, (long long)k_uptime_delta(&ts));
+}
+
 ZTEST(settings_perf, test_performance)
 {
 	int err;
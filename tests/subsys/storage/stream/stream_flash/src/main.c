@@ -638,6 +638,87 @@ ZTEST(lib_stream_flash, test_stream_flash_progress_clear)
 #endif
 }
 
+#ifdef CONFIG_STREAM_FLASH_PIPELINE
+#define BENCH_CHUNK 128
+#define BENCH_PAGES 16
+
+STREAM_FLASH_RTIO_DEFINE(sf_rtio);
+static uint8_t pipeline_buf[2 * BUF_LEN];
+
+ZTEST(lib_stream_flash, test_stream_flash_pipelined_write)
+{
+	int rc;
+	size_t total = page_size * MAX_NUM_PAGES;
+
+	init_target();
+
+	rc = stream_flash_init_pipelined(&ctx, fdev, pipeline_buf, sizeof(pipeline_buf),
+					 FLASH_BASE, FLASH_AVAILABLE, stream_flash_callback,
+					 &sf_rtio);
+	zassert_equal(rc, 0, "expected success");
+
+	/* Fill the first buffer, which is then written in the background */
+	rc = stream_flash_buffered_write(&ctx, write_buf, BUF_LEN + 128, false);
+	zassert_equal(rc, 0, "expected success");
+	zassert_equal(stream_flash_bytes_written(&ctx) + stream_flash_bytes_buffered(&ctx),
+		      BUF_LEN + 128, "all data should be accounted for");
+
+	/* Odd sized chunks cross buffer and page borders */
+	for (size_t off = BUF_LEN + 128; off < total; off += 100) {
+		rc = stream_flash_buffered_write(&ctx, write_buf, MIN(100, total - off), false);
+		zassert_equal(rc, 0, "expected success");
+	}
+
+	rc = stream_flash_buffered_write(&ctx, NULL, 0, true);
+	zassert_equal(rc, 0, "expected success");
+	zassert_equal(stream_flash_bytes_written(&ctx), total, "all data should be written");
+	zassert_equal(stream_flash_bytes_buffered(&ctx), 0, "nothing should be buffered");
+
+	VERIFY_WRITTEN(0, total);
+}
+
+/* Time writing an image that arrives in small chunks, with a pause for
+ * receiving each chunk.
+ */
+static uint32_t ingest_image(size_t total)
+{
+	int64_t start = k_uptime_get();
+	int rc;
+
+	for (size_t off = 0; off < total; off += BENCH_CHUNK) {
+		k_usleep(100);
+		rc = stream_flash_buffered_write(&ctx, write_buf, BENCH_CHUNK, false);
+		zassert_equal(rc, 0, "expected success");
+	}
+
+	rc = stream_flash_buffered_write(&ctx, NULL, 0, true);
+	zassert_equal(rc, 0, "expected success");
+	zassert_equal(stream_flash_bytes_written(&ctx), total, "all data should be written");
+
+	return (uint32_t)(k_uptime_get() - start);
+}
+
+ZTEST(lib_stream_flash, test_stream_flash_pipelined_benchmark)
+{
+	size_t total = MIN(page_size * BENCH_PAGES, FLASH_AVAILABLE);
+	uint32_t sync_ms;
+	uint32_t pipelined_ms;
+	int rc;
+
+	init_target();
+	sync_ms = ingest_image(total);
+
+	init_target();
+	rc = stream_flash_init_pipelined(&ctx, fdev, pipeline_buf, sizeof(pipeline_buf),
+					 FLASH_BASE, FLASH_AVAILABLE, NULL, &sf_rtio);
+	zassert_equal(rc, 0, "expected success");
+	pipelined_ms = ingest_image(total);
+
+	TC_PRINT("Ingested %zu bytes: synchronous %u ms, pipelined %u ms\n", total,
+		 sync_ms, pipelined_ms);
+}
+#endif /* CONFIG_STREAM_FLASH_PIPELINE */
+
 void lib_stream_flash_before(void *data)
 {
 	zassume_true(device_is_ready(fdev), "Device is not ready");
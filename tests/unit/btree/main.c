@@ -0,0 +1,209 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/ztest.h>
+#include <zephyr/sys/btree.h>
+
+#include "../../../lib/utils/btree.c"
+
+#define MAX_ITEMS 512
+
+struct item {
+	struct btnode node;
+	int32_t key;
+	bool in_tree;
+};
+
+static struct item items[MAX_ITEMS];
+static struct btree_node tree_nodes[BTREE_NODES(MAX_ITEMS)];
+static struct btree tree;
+
+/* Deterministic pseudo-random sequence so failures can be reproduced */
+static uint32_t next_rand(void)
+{
+	static uint32_t state = 123456789;
+
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+
+	return state;
+}
+
+static void reset_tree(void)
+{
+	btree_init(&tree, tree_nodes, ARRAY_SIZE(tree_nodes));
+	memset(items, 0, sizeof(items));
+}
+
+static void insert_item(int i, int32_t key)
+{
+	items[i].key = key;
+	zassert_ok(btree_insert(&tree, &items[i].node, key));
+	items[i].in_tree = true;
+}
+
+/* Walks the tree and checks it against the in_tree flags */
+static void check_tree(void)
+{
+	struct item *it;
+	struct item *prev = NULL;
+	size_t count = 0;
+	size_t expected = 0;
+
+	BTREE_FOR_EACH_CONTAINER(&tree, it, node) {
+		zassert_true(it->in_tree, "walked item %d not in tree", (int)(it - items));
+		zassert_equal(btnode_key(&it->node), it->key);
+		if (prev != NULL) {
+			zassert_true(prev->key <= it->key, "walk out of order");
+		}
+		prev = it;
+		count++;
+	}
+
+	for (int i = 0; i < MAX_ITEMS; i++) {
+		zassert_equal(btree_contains(&tree, &items[i].node), items[i].in_tree);
+		expected += items[i].in_tree ? 1 : 0;
+	}
+
+	zassert_equal(count, expected);
+	zassert_equal(btree_size(&tree), expected);
+}
+
+ZTEST(btree, test_empty)
+{
+	reset_tree();
+
+	zassert_true(btree_is_empty(&tree));
+	zassert_is_null(btree_get_min(&tree));
+	zassert_is_null(btree_get_max(&tree));
+	zassert_is_null(btree_remove_min(&tree));
+	zassert_false(btree_contains(&tree, &items[0].node));
+}
+
+ZTEST(btree, test_min_max)
+{
+	reset_tree();
+
+	for (int i = 0; i < MAX_ITEMS; i++) {
+		insert_item(i, (i * 37) % MAX_ITEMS - MAX_ITEMS / 2);
+	}
+
+	zassert_equal(btnode_key(btree_get_min(&tree)), -MAX_ITEMS / 2);
+	zassert_equal(btnode_key(btree_get_max(&tree)), MAX_ITEMS / 2 - 1);
+	check_tree();
+
+	for (int32_t key = -MAX_ITEMS / 2; key < MAX_ITEMS / 2; key++) {
+		struct btnode *n = btree_remove_min(&tree);
+
+		zassert_not_null(n);
+		zassert_equal(btnode_key(n), key);
+		CONTAINER_OF(n, struct item, node)->in_tree = false;
+	}
+
+	zassert_true(btree_is_empty(&tree));
+	check_tree();
+}
+
+ZTEST(btree, test_equal_keys_fifo)
+{
+	struct btnode *n;
+
+	reset_tree();
+
+	/* interleave two keys so equal entries land in different nodes */
+	for (int i = 0; i < MAX_ITEMS; i++) {
+		insert_item(i, i & 1);
+	}
+
+	for (int i = 0; i < MAX_ITEMS; i += 2) {
+		n = btree_remove_min(&tree);
+		zassert_equal_ptr(n, &items[i].node, "equal keys not in insertion order");
+	}
+	for (int i = 1; i < MAX_ITEMS; i += 2) {
+		n = btree_remove_min(&tree);
+		zassert_equal_ptr(n, &items[i].node, "equal keys not in insertion order");
+	}
+}
+
+ZTEST(btree, test_random_ops)
+{
+	struct item *it;
+
+	reset_tree();
+
+	for (int op = 0; op < 20000; op++) {
+		int i = next_rand() % MAX_ITEMS;
+
+		if (!items[i].in_tree) {
+			insert_item(i, (int32_t)(next_rand() % 64) - 32);
+		} else if (next_rand() & 1) {
+			btree_remove(&tree, &items[i].node);
+			items[i].in_tree = false;
+		} else {
+			it = CONTAINER_OF(btree_remove_min(&tree), struct item, node);
+			it->in_tree = false;
+		}
+
+		if (op % 1000 == 0) {
+			check_tree();
+		}
+	}
+
+	check_tree();
+}
+
+ZTEST(btree, test_remove_while_walking)
+{
+	struct item *it;
+
+	reset_tree();
+
+	for (int i = 0; i < MAX_ITEMS; i++) {
+		insert_item(i, i);
+	}
+
+	BTREE_FOR_EACH_CONTAINER(&tree, it, node) {
+		if (it->key % 3 != 0) {
+			btree_remove(&tree, &it->node);
+			it->in_tree = false;
+		}
+	}
+
+	zassert_equal(btree_size(&tree), DIV_ROUND_UP(MAX_ITEMS, 3));
+	check_tree();
+}
+
+ZTEST(btree, test_pool_exhausted)
+{
+	static struct btree_node small_pool[3];
+	struct btree small;
+	int inserted = 0;
+
+	reset_tree();
+
+	/* the full pool always holds the advertised number of entries */
+	for (int i = 0; i < MAX_ITEMS; i++) {
+		insert_item(i, MAX_ITEMS - i);
+	}
+	check_tree();
+
+	btree_init(&small, small_pool, ARRAY_SIZE(small_pool));
+	while (btree_insert(&small, &items[inserted].node, 0) == 0) {
+		inserted++;
+		zassert_true(inserted < MAX_ITEMS);
+	}
+
+	/* a failed insertion leaves the tree intact and usable */
+	zassert_true(inserted >= 2 * CONFIG_BTREE_MIN_DEGREE - 1);
+	zassert_equal(btree_size(&small), inserted);
+	zassert_false(btree_contains(&small, &items[inserted].node));
+	for (int i = 0; i < inserted; i++) {
+		zassert_equal_ptr(btree_remove_min(&small), &items[i].node);
+	}
+	zassert_true(btree_is_empty(&small));
+}
+
+ZTEST_SUITE(btree, NULL, NULL, NULL, NULL, NULL);
@@ -14,6 +14,7 @@
 #include "../../../subsys/crc/crc24_sw.c"
 #include "../../../subsys/crc/crc4_sw.c"
 #include "../../../subsys/crc/crc32k_4_2_sw.c"
+#include "../../../subsys/crc/crc32_combine.c"
 
 ZTEST(crc, test_crc32_k_4_2)
 {
@@ -74,6 +75,26 @@ ZTEST(crc, test_crc32_ieee)
 	zassert_equal(crc32_ieee(test3, sizeof(test3)), 0x20089AA4);
 }
 
+ZTEST(crc, test_crc32_combine)
+{
+	uint8_t test[300];
+
+	for (size_t i = 0; i < sizeof(test); i++) {
+		test[i] = (uint8_t)(i * 7U + 3U);
+	}
+
+	for (size_t split = 0; split <= sizeof(test); split += 13) {
+		size_t len2 = sizeof(test) - split;
+
+		zassert_equal(crc32_ieee_combine(crc32_ieee(test, split),
+						 crc32_ieee(test + split, len2), len2),
+			      crc32_ieee(test, sizeof(test)));
+		zassert_equal(crc32_c_combine(crc32_c(0, test, split, true, true),
+					      crc32_c(0, test + split, len2, true, true), len2),
+			      crc32_c(0, test, sizeof(test), true, true));
+	}
+}
+
 ZTEST(crc, test_crc24_pgp)
 {
 	uint8_t test1[] = { 'A' };